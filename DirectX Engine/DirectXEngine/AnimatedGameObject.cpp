@@ -1,34 +1,66 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Headers
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 #include "AnimatedGameObject.h"
+#include "ShaderManager.h"
+#include "Animation.h"
 
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+AnimatedGameObject::AnimatedGameObject(const XMFLOAT3& Position, Texture* texture) :
+	GameObject(Position, nullptr, texture)
+{
+	_Playhead = Animations::Instance()->CreatePlayhead();
 
+	//The morph shader only swaps the vertex shader - the layout still reads the texture coordinates from the shared mesh
+	_MorphShader = Shaders::Instance()->GetProgram<BasicShader>(L"morphShader.vs", L"basicShader.ps");
+}
 
-AnimatedGameObject::AnimatedGameObject(XMVECTOR Position, Texture* texture) 
-	//GameObject(Position, nullptr, texture)
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+AnimatedGameObject::~AnimatedGameObject()
 {
-	
-	_CurrentAnim = "walk";
+	Animations::Instance()->ReleasePlayhead(_Playhead);
 }
 
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+void AnimatedGameObject::Play(ClipId Clip)
+{
+	Animations::Instance()->Play(_Playhead, Clip);
+}
 
-AnimatedGameObject::~AnimatedGameObject()
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+void AnimatedGameObject::SetSpeed(float Speed)
 {
+	Animations::Instance()->SetSpeed(_Playhead, Speed);
 }
 
-void AnimatedGameObject::Update(float delta)
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ClipId AnimatedGameObject::GetClip() const
 {
-	_Animations.at(_CurrentAnim)->Update(delta);
-	SetModel(_Animations.at(_CurrentAnim)->GetCurrentFrame());
+	return Animations::Instance()->GetPlayingClip(_Playhead);
 }
 
-void AnimatedGameObject::AddAnimation(std::string name,Animation * anim)
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+void AnimatedGameObject::Submit(RenderQueue& Queue)
 {
-	_Animations.emplace(std::pair<std::string, Animation*>(name, anim));
+	if (!_MorphShader) { return; }
+
+	AnimationLibrary* animations = Animations::Instance();
+
+	Pose pose;
+	pose.Clip = animations->GetAnimation(animations->GetPlayingClip(_Playhead));
+	pose.Time = animations->GetTime(_Playhead);
+
+	if (!pose.Clip) { return; }
+
+	Queue.Submit(LAYER_OPAQUE, _MorphShader, GetTexture(), this, GetWorldMatrix(), GetPositionF(),
+				 XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f), &pose, sizeof(pose));
 }
 
-void AnimatedGameObject::Unload()
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+void AnimatedGameObject::Render(RenderContext& Context, const void* Data) const
 {
-	for (auto a : _Animations) {
-		a.second->Unload();
-		delete a.second;
-	}
+	//Only the copy is read here - the playhead may already have moved on, or been given another clip
+	const Pose* pose = static_cast<const Pose*>(Data);
+
+	pose->Clip->Render(Context, pose->Time);
 }
@@ -1,23 +1,92 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//  AnimatedGameObject.h, AnimatedGameObject.cpp
+//
+//  Created By:     Chris Hargove
+//  Last Updated:   19/10/2026
+//
+//  This class is a game object that is drawn with one of a set of animations, rather
+//  than a single still model.
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 #pragma once
 
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Headers
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 #include "GameObject.h"
-#include "Animation.h"
+#include "AnimationLibrary.h"
 
-#include <map>
-
-
-class AnimatedGameObject :	public GameObject
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//  This class is a game object that is drawn with one of a set of animations, rather
+//  than a single still model.
+//
+//  The clips themselves live in the animation library and are shared by every object
+//  playing them. Each object only has a playhead in the library - which clip, how far
+//  through it is and how fast it plays - and the library moves every playhead on at once.
+//
+//  The clip and time are copied in to the render queue when the object is submitted, so
+//  the frame is drawn as it was then, however the library changes while it's drawn.
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+class AnimatedGameObject : public GameObject, public Renderable
 {
 public:
-	AnimatedGameObject(XMVECTOR Position, Texture* texture);
-	~AnimatedGameObject();
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    //  Constructor
+    //  --Position-- The Objects position in the game scene.
+    //  --texture-- Pointer to a texture for this object.
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+	AnimatedGameObject(const XMFLOAT3& Position, Texture* texture);
+
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    //  Default Destructor
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+	virtual ~AnimatedGameObject();
+
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    //  Starts playing a clip from the beginning.
+    //  --Clip-- The clip ID given by the animation library when it was loaded.
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+	void Play(ClipId Clip);
+
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    //  Sets how fast the clip plays, 1 being normal speed and negative playing backwards.
+    //  --Speed-- The new playback speed.
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+	void SetSpeed(float Speed);
 
-	void Update(float delta);
-	void AddAnimation(std::string name, Animation* anim);
-	void Unload();
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    //  Gets the clip being played, or INVALID_CLIP if nothing is playing.
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+	ClipId GetClip() const;
+
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    //  Adds the game object to the render queue, drawn with the morph shader, along with
+    //  a copy of the clip and how far through it the playhead is.
+    //  --Queue--  The render queue for this frame.
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+	virtual void Submit(RenderQueue& Queue) override;
+
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    //  Draws the clip as it was when the object was submitted. Called by the queue.
+    //  --Context-- The render context to draw with.
+    //  --Data-- The pose copied in to the queue by Submit.
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+	virtual void Render(RenderContext& Context, const void* Data) const override;
 
 private:
-	std::map<std::string, Animation*> _Animations;
-	std::string _CurrentAnim;
-};
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    //  What's drawn for one frame - the clip itself rather than its ID, as the library's
+    //  list of clips may grow while the frame is drawn.
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+	struct Pose
+	{
+		const Animation*    Clip;
+		float               Time;
+	};
 
+private:
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    //  Member Variables.
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+	Playhead        _Playhead;      // The clip, time and speed in the animation library
+	BasicShader*    _MorphShader;   // Shared shader owned by the shader manager
+};
@@ -1,59 +1,267 @@
-#include "Animation.h"
-
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Headers
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <map>
 
+#include "Animation.h"
+#include "GraphicsManager.h"
+#include "RenderContext.h"
+#include "objLoader.h"
+#include "Log.h"
 
-Animation::Animation(int NumFrames, char* FileName, ID3D11Device* Device) :
-	_DeltaTime(0),
-	_CurrentFrame(0),
-	_NumFrames(NumFrames)
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+Animation::Animation() :
+	_Mesh(nullptr),
+	_Frames(nullptr),
+	_FrameView(nullptr),
+	_BoundsMin(0.0f, 0.0f, 0.0f),
+	_BoundsSize(1.0f, 1.0f, 1.0f),
+	_VertexCount(0),
+	_NumFrames(0),
+	_FrameRate(0.0f)
 {
-	Load(FileName, Device);
 }
 
-
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 Animation::~Animation()
 {
+	Unload();
 }
 
-Model * Animation::GetCurrentFrame()
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+bool Animation::Load(const std::string& FileName, int NumFrames, float FrameRate)
 {
-	if (_CurrentFrame == _NumFrames) {
-		_CurrentFrame == 0;
+	Unload();
+
+	if (NumFrames <= 0 || FrameRate <= 0.0f) {
+		DX_LOG("[ANIMATION] Animation needs at least one frame and a frame rate: ", FileName.c_str(), LOG_ERROR);
+		return false;
+	}
+
+	std::vector<std::vector<BufferConstants::PackedVertex>> frames(NumFrames);
+	ObjLoader objLoader;
+
+	for (int i = 0; i < NumFrames; i++) {
+		std::string frameName = FileName + "_" + std::to_string(i) + ".obj";
+
+		if (!objLoader.LoadObjFile(frameName.c_str(), frames[i])) {
+			DX_LOG("[ANIMATION] Couldn't load animation frame: ", frameName.c_str(), LOG_ERROR);
+			return false;
+		}
+
+		//Every frame has to be the same mesh in a different pose, or frames can't be blended
+		if (frames[i].empty() || frames[i].size() != frames[0].size()) {
+			DX_LOG("[ANIMATION] Animation frame doesn't match the first frame: ", frameName.c_str(), LOG_ERROR);
+			return false;
+		}
+	}
+
+	_NumFrames = NumFrames;
+	_FrameRate = FrameRate;
+
+	if (!Build(frames)) {
+		Unload();
+		return false;
 	}
-	return _Models[_CurrentFrame];
+
+	return true;
 }
 
-void Animation::Update(float deltaTime)
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+bool Animation::Build(const std::vector<std::vector<BufferConstants::PackedVertex>>& Frames)
 {
-	_DeltaTime += deltaTime;
-	if (_DeltaTime >= 0.1) {
-		_DeltaTime = 0;
-		_CurrentFrame++;
+	const unsigned int cornerCount = Frames[0].size();
+	const unsigned int frameCount = Frames.size();
+
+	//Two corners can only share a vertex if they match in every frame. The key is the first
+	//frame's whole corner, then the position and normal of the corner in every other frame.
+	const unsigned int positionSize = sizeof(XMFLOAT3);
+	const unsigned int normalOffset = offsetof(BufferConstants::PackedVertex, normal);
+
+	std::map<std::string, unsigned int> cornerToVertex;
+	std::vector<unsigned int> vertexCorner;
+	std::vector<unsigned int> indices(cornerCount);
+	std::string key;
+
+	for (unsigned int corner = 0; corner < cornerCount; corner++) {
+		key.assign((const char*)&Frames[0][corner], sizeof(BufferConstants::PackedVertex));
+
+		for (unsigned int frame = 1; frame < frameCount; frame++) {
+			const char* packed = (const char*)&Frames[frame][corner];
+			key.append(packed, positionSize);
+			key.append(packed + normalOffset, positionSize);
+		}
+
+		std::map<std::string, unsigned int>::iterator it = cornerToVertex.find(key);
+
+		if (it != cornerToVertex.end()) {
+			indices[corner] = it->second;
+		}
+		else {
+			indices[corner] = vertexCorner.size();
+			cornerToVertex[key] = indices[corner];
+			vertexCorner.push_back(corner);
+		}
+	}
+
+	_VertexCount = vertexCorner.size();
+
+	//The shared mesh is the first frame, the shader only takes its texture coordinates
+	std::vector<BufferConstants::PackedVertex> vertices(_VertexCount);
+
+	for (unsigned int i = 0; i < _VertexCount; i++) {
+		vertices[i] = Frames[0][vertexCorner[i]];
 	}
-	if (_NumFrames <= _CurrentFrame) {
-		_CurrentFrame = 0;
+
+	_Mesh = new Buffer();
+
+	if (!_Mesh->Push(vertices)) { return false; }
+	if (!_Mesh->Push(indices)) { return false; }
+
+	//Positions are stored relative to a box holding every frame, so it has to be found first
+	XMFLOAT3 minimum = Frames[0][0].position;
+	XMFLOAT3 maximum = minimum;
+
+	for (unsigned int frame = 0; frame < frameCount; frame++) {
+		for (unsigned int i = 0; i < _VertexCount; i++) {
+			const XMFLOAT3& position = Frames[frame][vertexCorner[i]].position;
+
+			minimum.x = (std::min)(minimum.x, position.x);  maximum.x = (std::max)(maximum.x, position.x);
+			minimum.y = (std::min)(minimum.y, position.y);  maximum.y = (std::max)(maximum.y, position.y);
+			minimum.z = (std::min)(minimum.z, position.z);  maximum.z = (std::max)(maximum.z, position.z);
+		}
 	}
+
+	//A flat axis still needs a size to divide by, anything will do as every position sits at 0
+	_BoundsMin = minimum;
+	_BoundsSize = XMFLOAT3((maximum.x > minimum.x) ? maximum.x - minimum.x : 1.0f,
+	                       (maximum.y > minimum.y) ? maximum.y - minimum.y : 1.0f,
+	                       (maximum.z > minimum.z) ? maximum.z - minimum.z : 1.0f);
+
+	std::vector<unsigned int> packed(_VertexCount * frameCount * 2);
+
+	for (unsigned int frame = 0; frame < frameCount; frame++) {
+		for (unsigned int i = 0; i < _VertexCount; i++) {
+			const BufferConstants::PackedVertex& vertex = Frames[frame][vertexCorner[i]];
+			Encode(vertex.position, vertex.normal, &packed[(frame * _VertexCount + i) * 2]);
+		}
+	}
+
+	//The frames never change once loaded, so they can live where the GPU reads them fastest
+	D3D11_BUFFER_DESC frameDescription = { 0 };
+	frameDescription.Usage = D3D11_USAGE_IMMUTABLE;
+	frameDescription.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+	frameDescription.ByteWidth = sizeof(unsigned int) * packed.size();
+
+	D3D11_SUBRESOURCE_DATA frameData = { 0 };
+	frameData.pSysMem = &packed.front();
+
+	ID3D11Device* device = Graphics::Instance()->GetDevice();
+
+	if (FAILED(device->CreateBuffer(&frameDescription, &frameData, &_Frames))) {
+		DX_LOG("[ANIMATION] Problem creating animation frame buffer", DX_LOG_EMPTY, LOG_ERROR);
+		return false;
+	}
+
+	D3D11_SHADER_RESOURCE_VIEW_DESC viewDescription;
+	ZeroMemory(&viewDescription, sizeof(viewDescription));
+	viewDescription.Format = DXGI_FORMAT_R32G32_UINT;
+	viewDescription.ViewDimension = D3D11_SRV_DIMENSION_BUFFER;
+	viewDescription.Buffer.FirstElement = 0;
+	viewDescription.Buffer.NumElements = _VertexCount * frameCount;
+
+	if (FAILED(device->CreateShaderResourceView(_Frames, &viewDescription, &_FrameView))) {
+		DX_LOG("[ANIMATION] Problem creating animation frame view", DX_LOG_EMPTY, LOG_ERROR);
+		return false;
+	}
+
+	return true;
 }
 
-void Animation::Load(char* FileName, ID3D11Device* Device)
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+void Animation::Encode(const XMFLOAT3& Position, const XMFLOAT3& Normal, unsigned int* Packed) const
 {
-	std::string NewFileName;
+	//Positions are 0 to 65535 across the bounds on each axis
+	float x = (Position.x - _BoundsMin.x) / _BoundsSize.x;
+	float y = (Position.y - _BoundsMin.y) / _BoundsSize.y;
+	float z = (Position.z - _BoundsMin.z) / _BoundsSize.z;
 
-	for (int i = 0; i < _NumFrames; i++) {
-		NewFileName = FileName;
-		NewFileName += "_" + std::to_string(i) + ".obj";
+	unsigned int qx = (unsigned int)((std::min)((std::max)(x, 0.0f), 1.0f) * 65535.0f + 0.5f);
+	unsigned int qy = (unsigned int)((std::min)((std::max)(y, 0.0f), 1.0f) * 65535.0f + 0.5f);
+	unsigned int qz = (unsigned int)((std::min)((std::max)(z, 0.0f), 1.0f) * 65535.0f + 0.5f);
 
-		char* temp = (char*)NewFileName.c_str();
+	//Normals are folded on to an octahedron, then flattened to 2 values of 0 to 255
+	float length = fabsf(Normal.x) + fabsf(Normal.y) + fabsf(Normal.z);
+	float u = (length > 0.0f) ? Normal.x / length : 0.0f;
+	float v = (length > 0.0f) ? Normal.y / length : 0.0f;
 
-		_Models.push_back(new Model());
-		_Models[i]->Load(temp);
+	if (Normal.z < 0.0f) {
+		float foldedU = (1.0f - fabsf(v)) * ((u >= 0.0f) ? 1.0f : -1.0f);
+		float foldedV = (1.0f - fabsf(u)) * ((v >= 0.0f) ? 1.0f : -1.0f);
+		u = foldedU;
+		v = foldedV;
 	}
+
+	unsigned int qu = (unsigned int)((u * 0.5f + 0.5f) * 255.0f + 0.5f);
+	unsigned int qv = (unsigned int)((v * 0.5f + 0.5f) * 255.0f + 0.5f);
+
+	Packed[0] = qx | (qy << 16);
+	Packed[1] = qz | (qu << 16) | (qv << 24);
 }
 
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 void Animation::Unload()
 {
-	for (auto mp : _Models) {
-		delete mp;
-		mp = nullptr;
-	}
+	if (_FrameView) { _FrameView->Release(); _FrameView = nullptr; }
+	if (_Frames) { _Frames->Release(); _Frames = nullptr; }
+
+	delete _Mesh;
+	_Mesh = nullptr;
+
+	_VertexCount = 0;
+	_NumFrames = 0;
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+void Animation::Render(RenderContext& Context, float Time) const
+{
+	if (!_Mesh || !_FrameView) { return; }
+
+	//Work out which two frames the time sits between, and how far it is from the first to the second
+	float frame = fmodf(Time * _FrameRate, (float)_NumFrames);
+	if (frame < 0.0f) { frame += (float)_NumFrames; }
+
+	MorphBufferData data;
+	data.vertexCount = _VertexCount;
+	data.frameA = (std::min)((unsigned int)frame, (unsigned int)_NumFrames - 1);
+	data.frameB = (data.frameA + 1) % _NumFrames;
+	data.blend = frame - (float)data.frameA;
+	data.boundsMin = XMFLOAT4(_BoundsMin.x, _BoundsMin.y, _BoundsMin.z, 0.0f);
+	data.boundsSize = XMFLOAT4(_BoundsSize.x, _BoundsSize.y, _BoundsSize.z, 0.0f);
+
+	Context.UploadVertexConstants(1, &data, sizeof(data));
+	Context.SetVertexShaderResource(0, _FrameView);
+
+	_Mesh->Render(Context, sizeof(BufferConstants::PackedVertex), 0);
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+float Animation::GetDuration() const
+{
+	return (_FrameRate > 0.0f) ? (float)_NumFrames / _FrameRate : 0.0f;
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+int Animation::GetNumFrames() const
+{
+	return _NumFrames;
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+unsigned int Animation::GetVertexCount() const
+{
+	return _VertexCount;
 }
@@ -1,26 +1,128 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//  Animation.h, Animation.cpp
+//
+//  Created By:     Chris Hargove
+//  Last Updated:   19/10/2026
+//
+//  This class holds one animation made from a run of OBJ files, one per frame
+//  (FileName_0.obj ... FileName_N.obj), and plays it back on the GPU.
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 #pragma once
-#include "Model.h"
 
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Headers
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+#include <d3d11.h>
+#include <xnamath.h>
+#include <string>
 #include <vector>
 
+#include "Buffer.h"
+
+class RenderContext;
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//  This class holds one animation made from a run of OBJ files, one per frame
+//  (FileName_0.obj ... FileName_N.obj), and plays it back on the GPU.
+//
+//  Every frame shares one vertex and index buffer, holding the texture coordinates. Only
+//  the positions and normals change from frame to frame, and those are packed in to a
+//  single buffer the vertex shader reads from - 8 bytes per vertex per frame, positions
+//  as 16 bits per axis inside the animation's bounds and normals octahedral encoded.
+//  The shader blends the two frames either side of the time it's given, so playback is
+//  smooth at any frame rate, and every object playing the animation draws the same mesh.
+//
+//  Corners are only merged in to one vertex when they're the same in every frame.
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 class Animation
 {
 public:
-	Animation(int NumFrames, char* FileName, ID3D11Device* Device);
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    //  Default Constructor
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+	Animation();
+
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    //  Default Destructor
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 	~Animation();
 
-	Model* GetCurrentFrame();
-	void Update(float deltaTime);
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    //  Loads every frame of the animation and sends it to the GPU.
+    //  --FileName-- The path of the frames, without the "_N.obj" on the end.
+    //  --NumFrames-- The number of frames to load.
+    //  --FrameRate-- How many frames play each second.
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+	bool Load(const std::string& FileName, int NumFrames, float FrameRate = 10.0f);
 
-	void Load(char* FileName, ID3D11Device* Device);
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    //  Releases the animation's GPU buffers.
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 	void Unload();
 
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    //  Draws the animation as it is at the time given. The morph shader must be bound.
+    //  --Context-- The render context to draw with.
+    //  --Time-- Seconds since the animation started, it loops once it reaches the end.
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+	void Render(RenderContext& Context, float Time) const;
+
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    //  Gets how long the animation takes to play once, in seconds.
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+	float GetDuration() const;
+
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    //  Gets the number of frames in the animation.
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+	int GetNumFrames() const;
+
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    //  Gets the number of vertices in each frame, after merging.
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+	unsigned int GetVertexCount() const;
+
 private:
-	std::vector<Model*> _Models;
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    //  The constants the morph shader reads, in register b1.
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    struct MorphBufferData
+    {
+        unsigned int    vertexCount;
+        unsigned int    frameA;
+        unsigned int    frameB;
+        float           blend;
+        XMFLOAT4        boundsMin;
+        XMFLOAT4        boundsSize;
+    };
 
-	float _DeltaTime;
-	int _NumFrames;
-	int _CurrentFrame;
-	
-};
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    //  Merges the corners of every frame in to shared vertices, and packs each frame.
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    bool Build(const std::vector<std::vector<BufferConstants::PackedVertex>>& Frames);
+
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    //  Packs one position and normal in to the two words the shader reads.
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    void Encode(const XMFLOAT3& Position, const XMFLOAT3& Normal, unsigned int* Packed) const;
+
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    //  Animations own GPU buffers, so copying one would release them twice.
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    Animation(const Animation&);
+    Animation& operator=(const Animation&);
 
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    //  Member Variables.
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+	Buffer*                     _Mesh;          // Shared vertices (texture coordinates) and indices
+	ID3D11Buffer*               _Frames;        // Every frame's packed positions and normals, one frame after another
+	ID3D11ShaderResourceView*   _FrameView;     // How the vertex shader reads the frames
+
+	XMFLOAT3                    _BoundsMin;     // The corner of the box holding every frame
+	XMFLOAT3                    _BoundsSize;    // The size of the box holding every frame
+
+	unsigned int                _VertexCount;
+	int                         _NumFrames;
+	float                       _FrameRate;
+};
@@ -0,0 +1,225 @@
+#include <cmath>
+
+#include "AnimationLibrary.h"
+#include "Animation.h"
+#include "Log.h"
+
+/*******************************************************************************************************************
+	Constructor with initializer list to set all default values of variables
+*******************************************************************************************************************/
+AnimationLibrary::AnimationLibrary()
+{
+	DX_LOG("[ANIMATIONS] Animation library constructor initialized", DX_LOG_EMPTY, LOG_MESSAGE);
+}
+
+
+/*******************************************************************************************************************
+	Function that deletes every clip still loaded - must be called before the graphics device is shut down
+*******************************************************************************************************************/
+void AnimationLibrary::Shutdown()
+{
+	for (unsigned int i = 0; i < m_clips.size(); i++) { delete m_clips[i]; }
+
+	m_clips.clear();
+	m_references.clear();
+	m_durations.clear();
+	m_names.clear();
+	m_freeClips.clear();
+	m_ids.clear();
+
+	m_playbacks.clear();
+	m_freePlayheads.clear();
+
+	DX_LOG("[ANIMATIONS] Animation library shutdown successfully", DX_LOG_EMPTY, LOG_SUCCESS);
+}
+
+
+/*******************************************************************************************************************
+	Function that loads a clip, or hands back the one already loaded from this file with another reference
+*******************************************************************************************************************/
+ClipId AnimationLibrary::Load(const std::string& fileName, int numFrames, float frameRate)
+{
+	std::map<std::string, ClipId>::iterator it = m_ids.find(fileName);
+
+	if (it != m_ids.end()) {
+		m_references[it->second]++;
+		return it->second;
+	}
+
+	Animation* animation = new Animation();
+
+	if (!animation->Load(fileName, numFrames, frameRate)) {
+		DX_LOG("[ANIMATIONS] Couldn't load animation clip: ", fileName.c_str(), LOG_ERROR);
+		delete animation;
+		return INVALID_CLIP;
+	}
+
+	ClipId clip = m_clips.size();
+
+	//-------------------------------------------- Reuse a released slot if there is one, otherwise take the next one on the end
+	if (!m_freeClips.empty()) {
+		clip = m_freeClips.back();
+		m_freeClips.pop_back();
+	}
+	else {
+		m_clips.push_back(nullptr);
+		m_references.push_back(0);
+		m_durations.push_back(0.0f);
+		m_names.push_back(std::string());
+	}
+
+	m_clips[clip]		= animation;
+	m_references[clip]	= 1;
+	m_durations[clip]	= animation->GetDuration();
+	m_names[clip]		= fileName;
+	m_ids[fileName]		= clip;
+
+	return clip;
+}
+
+
+/*******************************************************************************************************************
+	Function that adds a reference to a clip, so it stays loaded until that reference is released too
+*******************************************************************************************************************/
+void AnimationLibrary::AddReference(ClipId clip)
+{
+	if (clip >= m_clips.size() || !m_clips[clip]) { return; }
+
+	m_references[clip]++;
+}
+
+
+/*******************************************************************************************************************
+	Function that releases a reference to a clip, deleting the clip once nothing refers to it
+*******************************************************************************************************************/
+void AnimationLibrary::Release(ClipId clip)
+{
+	if (clip >= m_clips.size() || !m_clips[clip]) { return; }
+
+	if (--m_references[clip] > 0) { return; }
+
+	delete m_clips[clip];
+	m_clips[clip] = nullptr;
+
+	m_ids.erase(m_names[clip]);
+	m_names[clip].clear();
+	m_durations[clip] = 0.0f;
+
+	m_freeClips.push_back(clip);
+}
+
+
+/*******************************************************************************************************************
+	Function that creates a playhead at the start of the clip given, playing at normal speed
+*******************************************************************************************************************/
+Playhead AnimationLibrary::CreatePlayhead(ClipId clip)
+{
+	Playhead playhead = m_playbacks.size();
+
+	if (!m_freePlayheads.empty()) {
+		playhead = m_freePlayheads.back();
+		m_freePlayheads.pop_back();
+	}
+	else {
+		m_playbacks.push_back(Playback());
+	}
+
+	m_playbacks[playhead].clip	= INVALID_CLIP;
+	m_playbacks[playhead].time	= 0.0f;
+	m_playbacks[playhead].speed	= 1.0f;
+
+	Play(playhead, clip);
+
+	return playhead;
+}
+
+
+/*******************************************************************************************************************
+	Function that stops a playhead, releasing its clip, and hands its slot back to be reused
+*******************************************************************************************************************/
+void AnimationLibrary::ReleasePlayhead(Playhead playhead)
+{
+	if (playhead >= m_playbacks.size()) { return; }
+
+	Play(playhead, INVALID_CLIP);
+
+	m_freePlayheads.push_back(playhead);
+}
+
+
+/*******************************************************************************************************************
+	Function that starts a playhead from the beginning of a clip - the playhead holds a reference to what it plays
+*******************************************************************************************************************/
+void AnimationLibrary::Play(Playhead playhead, ClipId clip)
+{
+	if (playhead >= m_playbacks.size()) { return; }
+
+	Playback& playback = m_playbacks[playhead];
+
+	//-------------------------------------------- Reference the new clip first, so replaying the same clip can't delete it in between
+	if (clip < m_clips.size() && m_clips[clip])	{ AddReference(clip); }
+	else										{ clip = INVALID_CLIP; }
+
+	Release(playback.clip);
+
+	playback.clip = clip;
+	playback.time = 0.0f;
+}
+
+
+/*******************************************************************************************************************
+	Function that moves every playhead on by the time given, looping each one inside its clip
+*******************************************************************************************************************/
+void AnimationLibrary::Update(float deltaTime)
+{
+	const unsigned int count = m_playbacks.size();
+
+	for (unsigned int i = 0; i < count; i++) {
+		Playback& playback = m_playbacks[i];
+
+		if (playback.clip == INVALID_CLIP) { continue; }
+
+		playback.time += deltaTime * playback.speed;
+
+		//-------------------------------------------- Keep the time inside one loop, so it never grows big enough to lose precision - playing backwards loops too
+		float duration = m_durations[playback.clip];
+
+		if (playback.time >= duration || playback.time < 0.0f) {
+			playback.time = fmodf(playback.time, duration);
+			if (playback.time < 0.0f) { playback.time += duration; }
+		}
+	}
+}
+
+
+/*******************************************************************************************************************
+	Function that finds the clip loaded from a file, or INVALID_CLIP if it isn't loaded
+*******************************************************************************************************************/
+ClipId AnimationLibrary::GetClip(const std::string& fileName) const
+{
+	std::map<std::string, ClipId>::const_iterator it = m_ids.find(fileName);
+
+	return (it != m_ids.end()) ? it->second : INVALID_CLIP;
+}
+
+
+/*******************************************************************************************************************
+	Modifier Methods
+*******************************************************************************************************************/
+void AnimationLibrary::SetSpeed(Playhead playhead, float speed)
+{
+	if (playhead >= m_playbacks.size()) { return; }
+
+	m_playbacks[playhead].speed = speed;
+}
+
+
+/*******************************************************************************************************************
+	Accessor Methods
+*******************************************************************************************************************/
+const Animation* AnimationLibrary::GetAnimation(ClipId clip) const	{ return (clip < m_clips.size()) ? m_clips[clip] : nullptr; }
+ClipId AnimationLibrary::GetPlayingClip(Playhead playhead) const	{ return (playhead < m_playbacks.size()) ? m_playbacks[playhead].clip : INVALID_CLIP; }
+float AnimationLibrary::GetTime(Playhead playhead) const			{ return (playhead < m_playbacks.size()) ? m_playbacks[playhead].time : 0.0f; }
+float AnimationLibrary::GetSpeed(Playhead playhead) const			{ return (playhead < m_playbacks.size()) ? m_playbacks[playhead].speed : 0.0f; }
+unsigned int AnimationLibrary::GetClipCount() const					{ return m_ids.size(); }
+unsigned int AnimationLibrary::GetPlayheadCount() const				{ return m_playbacks.size() - m_freePlayheads.size(); }
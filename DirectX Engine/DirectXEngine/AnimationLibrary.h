@@ -0,0 +1,97 @@
+#pragma once
+
+/*******************************************************************************************************************
+	AnimationLibrary.h, AnimationLibrary.cpp
+	Created by Kim Kane
+	Last updated: 19/10/2026
+
+	Singleton class that owns every loaded animation clip, and the playback of every animated object.
+
+	A clip is loaded once, however many objects play it, and is never changed after loading. Loading the same
+	file again hands back the same clip ID - the file name is only looked up when loading, everything after
+	that uses the ID. Each clip counts its references (whoever loaded it, plus every playhead playing it) and is
+	deleted when the last one is released.
+
+	A playhead is all an object needs to play a clip: which clip, how far through it is and how fast it plays.
+	Playheads are kept together in one array, so Update() moves every one of them on in a single pass.
+
+	Nothing here is drawn straight from the library - the render thread may be drawing an older frame while the
+	game updates this one, so an object copies its clip and time in to the render queue when it's submitted
+	(see AnimatedGameObject). A clip a frame in flight draws must stay loaded until that frame is done, so as
+	with any mesh or texture, the last reference to a clip is released only after the frame pipeline is flushed.
+
+*******************************************************************************************************************/
+#include <map>
+#include <string>
+#include <vector>
+
+#include "Singleton.h"
+
+class Animation;
+
+typedef unsigned int ClipId;
+typedef unsigned int Playhead;
+
+const ClipId INVALID_CLIP = 0xFFFFFFFF;
+const Playhead INVALID_PLAYHEAD = 0xFFFFFFFF;
+
+class AnimationLibrary {
+
+public:
+	friend class Singleton<AnimationLibrary>;
+
+public:
+	void Shutdown();
+
+public:
+	ClipId Load(const std::string& fileName, int numFrames, float frameRate = 10.0f);
+	void AddReference(ClipId clip);
+	void Release(ClipId clip);
+
+public:
+	Playhead CreatePlayhead(ClipId clip = INVALID_CLIP);
+	void ReleasePlayhead(Playhead playhead);
+	void Play(Playhead playhead, ClipId clip);
+	void SetSpeed(Playhead playhead, float speed);
+
+public:
+	void Update(float deltaTime);
+
+public:
+	ClipId GetClip(const std::string& fileName) const;
+	const Animation* GetAnimation(ClipId clip) const;
+	ClipId GetPlayingClip(Playhead playhead) const;
+	float GetTime(Playhead playhead) const;
+	float GetSpeed(Playhead playhead) const;
+	unsigned int GetClipCount() const;
+	unsigned int GetPlayheadCount() const;
+
+private:
+	//-------------------------------------------- One object's playback - clip is INVALID_CLIP when it's playing nothing
+	struct Playback
+	{
+		ClipId	clip;
+		float	time;
+		float	speed;
+	};
+
+private:
+	AnimationLibrary();
+	AnimationLibrary(const AnimationLibrary&);
+	AnimationLibrary& operator=(const AnimationLibrary&);
+
+private:
+	//-------------------------------------------- Indexed by clip ID - a released clip has no animation and no references
+	std::vector<Animation*>			m_clips;
+	std::vector<unsigned int>		m_references;
+	std::vector<float>				m_durations;
+	std::vector<std::string>		m_names;
+	std::vector<ClipId>				m_freeClips;
+
+	std::map<std::string, ClipId>	m_ids;
+
+	std::vector<Playback>			m_playbacks;
+	std::vector<Playhead>			m_freePlayheads;
+};
+
+typedef Singleton<AnimationLibrary> Animations;
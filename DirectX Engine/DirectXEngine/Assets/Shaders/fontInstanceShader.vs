@@ -0,0 +1,45 @@
+/*******************************************************************************************************************
+	Data for a single letter - every vertex of the letter's quad reads the same instance
+*******************************************************************************************************************/
+struct InstanceInput
+{
+    float2 position : POSITION;
+    float2 size		: TEXCOORD1;
+    float4 texRect	: TEXCOORD0;
+    float4 color	: COLOR0;
+    uint vertexID	: SV_VertexID;
+};
+
+
+/*******************************************************************************************************************
+	Data to be sent to the pixel shader
+*******************************************************************************************************************/
+struct PixelOutput
+{
+    float4 position : SV_POSITION;
+    float2 tex		: TEXCOORD0;
+    float4 color	: COLOR0;
+};
+
+
+/*******************************************************************************************************************
+	Main Function
+*******************************************************************************************************************/
+PixelOutput VertexMain(InstanceInput instanceInput)
+{
+    PixelOutput pixelOutput;
+
+	//-------------------------------------------- Work out which corner of the quad this is - drawn as a strip of 4: bottom left, top left, bottom right, top right
+	float2 corner = float2(instanceInput.vertexID >> 1, instanceInput.vertexID & 1);
+
+	//-------------------------------------------- Stretch the letter out from its bottom left corner
+    pixelOutput.position = float4(instanceInput.position + (corner * instanceInput.size), 1.0f, 1.0f);
+
+	//-------------------------------------------- The letter's rectangle of the font atlas - top left is stored first, so flip y to match the quad
+	pixelOutput.tex = lerp(instanceInput.texRect.xy, instanceInput.texRect.zw, float2(corner.x, 1.0f - corner.y));
+
+	pixelOutput.color = instanceInput.color;
+
+	//-------------------------------------------- Send the data to the pixel shader
+    return pixelOutput;
+}
\ No newline at end of file
@@ -4,8 +4,9 @@
 *******************************************************************************************************************/
 struct VertexInput
 {
-    float4 position : POSITION;
+    float2 position : POSITION;
     float2 tex		: TEXCOORD0;
+    float4 color	: COLOR0;
 };
 
 
@@ -16,6 +17,7 @@ struct PixelOutput
 {
     float4 position : SV_POSITION;
     float2 tex		: TEXCOORD0;
+    float4 color	: COLOR0;
 };
 
 
@@ -26,11 +28,14 @@ PixelOutput VertexMain(VertexInput vertexInput)
 {
     PixelOutput pixelOutput;
 
-	//-------------------------------------------- Change the position vector to be 4 units for proper matrix calculations
-    pixelOutput.position = vertexInput.position;
+	//-------------------------------------------- Positions arrive packed as 2D screen coordinates, so put the depth and w back
+    pixelOutput.position = float4(vertexInput.position, 1.0f, 1.0f);
     
 	//-------------------------------------------- Store the texture coordinates for the pixel shader to use
 	pixelOutput.tex = vertexInput.tex;
+
+	//-------------------------------------------- Each letter carries its own color, so a whole frame of text can be drawn at once
+	pixelOutput.color = vertexInput.color;
     
 	//-------------------------------------------- Send the data to the pixel shader
     return pixelOutput;
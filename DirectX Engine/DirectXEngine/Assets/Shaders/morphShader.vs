@@ -0,0 +1,96 @@
+/*******************************************************************************************************************
+	Constant buffer data coming in from the CPU
+*******************************************************************************************************************/
+cbuffer MatrixBuffer : register(b0)
+{
+	matrix worldMatrix;
+	matrix viewMatrix;
+	matrix projectionMatrix;
+};
+
+cbuffer MorphBuffer : register(b1)
+{
+	uint vertexCount;
+	uint frameA;
+	uint frameB;
+	float blend;
+	float4 boundsMin;
+	float4 boundsSize;
+};
+
+
+/*******************************************************************************************************************
+	Every frame of the animation, one after another - each vertex is 16 bit x, y, z and an 8 bit octahedral normal
+*******************************************************************************************************************/
+Buffer<uint2> frames : register(t0);
+
+
+/*******************************************************************************************************************
+	Vertex data coming in from the shared animation mesh - positions come from the frames instead
+*******************************************************************************************************************/
+struct VertexInput
+{
+	float2 textureCoord 	: TEXCOORD0;
+	uint vertexID			: SV_VertexID;
+};
+
+
+/*******************************************************************************************************************
+	Data to be sent to the pixel shader
+*******************************************************************************************************************/
+struct PixelOutput
+{
+    float4 position 		: SV_POSITION;
+	float2 textureCoord 	: TEXCOORD0;
+	float3 normal			: TEXCOORD1;
+};
+
+
+/*******************************************************************************************************************
+	Functions that unpack a vertex from a frame
+*******************************************************************************************************************/
+float3 DecodePosition(uint2 packed)
+{
+	float3 position = float3(packed.x & 0xFFFF, packed.x >> 16, packed.y & 0xFFFF) / 65535.0f;
+	return boundsMin.xyz + position * boundsSize.xyz;
+}
+
+
+float3 DecodeNormal(uint2 packed)
+{
+	//-------------------------------------------- Unflatten the octahedron, then unfold the lower half back under the upper half
+	float2 folded = float2((packed.y >> 16) & 0xFF, packed.y >> 24) / 255.0f * 2.0f - 1.0f;
+	float3 normal = float3(folded, 1.0f - abs(folded.x) - abs(folded.y));
+	float fold = saturate(-normal.z);
+	normal.xy += (normal.xy >= 0.0f) ? -fold : fold;
+
+	return normalize(normal);
+}
+
+
+/*******************************************************************************************************************
+	Main Function
+*******************************************************************************************************************/
+PixelOutput VertexMain(VertexInput vertexInput)
+{
+    PixelOutput pixelOutput;
+
+	//-------------------------------------------- Blend this vertex between the two frames either side of the current time
+	uint2 packedA = frames.Load(frameA * vertexCount + vertexInput.vertexID);
+	uint2 packedB = frames.Load(frameB * vertexCount + vertexInput.vertexID);
+
+	float4 position = float4(lerp(DecodePosition(packedA), DecodePosition(packedB), blend), 1.0f);
+	float3 normal = normalize(lerp(DecodeNormal(packedA), DecodeNormal(packedB), blend));
+
+	//--------------------------------------------  Calculate the position of the vertex against the world, view, and projection matrices
+    pixelOutput.position = mul(position, worldMatrix);
+    pixelOutput.position = mul(pixelOutput.position, viewMatrix);
+    pixelOutput.position = mul(pixelOutput.position, projectionMatrix);
+
+	//--------------------------------------------  Store the input texture and the normal in world space for the pixel shader to use
+    pixelOutput.textureCoord = vertexInput.textureCoord;
+	pixelOutput.normal = normalize(mul(normal, (float3x3)worldMatrix));
+
+	//-------------------------------------------- Send the data to the pixel shader
+    return pixelOutput;
+}
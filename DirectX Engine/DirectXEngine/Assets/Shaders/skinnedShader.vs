@@ -0,0 +1,68 @@
+/*******************************************************************************************************************
+	Constant buffer data coming in from the CPU
+*******************************************************************************************************************/
+cbuffer MatrixBuffer : register(b0)
+{
+	matrix worldMatrix;
+	matrix viewMatrix;
+	matrix projectionMatrix;
+};
+
+cbuffer BonePalette : register(b1)
+{
+	row_major matrix bones[64];
+};
+
+
+/*******************************************************************************************************************
+	Vertex data coming in from the skinned models - up to four joints per vertex, weights adding up to 1
+*******************************************************************************************************************/
+struct VertexInput
+{
+    float4 position 		: POSITION;
+	float2 textureCoord 	: TEXCOORD0;
+	float3 normal			: NORMAL;
+	uint4 joints			: BLENDINDICES;
+	float4 weights			: BLENDWEIGHT;
+};
+
+
+/*******************************************************************************************************************
+	Data to be sent to the pixel shader
+*******************************************************************************************************************/
+struct PixelOutput
+{
+    float4 position 		: SV_POSITION;
+	float2 textureCoord 	: TEXCOORD0;
+	float3 normal			: TEXCOORD1;
+};
+
+
+/*******************************************************************************************************************
+	Main Function
+*******************************************************************************************************************/
+PixelOutput VertexMain(VertexInput vertexInput)
+{
+    PixelOutput pixelOutput;
+
+	//-------------------------------------------- Blend the joints' matrices first, so the vertex is only transformed once
+	float4x4 skin	= bones[vertexInput.joints.x] * vertexInput.weights.x;
+	skin			+= bones[vertexInput.joints.y] * vertexInput.weights.y;
+	skin			+= bones[vertexInput.joints.z] * vertexInput.weights.z;
+	skin			+= bones[vertexInput.joints.w] * vertexInput.weights.w;
+
+	float4 position = mul(float4(vertexInput.position.xyz, 1.0f), skin);
+	float3 normal = mul(vertexInput.normal, (float3x3)skin);
+
+	//--------------------------------------------  Calculate the position of the vertex against the world, view, and projection matrices
+    pixelOutput.position = mul(position, worldMatrix);
+    pixelOutput.position = mul(pixelOutput.position, viewMatrix);
+    pixelOutput.position = mul(pixelOutput.position, projectionMatrix);
+
+	//--------------------------------------------  Store the input texture and the normal in world space for the pixel shader to use
+    pixelOutput.textureCoord = vertexInput.textureCoord;
+	pixelOutput.normal = normalize(mul(normal, (float3x3)worldMatrix));
+
+	//-------------------------------------------- Send the data to the pixel shader
+    return pixelOutput;
+}
@@ -1,21 +1,20 @@
-#include <d3dcompiler.h>
-#include <fstream>
-
 #include "BasicShader.h"
 #include "GraphicsManager.h"
 #include "ScreenManager.h"
+#include "ShaderManager.h"
 #include "Camera.h"
-#include "Buffer.h"
 #include "Log.h"
+#include "Profiler.h"
 #include "Texture.h"
+#include "RenderQueue.h"
+#include "RenderContext.h"
 
 /*******************************************************************************************************************
 	Constructor with initializer list to set all default values of variables
 *******************************************************************************************************************/
 BasicShader::BasicShader()	:	m_vertexShader(nullptr),
 								m_pixelShader(nullptr),
-								m_layout(nullptr),
-								m_matrixBuffer(nullptr)
+								m_layout(nullptr)
 {
 
 }
@@ -26,10 +25,7 @@ BasicShader::BasicShader()	:	m_vertexShader(nullptr),
 *******************************************************************************************************************/
 BasicShader::~BasicShader()
 {
-	if (m_matrixBuffer)		{ m_matrixBuffer->Release(); m_matrixBuffer = nullptr; }
-	if (m_layout)			{ m_layout->Release(); m_layout = nullptr; }
-	if (m_pixelShader)		{ m_pixelShader->Release(); m_pixelShader = nullptr; }
-	if (m_vertexShader)		{ m_vertexShader->Release(); m_vertexShader = nullptr; }
+	//-------------------------------------------- The shaders and layout belong to the shader manager, and the constant buffers to the render contexts
 }
 
 
@@ -38,53 +34,12 @@ BasicShader::~BasicShader()
 *******************************************************************************************************************/
 bool BasicShader::LoadShader(const std::wstring& vertexFileLocation, const std::wstring& pixelFileLocation)
 {
-	HRESULT result = S_OK;
-
-	std::wstring vertexFile = L"Assets\\Shaders\\" + vertexFileLocation;
-	std::wstring pixelFile	= L"Assets\\Shaders\\" + pixelFileLocation;
-
-	ID3D10Blob* errorMessage		= nullptr;
-	ID3D10Blob* vertexShaderBuffer	= nullptr;
-
-	//-------------------------------------------- Compile the vertex shader code
-	result = D3DCompileFromFile(vertexFile.c_str(), nullptr, nullptr, "VertexMain", "vs_4_0",
-		D3D10_SHADER_ENABLE_STRICTNESS, 0, &vertexShaderBuffer, &errorMessage);
+	//-------------------------------------------- Get the compiled shaders from the shader manager - only compiled the first time they are requested
+	m_vertexShader	= Shaders::Instance()->GetVertexShader(vertexFileLocation);
+	m_pixelShader	= Shaders::Instance()->GetPixelShader(pixelFileLocation);
 
-	if (FAILED(result))
-	{	
-		//-------------------------------------------- If the shader failed to compile it should have writen something to the error message
-		if (errorMessage) { OutputShaderErrorMessage(errorMessage, vertexFile.c_str()); }
-		
-		//-------------------------------------------- If there was  nothing in the error message then it simply could not find the shader file itself
-		else { MessageBox(Screen::Instance()->GetWindow(), (LPCSTR)vertexFile.c_str(), "Missing Shader File", MB_OK); }
-
-		return false;
-	}
-
-	ID3D10Blob* pixelShaderBuffer = nullptr;
-
-	//-------------------------------------------- Compile the pixel shader code
-	result = D3DCompileFromFile((LPCWSTR)pixelFile.c_str(), nullptr, nullptr, "PixelMain", "ps_4_0",
-		D3D10_SHADER_ENABLE_STRICTNESS, 0, &pixelShaderBuffer, &errorMessage);
-
-	if (FAILED(result))
-	{
-		if (errorMessage) { OutputShaderErrorMessage(errorMessage, pixelFile.c_str()); }
-		else { MessageBox(Screen::Instance()->GetWindow(), (LPCSTR)pixelFile.c_str(), "Missing Shader File", MB_OK); }
-
-		return false;
-	}
-
-	//-------------------------------------------- Create the vertex shader from the buffer
-	result = Graphics::Instance()->GetDevice()->CreateVertexShader(vertexShaderBuffer->GetBufferPointer(), vertexShaderBuffer->GetBufferSize(), nullptr, &m_vertexShader);
-	if (FAILED(result)) { 
-		DX_LOG("[BASIC SHADER] Can't create vertex shader", DX_LOG_EMPTY, LOG_ERROR); return false; 
-	}
-
-	//-------------------------------------------- Create the pixel shader from the buffer
-	result = Graphics::Instance()->GetDevice()->CreatePixelShader(pixelShaderBuffer->GetBufferPointer(), pixelShaderBuffer->GetBufferSize(), NULL, &m_pixelShader);
-	if (FAILED(result)) { 
-		DX_LOG("[BASIC SHADER] Can't create pixel shader", DX_LOG_EMPTY, LOG_ERROR); return false; 
+	if (!m_vertexShader || !m_pixelShader) {
+		DX_LOG("[BASIC SHADER] Can't load shader files", DX_LOG_EMPTY, LOG_ERROR); return false;
 	}
 
 	//-------------------------------------------- Create the layout description
@@ -93,63 +48,23 @@ bool BasicShader::LoadShader(const std::wstring& vertexFileLocation, const std::
 		{ "TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
 	};
 
-	//-------------------------------------------- Create vertex input layout
-	result = Graphics::Instance()->GetDevice()->CreateInputLayout(layout, _countof(layout), vertexShaderBuffer->GetBufferPointer(),
-		vertexShaderBuffer->GetBufferSize(), &m_layout);
-	if (FAILED(result)) { 
+	//-------------------------------------------- Get the vertex input layout
+	m_layout = Shaders::Instance()->GetInputLayout(m_vertexShader, layout, _countof(layout));
+	if (!m_layout) { 
 		DX_LOG("[BASIC SHADER] Can't create the input layout", DX_LOG_EMPTY, LOG_ERROR); return false;
 	}
-
-	//-------------------------------------------- Release the vertex shader buffer and pixel shader buffer since they are no longer needed
-	vertexShaderBuffer->Release();
-	vertexShaderBuffer = nullptr;
-
-	pixelShaderBuffer->Release();
-	pixelShaderBuffer = nullptr;
 	
 	//-------------------------------------------- Generate the default sampler filter settings for the textures used within this shader
 	if (!Texture::GenerateSamplerFilters()) { return false; }
 
-	//-------------------------------------------- Create the constant buffer within the shader, so we can access the data from the CPU
-	if (!Buffer::CreateConstantBuffer(&m_matrixBuffer, sizeof(MatrixBufferData))) { return false; }
-
 	return true;
 }
 
 
-/*******************************************************************************************************************
-	Function that outputs any shader errors generated to a file
-*******************************************************************************************************************/
-void BasicShader::OutputShaderErrorMessage(ID3D10Blob* errorMessage, const WCHAR* fileLocation)
-{
-	std::ofstream file;
-
-	//-------------------------------------------- Get a pointer to the error message text buffer
-	char* compileErrors = (char*)(errorMessage->GetBufferPointer());
-	
-	//-------------------------------------------- Get the length of the message
-	unsigned long bufferSize = errorMessage->GetBufferSize();
-	
-	//-------------------------------------------- Open a file to write the error message to
-	file.open("ShaderErrors.txt");
-
-	//-------------------------------------------- Write out the error message
-	for (unsigned long i = 0; i < bufferSize; i++) { file << compileErrors[i]; }
-
-	//-------------------------------------------- Close file and release error message pointer
-	file.close();
-	errorMessage->Release();
-	errorMessage = nullptr;
-
-	//-------------------------------------------- Pop a message up on the screen to notify the user to check the text file for compile errors
-	MessageBox(Screen::Instance()->GetWindow(), "Error compiling shader.  Check ShaderErrors.txt for message.", (LPCSTR)fileLocation, MB_OK);
-}
-
-
 /*******************************************************************************************************************
 	Function that updates all of the constant buffers within the shader
 *******************************************************************************************************************/
-bool BasicShader::UpdateConstantBuffers(XMMATRIX& world, Camera* camera)
+bool BasicShader::UpdateConstantBuffers(RenderContext& context, XMMATRIX& world, Camera* camera)
 {
 	//-------------------------------------------- Check a shader exists first before trying to update it
 	if (m_vertexShader == nullptr || m_pixelShader == nullptr) { 
@@ -160,64 +75,90 @@ bool BasicShader::UpdateConstantBuffers(XMMATRIX& world, Camera* camera)
 	//-------------------------------------------- Get the model transform matrix, camera view matrix, and screen projection matrix
 	XMMATRIX worldMatrix		= world;
 	XMMATRIX viewMatrix			= camera->GetViewMatrix();
-	XMMATRIX projectionMatrix	= (Screen::Instance()->Is3dEnabled())	? Screen::Instance()->GetPerspectiveMatrix()
-																		: Screen::Instance()->GetOrthographicMatrix();
+	ScreenManager* screen		= Screen::Instance();
+	XMMATRIX projectionMatrix	= (screen->Is3dEnabled())	? screen->GetPerspectiveMatrix()
+															: screen->GetOrthographicMatrix();
+
 	//-------------------------------------------- Transpose these matrices to prepare them for the shader
-	worldMatrix			= XMMatrixTranspose(worldMatrix);
-	viewMatrix			= XMMatrixTranspose(viewMatrix);
-	projectionMatrix	= XMMatrixTranspose(projectionMatrix);
-	
-	//-------------------------------------------- Create a subresource here so we can access the data later, and lock the constant buffer so we can write to it
-	D3D11_MAPPED_SUBRESOURCE mappedResource = { 0 };
-	if (!Buffer::LockConstantBuffer(m_matrixBuffer, mappedResource)) { return false; }
+	MatrixBufferData data;
+	data.world			= XMMatrixTranspose(worldMatrix);
+	data.view			= XMMatrixTranspose(viewMatrix);
+	data.projection		= XMMatrixTranspose(projectionMatrix);
 
-	//-------------------------------------------- Get a pointer to the data in the constant buffer
-	MatrixBufferData* data = (MatrixBufferData*)mappedResource.pData;
+	//-------------------------------------------- Copy the matrices in to the context's constant buffer and set it in the vertex shader
+	return context.UploadVertexConstants(0, &data, sizeof(data));
+}
 
-	//-------------------------------------------- Copy the matrices above into the constant buffer
-	data->world			= worldMatrix;
-	data->view			= viewMatrix;
-	data->projection	= projectionMatrix;
-	
-	//-------------------------------------------- Unlock the constant buffer when we are finished altering the data
-	Buffer::UnlockConstantBuffer(m_matrixBuffer);
 
-	//-------------------------------------------- Finally, set the constant buffer in the vertex shader with the updated values
-	Buffer::SetVertexConstantBuffer(0, m_matrixBuffer);
+/*******************************************************************************************************************
+	Function that sets this shader and vertex layout as the active shader and layout & sets shader parameters
+*******************************************************************************************************************/
+void BasicShader::Bind(XMMATRIX& world, Camera* camera, Texture* texture, D3D_PRIMITIVE_TOPOLOGY renderMode)
+{
+	DX_PROFILE_FUNCTION();
 
-	return true;
+	RenderContext& context = Graphics::Instance()->GetImmediateContext();
+
+	BindProgram(context);
+
+	//-------------------------------------------- Set how this will be drawn - triangles/lines/points, etc.
+	context.SetPrimitiveTopology(renderMode);
+
+	UpdateConstantBuffers(context, world, camera);
+	SetTexture(context, texture);
 }
 
 
 /*******************************************************************************************************************
-	Function that sets this shader and vertex layout as the active shader and layout & sets shader parameters
+	Function that sets this shader, its vertex layout and sampler as active - used by the render queue once per shader change
 *******************************************************************************************************************/
-void BasicShader::Bind(XMMATRIX& world, Camera* camera, Texture* texture, D3D_PRIMITIVE_TOPOLOGY renderMode)
+void BasicShader::BindProgram(RenderContext& context)
 {
+	DX_PROFILE_FUNCTION();
+
 	//-------------------------------------------- Set the vertex input layout
-	Graphics::Instance()->GetDeviceContext()->IASetInputLayout(m_layout);
+	context.SetInputLayout(m_layout);
 
 	//-------------------------------------------- Set how this will be drawn - triangles/lines/points, etc.
-	Graphics::Instance()->GetDeviceContext()->IASetPrimitiveTopology(renderMode);
+	context.SetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 
 	//-------------------------------------------- Set the vertex and pixel shaders that will be used to render this object
-	Graphics::Instance()->GetDeviceContext()->VSSetShader(m_vertexShader, nullptr, 0);
-	Graphics::Instance()->GetDeviceContext()->PSSetShader(m_pixelShader, nullptr, 0);
+	context.SetVertexShader(m_vertexShader);
+	context.SetPixelShader(m_pixelShader);
+
+	context.SetSampler(0, *Texture::GetSampler());
+}
+
+
+/*******************************************************************************************************************
+	Function that sets the texture used by the following draws - used by the render queue once per texture change
+*******************************************************************************************************************/
+void BasicShader::BindTexture(RenderContext& context, Texture* texture)
+{
+	DX_PROFILE_FUNCTION();
 
-	UpdateConstantBuffers(world, camera);
+	SetTexture(context, texture);
+}
 
-	Graphics::Instance()->GetDeviceContext()->PSSetSamplers(0, 1, Texture::GetSampler());
 
-	SetTexture(texture);
+/*******************************************************************************************************************
+	Function that sets the per-object constants for a single queued draw
+*******************************************************************************************************************/
+void BasicShader::BindObject(RenderContext& context, const RenderCommand& command, Camera* camera)
+{
+	DX_PROFILE_FUNCTION();
+
+	XMMATRIX world = XMLoadFloat4x4(&command.world);
+	UpdateConstantBuffers(context, world, camera);
 }
 
 
 /*******************************************************************************************************************
 	Function that sets a texture within the shader (if texture is nullptr, default colour will be black)
 *******************************************************************************************************************/
-void BasicShader::SetTexture(Texture* texture)
+void BasicShader::SetTexture(RenderContext& context, Texture* texture)
 {
 	if (texture != nullptr) {
-		Graphics::Instance()->GetDeviceContext()->PSSetShaderResources(0, 1, texture->GetTexture());
+		context.SetShaderResource(0, *texture->GetTexture());
 	}
-}
+}
\ No newline at end of file
@@ -2,42 +2,50 @@
 /*******************************************************************************************************************
 	BasicShader.h, BasicShader.cpp
 	Created by Kim Kane
-	Last updated: 09/02/2018
+	Last updated: 19/10/2026
 
 	Loads in a basic vertex and pixel shader.
 	Attributes available: world, view, projection matrices, model position and texture
 
+	The compiled shaders and input layout are owned by the shader manager and shared between all instances.
+	Constant buffers belong to the render context the shader is bound through.
+
 *******************************************************************************************************************/
 #include <d3d11.h>
 #include <xnamath.h>
 #include <d3dx11async.h>
 #include <string>
 
+#include "ShaderProgram.h"
+
 class Texture;
 class Camera;
 
-class BasicShader {
+class BasicShader : public ShaderProgram {
 
 public:
 	BasicShader();
-	~BasicShader();
+	virtual ~BasicShader();
 
-	bool LoadShader(const std::wstring& vertexFileLocation, const std::wstring& pixelFileLocation);
+	virtual bool LoadShader(const std::wstring& vertexFileLocation, const std::wstring& pixelFileLocation);
 	void Bind(XMMATRIX& world, Camera* camera, Texture* texture, D3D_PRIMITIVE_TOPOLOGY renderMode = D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 
+public:
+	virtual void BindProgram(RenderContext& context);
+	virtual void BindTexture(RenderContext& context, Texture* texture);
+	virtual void BindObject(RenderContext& context, const RenderCommand& command, Camera* camera);
+
 private:
 	BasicShader(const BasicShader&);
 
 private:
-	void OutputShaderErrorMessage(ID3D10Blob* errorMessage, const WCHAR* fileLocation);
-	bool UpdateConstantBuffers(XMMATRIX& world, Camera* camera);
-	void SetTexture(Texture* texture);
+	bool UpdateConstantBuffers(RenderContext& context, XMMATRIX& world, Camera* camera);
+	void SetTexture(RenderContext& context, Texture* texture);
 
 private:
 	ID3D11VertexShader*		m_vertexShader;
 	ID3D11PixelShader*		m_pixelShader;
 	ID3D11InputLayout*		m_layout;
-	ID3D11Buffer*			m_matrixBuffer;
 
 private:
 	struct MatrixBufferData
@@ -0,0 +1,690 @@
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Benchmark.h"
+#include "TransformManager.h"
+#include "CollisionWorld.h"
+#include "PhysicsWorld.h"
+#include "Skeleton.h"
+#include "SkeletalClip.h"
+#include "RenderQueue.h"
+#include "RenderDevice.h"
+#include "ShaderProgram.h"
+#include "Texture.h"
+#include "Camera.h"
+#include "Clock.h"
+#include "Constants.h"
+
+namespace {
+
+	//-------------------------------------------- A shader and a renderable that bind and draw nothing, so the render queue can run without a graphics device
+	class NullShader : public ShaderProgram {
+
+	public:
+		virtual bool LoadShader(const std::wstring&, const std::wstring&) override			{ return true; }
+		virtual void BindProgram(RenderContext&) override									{}
+		virtual void BindTexture(RenderContext&, Texture*) override							{}
+		virtual void BindObject(RenderContext&, const RenderCommand&, Camera*) override		{}
+	};
+
+	class NullRenderable : public Renderable {
+
+	public:
+		virtual void Render(RenderContext&, const void*) const override {}
+	};
+
+	//-------------------------------------------- What was submitted for one draw, to work out where the queue should put it
+	struct SubmittedDraw
+	{
+		RenderLayer			layer;
+		unsigned int		shaderId;
+		unsigned int		textureId;
+		float				depth;
+		unsigned int		index;
+	};
+
+	//-------------------------------------------- A key that must sort before another
+	struct KeyOrder
+	{
+		const char*			name;
+		unsigned long long	first;
+		unsigned long long	second;
+	};
+}
+
+/*******************************************************************************************************************
+	Function that runs the benchmarks asked for (all of them if none are named) - returns the process exit code
+*******************************************************************************************************************/
+int Benchmark::Run(int argumentCount, char* arguments[])
+{
+	std::string name = (argumentCount > 0) ? arguments[0] : "";
+
+	if (!name.empty() && name != "collisions" && name != "physics" && name != "skinning" && name != "renderqueue") {
+		printf("Unknown benchmark: %s - try collisions, physics, skinning or renderqueue\n", name.c_str());
+		return 1;
+	}
+
+	bool passed = true;
+
+	if (name.empty() || name == "collisions")	{ passed = RunCollisions() && passed; }
+	if (name.empty() || name == "physics")		{ passed = RunPhysics() && passed; }
+	if (name.empty() || name == "skinning")		{ passed = RunSkinning() && passed; }
+	if (name.empty() || name == "renderqueue")	{ passed = RunRenderQueue() && passed; }
+
+	return passed ? 0 : 1;
+}
+
+
+/*******************************************************************************************************************
+	Function that times the collision world's Update() with every object moving, at each object count
+*******************************************************************************************************************/
+bool Benchmark::RunCollisions()
+{
+	const unsigned int runCount = sizeof(BenchmarkConstants::CollisionCounts) / sizeof(BenchmarkConstants::CollisionCounts[0]);
+
+	printf("[BENCHMARK] Collision world - every sphere moving, %u updates timed per run\n\n", BenchmarkConstants::CollisionFrames);
+	printf("%10s %16s %16s %16s\n", "Spheres", "ms per update", "ns per sphere", "Contacts");
+
+	for (unsigned int run = 0; run < runCount; run++) {
+
+		unsigned int count		= BenchmarkConstants::CollisionCounts[run];
+		unsigned int contacts	= 0;
+		double time				= TimeCollisions(count, contacts);
+
+		printf("%10u %16.3f %16.1f %16u\n", count, time * 1000.0, time * 1000000000.0 / count, contacts);
+	}
+
+	printf("\n");
+
+	return true;
+}
+
+
+/*******************************************************************************************************************
+	Function that times the physics world's Step() with 1 thread up to one per core, at each body count - false if
+	any thread count doesn't step exactly the same as 1 thread does
+*******************************************************************************************************************/
+bool Benchmark::RunPhysics()
+{
+	const unsigned int runCount		= sizeof(BenchmarkConstants::PhysicsCounts) / sizeof(BenchmarkConstants::PhysicsCounts[0]);
+	const unsigned int maxThreads	= (std::thread::hardware_concurrency() > 0) ? std::thread::hardware_concurrency() : 1;
+
+	printf("[BENCHMARK] Physics world - 1 to %u threads, %u steps timed per run\n\n", maxThreads, BenchmarkConstants::PhysicsSteps);
+	printf("%10s %10s %16s %10s %10s %18s\n", "Bodies", "Threads", "ms per step", "Speedup", "Islands", "Hash");
+
+	bool passed = true;
+
+	for (unsigned int run = 0; run < runCount; run++) {
+
+		unsigned int count = BenchmarkConstants::PhysicsCounts[run];
+		PhysicsResult single;
+
+		for (unsigned int threads = 1; threads <= maxThreads; threads++) {
+
+			PhysicsResult result = TimePhysics(count, threads);
+			if (threads == 1) { single = result; }
+
+			//-------------------------------------------- Islands are numbered by their lowest body and solved in the order their contacts were found, so nothing may change
+			bool matches = (result.hash == single.hash);
+			passed = passed && matches;
+
+			printf("%10u %10u %16.3f %9.2fx %10u   %016llx%s\n", count, threads, result.stepTime * 1000.0, single.stepTime / result.stepTime,
+				   result.islands, result.hash, matches ? "" : "  MISMATCH");
+		}
+
+		printf("\n");
+	}
+
+	if (!passed) { printf("[BENCHMARK] Physics results depend on the thread count - replays won't match\n\n"); }
+
+	return passed;
+}
+
+
+/*******************************************************************************************************************
+	Function that checks a random skeleton and clip against exact answers, then times skinning a mesh on the CPU -
+	false if any result is further from exact than its tolerance
+*******************************************************************************************************************/
+bool Benchmark::RunSkinning()
+{
+	const unsigned int jointCount	= BenchmarkConstants::SkinningJoints;
+	const unsigned int frameCount	= BenchmarkConstants::SkinningFrames;
+	const unsigned int vertexCount	= BenchmarkConstants::SkinningVertices;
+
+	printf("[BENCHMARK] Skinning - %u joints, %u frames, %u vertices skinned %u times per run\n\n", jointCount, frameCount, vertexCount,
+		   BenchmarkConstants::SkinningRuns);
+
+	unsigned int seed = BenchmarkConstants::Seed;
+
+	//-------------------------------------------- Each joint hangs off any joint before it, so the tree is both deep and wide
+	std::vector<int> parents(jointCount);
+	std::vector<JointPose> bindPose(jointCount);
+
+	for (unsigned int i = 0; i < jointCount; i++) {
+		parents[i]				= (i == 0) ? -1 : (int)(Random(seed) * i);
+		bindPose[i].rotation	= RandomRotation(seed);
+		bindPose[i].translation	= XMFLOAT3(Random(seed) * 2.0f - 1.0f, Random(seed) * 2.0f - 1.0f, Random(seed) * 2.0f - 1.0f);
+	}
+
+	Skeleton skeleton;
+	if (!skeleton.Create(parents, bindPose)) { printf("[BENCHMARK] Couldn't create the skeleton\n\n"); return false; }
+
+	std::vector<XMFLOAT4X4> modelPose(jointCount);
+	std::vector<XMFLOAT4X4> palette(jointCount);
+
+	//-------------------------------------------- In the bind pose nothing has moved, so every joint's palette entry must be identity
+	skeleton.LocalToModel(skeleton.GetBindPose(), &modelPose[0]);
+	skeleton.BuildPalette(&modelPose[0], &palette[0]);
+
+	float paletteError = 0.0f;
+
+	for (unsigned int i = 0; i < jointCount; i++) {
+		for (unsigned int row = 0; row < 4; row++) {
+			for (unsigned int column = 0; column < 4; column++) {
+				paletteError = (std::max)(paletteError, fabsf(palette[i].m[row][column] - ((row == column) ? 1.0f : 0.0f)));
+			}
+		}
+	}
+
+	//-------------------------------------------- A clip of random poses, sampled exactly on each frame, must give back what it was made from
+	std::vector<JointPose> keys(jointCount * frameCount);
+	XMFLOAT3 minimum(FLT_MAX, FLT_MAX, FLT_MAX);
+	XMFLOAT3 maximum(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+
+	for (unsigned int i = 0; i < keys.size(); i++) {
+		keys[i].rotation	= RandomRotation(seed);
+		keys[i].translation	= XMFLOAT3(Random(seed) * 4.0f - 2.0f, Random(seed) * 4.0f - 2.0f, Random(seed) * 4.0f - 2.0f);
+
+		minimum.x = (std::min)(minimum.x, keys[i].translation.x);	maximum.x = (std::max)(maximum.x, keys[i].translation.x);
+		minimum.y = (std::min)(minimum.y, keys[i].translation.y);	maximum.y = (std::max)(maximum.y, keys[i].translation.y);
+		minimum.z = (std::min)(minimum.z, keys[i].translation.z);	maximum.z = (std::max)(maximum.z, keys[i].translation.z);
+	}
+
+	SkeletalClip clip;
+	if (!clip.Create(jointCount, frameCount, BenchmarkConstants::SkinningFrameRate, keys)) { printf("[BENCHMARK] Couldn't create the clip\n\n"); return false; }
+
+	std::vector<JointPose> localPose(jointCount);
+	float rotationError		= 0.0f;
+	float translationError	= 0.0f;
+
+	for (unsigned int frame = 0; frame < frameCount; frame++) {
+		clip.Sample((float)frame / BenchmarkConstants::SkinningFrameRate, &localPose[0]);
+
+		for (unsigned int i = 0; i < jointCount; i++) {
+			const JointPose& key = keys[frame * jointCount + i];
+
+			//-------------------------------------------- The angle between the two rotations, from the gap between them rather than acos of their dot (which is too coarse near 1) - q and -q are the same rotation, so the nearer one counts
+			XMVECTOR sampled	= XMLoadFloat4(&localPose[i].rotation);
+			XMVECTOR original	= XMLoadFloat4(&key.rotation);
+			float gap			= (std::min)(XMVectorGetX(XMVector4Length(XMVectorSubtract(sampled, original))), XMVectorGetX(XMVector4Length(XMVectorAdd(sampled, original))));
+
+			rotationError = (std::max)(rotationError, 4.0f * asinf((std::min)(gap * 0.5f, 1.0f)));
+
+			translationError = (std::max)(translationError, fabsf(localPose[i].translation.x - key.translation.x) / (maximum.x - minimum.x));
+			translationError = (std::max)(translationError, fabsf(localPose[i].translation.y - key.translation.y) / (maximum.y - minimum.y));
+			translationError = (std::max)(translationError, fabsf(localPose[i].translation.z - key.translation.z) / (maximum.z - minimum.z));
+		}
+	}
+
+	//-------------------------------------------- Skin with a pose part way between two frames, so the palette is nothing like identity
+	clip.Sample(1.5f / BenchmarkConstants::SkinningFrameRate, &localPose[0]);
+	skeleton.LocalToModel(&localPose[0], &modelPose[0]);
+	skeleton.BuildPalette(&modelPose[0], &palette[0]);
+
+	std::vector<BufferConstants::PackedSkinnedVertex> vertices(vertexCount);
+
+	for (unsigned int i = 0; i < vertexCount; i++) {
+		BufferConstants::PackedSkinnedVertex& vertex = vertices[i];
+
+		vertex.position		= XMFLOAT3(Random(seed) * 2.0f - 1.0f, Random(seed) * 2.0f - 1.0f, Random(seed) * 2.0f - 1.0f);
+		vertex.textureCoord	= XMFLOAT2(Random(seed), Random(seed));
+		XMStoreFloat3(&vertex.normal, XMVector3Normalize(XMVectorSet(Random(seed) - 0.5f, Random(seed) - 0.5f, Random(seed) - 0.5f, 0.0f)));
+
+		//-------------------------------------------- Split 255 between the influences at random - later ones are often left with nothing, as in a real mesh
+		unsigned int left = 255;
+
+		for (unsigned int j = 0; j < SkinningConstants::MaxInfluences; j++) {
+			unsigned int weight = (j + 1 == SkinningConstants::MaxInfluences) ? left : (std::min)((unsigned int)(Random(seed) * 256.0f), left);
+
+			vertex.joints[j]	= (unsigned char)(Random(seed) * jointCount);
+			vertex.weights[j]	= (unsigned char)weight;
+			left -= weight;
+		}
+	}
+
+	//-------------------------------------------- Checking a vertex naming a joint past the end of the skeleton has to fail, or SkinVertices() would read past the palette
+	BufferConstants::PackedSkinnedVertex outside = vertices[0];
+	outside.joints[0] = (unsigned char)jointCount;
+
+	bool checked	= skeleton.CheckVertices(&vertices[0], vertexCount);
+	bool rejected	= !skeleton.CheckVertices(&outside, 1);
+
+	std::vector<XMFLOAT3> positions(vertexCount);
+	std::vector<XMFLOAT3> normals(vertexCount);
+
+	Skeleton::SkinVertices(&vertices[0], vertexCount, &palette[0], &positions[0], &normals[0]);
+
+	float positionError	= 0.0f;
+	float normalError	= 0.0f;
+
+	for (unsigned int i = 0; i < vertexCount; i++) {
+		XMFLOAT3 position;
+		XMFLOAT3 normal;
+		SkinReference(vertices[i], &palette[0], position, normal);
+
+		positionError	= (std::max)(positionError, (std::max)(fabsf(positions[i].x - position.x), (std::max)(fabsf(positions[i].y - position.y), fabsf(positions[i].z - position.z))));
+		normalError		= (std::max)(normalError, (std::max)(fabsf(normals[i].x - normal.x), (std::max)(fabsf(normals[i].y - normal.y), fabsf(normals[i].z - normal.z))));
+	}
+
+	double time = TimeSkinning(&vertices[0], vertexCount, &palette[0]);
+
+	bool paletteMatches		= (paletteError <= BenchmarkConstants::PaletteTolerance);
+	bool rotationMatches	= (rotationError <= BenchmarkConstants::RotationTolerance);
+	bool translationMatches	= (translationError <= BenchmarkConstants::TranslationTolerance);
+	bool skinningMatches	= (positionError <= BenchmarkConstants::SkinningTolerance && normalError <= BenchmarkConstants::SkinningTolerance);
+
+	printf("%-28s %16s %16s\n", "Check", "Largest error", "Tolerance");
+	printf("%-28s %16.8f %16.8f%s\n", "Bind pose palette", paletteError, BenchmarkConstants::PaletteTolerance, paletteMatches ? "" : "  FAILED");
+	printf("%-28s %16.8f %16.8f%s\n", "Clip rotation (radians)", rotationError, BenchmarkConstants::RotationTolerance, rotationMatches ? "" : "  FAILED");
+	printf("%-28s %16.8f %16.8f%s\n", "Clip translation (of box)", translationError, BenchmarkConstants::TranslationTolerance, translationMatches ? "" : "  FAILED");
+	printf("%-28s %16.8f %16.8f%s\n", "Skinned position", positionError, BenchmarkConstants::SkinningTolerance, skinningMatches ? "" : "  FAILED");
+	printf("%-28s %16.8f %16.8f%s\n", "Skinned normal", normalError, BenchmarkConstants::SkinningTolerance, skinningMatches ? "" : "  FAILED");
+	printf("%-28s %16s %16s%s\n", "Vertex joints checked", checked ? "passed" : "failed", "", checked ? "" : "  FAILED");
+	printf("%-28s %16s %16s%s\n", "Joint outside skeleton", rejected ? "rejected" : "accepted", "", rejected ? "" : "  FAILED");
+	printf("\n%10s %16s %16s\n", "Vertices", "ms per skin", "ns per vertex");
+	printf("%10u %16.3f %16.1f\n\n", vertexCount, time * 1000.0, time * 1000000000.0 / vertexCount);
+
+	bool passed = paletteMatches && rotationMatches && translationMatches && skinningMatches && checked && rejected;
+
+	if (!passed) { printf("[BENCHMARK] Skinning results are further from exact than they should be\n\n"); }
+
+	return passed;
+}
+
+
+/*******************************************************************************************************************
+	Function that checks the render queue's sort keys, then executes a random frame of draws on a device that only
+	records the calls - false if the draws come out in the wrong order, or with more or fewer state changes than
+	that order needs
+*******************************************************************************************************************/
+bool Benchmark::RunRenderQueue()
+{
+	const unsigned int count = BenchmarkConstants::RenderCommands;
+
+	printf("[BENCHMARK] Render queue - %u draws over %u shaders and %u textures, recorded without a graphics device\n\n", count,
+		   BenchmarkConstants::RenderShaders, BenchmarkConstants::RenderTextures);
+
+	bool passed = true;
+
+	//-------------------------------------------- Each field of the key has to win over everything after it, however large the later fields are
+	const KeyOrder keyOrders[] = {
+		{ "Opaque before transparent",	RenderQueue::GenerateSortKey(LAYER_OPAQUE, 0xFFF, 0xFFFF, FLT_MAX),			RenderQueue::GenerateSortKey(LAYER_TRANSPARENT, 0, 0, FLT_MAX) },
+		{ "Transparent before overlay",	RenderQueue::GenerateSortKey(LAYER_TRANSPARENT, 0xFFF, 0xFFFF, 0.0f),		RenderQueue::GenerateSortKey(LAYER_OVERLAY, 0, 0, 0.0f) },
+		{ "Shader before texture",		RenderQueue::GenerateSortKey(LAYER_OPAQUE, 1, 0xFFFF, FLT_MAX),				RenderQueue::GenerateSortKey(LAYER_OPAQUE, 2, 0, 0.0f) },
+		{ "Texture before depth",		RenderQueue::GenerateSortKey(LAYER_OPAQUE, 1, 1, FLT_MAX),					RenderQueue::GenerateSortKey(LAYER_OPAQUE, 1, 2, 0.0f) },
+		{ "Opaque front-to-back",		RenderQueue::GenerateSortKey(LAYER_OPAQUE, 1, 1, 1.0f),						RenderQueue::GenerateSortKey(LAYER_OPAQUE, 1, 1, 2.0f) },
+		{ "Transparent back-to-front",	RenderQueue::GenerateSortKey(LAYER_TRANSPARENT, 1, 1, 2.0f),				RenderQueue::GenerateSortKey(LAYER_TRANSPARENT, 1, 1, 1.0f) }
+	};
+
+	printf("%-32s %16s\n", "Check", "Result");
+
+	for (unsigned int i = 0; i < sizeof(keyOrders) / sizeof(keyOrders[0]); i++) {
+		bool ordered = (keyOrders[i].first < keyOrders[i].second);
+		passed = passed && ordered;
+
+		printf("%-32s %16s%s\n", keyOrders[i].name, ordered ? "in order" : "out of order", ordered ? "" : "  FAILED");
+	}
+
+	//-------------------------------------------- A frame of draws in a random order - some untextured, so texture id 0 is in there too
+	Camera camera;
+	NullShader shaders[BenchmarkConstants::RenderShaders];
+	Texture textures[BenchmarkConstants::RenderTextures];
+	std::vector<NullRenderable> renderables(count);
+	std::vector<SubmittedDraw> draws(count);
+
+	for (unsigned int i = 0; i < BenchmarkConstants::RenderShaders; i++) { shaders[i].SetSortId(i + 1); }
+
+	RenderQueue queue;
+	queue.Begin(&camera);
+
+	XMMATRIX view = camera.GetViewMatrix();
+	unsigned int seed = BenchmarkConstants::Seed;
+
+	for (unsigned int i = 0; i < count; i++) {
+		RenderLayer layer		= (RenderLayer)(unsigned int)(Random(seed) * LAYER_TOTAL);
+		NullShader* shader		= &shaders[(unsigned int)(Random(seed) * BenchmarkConstants::RenderShaders)];
+		Texture* texture		= (Random(seed) < 0.1f) ? nullptr : &textures[(unsigned int)(Random(seed) * BenchmarkConstants::RenderTextures)];
+		XMFLOAT3 position((Random(seed) * 2.0f - 1.0f) * BenchmarkConstants::RenderDistance, (Random(seed) * 2.0f - 1.0f) * BenchmarkConstants::RenderDistance,
+						  1.0f + Random(seed) * BenchmarkConstants::RenderDistance);
+
+		queue.Submit(layer, shader, texture, &renderables[i], XMMatrixIdentity(), position);
+
+		draws[i].layer		= layer;
+		draws[i].shaderId	= shader->GetSortId();
+		draws[i].textureId	= texture ? texture->GetSortId() : 0;
+		draws[i].depth		= (layer == LAYER_OVERLAY) ? 0.0f : XMVectorGetZ(XMVector3TransformCoord(XMLoadFloat3(&position), view));
+		draws[i].index		= i;
+	}
+
+	//-------------------------------------------- The order the draws should come out in, worked out the slow way - equal draws keep the order they were submitted in
+	std::vector<SubmittedDraw> expected = draws;
+
+	std::stable_sort(expected.begin(), expected.end(), [](const SubmittedDraw& first, const SubmittedDraw& second) {
+		if (first.layer != second.layer)			{ return first.layer < second.layer; }
+		if (first.shaderId != second.shaderId)		{ return first.shaderId < second.shaderId; }
+		if (first.textureId != second.textureId)	{ return first.textureId < second.textureId; }
+		if (first.layer == LAYER_OPAQUE)			{ return first.depth < second.depth; }
+		if (first.layer == LAYER_TRANSPARENT)		{ return first.depth > second.depth; }
+		return false;
+	});
+
+	//-------------------------------------------- In that order, state only needs changing when the next draw differs - and a new shader always rebinds the texture
+	unsigned int expectedChanges = 0;
+
+	for (unsigned int i = 0; i < count; i++) {
+		bool newLayer	= (i == 0 || expected[i].layer != expected[i - 1].layer);
+		bool newShader	= (i == 0 || expected[i].shaderId != expected[i - 1].shaderId);
+		bool newTexture	= (newShader || expected[i].textureId != expected[i - 1].textureId);
+
+		expectedChanges += (newLayer ? 1 : 0) + (newShader ? 1 : 0) + (newTexture ? 1 : 0);
+	}
+
+	RecordingRenderDevice device;
+	queue.Execute(device);
+
+	//-------------------------------------------- Play the recording back, checking every draw is the one expected next and is drawn with its own state bound
+	const std::vector<RecordingRenderDevice::Call>& calls = device.GetCalls();
+
+	RenderLayer boundLayer		= LAYER_TOTAL;
+	ShaderProgram* boundShader	= nullptr;
+	Texture* boundTexture		= nullptr;
+	unsigned int drawn			= 0;
+	unsigned int changes		= 0;
+	bool ordered				= true;
+	bool bound					= true;
+
+	for (unsigned int i = 0; i < calls.size(); i++) {
+		const RecordingRenderDevice::Call& call = calls[i];
+
+		switch (call.type) {
+			case RecordingRenderDevice::CALL_SET_LAYER:		boundLayer = call.layer;		changes++; break;
+			case RecordingRenderDevice::CALL_SET_SHADER:	boundShader = call.shader;		changes++; break;
+			case RecordingRenderDevice::CALL_SET_TEXTURE:	boundTexture = call.texture;	changes++; break;
+
+			case RecordingRenderDevice::CALL_DRAW: {
+				unsigned int index = (unsigned int)(static_cast<const NullRenderable*>(call.renderable) - &renderables[0]);
+
+				ordered	= ordered && drawn < count && expected[drawn].index == index;
+				bound	= bound && boundLayer == draws[index].layer && boundShader == call.shader && boundTexture == call.texture;
+				drawn++;
+				break;
+			}
+
+			default: break;
+		}
+	}
+
+	ordered = ordered && (drawn == count);
+
+	const RenderStats& stats	= queue.GetStats();
+	bool changesMatch			= (changes == expectedChanges && stats.stateChanges == expectedChanges);
+
+	passed = passed && ordered && bound && changesMatch;
+
+	printf("%-32s %16s%s\n", "Draws in sorted order", ordered ? "in order" : "out of order", ordered ? "" : "  FAILED");
+	printf("%-32s %16s%s\n", "Draws with their state bound", bound ? "bound" : "not bound", bound ? "" : "  FAILED");
+	printf("\n%10s %16s %16s %16s %16s\n", "Draws", "Changes counted", "Changes made", "Changes needed", "ms to sort");
+	printf("%10u %16u %16u %16u %16.3f%s\n\n", drawn, stats.stateChanges, changes, expectedChanges, stats.sortTime, changesMatch ? "" : "  MISMATCH");
+
+	if (!passed) { printf("[BENCHMARK] The render queue draws in the wrong order, or changes state more than it needs to\n\n"); }
+
+	return passed;
+}
+
+
+/*******************************************************************************************************************
+	Function that scatters spheres over a square, then moves them all every frame - returns the seconds per update,
+	and the average number of contacts found per update
+*******************************************************************************************************************/
+double Benchmark::TimeCollisions(unsigned int count, unsigned int& contacts)
+{
+	CreateWorlds();
+
+	TransformManager* transforms	= Transforms::Instance();
+	CollisionWorld* collisions		= Collisions::Instance();
+
+	//-------------------------------------------- The square grows with the count, so the spheres are as crowded at every count and only the number of them changes
+	const float size = sqrtf((float)count) * BenchmarkConstants::CollisionSpacing;
+
+	std::vector<TransformHandle> handles(count);
+	std::vector<XMFLOAT3> velocities(count);
+
+	unsigned int seed = BenchmarkConstants::Seed;
+
+	for (unsigned int i = 0; i < count; i++) {
+		handles[i] = transforms->Create(XMFLOAT3(Random(seed) * size, 0.0f, Random(seed) * size));
+		collisions->CreateSphere(handles[i], XMFLOAT3(0.0f, 0.0f, 0.0f), BenchmarkConstants::SphereRadius);
+
+		velocities[i] = XMFLOAT3((Random(seed) * 2.0f - 1.0f) * BenchmarkConstants::CollisionSpeed, 0.0f,
+								 (Random(seed) * 2.0f - 1.0f) * BenchmarkConstants::CollisionSpeed);
+	}
+
+	long long ticks				= 0;
+	unsigned long long found	= 0;
+
+	for (unsigned int frame = 0; frame < BenchmarkConstants::WarmUpFrames + BenchmarkConstants::CollisionFrames; frame++) {
+
+		//-------------------------------------------- Bounce off the edges of the square, so the spheres stay as crowded as they started
+		for (unsigned int i = 0; i < count; i++) {
+			XMFLOAT3 position = transforms->GetPosition(handles[i]);
+
+			if ((position.x < 0.0f && velocities[i].x < 0.0f) || (position.x > size && velocities[i].x > 0.0f)) { velocities[i].x = -velocities[i].x; }
+			if ((position.z < 0.0f && velocities[i].z < 0.0f) || (position.z > size && velocities[i].z > 0.0f)) { velocities[i].z = -velocities[i].z; }
+
+			transforms->Translate(handles[i], velocities[i].x, 0.0f, velocities[i].z);
+		}
+
+		long long start = SystemClock::GetTicks();
+
+		collisions->Update();
+
+		if (frame >= BenchmarkConstants::WarmUpFrames) {
+			ticks += SystemClock::GetTicks() - start;
+			found += collisions->GetContacts().size();
+		}
+	}
+
+	DestroyWorlds();
+
+	contacts = (unsigned int)(found / BenchmarkConstants::CollisionFrames);
+
+	return (double)ticks / (double)SystemClock::GetTicksPerSecond() / (double)BenchmarkConstants::CollisionFrames;
+}
+
+
+/*******************************************************************************************************************
+	Function that piles bodies in to a square and steps them on the number of threads given, hashing every step
+*******************************************************************************************************************/
+Benchmark::PhysicsResult Benchmark::TimePhysics(unsigned int count, unsigned int threadCount)
+{
+	CreateWorlds();
+
+	TransformManager* transforms	= Transforms::Instance();
+	CollisionWorld* collisions		= Collisions::Instance();
+	PhysicsWorld* physics			= Physics::Instance();
+
+	//-------------------------------------------- The calling thread helps, so it only needs one worker less than the threads asked for
+	physics->Initialize(threadCount - 1);
+
+	const float size = sqrtf((float)count) * BenchmarkConstants::PhysicsSpacing;
+
+	std::vector<PhysicsBody> bodies(count);
+
+	unsigned int seed = BenchmarkConstants::Seed;
+
+	for (unsigned int i = 0; i < count; i++) {
+		TransformHandle transform = transforms->Create(XMFLOAT3(Random(seed) * size, 0.0f, Random(seed) * size));
+		collisions->CreateSphere(transform, XMFLOAT3(0.0f, 0.0f, 0.0f), BenchmarkConstants::SphereRadius);
+
+		bodies[i] = physics->Create(transform);
+		physics->SetMass(bodies[i], 1.0f + (float)(i % 3));
+		physics->SetVelocity(bodies[i], XMVectorSet((Random(seed) * 2.0f - 1.0f) * BenchmarkConstants::PhysicsSpeed, 0.0f,
+													(Random(seed) * 2.0f - 1.0f) * BenchmarkConstants::PhysicsSpeed, 0.0f));
+	}
+
+	for (unsigned int i = 0; i + 1 < count; i += BenchmarkConstants::LinkEvery) { physics->Link(bodies[i], bodies[i + 1]); }
+
+	//-------------------------------------------- Something in the middle that doesn't move, for bodies to be pushed off
+	TransformHandle wall = transforms->Create(XMFLOAT3(size * 0.5f, 0.0f, size * 0.5f));
+	collisions->CreateBox(wall, XMFLOAT3(0.0f, 0.0f, 0.0f), XMFLOAT3(2.0f, 2.0f, 2.0f));
+
+	PhysicsResult result;
+	result.hash		= 14695981039346656037ull;
+	result.islands	= 0;
+
+	long long ticks = 0;
+
+	for (unsigned int step = 0; step < BenchmarkConstants::WarmUpFrames + BenchmarkConstants::PhysicsSteps; step++) {
+
+		long long start = SystemClock::GetTicks();
+
+		physics->Step(PhysicsConstants::TimeStep);
+
+		if (step >= BenchmarkConstants::WarmUpFrames) { ticks += SystemClock::GetTicks() - start; }
+
+		//-------------------------------------------- Hash outside the timing - a different result at any step fails, even if the bodies end up in the same place
+		result.islands	= physics->GetIslandCount();
+		result.hash		= Hash(result.hash, &result.islands, sizeof(result.islands));
+
+		for (unsigned int i = 0; i < count; i++) {
+			XMFLOAT3 position = physics->GetPosition(bodies[i]);
+			result.hash = Hash(result.hash, &position, sizeof(position));
+		}
+	}
+
+	physics->Shutdown();
+
+	DestroyWorlds();
+
+	result.stepTime = (double)ticks / (double)SystemClock::GetTicksPerSecond() / (double)BenchmarkConstants::PhysicsSteps;
+
+	return result;
+}
+
+
+/*******************************************************************************************************************
+	Function that skins the vertices given over and over - returns the seconds per pass over all of them
+*******************************************************************************************************************/
+double Benchmark::TimeSkinning(const BufferConstants::PackedSkinnedVertex* vertices, unsigned int count, const XMFLOAT4X4* palette)
+{
+	std::vector<XMFLOAT3> positions(count);
+	std::vector<XMFLOAT3> normals(count);
+
+	long long ticks = 0;
+
+	for (unsigned int run = 0; run < BenchmarkConstants::WarmUpFrames + BenchmarkConstants::SkinningRuns; run++) {
+
+		long long start = SystemClock::GetTicks();
+
+		Skeleton::SkinVertices(vertices, count, palette, &positions[0], &normals[0]);
+
+		if (run >= BenchmarkConstants::WarmUpFrames) { ticks += SystemClock::GetTicks() - start; }
+	}
+
+	return (double)ticks / (double)SystemClock::GetTicksPerSecond() / (double)BenchmarkConstants::SkinningRuns;
+}
+
+
+/*******************************************************************************************************************
+	Function that skins one vertex the slow, obvious way - each joint moves the vertex, then the results are blended
+*******************************************************************************************************************/
+void Benchmark::SkinReference(const BufferConstants::PackedSkinnedVertex& vertex, const XMFLOAT4X4* palette, XMFLOAT3& position, XMFLOAT3& normal)
+{
+	double skinned[3]	= { 0.0, 0.0, 0.0 };
+	double turned[3]	= { 0.0, 0.0, 0.0 };
+
+	for (unsigned int j = 0; j < SkinningConstants::MaxInfluences; j++) {
+		const XMFLOAT4X4& joint = palette[vertex.joints[j]];
+		double weight = vertex.weights[j] / 255.0;
+
+		//-------------------------------------------- Row vectors - the position is multiplied by the whole matrix, the normal only by its rotation
+		for (unsigned int axis = 0; axis < 3; axis++) {
+			skinned[axis]	+= weight * (vertex.position.x * joint.m[0][axis] + vertex.position.y * joint.m[1][axis] + vertex.position.z * joint.m[2][axis] + joint.m[3][axis]);
+			turned[axis]	+= weight * (vertex.normal.x * joint.m[0][axis] + vertex.normal.y * joint.m[1][axis] + vertex.normal.z * joint.m[2][axis]);
+		}
+	}
+
+	double length = sqrt(turned[0] * turned[0] + turned[1] * turned[1] + turned[2] * turned[2]);
+	if (length <= 0.0) { length = 1.0; }
+
+	position	= XMFLOAT3((float)skinned[0], (float)skinned[1], (float)skinned[2]);
+	normal		= XMFLOAT3((float)(turned[0] / length), (float)(turned[1] / length), (float)(turned[2] / length));
+}
+
+
+/*******************************************************************************************************************
+	Function that creates empty worlds for a run - each world is made after the ones it depends on
+*******************************************************************************************************************/
+void Benchmark::CreateWorlds()
+{
+	Transforms::Create();
+	Collisions::Create();
+	Physics::Create();
+}
+
+
+/*******************************************************************************************************************
+	Function that destroys a run's worlds in the opposite order, along with everything in them
+*******************************************************************************************************************/
+void Benchmark::DestroyWorlds()
+{
+	Physics::Destroy();
+	Collisions::Destroy();
+	Transforms::Destroy();
+}
+
+
+/*******************************************************************************************************************
+	Function that returns a random number from 0 to 1 - the same seed always gives the same numbers, on any machine
+*******************************************************************************************************************/
+float Benchmark::Random(unsigned int& seed)
+{
+	seed = seed * 1664525u + 1013904223u;
+
+	return (float)(seed >> 8) / 16777216.0f;
+}
+
+
+/*******************************************************************************************************************
+	Function that returns a random rotation, as a unit quaternion - from the same seed numbers as Random()
+*******************************************************************************************************************/
+XMFLOAT4 Benchmark::RandomRotation(unsigned int& seed)
+{
+	XMVECTOR axis = XMVectorSet(Random(seed) - 0.5f, Random(seed) - 0.5f, Random(seed) - 0.5f, 0.0f);
+
+	XMFLOAT4 rotation;
+	XMStoreFloat4(&rotation, XMQuaternionRotationNormal(XMVector3Normalize(axis), (Random(seed) * 2.0f - 1.0f) * XM_PI));
+
+	return rotation;
+}
+
+
+/*******************************************************************************************************************
+	Function that adds some bytes to a running hash (FNV-1a) - the bytes of a float, so any change at all is seen
+*******************************************************************************************************************/
+unsigned long long Benchmark::Hash(unsigned long long hash, const void* data, unsigned int size)
+{
+	const unsigned char* bytes = static_cast<const unsigned char*>(data);
+
+	for (unsigned int i = 0; i < size; i++) {
+		hash ^= bytes[i];
+		hash *= 1099511628211ull;
+	}
+
+	return hash;
+}
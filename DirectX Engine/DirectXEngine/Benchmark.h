@@ -0,0 +1,70 @@
+#pragma once
+
+/*******************************************************************************************************************
+	Benchmark.h, Benchmark.cpp
+	Created by Kim Kane
+	Last updated: 19/10/2026
+
+	Headless stress tests and checks for the engine - nothing here opens a window or needs the graphics device.
+
+	Starting the game with -benchmark runs these instead of the game and prints the results to the console.
+	A benchmark's name can follow it to run just that one (e.g. "-benchmark collisions").
+
+		- collisions: a field of spheres, every one of them moving every frame, with the time per Update() and
+		  how many contacts it found at each object count.
+		- physics: a crowded field of bodies (some linked in pairs) stepped with 1 thread, then 2, and so on up
+		  to one per core, with the time per Step() and the speedup over 1 thread at each body count.
+		- skinning: a random skeleton and clip, checked against exact answers - the bind pose's palette must be
+		  identity, every frame of the clip must come back from quantizing within a set error, and SkinVertices()
+		  must match a plain scalar version - then the time to skin a mesh's worth of vertices.
+		- renderqueue: sort keys built to test each field against the ones after it, then a frame of draws
+		  submitted in a random order and executed on a RecordingRenderDevice - the draws must come out grouped
+		  by layer, shader, texture and depth (transparent ones back-to-front), with only the state changes that
+		  order needs.
+
+	The physics world promises the same results however many threads solve the islands (see PhysicsWorld.h),
+	so the physics benchmark checks it - every body's position and the island count are hashed after every
+	step, and any thread count whose hash differs from 1 thread's is reported as a failure.
+
+	Every run starts from empty worlds - the transform manager, collision world and physics world are destroyed
+	and created again in between - and scatters its objects from the same seed, so runs can be compared.
+
+*******************************************************************************************************************/
+#include "Constants.h"
+
+class Benchmark {
+
+public:
+	static int Run(int argumentCount, char* arguments[]);
+
+public:
+	static bool RunCollisions();
+	static bool RunPhysics();
+	static bool RunSkinning();
+	static bool RunRenderQueue();
+
+private:
+	Benchmark();
+
+private:
+	//-------------------------------------------- One physics run - the hash covers every step, not just the last one
+	struct PhysicsResult
+	{
+		double				stepTime;
+		unsigned int		islands;
+		unsigned long long	hash;
+	};
+
+private:
+	static double TimeCollisions(unsigned int count, unsigned int& contacts);
+	static PhysicsResult TimePhysics(unsigned int count, unsigned int threadCount);
+	static double TimeSkinning(const BufferConstants::PackedSkinnedVertex* vertices, unsigned int count, const XMFLOAT4X4* palette);
+	static void SkinReference(const BufferConstants::PackedSkinnedVertex& vertex, const XMFLOAT4X4* palette, XMFLOAT3& position, XMFLOAT3& normal);
+
+private:
+	static void CreateWorlds();
+	static void DestroyWorlds();
+	static float Random(unsigned int& seed);
+	static XMFLOAT4 RandomRotation(unsigned int& seed);
+	static unsigned long long Hash(unsigned long long hash, const void* data, unsigned int size);
+};
@@ -2,6 +2,7 @@
 #include "objLoader.h"
 #include "Log.h"
 #include "GraphicsManager.h"
+#include "RenderContext.h"
 
 /*******************************************************************************************************************
 	Constructor with initializer list to set all default values of variables
@@ -119,6 +120,46 @@ bool Buffer::Push(const std::vector<BufferConstants::PackedTerrainVertex>& verti
 }
 
 
+/*******************************************************************************************************************
+	Function that sends skinned model vertex data to the GPU
+*******************************************************************************************************************/
+bool Buffer::Push(const std::vector<BufferConstants::PackedSkinnedVertex>& vertices)
+{
+	HRESULT result = S_OK;
+
+	if (vertices.empty()) {
+		DX_LOG("[SKINNED VERTEX BUFFER] Skinned vertices vector container is empty", DX_LOG_EMPTY, LOG_ERROR); return false;
+	}
+
+	//-------------------------------------------- The shader reads any joint a vertex names from the palette, so none may be past the end of it (Skeleton::CheckVertices() checks against the skeleton itself)
+	for (unsigned int i = 0; i < vertices.size(); i++) {
+		for (unsigned int j = 0; j < SkinningConstants::MaxInfluences; j++) {
+			if (vertices[i].joints[j] >= SkinningConstants::MaxJoints) {
+				DX_LOG("[SKINNED VERTEX BUFFER] Vertex names a joint past the end of the bone palette: ", i, LOG_ERROR); return false;
+			}
+		}
+	}
+
+	m_vertexCount = vertices.size();
+
+	D3D11_BUFFER_DESC vertexDescription = { 0 };
+	vertexDescription.Usage				= D3D11_USAGE_DEFAULT;
+	vertexDescription.BindFlags			= D3D11_BIND_VERTEX_BUFFER;
+	vertexDescription.ByteWidth			= sizeof(BufferConstants::PackedSkinnedVertex) * vertices.size();
+
+	D3D11_SUBRESOURCE_DATA vertexData	= { 0 };
+	vertexData.pSysMem					= &vertices.front();
+
+	result = Graphics::Instance()->GetDevice()->CreateBuffer(&vertexDescription, &vertexData, &m_vertexBufferObject);
+
+	if (FAILED(result)) {
+		DX_LOG("[SKINNED VERTEX BUFFER] Problem creating skinned vertex buffer", DX_LOG_EMPTY, LOG_ERROR); return false;
+	}
+
+	return true;
+}
+
+
 /*******************************************************************************************************************
 	Function that sends user-defined terrain index data to the GPU
 *******************************************************************************************************************/
@@ -155,10 +196,19 @@ bool Buffer::Push(const std::vector<unsigned long>& indices)
 *******************************************************************************************************************/
 void Buffer::Render(unsigned int stride, unsigned int offset) const
 {
-	Graphics::Instance()->GetDeviceContext()->IASetVertexBuffers(0, 1, &m_vertexBufferObject, &stride, &offset);
-	Graphics::Instance()->GetDeviceContext()->IASetIndexBuffer(m_indexBufferObject, DXGI_FORMAT_R32_UINT, 0);
+	Render(Graphics::Instance()->GetImmediateContext(), stride, offset);
+}
+
 
-	Graphics::Instance()->GetDeviceContext()->DrawIndexed(m_indexCount, 0, 0);
+/*******************************************************************************************************************
+	Function that renders the GPU buffer data through a render context - used by the render threads
+*******************************************************************************************************************/
+void Buffer::Render(RenderContext& context, unsigned int stride, unsigned int offset) const
+{
+	context.SetVertexBuffer(m_vertexBufferObject, stride, offset);
+	context.SetIndexBuffer(m_indexBufferObject, DXGI_FORMAT_R32_UINT);
+
+	context.DrawIndexed(m_indexCount, 0, 0);
 }
 
 
@@ -174,41 +224,6 @@ ID3D11Buffer* const* Buffer::GetIndexBuffer() const		{ return &m_indexBufferObje
 /*******************************************************************************************************************
 	Static functions and variables
 *******************************************************************************************************************/
-bool Buffer::LockConstantBuffer(ID3D11Buffer* constantBuffer, D3D11_MAPPED_SUBRESOURCE& mappedResource)
-{	
-	//-------------------------------------------- Lock the constant buffer so it can be written to
-	HRESULT result = S_OK;
-
-	result = Graphics::Instance()->GetDeviceContext()->Map(constantBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedResource);
-	if (FAILED(result)) { 
-		DX_LOG("[CONSTANT BUFFER] Problem writing to the constant buffer", DX_LOG_EMPTY, LOG_ERROR); return false; 
-	}
-
-	return true;
-}
-
-
-void Buffer::UnlockConstantBuffer(ID3D11Buffer* constantBuffer)
-{
-	//-------------------------------------------- Unlock the constant buffer after writing to it
-	Graphics::Instance()->GetDeviceContext()->Unmap(constantBuffer, 0);
-}
-
-
-void Buffer::SetVertexConstantBuffer(unsigned int location, ID3D11Buffer* constantBuffer)
-{
-	//-------------------------------------------- Sets the constant buffer in the vertex shader with the updated values
-	Graphics::Instance()->GetDeviceContext()->VSSetConstantBuffers(location, 1, &constantBuffer);
-}
-
-
-void Buffer::SetPixelConstantBuffer(unsigned int location, ID3D11Buffer* constantBuffer)
-{
-	//-------------------------------------------- Sets the constant buffer in the pixel shader with the updated values
-	Graphics::Instance()->GetDeviceContext()->PSSetConstantBuffers(location, 1, &constantBuffer);
-}
-
-
 bool Buffer::CreateConstantBuffer(ID3D11Buffer** constantBuffer, UINT bufferByteSize)
 {
 	//-------------------------------------------- Set up the description of the dynamic constant buffer that is in the shader
@@ -12,6 +12,8 @@
 #include <vector>
 #include "Constants.h"
 
+class RenderContext;
+
 class Buffer {
 
 public:
@@ -30,16 +32,14 @@ public:
 	bool Push(const std::vector<unsigned int>& indices);
 
 	bool Push(const std::vector<BufferConstants::PackedTerrainVertex>& vertices);
+	bool Push(const std::vector<BufferConstants::PackedSkinnedVertex>& vertices);
 	bool Push(const std::vector<unsigned long>& indices);
 
 public:
 	void Render(unsigned int stride, unsigned int offset) const;
+	void Render(RenderContext& context, unsigned int stride, unsigned int offset) const;
 
 public:
-	static bool LockConstantBuffer(ID3D11Buffer* constantBuffer, D3D11_MAPPED_SUBRESOURCE& mappedResource);
-	static void UnlockConstantBuffer(ID3D11Buffer* constantBuffer);
-	static void SetVertexConstantBuffer(unsigned int location, ID3D11Buffer* constantBuffer);
-	static void SetPixelConstantBuffer(unsigned int location, ID3D11Buffer* constantBuffer);
 	static bool CreateConstantBuffer(ID3D11Buffer** constantBuffer, UINT bufferByteSize);
 
 private:
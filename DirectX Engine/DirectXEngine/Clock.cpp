@@ -0,0 +1,363 @@
+#include <algorithm>
+
+#include "Clock.h"
+#include "Constants.h"
+#include "Log.h"
+
+//-------------------------------------------- After Clock.h, as mmsystem.h needs the types Windows.h defines
+#if defined(_WIN32)
+	#include <mmsystem.h>
+#else
+	#include <fstream>
+	#include <sstream>
+	#include <sched.h>
+#endif
+
+/*******************************************************************************************************************
+	Constructor - on Windows, asks for sleeping threads to be woken every millisecond, so a wait can sleep accurately
+*******************************************************************************************************************/
+SystemClock::SystemClock()	:	m_secondsPerTick(1.0 / (double)GetTicksPerSecond()),
+								m_timerPeriodSet(false)
+{
+#if defined(_WIN32)
+	m_timerPeriodSet = (timeBeginPeriod(1) == TIMERR_NOERROR);
+#endif
+}
+
+
+/*******************************************************************************************************************
+	Shut down all necessary procedures, release resources and clean up memory
+*******************************************************************************************************************/
+SystemClock::~SystemClock()
+{
+#if defined(_WIN32)
+	if (m_timerPeriodSet) { timeEndPeriod(1); }
+#endif
+}
+
+
+/*******************************************************************************************************************
+	Function that gets the time in seconds, from whenever the steady clock started
+*******************************************************************************************************************/
+double SystemClock::GetTime()
+{
+	return (double)GetTicks() * m_secondsPerTick;
+}
+
+
+/*******************************************************************************************************************
+	Function that gets how much CPU time (user and kernel) every thread in the process has used, in seconds
+*******************************************************************************************************************/
+double SystemClock::GetProcessTime()
+{
+#if defined(_WIN32)
+	FILETIME creation, exit, kernel, user;
+	if (!GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user)) { return 0.0; }
+
+	//-------------------------------------------- File times count in 100 nanoseconds
+	ULARGE_INTEGER kernelTime = { kernel.dwLowDateTime, kernel.dwHighDateTime };
+	ULARGE_INTEGER userTime = { user.dwLowDateTime, user.dwHighDateTime };
+
+	return (double)(kernelTime.QuadPart + userTime.QuadPart) * 1.0e-7;
+#else
+	timespec time;
+	clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &time);
+
+	return (double)time.tv_sec + (double)time.tv_nsec * 1.0e-9;
+#endif
+}
+
+
+/*******************************************************************************************************************
+	Function that gets how much CPU time the calling thread has used, in seconds
+*******************************************************************************************************************/
+double SystemClock::GetThreadTime()
+{
+#if defined(_WIN32)
+	FILETIME creation, exit, kernel, user;
+	if (!GetThreadTimes(GetCurrentThread(), &creation, &exit, &kernel, &user)) { return 0.0; }
+
+	ULARGE_INTEGER kernelTime = { kernel.dwLowDateTime, kernel.dwHighDateTime };
+	ULARGE_INTEGER userTime = { user.dwLowDateTime, user.dwHighDateTime };
+
+	return (double)(kernelTime.QuadPart + userTime.QuadPart) * 1.0e-7;
+#else
+	timespec time;
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time);
+
+	return (double)time.tv_sec + (double)time.tv_nsec * 1.0e-9;
+#endif
+}
+
+
+/*******************************************************************************************************************
+	Function that waits until the time given - sleeps while there's plenty of time, then spins the rest
+*******************************************************************************************************************/
+void SystemClock::WaitUntil(double time)
+{
+	//-------------------------------------------- Sleeping can wake up a millisecond or more late, so stop sleeping a little early
+	double remaining = time - GetTime();
+
+	while (remaining > ClockConstants::SpinTime) {
+#if defined(_WIN32)
+		Sleep((DWORD)((remaining - ClockConstants::SpinTime) * 1000.0));
+#else
+		double sleepTime = remaining - ClockConstants::SpinTime;
+		timespec wait = { (time_t)sleepTime, (long)((sleepTime - (double)(time_t)sleepTime) * 1.0e9) };
+		nanosleep(&wait, nullptr);
+#endif
+		remaining = time - GetTime();
+	}
+
+	while (GetTime() < time) {
+#if defined(_WIN32)
+		YieldProcessor();
+#else
+		sched_yield();
+#endif
+	}
+}
+
+
+/*******************************************************************************************************************
+	Constructor with initializer list to set all default values of variables
+*******************************************************************************************************************/
+FakeClock::FakeClock()	:	m_time(0.0),
+							m_cpuTime(0.0)
+{
+}
+
+
+/*******************************************************************************************************************
+	Shut down all necessary procedures, release resources and clean up memory
+*******************************************************************************************************************/
+FakeClock::~FakeClock()
+{
+}
+
+
+/*******************************************************************************************************************
+	Function that moves the clock on, along with how much CPU time was used in that time
+*******************************************************************************************************************/
+void FakeClock::Advance(double seconds, double cpuSeconds)
+{
+	m_time		+= seconds;
+	m_cpuTime	+= cpuSeconds;
+}
+
+
+/*******************************************************************************************************************
+	Function that waits without waiting - the time just jumps to the time waited for
+*******************************************************************************************************************/
+void FakeClock::WaitUntil(double time)
+{
+	m_time = (std::max)(m_time, time);
+}
+
+
+/*******************************************************************************************************************
+	Accessor Methods
+*******************************************************************************************************************/
+double FakeClock::GetTime()			{ return m_time; }
+double FakeClock::GetProcessTime()	{ return m_cpuTime; }
+double FakeClock::GetThreadTime()	{ return m_cpuTime; }
+
+
+/*******************************************************************************************************************
+	Modifier Methods
+*******************************************************************************************************************/
+void FakeClock::SetTime(double time) { m_time = time; }
+
+
+/*******************************************************************************************************************
+	Constructor with initializer list to set all default values of variables
+*******************************************************************************************************************/
+CpuMonitor::CpuMonitor()	:	m_totalUsage(0.0f),
+								m_isReady(false)
+#if defined(_WIN32)
+								, m_query(nullptr),
+								m_cores(nullptr),
+								m_total(nullptr)
+#endif
+{
+}
+
+
+/*******************************************************************************************************************
+	Shut down all necessary procedures, release resources and clean up memory
+*******************************************************************************************************************/
+CpuMonitor::~CpuMonitor()
+{
+	Shutdown();
+}
+
+
+#if defined(_WIN32)
+
+/*******************************************************************************************************************
+	Function that sets up the processor counters - every core, and all of them together
+*******************************************************************************************************************/
+bool CpuMonitor::Initialize()
+{
+	Shutdown();
+
+	if (PdhOpenQuery(nullptr, 0, &m_query) != ERROR_SUCCESS) { m_query = nullptr; return false; }
+
+	//-------------------------------------------- English names, so the counters are found whatever language windows is in
+	if (PdhAddEnglishCounter(m_query, TEXT("\\Processor(*)\\% Processor Time"), 0, &m_cores) != ERROR_SUCCESS ||
+		PdhAddEnglishCounter(m_query, TEXT("\\Processor(_Total)\\% Processor Time"), 0, &m_total) != ERROR_SUCCESS) {
+		DX_LOG("[CPU MONITOR] Couldn't add the processor counters", DX_LOG_EMPTY, LOG_WARN);
+		Shutdown(); return false;
+	}
+
+	//-------------------------------------------- Usage is worked out between two samples, so take the first one now
+	PdhCollectQueryData(m_query);
+	m_isReady = true;
+
+	return true;
+}
+
+
+/*******************************************************************************************************************
+	Function that works out how busy each core has been since the last sample
+*******************************************************************************************************************/
+bool CpuMonitor::Sample()
+{
+	if (!m_isReady || PdhCollectQueryData(m_query) != ERROR_SUCCESS) { return false; }
+
+	PDH_FMT_COUNTERVALUE total;
+	if (PdhGetFormattedCounterValue(m_total, PDH_FMT_DOUBLE, nullptr, &total) == ERROR_SUCCESS) { m_totalUsage = (float)total.doubleValue; }
+
+	//-------------------------------------------- Ask how much room every core's value needs, then get them all at once
+	DWORD bufferSize = 0, itemCount = 0;
+	if (PdhGetFormattedCounterArray(m_cores, PDH_FMT_DOUBLE, &bufferSize, &itemCount, nullptr) != PDH_MORE_DATA) { return false; }
+
+	m_counterBuffer.resize(bufferSize);
+	PDH_FMT_COUNTERVALUE_ITEM* items = (PDH_FMT_COUNTERVALUE_ITEM*)&m_counterBuffer[0];
+
+	if (PdhGetFormattedCounterArray(m_cores, PDH_FMT_DOUBLE, &bufferSize, &itemCount, items) != ERROR_SUCCESS) { return false; }
+
+	//-------------------------------------------- The wildcard brings back _Total as well, which is already kept on its own
+	m_coreUsage.clear();
+
+	for (DWORD i = 0; i < itemCount; i++) {
+		if (lstrcmp(items[i].szName, TEXT("_Total")) == 0) { continue; }
+		m_coreUsage.push_back((float)items[i].FmtValue.doubleValue);
+	}
+
+	return true;
+}
+
+
+/*******************************************************************************************************************
+	Function that closes the processor counters
+*******************************************************************************************************************/
+void CpuMonitor::Shutdown()
+{
+	if (m_query) { PdhCloseQuery(m_query); }
+
+	m_query		= nullptr;
+	m_cores		= nullptr;
+	m_total		= nullptr;
+	m_isReady	= false;
+}
+
+#else
+
+/*******************************************************************************************************************
+	Function that sets which file the CPU times are read from - always /proc/stat, apart from in tests
+*******************************************************************************************************************/
+bool CpuMonitor::Initialize(const std::string& statFile)
+{
+	Shutdown();
+
+	m_statFile = statFile;
+
+	std::ifstream file(m_statFile);
+	if (!file.is_open()) { DX_LOG("[CPU MONITOR] Couldn't open: ", m_statFile.c_str(), LOG_WARN); return false; }
+
+	m_isReady = true;
+
+	//-------------------------------------------- Usage is worked out between two samples, so take the first one now
+	m_totalUsage = 0.0f;
+	Sample();
+
+	return true;
+}
+
+
+/*******************************************************************************************************************
+	Function that works out how busy each core has been since the last sample, from the time each has spent idle
+*******************************************************************************************************************/
+bool CpuMonitor::Sample()
+{
+	if (!m_isReady) { return false; }
+
+	std::ifstream file(m_statFile);
+	if (!file.is_open()) { return false; }
+
+	std::vector<CoreTimes> times;
+	std::string line;
+
+	//-------------------------------------------- "cpu" is the whole machine and "cpu0", "cpu1"... are the cores - they all come first
+	while (std::getline(file, line) && line.compare(0, 3, "cpu") == 0) {
+		//-------------------------------------------- A line with no fields after its name has nothing to read (and substr would throw), so skip it
+		size_t space = line.find(' ');
+		if (space == std::string::npos) { continue; }
+
+		std::istringstream fields(line.substr(space));
+
+		unsigned long long value, total = 0, idle = 0;
+
+		//-------------------------------------------- user, nice, system, idle, iowait, irq, softirq, steal - guest time is already counted in user
+		for (unsigned int i = 0; i < 8 && (fields >> value); i++) {
+			total += value;
+			if (i == 3 || i == 4) { idle += value; }
+		}
+
+		CoreTimes core = { total - idle, total };
+		times.push_back(core);
+	}
+
+	if (times.empty()) { return false; }
+
+	//-------------------------------------------- Cores can come and go (being taken offline), so only compare like with like
+	if (times.size() == m_lastTimes.size()) {
+		m_coreUsage.resize(times.size() - 1);
+
+		for (unsigned int i = 0; i < times.size(); i++) {
+			unsigned long long total = times[i].total - m_lastTimes[i].total;
+			float usage = (total > 0) ? (float)(100.0 * (double)(times[i].busy - m_lastTimes[i].busy) / (double)total) : 0.0f;
+
+			if (i == 0)	{ m_totalUsage = usage; }
+			else		{ m_coreUsage[i - 1] = usage; }
+		}
+	}
+	else {
+		m_coreUsage.assign(times.size() - 1, 0.0f);
+	}
+
+	m_lastTimes = times;
+
+	return true;
+}
+
+
+/*******************************************************************************************************************
+	Function that stops sampling
+*******************************************************************************************************************/
+void CpuMonitor::Shutdown()
+{
+	m_lastTimes.clear();
+	m_isReady = false;
+}
+
+#endif
+
+
+/*******************************************************************************************************************
+	Accessor Methods
+*******************************************************************************************************************/
+unsigned int CpuMonitor::GetCoreCount() const				{ return (unsigned int)m_coreUsage.size(); }
+float CpuMonitor::GetCoreUsage(unsigned int core) const		{ return (core < m_coreUsage.size()) ? m_coreUsage[core] : 0.0f; }
+float CpuMonitor::GetTotalUsage() const						{ return m_totalUsage; }
@@ -0,0 +1,152 @@
+#pragma once
+
+/*******************************************************************************************************************
+	Clock.h, Clock.cpp
+	Created by Kim Kane
+	Last updated: 19/10/2026
+
+	Where the engine gets its time from, so timing works the same on Windows and in the Linux benchmarks.
+
+	A Clock gives the time in seconds from a steady clock (one that never jumps when the system time changes),
+	how much CPU time the process and the calling thread have used, and waits until a given time. SystemClock
+	is the real one - the performance counter on Windows and clock_gettime() everywhere else. FakeClock only
+	moves when it's told to, so anything timed by a Clock (the game loop, the trackers) can be tested exactly
+	and without waiting.
+
+	SystemClock::GetTicks() is the raw counter behind it, for timing that has to be as cheap as possible (the
+	profiler) - GetTicksPerSecond() turns ticks in to seconds.
+
+	CpuMonitor samples how busy each core is, and all of them together, between one Sample() and the next -
+	from the PDH processor counters on Windows and /proc/stat on Linux.
+
+*******************************************************************************************************************/
+#if defined(_WIN32)
+	#pragma comment(lib, "pdh.lib")
+	#pragma comment(lib, "winmm.lib")
+
+	#include <Windows.h>
+	#include <pdh.h>
+#else
+	#include <time.h>
+#endif
+
+#include <string>
+#include <vector>
+
+//-------------------------------------------- Where time comes from - all times are in seconds
+class Clock {
+
+public:
+	virtual ~Clock() {}
+
+public:
+	virtual double GetTime() = 0;
+	virtual double GetProcessTime() = 0;
+	virtual double GetThreadTime() = 0;
+	virtual void WaitUntil(double time) = 0;
+};
+
+//-------------------------------------------- The real clock
+class SystemClock : public Clock {
+
+public:
+	SystemClock();
+	virtual ~SystemClock();
+
+public:
+	virtual double GetTime();
+	virtual double GetProcessTime();
+	virtual double GetThreadTime();
+	virtual void WaitUntil(double time);
+
+public:
+#if defined(_WIN32)
+	static long long GetTicks()				{ LARGE_INTEGER counter; QueryPerformanceCounter(&counter); return counter.QuadPart; }
+	static long long GetTicksPerSecond()	{ LARGE_INTEGER frequency; QueryPerformanceFrequency(&frequency); return frequency.QuadPart; }
+#else
+	static long long GetTicks()				{ timespec now; clock_gettime(CLOCK_MONOTONIC, &now); return now.tv_sec * 1000000000LL + now.tv_nsec; }
+	static long long GetTicksPerSecond()	{ return 1000000000LL; }
+#endif
+
+private:
+	SystemClock(const SystemClock&);
+	SystemClock& operator=(const SystemClock&);
+
+private:
+	double			m_secondsPerTick;
+	bool			m_timerPeriodSet;
+};
+
+//-------------------------------------------- A clock that only moves when it's told to - waiting moves it straight to the time waited for
+class FakeClock : public Clock {
+
+public:
+	FakeClock();
+	virtual ~FakeClock();
+
+public:
+	virtual double GetTime();
+	virtual double GetProcessTime();
+	virtual double GetThreadTime();
+	virtual void WaitUntil(double time);
+
+public:
+	void Advance(double seconds, double cpuSeconds = 0.0);
+	void SetTime(double time);
+
+private:
+	FakeClock(const FakeClock&);
+	FakeClock& operator=(const FakeClock&);
+
+private:
+	double			m_time;
+	double			m_cpuTime;
+};
+
+//-------------------------------------------- How busy each core has been between the last two samples, from 0 to 100
+class CpuMonitor {
+
+public:
+	CpuMonitor();
+	~CpuMonitor();
+
+public:
+#if defined(_WIN32)
+	bool Initialize();
+#else
+	bool Initialize(const std::string& statFile = "/proc/stat");
+#endif
+	bool Sample();
+	void Shutdown();
+
+public:
+	unsigned int GetCoreCount() const;
+	float GetCoreUsage(unsigned int core) const;
+	float GetTotalUsage() const;
+
+private:
+	CpuMonitor(const CpuMonitor&);
+	CpuMonitor& operator=(const CpuMonitor&);
+
+private:
+	std::vector<float>		m_coreUsage;
+	float					m_totalUsage;
+	bool					m_isReady;
+
+#if defined(_WIN32)
+	HQUERY					m_query;
+	HCOUNTER				m_cores;
+	HCOUNTER				m_total;
+	std::vector<BYTE>		m_counterBuffer;
+#else
+	//-------------------------------------------- Each line's busy and total time the last time it was read - the whole machine first, then each core
+	struct CoreTimes
+	{
+		unsigned long long	busy;
+		unsigned long long	total;
+	};
+
+	std::string				m_statFile;
+	std::vector<CoreTimes>	m_lastTimes;
+#endif
+};
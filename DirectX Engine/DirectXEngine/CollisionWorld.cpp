@@ -0,0 +1,415 @@
+#include <algorithm>
+#include <cmath>
+
+#include "CollisionWorld.h"
+#include "Constants.h"
+
+/*******************************************************************************************************************
+	Constructor with initializer list to set all default values of variables
+*******************************************************************************************************************/
+CollisionWorld::CollisionWorld()	:	m_count(0)
+{
+	m_buckets.resize(CollisionConstants::MinBuckets);
+}
+
+
+/*******************************************************************************************************************
+	Function that creates a sphere collider, centred at an offset from the transform's position
+*******************************************************************************************************************/
+Collider CollisionWorld::CreateSphere(TransformHandle transform, const XMFLOAT3& center, float radius)
+{
+	return Create(transform, COLLIDER_SPHERE, center, XMFLOAT3(radius, radius, radius));
+}
+
+
+/*******************************************************************************************************************
+	Function that creates an axis aligned box collider, centred at an offset from the transform's position
+*******************************************************************************************************************/
+Collider CollisionWorld::CreateBox(TransformHandle transform, const XMFLOAT3& center, const XMFLOAT3& halfExtents)
+{
+	return Create(transform, COLLIDER_BOX, center, halfExtents);
+}
+
+
+/*******************************************************************************************************************
+	Function that creates a collider - it's binned in to the grid on the next update
+*******************************************************************************************************************/
+Collider CollisionWorld::Create(TransformHandle transform, ColliderShape shape, const XMFLOAT3& center, const XMFLOAT3& extents)
+{
+	Collider collider = m_count;
+
+	//-------------------------------------------- Reuse a released slot if there is one, otherwise take the next one on the end
+	if (!m_freeColliders.empty()) {
+		collider = m_freeColliders.back();
+		m_freeColliders.pop_back();
+	}
+	else {
+		m_transforms.push_back(INVALID_TRANSFORM);
+		m_shapes.push_back(shape);
+		m_centers.push_back(center);
+		m_extents.push_back(extents);
+		m_minimum.push_back(center);
+		m_maximum.push_back(center);
+		m_cells.push_back(CellRange());
+
+		m_count++;
+	}
+
+	CellRange empty = { 0, 0, -1, -1 };
+
+	m_transforms[collider]	= transform;
+	m_shapes[collider]		= shape;
+	m_centers[collider]		= center;
+	m_extents[collider]		= extents;
+	m_cells[collider]		= empty;
+
+	//-------------------------------------------- Keep buckets at no more than half full on average, so most cells get a bucket to themselves
+	if (GetCount() * 2 > m_buckets.size()) { Rehash((unsigned int)m_buckets.size() * 2); }
+
+	return collider;
+}
+
+
+/*******************************************************************************************************************
+	Function that takes a collider out of the grid and hands its slot back to be reused
+*******************************************************************************************************************/
+void CollisionWorld::Release(Collider collider)
+{
+	if (collider >= m_count || m_transforms[collider] == INVALID_TRANSFORM) { return; }
+
+	RemoveFromCells(collider, m_cells[collider]);
+
+	m_transforms[collider] = INVALID_TRANSFORM;
+	m_freeColliders.push_back(collider);
+}
+
+
+/*******************************************************************************************************************
+	Function that bins every collider where its transform now is, then finds everything that's touching
+*******************************************************************************************************************/
+void CollisionWorld::Update()
+{
+	Bin();
+	FindPairs();
+	FindContacts();
+}
+
+
+/*******************************************************************************************************************
+	Function that refreshes every collider's bounds, and moves the ones that have changed cells
+*******************************************************************************************************************/
+void CollisionWorld::Bin()
+{
+	TransformManager* transforms = Transforms::Instance();
+
+	for (Collider collider = 0; collider < m_count; collider++) {
+		if (m_transforms[collider] == INVALID_TRANSFORM) { continue; }
+
+		XMFLOAT3 position		= transforms->GetPosition(m_transforms[collider]);
+		const XMFLOAT3& center	= m_centers[collider];
+		const XMFLOAT3& extents	= m_extents[collider];
+
+		m_minimum[collider] = XMFLOAT3(position.x + center.x - extents.x, position.y + center.y - extents.y, position.z + center.z - extents.z);
+		m_maximum[collider] = XMFLOAT3(position.x + center.x + extents.x, position.y + center.y + extents.y, position.z + center.z + extents.z);
+
+		//-------------------------------------------- Most colliders stay in the same cells from one frame to the next, and then there's nothing to do
+		CellRange range		= GetCellRange(m_minimum[collider], m_maximum[collider]);
+		CellRange& current	= m_cells[collider];
+
+		if (range.minX == current.minX && range.minZ == current.minZ && range.maxX == current.maxX && range.maxZ == current.maxZ) { continue; }
+
+		RemoveFromCells(collider, current);
+		AddToCells(collider, range);
+		current = range;
+	}
+}
+
+
+/*******************************************************************************************************************
+	Function that finds every pair of colliders sharing a cell whose bounds overlap
+*******************************************************************************************************************/
+void CollisionWorld::FindPairs()
+{
+	m_pairs.clear();
+
+	for (unsigned int bucket = 0; bucket < m_buckets.size(); bucket++) {
+		const std::vector<CellEntry>& entries = m_buckets[bucket];
+
+		for (unsigned int i = 0; i < entries.size(); i++) {
+			for (unsigned int j = i + 1; j < entries.size(); j++) {
+
+				//-------------------------------------------- Different cells that happen to hash to the same bucket
+				if (entries[i].cellX != entries[j].cellX || entries[i].cellZ != entries[j].cellZ) { continue; }
+
+				Collider first	= (std::min)(entries[i].collider, entries[j].collider);
+				Collider second	= (std::max)(entries[i].collider, entries[j].collider);
+
+				if (!Overlaps(first, second)) { continue; }
+
+				//-------------------------------------------- Overlapping colliders may share several cells - only report the pair from the lowest one they share
+				int ownerX = (std::max)(m_cells[first].minX, m_cells[second].minX);
+				int ownerZ = (std::max)(m_cells[first].minZ, m_cells[second].minZ);
+
+				if (ownerX != entries[i].cellX || ownerZ != entries[i].cellZ) { continue; }
+
+				ColliderPair pair = { first, second };
+				m_pairs.push_back(pair);
+			}
+		}
+	}
+}
+
+
+/*******************************************************************************************************************
+	Function that tests every candidate pair exactly and keeps the ones that touch
+*******************************************************************************************************************/
+void CollisionWorld::FindContacts()
+{
+	m_contacts.clear();
+
+	for (unsigned int i = 0; i < m_pairs.size(); i++) {
+		Collider first	= m_pairs[i].first;
+		Collider second	= m_pairs[i].second;
+
+		Contact contact;
+		bool touching = false;
+
+		if (m_shapes[first] == COLLIDER_SPHERE && m_shapes[second] == COLLIDER_SPHERE) {
+			touching = SphereSphere(first, second, contact);
+		}
+		else if (m_shapes[first] == COLLIDER_BOX && m_shapes[second] == COLLIDER_BOX) {
+			touching = BoxBox(first, second, contact);
+		}
+		else if (m_shapes[first] == COLLIDER_SPHERE) {
+			touching = SphereBox(first, second, contact);
+		}
+		else {
+			//-------------------------------------------- Test it sphere first, then turn the contact back round so first stays first
+			touching = SphereBox(second, first, contact);
+
+			contact.first		= first;
+			contact.second		= second;
+			contact.normal		= XMFLOAT3(-contact.normal.x, -contact.normal.y, -contact.normal.z);
+		}
+
+		if (touching) { m_contacts.push_back(contact); }
+	}
+}
+
+
+/*******************************************************************************************************************
+	Function that adds a collider to every cell in a range
+*******************************************************************************************************************/
+void CollisionWorld::AddToCells(Collider collider, const CellRange& range)
+{
+	for (int z = range.minZ; z <= range.maxZ; z++) {
+		for (int x = range.minX; x <= range.maxX; x++) {
+			CellEntry entry = { collider, x, z };
+			m_buckets[Hash(x, z)].push_back(entry);
+		}
+	}
+}
+
+
+/*******************************************************************************************************************
+	Function that takes a collider out of every cell in a range
+*******************************************************************************************************************/
+void CollisionWorld::RemoveFromCells(Collider collider, const CellRange& range)
+{
+	for (int z = range.minZ; z <= range.maxZ; z++) {
+		for (int x = range.minX; x <= range.maxX; x++) {
+			std::vector<CellEntry>& entries = m_buckets[Hash(x, z)];
+
+			//-------------------------------------------- Order within a bucket doesn't matter, so swap the last entry in to the gap
+			for (unsigned int i = 0; i < entries.size(); i++) {
+				if (entries[i].collider == collider && entries[i].cellX == x && entries[i].cellZ == z) {
+					entries[i] = entries.back();
+					entries.pop_back();
+					break;
+				}
+			}
+		}
+	}
+}
+
+
+/*******************************************************************************************************************
+	Function that changes the number of buckets and puts every binned collider back in to them
+*******************************************************************************************************************/
+void CollisionWorld::Rehash(unsigned int bucketCount)
+{
+	m_buckets.clear();
+	m_buckets.resize(bucketCount);
+
+	for (Collider collider = 0; collider < m_count; collider++) {
+		if (m_transforms[collider] != INVALID_TRANSFORM) { AddToCells(collider, m_cells[collider]); }
+	}
+}
+
+
+/*******************************************************************************************************************
+	Function that picks the bucket for a cell
+*******************************************************************************************************************/
+unsigned int CollisionWorld::Hash(int cellX, int cellZ) const
+{
+	//-------------------------------------------- Large primes spread neighbouring cells over the whole table
+	unsigned int hash = ((unsigned int)cellX * 73856093u) ^ ((unsigned int)cellZ * 19349663u);
+
+	return hash & ((unsigned int)m_buckets.size() - 1);
+}
+
+
+/*******************************************************************************************************************
+	Function that finds the cells covered by a pair of bounds
+*******************************************************************************************************************/
+CollisionWorld::CellRange CollisionWorld::GetCellRange(const XMFLOAT3& minimum, const XMFLOAT3& maximum) const
+{
+	float scale = 1.0f / CollisionConstants::CellSize;
+	float limit = CollisionConstants::MaxCell;
+
+	//-------------------------------------------- Clamped first, so something flung off to infinity still lands in a cell
+	CellRange range = { (int)floorf((std::max)(-limit, (std::min)(minimum.x * scale, limit))), (int)floorf((std::max)(-limit, (std::min)(minimum.z * scale, limit))),
+						(int)floorf((std::max)(-limit, (std::min)(maximum.x * scale, limit))), (int)floorf((std::max)(-limit, (std::min)(maximum.z * scale, limit))) };
+
+	return range;
+}
+
+
+/*******************************************************************************************************************
+	Function that checks whether the bounds of two colliders overlap
+*******************************************************************************************************************/
+bool CollisionWorld::Overlaps(Collider first, Collider second) const
+{
+	const XMFLOAT3& minA = m_minimum[first];	const XMFLOAT3& maxA = m_maximum[first];
+	const XMFLOAT3& minB = m_minimum[second];	const XMFLOAT3& maxB = m_maximum[second];
+
+	return	minA.x <= maxB.x && minB.x <= maxA.x &&
+			minA.y <= maxB.y && minB.y <= maxA.y &&
+			minA.z <= maxB.z && minB.z <= maxA.z;
+}
+
+
+/*******************************************************************************************************************
+	Function that tests two spheres
+*******************************************************************************************************************/
+bool CollisionWorld::SphereSphere(Collider first, Collider second, Contact& contact) const
+{
+	float radiusA = m_extents[first].x;
+	float radiusB = m_extents[second].x;
+
+	//-------------------------------------------- The centre of each sphere is the middle of its bounds
+	float x = (m_minimum[second].x + radiusB) - (m_minimum[first].x + radiusA);
+	float y = (m_minimum[second].y + radiusB) - (m_minimum[first].y + radiusA);
+	float z = (m_minimum[second].z + radiusB) - (m_minimum[first].z + radiusA);
+
+	float distanceSq	= x * x + y * y + z * z;
+	float radii			= radiusA + radiusB;
+
+	if (distanceSq > radii * radii) { return false; }
+
+	float distance = sqrtf(distanceSq);
+
+	contact.first	= first;
+	contact.second	= second;
+	contact.depth	= radii - distance;
+
+	//-------------------------------------------- Right on top of each other, so there's no direction between them - push straight up
+	contact.normal = (distance > 0.0f) ? XMFLOAT3(x / distance, y / distance, z / distance) : XMFLOAT3(0.0f, 1.0f, 0.0f);
+
+	return true;
+}
+
+
+/*******************************************************************************************************************
+	Function that tests a sphere against a box - the normal points from the sphere towards the box
+*******************************************************************************************************************/
+bool CollisionWorld::SphereBox(Collider sphere, Collider box, Contact& contact) const
+{
+	float radius = m_extents[sphere].x;
+	const XMFLOAT3& half = m_extents[box];
+
+	//-------------------------------------------- Work relative to the box's centre
+	float local[3] = {	(m_minimum[sphere].x + radius) - (m_minimum[box].x + half.x),
+						(m_minimum[sphere].y + radius) - (m_minimum[box].y + half.y),
+						(m_minimum[sphere].z + radius) - (m_minimum[box].z + half.z) };
+
+	float extents[3] = { half.x, half.y, half.z };
+	float normal[3] = { 0.0f, 0.0f, 0.0f };
+
+	//-------------------------------------------- The closest point in the box to the sphere's centre
+	float closest[3];
+	for (int axis = 0; axis < 3; axis++) { closest[axis] = (std::max)(-extents[axis], (std::min)(local[axis], extents[axis])); }
+
+	float offset[3]		= { local[0] - closest[0], local[1] - closest[1], local[2] - closest[2] };
+	float distanceSq	= offset[0] * offset[0] + offset[1] * offset[1] + offset[2] * offset[2];
+
+	if (distanceSq > radius * radius) { return false; }
+
+	if (distanceSq > 0.0f) {
+		float distance = sqrtf(distanceSq);
+
+		for (int axis = 0; axis < 3; axis++) { normal[axis] = -offset[axis] / distance; }
+		contact.depth = radius - distance;
+	}
+	else {
+		//-------------------------------------------- The centre is inside the box, so push it out through the nearest face
+		int nearest = 0;
+		for (int axis = 1; axis < 3; axis++) {
+			if (extents[axis] - fabsf(local[axis]) < extents[nearest] - fabsf(local[nearest])) { nearest = axis; }
+		}
+
+		normal[nearest] = (local[nearest] < 0.0f) ? 1.0f : -1.0f;
+		contact.depth = radius + extents[nearest] - fabsf(local[nearest]);
+	}
+
+	contact.first	= sphere;
+	contact.second	= box;
+	contact.normal	= XMFLOAT3(normal[0], normal[1], normal[2]);
+
+	return true;
+}
+
+
+/*******************************************************************************************************************
+	Function that tests two boxes - their bounds are the boxes, so they touch if the bounds overlap
+*******************************************************************************************************************/
+bool CollisionWorld::BoxBox(Collider first, Collider second, Contact& contact) const
+{
+	const XMFLOAT3& minA = m_minimum[first];	const XMFLOAT3& maxA = m_maximum[first];
+	const XMFLOAT3& minB = m_minimum[second];	const XMFLOAT3& maxB = m_maximum[second];
+
+	float overlap[3] = {	(std::min)(maxA.x, maxB.x) - (std::max)(minA.x, minB.x),
+							(std::min)(maxA.y, maxB.y) - (std::max)(minA.y, minB.y),
+							(std::min)(maxA.z, maxB.z) - (std::max)(minA.z, minB.z) };
+
+	float direction[3] = {	(minB.x + maxB.x) - (minA.x + maxA.x),
+							(minB.y + maxB.y) - (minA.y + maxA.y),
+							(minB.z + maxB.z) - (minA.z + maxA.z) };
+
+	//-------------------------------------------- Separate them along whichever axis they overlap least on
+	int axis = 0;
+	if (overlap[1] < overlap[axis]) { axis = 1; }
+	if (overlap[2] < overlap[axis]) { axis = 2; }
+
+	if (overlap[axis] < 0.0f) { return false; }
+
+	float normal[3] = { 0.0f, 0.0f, 0.0f };
+	normal[axis] = (direction[axis] < 0.0f) ? -1.0f : 1.0f;
+
+	contact.first	= first;
+	contact.second	= second;
+	contact.normal	= XMFLOAT3(normal[0], normal[1], normal[2]);
+	contact.depth	= overlap[axis];
+
+	return true;
+}
+
+
+/*******************************************************************************************************************
+	Accessor Methods
+*******************************************************************************************************************/
+const std::vector<ColliderPair>& CollisionWorld::GetPairs() const		{ return m_pairs; }
+const std::vector<Contact>& CollisionWorld::GetContacts() const			{ return m_contacts; }
+TransformHandle CollisionWorld::GetTransform(Collider collider) const	{ return m_transforms[collider]; }
+ColliderShape CollisionWorld::GetShape(Collider collider) const			{ return m_shapes[collider]; }
+unsigned int CollisionWorld::GetCount() const							{ return m_count - (unsigned int)m_freeColliders.size(); }
@@ -0,0 +1,139 @@
+#pragma once
+
+/*******************************************************************************************************************
+	CollisionWorld.h, CollisionWorld.cpp
+	Created by Kim Kane
+	Last updated: 19/10/2026
+
+	Singleton class that finds which game objects are touching each other.
+
+	Every collider is a sphere or an axis aligned box, attached to a transform in the transform manager with an
+	offset from its position. Colliders are binned in to a uniform grid over the ground (X and Z), with cell
+	edges sitting on the terrain's grid lines. Only cells that are actually used are stored - each cell is
+	hashed in to a fixed number of buckets, so the grid is unbounded and costs nothing where there's nothing.
+
+	Update() runs in three stages:
+		- Binning: each collider's bounds are refreshed from its transform, and it's only moved between cells
+		  when the range of cells it covers has changed. Something moving within its cells costs nothing more.
+		- Broad phase: colliders sharing a cell with overlapping bounds become candidate pairs. A pair that
+		  shares several cells is only reported from one of them, so every pair is found exactly once.
+		- Narrow phase: each candidate pair is tested exactly (sphere/sphere, sphere/box, box/box), and the
+		  ones that touch become contacts, with the direction and distance to push them apart.
+
+	The work done is proportional to the number of colliders and the pairs that are close, not the square of
+	the number of colliders, as long as cells aren't packed far fuller than their size suggests.
+
+	Nothing here needs the graphics device, so it can be run and timed on its own.
+
+*******************************************************************************************************************/
+#include <d3d11.h>
+#include <xnamath.h>
+#include <vector>
+
+#include "Singleton.h"
+#include "TransformManager.h"
+
+typedef unsigned int Collider;
+
+const Collider INVALID_COLLIDER = 0xFFFFFFFF;
+
+enum ColliderShape { COLLIDER_SPHERE, COLLIDER_BOX };
+
+//-------------------------------------------- Two colliders whose bounds overlap - first is always the lower of the two
+struct ColliderPair
+{
+	Collider	first;
+	Collider	second;
+};
+
+//-------------------------------------------- Two colliders that touch - moving second along the normal by depth separates them
+struct Contact
+{
+	Collider	first;
+	Collider	second;
+	XMFLOAT3	normal;
+	float		depth;
+};
+
+class CollisionWorld {
+
+public:
+	friend class Singleton<CollisionWorld>;
+
+public:
+	Collider CreateSphere(TransformHandle transform, const XMFLOAT3& center, float radius);
+	Collider CreateBox(TransformHandle transform, const XMFLOAT3& center, const XMFLOAT3& halfExtents);
+	void Release(Collider collider);
+
+public:
+	void Update();
+
+public:
+	const std::vector<ColliderPair>& GetPairs() const;
+	const std::vector<Contact>& GetContacts() const;
+	TransformHandle GetTransform(Collider collider) const;
+	ColliderShape GetShape(Collider collider) const;
+	unsigned int GetCount() const;
+
+private:
+	//-------------------------------------------- The cells a collider covers, inclusive - empty when minX > maxX
+	struct CellRange
+	{
+		int minX, minZ;
+		int maxX, maxZ;
+	};
+
+	//-------------------------------------------- One collider in one cell - the cell is kept because different cells can share a bucket
+	struct CellEntry
+	{
+		Collider	collider;
+		int			cellX, cellZ;
+	};
+
+private:
+	Collider Create(TransformHandle transform, ColliderShape shape, const XMFLOAT3& center, const XMFLOAT3& extents);
+	void Bin();
+	void FindPairs();
+	void FindContacts();
+
+private:
+	void AddToCells(Collider collider, const CellRange& range);
+	void RemoveFromCells(Collider collider, const CellRange& range);
+	void Rehash(unsigned int bucketCount);
+	unsigned int Hash(int cellX, int cellZ) const;
+	CellRange GetCellRange(const XMFLOAT3& minimum, const XMFLOAT3& maximum) const;
+	bool Overlaps(Collider first, Collider second) const;
+
+private:
+	bool SphereSphere(Collider first, Collider second, Contact& contact) const;
+	bool SphereBox(Collider sphere, Collider box, Contact& contact) const;
+	bool BoxBox(Collider first, Collider second, Contact& contact) const;
+
+private:
+	CollisionWorld();
+	CollisionWorld(const CollisionWorld&);
+	CollisionWorld& operator=(const CollisionWorld&);
+
+private:
+	//-------------------------------------------- Extents are the radius (in x, y and z) for a sphere, or half the size for a box
+	std::vector<TransformHandle>			m_transforms;
+	std::vector<ColliderShape>				m_shapes;
+	std::vector<XMFLOAT3>					m_centers;
+	std::vector<XMFLOAT3>					m_extents;
+
+	//-------------------------------------------- Refreshed from the transforms every update
+	std::vector<XMFLOAT3>					m_minimum;
+	std::vector<XMFLOAT3>					m_maximum;
+	std::vector<CellRange>					m_cells;
+
+	//-------------------------------------------- Always a power of 2, so hashing is a mask
+	std::vector<std::vector<CellEntry>>		m_buckets;
+
+	std::vector<ColliderPair>				m_pairs;
+	std::vector<Contact>					m_contacts;
+
+	std::vector<Collider>					m_freeColliders;
+	unsigned int							m_count;
+};
+
+typedef Singleton<CollisionWorld> Collisions;
@@ -13,6 +13,19 @@
 #include <d3d11.h>
 #include <xnamath.h>
 
+namespace LogConstants {
+
+	//-------------------------------------------- Messages waiting to be written - past this they're dropped rather than making anything wait. Must be a power of 2
+	const unsigned int QueueSize		= 4096;
+	const unsigned int MaxLength		= 247;
+
+	//-------------------------------------------- How often the log thread writes out what's waiting (ms), unless an error or a filling queue wakes it sooner
+	const unsigned int FlushInterval	= 10;
+
+	const std::string LogFile			= "Log.txt";
+}
+
+
 namespace FileConstants {
 
 	const std::string LineBreak		= "-";
@@ -68,11 +81,194 @@ namespace ScreenConstants {
 }
 
 
+namespace ShaderConstants {
+
+	const std::wstring Directory		= L"Assets\\Shaders\\";
+	const std::wstring CacheDirectory	= L"Assets\\Shaders\\Cache\\";
+
+	const unsigned int ReloadInterval	= 500;
+}
+
+
+namespace FontConstants {
+
+	const std::string Directory			= "Assets\\Fonts\\";
+	const std::string HudFont			= "hud.font";
+
+	//-------------------------------------------- Settings fonts are baked with when a debug build finds one missing
+	const std::string FaceName			= "Arial";
+	const float PixelSize				= 32.0f;
+	const float DistanceRange			= 4.0f;
+	const unsigned int Supersample		= 4;
+	const unsigned int AtlasWidth		= 512;
+	const unsigned char FirstCharacter	= 32;
+	const unsigned char LastCharacter	= 126;
+}
+
+
 namespace GraphicConstants {
 
 	enum GraphicSettings {
 		BUFFER_SIZE		= 128
 	};
+
+	enum RenderThreadSettings {
+		MAX_RENDER_THREADS		= 4,
+		MIN_COMMANDS_PER_THREAD	= 32
+	};
+
+	//-------------------------------------------- Each draw's copied data starts on a multiple of this, so it can be read back as whatever struct it was copied from
+	enum RenderQueueSettings {
+		COMMAND_DATA_ALIGNMENT	= 16
+	};
+}
+
+
+namespace CollisionConstants {
+
+	//-------------------------------------------- A whole number of terrain squares, so cell edges sit on the terrain's grid lines
+	const float CellSize				= 8.0f;
+	const unsigned int MinBuckets		= 1024;
+	const float MaxCell					= 1000000.0f;
+}
+
+
+namespace PhysicsConstants {
+
+	const float TimeStep				= 1.0f / 60.0f;
+	const unsigned int MaxStepsPerFrame	= 5;
+
+	const unsigned int SolverIterations	= 4;
+	const float ContactSlop				= 0.01f;
+
+	//-------------------------------------------- How much work each thread is handed at a time - enough to be worth the hand over
+	const unsigned int IntegrateBlockSize	= 1024;
+	const unsigned int IslandBatchSize		= 64;
+}
+
+
+namespace BenchmarkConstants {
+
+	//-------------------------------------------- Object counts each benchmark is run at
+	const unsigned int CollisionCounts[]	= { 1000, 5000, 10000, 20000, 50000 };
+	const unsigned int PhysicsCounts[]		= { 1000, 10000, 50000 };
+
+	//-------------------------------------------- Updates run before timing starts (so every cell and pair list has grown), then updates timed
+	const unsigned int WarmUpFrames			= 10;
+	const unsigned int CollisionFrames		= 120;
+	const unsigned int PhysicsSteps			= 60;
+
+	//-------------------------------------------- Spheres are spread over a square this much larger than their count, moving up to this far per frame
+	const float SphereRadius				= 0.5f;
+	const float CollisionSpacing			= 4.0f;
+	const float CollisionSpeed				= 0.5f;
+
+	//-------------------------------------------- Bodies are packed closer, so they pile in to islands - every so many is linked to the next one as well
+	const float PhysicsSpacing				= 1.2f;
+	const float PhysicsSpeed				= 2.0f;
+	const unsigned int LinkEvery			= 50;
+
+	//-------------------------------------------- A skeleton as big as the palette allows, a clip of random poses, and the vertices skinned each run
+	const unsigned int SkinningJoints		= 64;
+	const unsigned int SkinningFrames		= 60;
+	const float SkinningFrameRate			= 30.0f;
+	const unsigned int SkinningVertices		= 100000;
+	const unsigned int SkinningRuns			= 20;
+
+	//-------------------------------------------- How far each result may be from exact - a rotation in radians, a translation as a share of the clip's box (one 16 bit step)
+	const float PaletteTolerance			= 0.0001f;
+	const float RotationTolerance			= 0.0001f;
+	const float TranslationTolerance		= 1.0f / 65535.0f;
+	const float SkinningTolerance			= 0.001f;
+
+	//-------------------------------------------- Draws submitted to the render queue in a random order, spread over this many shaders and textures and this far in front of the camera
+	const unsigned int RenderCommands		= 10000;
+	const unsigned int RenderShaders		= 8;
+	const unsigned int RenderTextures		= 32;
+	const float RenderDistance				= 100.0f;
+
+	const unsigned int Seed					= 12345;
+}
+
+
+namespace ClockConstants {
+
+	//-------------------------------------------- How long before the time being waited for to stop sleeping and spin - sleeps can wake up late
+	const double SpinTime				= 0.002;
+}
+
+
+namespace LoopConstants {
+
+	//-------------------------------------------- Game states update at the same rate physics steps, so each update is exactly one physics step
+	const float TimeStep				= PhysicsConstants::TimeStep;
+	const unsigned int MaxStepsPerFrame	= 5;
+
+	//-------------------------------------------- Frames per second when vsync is off (0 for no cap)
+	const float FrameCap				= 240.0f;
+}
+
+
+namespace PipelineConstants {
+
+	//-------------------------------------------- One being drawn, one waiting to be drawn and one being filled - so the update is never more than 2 frames ahead
+	const unsigned int SnapshotCount	= 3;
+	const unsigned int MaxSnapshots		= 4;
+
+	//-------------------------------------------- How long the game loop waits for a free snapshot before going round again to handle windows messages (ms)
+	const unsigned int SnapshotWait		= 1;
+}
+
+
+namespace TrackerConstants {
+
+	//-------------------------------------------- How many of the latest frame times are kept for the frame statistics - about 17 seconds at 60fps
+	const unsigned int FrameHistory		= 1024;
+
+	//-------------------------------------------- The histogram's buckets are this wide (ms) - anything past the last bucket goes in the last bucket
+	const unsigned int HistogramBuckets	= 20;
+	const float BucketWidth				= 2.5f;
+
+	const std::string FrameTimesFile	= "FrameTimes.csv";
+}
+
+
+namespace ProfilerConstants {
+
+	//-------------------------------------------- Zones each thread can record between two frames before the oldest unread ones are dropped - must be a power of 2
+	const unsigned int EventBufferSize	= 16384;
+
+	//-------------------------------------------- The on-screen summary is averaged over this many frames, and shows this many lines down to this depth
+	const unsigned int SummaryFrames	= 60;
+	const unsigned int SummaryLines		= 10;
+	const unsigned int SummaryDepth		= 3;
+
+	//-------------------------------------------- How many frames a capture records, and the most zones it keeps
+	const unsigned int CaptureFrames	= 120;
+	const unsigned int MaxCaptureEvents	= 1 << 20;
+	const std::string CaptureFile		= "Profile.json";
+}
+
+
+namespace EventLogConstants {
+
+	//-------------------------------------------- Bytes of events each thread can record before the log thread empties it - must be a power of 2
+	const unsigned int ThreadBufferSize	= 1 << 16;
+	const unsigned int MaxArguments		= 8;
+
+	//-------------------------------------------- How often the log thread writes out what's waiting (ms)
+	const unsigned int FlushInterval	= 50;
+
+	const std::string LogFile			= "Events.bin";
+	const std::string TextFile			= "Events.txt";
+}
+
+
+namespace SkinningConstants {
+
+	//-------------------------------------------- The bone palette is one constant buffer, so a skeleton can't have more joints than fit in it
+	const unsigned int MaxJoints		= 64;
+	const unsigned int MaxInfluences	= 4;
 }
 
 
@@ -99,4 +295,14 @@ namespace BufferConstants {
 			return memcmp((void*)this, (void*)&that, sizeof(PackedVertex))>0;
 		};
 	};
+
+	//-------------------------------------------- Up to 4 joints move each vertex - weights are 0 to 255 and add up to 255
+	struct PackedSkinnedVertex
+	{
+		XMFLOAT3		position;
+		XMFLOAT2		textureCoord;
+		XMFLOAT3		normal;
+		unsigned char	joints[4];
+		unsigned char	weights[4];
+	};
 }
\ No newline at end of file
@@ -0,0 +1,123 @@
+#include "DynamicRingBuffer.h"
+#include "GraphicsManager.h"
+#include "Log.h"
+
+/*******************************************************************************************************************
+	Constructor with initializer list to set all default values of variables
+*******************************************************************************************************************/
+DynamicRingBuffer::DynamicRingBuffer()	:	m_buffer(nullptr),
+											m_size(0),
+											m_offset(0),
+											m_needsDiscard(true),
+											m_allowNoOverwrite(false)
+{
+
+}
+
+
+/*******************************************************************************************************************
+	Shut down all necessary procedures, release resources and clean up memory
+*******************************************************************************************************************/
+DynamicRingBuffer::~DynamicRingBuffer()
+{
+	Release();
+}
+
+
+/*******************************************************************************************************************
+	Function that creates the buffer - without no-overwrite support every map discards, just like a small buffer would
+*******************************************************************************************************************/
+bool DynamicRingBuffer::Create(unsigned int size, UINT bindFlags, bool allowNoOverwrite)
+{
+	Release();
+
+	D3D11_BUFFER_DESC bufferDescription		= { 0 };
+	bufferDescription.Usage					= D3D11_USAGE_DYNAMIC;
+	bufferDescription.ByteWidth				= size;
+	bufferDescription.BindFlags				= bindFlags;
+	bufferDescription.CPUAccessFlags		= D3D11_CPU_ACCESS_WRITE;
+
+	HRESULT result = Graphics::Instance()->GetDevice()->CreateBuffer(&bufferDescription, nullptr, &m_buffer);
+	if (FAILED(result)) {
+		DX_LOG("[RING BUFFER] Problem creating dynamic ring buffer", DX_LOG_EMPTY, LOG_ERROR); return false;
+	}
+
+	m_size				= size;
+	m_allowNoOverwrite	= allowNoOverwrite;
+
+	Discard();
+
+	return true;
+}
+
+
+/*******************************************************************************************************************
+	Function that releases the buffer
+*******************************************************************************************************************/
+void DynamicRingBuffer::Release()
+{
+	if (m_buffer) { m_buffer->Release(); m_buffer = nullptr; }
+
+	m_size = 0;
+}
+
+
+/*******************************************************************************************************************
+	Function that reserves space for an upload and maps it - returns where to write, and the offset in to the buffer
+*******************************************************************************************************************/
+void* DynamicRingBuffer::Map(ID3D11DeviceContext* context, unsigned int size, unsigned int alignment, unsigned int& offset)
+{
+	if (!m_buffer || size > m_size) {
+		DX_LOG("[RING BUFFER] Upload doesn't fit in the ring buffer: ", size, LOG_ERROR); return nullptr;
+	}
+
+	if (alignment == 0) { alignment = 1; }
+
+	unsigned int alignedOffset = ((m_offset + alignment - 1) / alignment) * alignment;
+
+	//-------------------------------------------- Only discard when we have to - on wraparound, or the first map since Discard() was called
+	D3D11_MAP mapType = D3D11_MAP_WRITE_NO_OVERWRITE;
+
+	if (m_needsDiscard || !m_allowNoOverwrite || alignedOffset + size > m_size) {
+		mapType			= D3D11_MAP_WRITE_DISCARD;
+		alignedOffset	= 0;
+		m_needsDiscard	= false;
+	}
+
+	D3D11_MAPPED_SUBRESOURCE mappedResource = { 0 };
+	if (FAILED(context->Map(m_buffer, 0, mapType, 0, &mappedResource))) {
+		DX_LOG("[RING BUFFER] Problem mapping the ring buffer", DX_LOG_EMPTY, LOG_ERROR); return nullptr;
+	}
+
+	offset		= alignedOffset;
+	m_offset	= alignedOffset + size;
+
+	return (unsigned char*)mappedResource.pData + alignedOffset;
+}
+
+
+/*******************************************************************************************************************
+	Function that unmaps the buffer once the upload has been written
+*******************************************************************************************************************/
+void DynamicRingBuffer::Unmap(ID3D11DeviceContext* context)
+{
+	context->Unmap(m_buffer, 0);
+}
+
+
+/*******************************************************************************************************************
+	Function that makes the next map discard and start again from the beginning
+*******************************************************************************************************************/
+void DynamicRingBuffer::Discard()
+{
+	m_offset		= 0;
+	m_needsDiscard	= true;
+}
+
+
+/*******************************************************************************************************************
+	Accessor Methods
+*******************************************************************************************************************/
+ID3D11Buffer* DynamicRingBuffer::GetBuffer() const	{ return m_buffer; }
+unsigned int DynamicRingBuffer::GetSize() const		{ return m_size; }
+bool DynamicRingBuffer::IsCreated() const			{ return m_buffer != nullptr; }
@@ -0,0 +1,52 @@
+#pragma once
+
+/*******************************************************************************************************************
+	DynamicRingBuffer.h, DynamicRingBuffer.cpp
+	Created by Kim Kane
+	Last updated: 19/10/2026
+
+	One large dynamic buffer that small per-draw uploads are carved out of - each RenderContext keeps one for
+	its shader constants.
+
+	Each upload is written after the previous one with D3D11_MAP_WRITE_NO_OVERWRITE, promising the driver
+	we won't touch anything the GPU may still be reading. Only when the buffer is full do we map with
+	D3D11_MAP_WRITE_DISCARD and start again from the beginning - so the driver renames the buffer once per
+	wrap rather than once per upload.
+
+	Deferred contexts must discard the first time they map a buffer in each command list, so Discard()
+	is called whenever a context starts a new recording.
+
+*******************************************************************************************************************/
+#include <d3d11.h>
+
+class DynamicRingBuffer {
+
+public:
+	DynamicRingBuffer();
+	~DynamicRingBuffer();
+
+public:
+	bool Create(unsigned int size, UINT bindFlags, bool allowNoOverwrite);
+	void Release();
+
+public:
+	void* Map(ID3D11DeviceContext* context, unsigned int size, unsigned int alignment, unsigned int& offset);
+	void Unmap(ID3D11DeviceContext* context);
+	void Discard();
+
+public:
+	ID3D11Buffer* GetBuffer() const;
+	unsigned int GetSize() const;
+	bool IsCreated() const;
+
+private:
+	DynamicRingBuffer(const DynamicRingBuffer&);
+	DynamicRingBuffer& operator=(const DynamicRingBuffer&);
+
+private:
+	ID3D11Buffer*	m_buffer;
+	unsigned int	m_size;
+	unsigned int	m_offset;
+	bool			m_needsDiscard;
+	bool			m_allowNoOverwrite;
+};
@@ -0,0 +1,264 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+#include "EventDecoder.h"
+
+namespace {
+
+	//-------------------------------------------- Reads a value out of the file's bytes - false if it would run off the end
+	template <typename T> bool Read(const std::string& data, unsigned long long offset, T& value)
+	{
+		if (offset + sizeof(T) > data.size()) { return false; }
+
+		memcpy(&value, data.data() + offset, sizeof(T));
+		return true;
+	}
+}
+
+
+/*******************************************************************************************************************
+	Static variables initialization
+*******************************************************************************************************************/
+std::vector<EventDecoder::DecodedFormat>				EventDecoder::m_formats;
+std::unordered_map<unsigned long long, std::string>		EventDecoder::m_strings;
+
+
+/*******************************************************************************************************************
+	Function that decodes an event file, writing one line per event to the output file
+*******************************************************************************************************************/
+bool EventDecoder::Decode(const std::string& fileLocation, const std::string& outputFileLocation)
+{
+	std::ifstream file(fileLocation, std::ios::in | std::ios::binary);
+	if (!file.is_open()) { return false; }
+
+	std::stringstream contents;
+	contents << file.rdbuf();
+	std::string data = contents.str();
+
+	EventFileHeader header;
+	if (!Read(data, 0, header) || header.magic != EventFormat::Magic || header.version != EventFormat::Version) { return false; }
+
+	long long ticksPerSecond	= (long long)(((unsigned long long)header.ticksPerSecondHigh << 32) | header.ticksPerSecondLow);
+	long long startTicks		= (long long)(((unsigned long long)header.startTicksHigh << 32) | header.startTicksLow);
+
+	if (ticksPerSecond <= 0) { return false; }
+
+	m_formats.clear();
+	m_strings.clear();
+
+	std::vector<DecodedEvent> events;
+	std::vector<DecodedArgument> arguments;
+	std::string problem;
+
+	unsigned long long offset = sizeof(header);
+
+	//-------------------------------------------- Go through every record - a record cut short (the game stopped mid-write) ends the file
+	while (offset < data.size() && problem.empty()) {
+		EventRecordHeader record;
+		if (!Read(data, offset, record) || offset + sizeof(record) + record.size > data.size()) { problem = "the last record was cut short"; break; }
+
+		unsigned long long start = offset + sizeof(record);
+		unsigned long long end = start + record.size;
+		offset = end;
+
+		switch (record.type) {
+
+			case EVENT_RECORD_FORMAT: {
+				EventFormatRecord formatRecord;
+				if (!Read(data, start, formatRecord) ||
+					sizeof(formatRecord) + (unsigned long long)formatRecord.argumentCount + formatRecord.fileLength + formatRecord.formatLength > record.size) {
+					problem = "a format record is corrupt"; break;
+				}
+
+				const char* text = data.data() + start + sizeof(formatRecord);
+
+				DecodedFormat format;
+				format.types.assign(text, text + formatRecord.argumentCount);
+				format.file.assign(text + formatRecord.argumentCount, formatRecord.fileLength);
+				format.format.assign(text + formatRecord.argumentCount + formatRecord.fileLength, formatRecord.formatLength);
+				format.line = formatRecord.line;
+
+				if (formatRecord.id >= m_formats.size()) { m_formats.resize(formatRecord.id + 1); }
+				m_formats[formatRecord.id] = format;
+				break;
+			}
+
+			case EVENT_RECORD_STRING: {
+				EventStringRecord stringRecord;
+				if (!Read(data, start, stringRecord) || record.size < sizeof(stringRecord)) { problem = "a string record is corrupt"; break; }
+
+				unsigned long long address = ((unsigned long long)stringRecord.addressHigh << 32) | stringRecord.addressLow;
+				m_strings[address].assign(data.data() + start + sizeof(stringRecord), record.size - sizeof(stringRecord));
+				break;
+			}
+
+			case EVENT_RECORD_BLOCK: {
+				EventBlockRecord block;
+				if (!Read(data, start, block)) { problem = "a block record is corrupt"; break; }
+
+				//-------------------------------------------- Each event's size comes from its format, so a bad id means the rest of the block can't be read
+				for (unsigned long long position = start + sizeof(block); position < end && problem.empty();) {
+					unsigned int id;
+					long long ticks;
+
+					if (!Read(data, position, id) || !Read(data, position + sizeof(id), ticks) || id >= m_formats.size()) { problem = "an event is corrupt"; break; }
+					position += EventFormat::EventHeaderSize;
+
+					const DecodedFormat& format = m_formats[id];
+					arguments.clear();
+
+					for (unsigned int i = 0; i < format.types.size(); i++) {
+						DecodedArgument argument = { format.types[i], 0, 0, 0.0 };
+
+						switch (argument.type) {
+							case EVENT_INT:		{ int value = 0;			Read(data, position, value); argument.integer = value; argument.unsignedInteger = (unsigned int)value; argument.real = value; break; }
+							case EVENT_UINT:	{ unsigned int value = 0;	Read(data, position, value); argument.integer = value; argument.unsignedInteger = value; argument.real = value; break; }
+							case EVENT_INT64:	{ long long value = 0;		Read(data, position, value); argument.integer = value; argument.unsignedInteger = value; argument.real = (double)value; break; }
+							case EVENT_FLOAT:	{ float value = 0.0f;		Read(data, position, value); argument.integer = (long long)value; argument.unsignedInteger = (unsigned long long)argument.integer; argument.real = value; break; }
+							case EVENT_DOUBLE:	{ double value = 0.0;		Read(data, position, value); argument.integer = (long long)value; argument.unsignedInteger = (unsigned long long)argument.integer; argument.real = value; break; }
+							default:			{ unsigned long long value = 0; Read(data, position, value); argument.integer = (long long)value; argument.unsignedInteger = value; argument.real = (double)value; break; }
+						}
+
+						position += EventArgumentSize(argument.type);
+						arguments.push_back(argument);
+					}
+
+					if (position > end) { problem = "an event runs past the end of its block"; break; }
+
+					DecodedEvent event = { ticks, block.thread, Format(format.format, arguments) };
+					events.push_back(event);
+				}
+				break;
+			}
+
+			case EVENT_RECORD_DROPPED: {
+				EventDroppedRecord dropped;
+				if (!Read(data, start, dropped)) { problem = "a dropped record is corrupt"; break; }
+
+				char text[64];
+				snprintf(text, sizeof(text), "[EVENT LOG] %u events were dropped - the buffer was full", dropped.count);
+
+				//-------------------------------------------- Put it just after the last event read from that thread
+				long long ticks = startTicks;
+				for (unsigned int i = (unsigned int)events.size(); i > 0; i--) {
+					if (events[i - 1].thread == dropped.thread) { ticks = events[i - 1].ticks; break; }
+				}
+
+				DecodedEvent event = { ticks, dropped.thread, text };
+				events.push_back(event);
+				break;
+			}
+
+			//-------------------------------------------- A record this version doesn't know about - its size says how far to skip
+			default: { break; }
+		}
+	}
+
+	//-------------------------------------------- Blocks are written a thread at a time, so sort the events back in to the order they happened - events on the same tick stay in the order they were read
+	std::vector<std::pair<long long, unsigned int>> order(events.size());
+
+	for (unsigned int i = 0; i < events.size(); i++) { order[i] = std::make_pair(events[i].ticks, i); }
+	std::sort(order.begin(), order.end());
+
+	FILE* output = fopen(outputFileLocation.c_str(), "w");
+	if (!output) { return false; }
+
+	for (unsigned int i = 0; i < order.size(); i++) {
+		const DecodedEvent& event = events[order[i].second];
+		double time = (double)(event.ticks - startTicks) * 1000.0 / (double)ticksPerSecond;
+
+		fprintf(output, "%12.3f  [%2u]  %s\n", time, event.thread, event.text.c_str());
+	}
+
+	if (!problem.empty()) { fprintf(output, "[EVENT LOG] Stopped reading - %s\n", problem.c_str()); }
+
+	fclose(output);
+
+	return true;
+}
+
+
+/*******************************************************************************************************************
+	Function that formats one event - each printf specifier in the format string is given the next argument
+*******************************************************************************************************************/
+std::string EventDecoder::Format(const std::string& format, const std::vector<DecodedArgument>& arguments)
+{
+	std::string text;
+	unsigned int next = 0;
+
+	for (size_t i = 0; i < format.size(); i++) {
+		if (format[i] != '%') { text += format[i]; continue; }
+		if (i + 1 < format.size() && format[i + 1] == '%') { text += '%'; i++; continue; }
+
+		//-------------------------------------------- Keep the flags, width and precision, but not the length (h, l, ll...) - the argument's own type decides that
+		std::string specifier = "%";
+		size_t letter = i + 1;
+
+		while (letter < format.size() && strchr("-+ #0123456789.", format[letter])) { specifier += format[letter++]; }
+		while (letter < format.size() && strchr("hlLqjzt", format[letter])) { letter++; }
+
+		if (letter >= format.size()) { text += format.substr(i); break; }
+
+		char conversion = format[letter];
+		i = letter;
+
+		if (next >= arguments.size()) { text += specifier + conversion; continue; }
+
+		text += FormatArgument(specifier, conversion, arguments[next++]);
+	}
+
+	return text;
+}
+
+
+/*******************************************************************************************************************
+	Function that formats one argument with its specifier, as whichever kind of value the specifier asks for
+*******************************************************************************************************************/
+std::string EventDecoder::FormatArgument(const std::string& specifier, char conversion, const DecodedArgument& argument)
+{
+	char text[512];
+
+	switch (conversion) {
+
+		case 'd': case 'i':
+			snprintf(text, sizeof(text), (specifier + "lld").c_str(), argument.integer); break;
+
+		case 'u': case 'x': case 'X': case 'o':
+			snprintf(text, sizeof(text), (specifier + "ll" + conversion).c_str(), argument.unsignedInteger); break;
+
+		case 'c':
+			snprintf(text, sizeof(text), (specifier + "c").c_str(), (int)argument.integer); break;
+
+		case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+			snprintf(text, sizeof(text), (specifier + conversion).c_str(), argument.real); break;
+
+		case 'p':
+			snprintf(text, sizeof(text), "0x%llx", argument.unsignedInteger); break;
+
+		case 's':
+			if (argument.type == EVENT_STRING)	{ snprintf(text, sizeof(text), (specifier + "s").c_str(), FindString(argument.unsignedInteger).c_str()); }
+			else								{ snprintf(text, sizeof(text), "%lld", argument.integer); }
+			break;
+
+		default:
+			return specifier + conversion;
+	}
+
+	return text;
+}
+
+
+/*******************************************************************************************************************
+	Function that gets the text of a string argument from its address
+*******************************************************************************************************************/
+std::string EventDecoder::FindString(unsigned long long address)
+{
+	if (address == 0) { return "(null)"; }
+
+	std::unordered_map<unsigned long long, std::string>::const_iterator string = m_strings.find(address);
+
+	return (string != m_strings.end()) ? string->second : "(unknown string)";
+}
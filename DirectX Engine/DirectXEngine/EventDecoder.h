@@ -0,0 +1,67 @@
+#pragma once
+
+/*******************************************************************************************************************
+	EventDecoder.h, EventDecoder.cpp
+	Created by Kim Kane
+	Last updated: 19/10/2026
+
+	Offline tool that turns an event file written by EventLog (see EventFormat.h) back in to text.
+
+	Every event is formatted with its call site's format string and its recorded arguments, then all the
+	events are put in the order they happened (threads' blocks are written out separately, so the file isn't
+	in order) and written one per line - the time in milliseconds from when logging started, the thread,
+	then the text. Dropped events are reported where they were found.
+
+	Any build can decode an event file without starting the game - run it with -decode, optionally followed by
+	the event file and the text file to write (Events.bin and Events.txt by default). Debug builds also decode
+	the event file when the game shuts down.
+
+*******************************************************************************************************************/
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "EventFormat.h"
+
+class EventDecoder {
+
+public:
+	static bool Decode(const std::string& fileLocation, const std::string& outputFileLocation);
+
+private:
+	EventDecoder();
+
+private:
+	struct DecodedFormat
+	{
+		std::string					format;
+		std::string					file;
+		unsigned int				line;
+		std::vector<unsigned char>	types;
+	};
+
+	struct DecodedEvent
+	{
+		long long		ticks;
+		unsigned int	thread;
+		std::string		text;
+	};
+
+	//-------------------------------------------- One recorded argument, read as every kind of number so any format can use it
+	struct DecodedArgument
+	{
+		unsigned int		type;
+		long long			integer;
+		unsigned long long	unsignedInteger;
+		double				real;
+	};
+
+private:
+	static std::string Format(const std::string& format, const std::vector<DecodedArgument>& arguments);
+	static std::string FormatArgument(const std::string& specifier, char conversion, const DecodedArgument& argument);
+	static std::string FindString(unsigned long long address);
+
+private:
+	static std::vector<DecodedFormat>							m_formats;
+	static std::unordered_map<unsigned long long, std::string>	m_strings;
+};
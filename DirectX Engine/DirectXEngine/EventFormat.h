@@ -0,0 +1,91 @@
+#pragma once
+
+/*******************************************************************************************************************
+	EventFormat.h
+	Created by Kim Kane
+	Last updated: 19/10/2026
+
+	The layout of an event log file, written by EventLog and turned back in to text by EventDecoder.
+
+	The file is a header followed by records, each starting with its type and how many bytes follow it:
+		- A format record describes one DX_EVENT call site - its format string, where it is, and the type of
+		  each argument. It's written before the first event that uses it.
+		- A string record gives the text of a string argument, the first time that string is seen. Events
+		  only hold the string's address, so strings are written once however many events use them.
+		- A block record is a run of events from one thread, copied straight from that thread's buffer. Each
+		  event is its format id and the tick it happened on, then its arguments packed one after another -
+		  how many bytes that is comes from the event's format.
+		- A dropped record says how many events a thread lost because its buffer was full.
+
+	Record header fields are all 4 bytes, so the headers have no padding and the layout is the same in every
+	build. Events themselves are packed with no padding at all, and are copied in and out with memcpy.
+
+	Nothing in here depends on the rest of the engine, so the decoder can be built on its own.
+
+*******************************************************************************************************************/
+
+namespace EventFormat {
+
+	const unsigned int Magic		= 0x56455844;	// "DXEV"
+	const unsigned int Version		= 1;
+
+	//-------------------------------------------- Each event starts with its format id (4 bytes) and its tick (8 bytes)
+	const unsigned int EventHeaderSize	= 12;
+}
+
+enum EventRecordType	{ EVENT_RECORD_FORMAT, EVENT_RECORD_STRING, EVENT_RECORD_BLOCK, EVENT_RECORD_DROPPED };
+
+//-------------------------------------------- How each argument is stored - strings and pointers are both stored as addresses
+enum EventArgumentType	{ EVENT_INT, EVENT_UINT, EVENT_INT64, EVENT_UINT64, EVENT_FLOAT, EVENT_DOUBLE, EVENT_POINTER, EVENT_STRING };
+
+inline unsigned int EventArgumentSize(unsigned int type)
+{
+	return (type == EVENT_INT || type == EVENT_UINT || type == EVENT_FLOAT) ? 4 : 8;
+}
+
+struct EventFileHeader
+{
+	unsigned int	magic;
+	unsigned int	version;
+
+	//-------------------------------------------- 64 bit values are split in to their low and high halves, so the header is all 4 byte fields
+	unsigned int	ticksPerSecondLow;
+	unsigned int	ticksPerSecondHigh;
+	unsigned int	startTicksLow;
+	unsigned int	startTicksHigh;
+};
+
+struct EventRecordHeader
+{
+	unsigned int	type;
+	unsigned int	size;
+};
+
+//-------------------------------------------- Followed by one byte per argument type, then the file name and the format string (neither ends in a 0)
+struct EventFormatRecord
+{
+	unsigned int	id;
+	unsigned int	line;
+	unsigned int	argumentCount;
+	unsigned int	fileLength;
+	unsigned int	formatLength;
+};
+
+//-------------------------------------------- Followed by the string's text, to the end of the record
+struct EventStringRecord
+{
+	unsigned int	addressLow;
+	unsigned int	addressHigh;
+};
+
+//-------------------------------------------- Followed by the thread's events, to the end of the record
+struct EventBlockRecord
+{
+	unsigned int	thread;
+};
+
+struct EventDroppedRecord
+{
+	unsigned int	thread;
+	unsigned int	count;
+};
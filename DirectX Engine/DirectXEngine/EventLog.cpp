@@ -0,0 +1,346 @@
+#include "EventLog.h"
+
+#if EVENT_MODE == 1
+
+#include <algorithm>
+#include <chrono>
+
+#include "Log.h"
+
+namespace {
+
+	//-------------------------------------------- Each thread's buffer, found the first time the thread records an event
+	thread_local EventThread* t_thread = nullptr;
+
+	const unsigned int BufferMask = EventLogConstants::ThreadBufferSize - 1;
+
+	static_assert((EventLogConstants::ThreadBufferSize & BufferMask) == 0, "The event buffer size must be a power of 2");
+
+	//-------------------------------------------- Counts the arguments a printf format string asks for
+	unsigned int CountArguments(const char* format)
+	{
+		unsigned int count = 0;
+
+		for (const char* letter = format; *letter; letter++) {
+			if (*letter != '%') { continue; }
+			if (*(letter + 1) == '%') { letter++; continue; }
+
+			count++;
+		}
+
+		return count;
+	}
+}
+
+
+/*******************************************************************************************************************
+	Static variables initialization
+*******************************************************************************************************************/
+std::atomic<bool>							EventLog::m_isRunning(false);
+std::mutex									EventLog::m_mutex;
+std::vector<std::unique_ptr<EventThread>>	EventLog::m_threads;
+std::vector<EventLog::EventFormatInfo>		EventLog::m_formats;
+std::thread									EventLog::m_thread;
+std::condition_variable						EventLog::m_condition;
+bool										EventLog::m_isClosing = false;
+FILE*										EventLog::m_file = nullptr;
+std::vector<EventLog::EventFormatInfo>		EventLog::m_writtenFormats;
+std::vector<EventThread*>					EventLog::m_writeThreads;
+std::unordered_set<unsigned long long>		EventLog::m_writtenStrings;
+std::vector<unsigned char>					EventLog::m_events;
+
+
+/*******************************************************************************************************************
+	Constructor with initializer list to set all default values of variables
+*******************************************************************************************************************/
+EventThread::EventThread(unsigned int id)	:	id(id),
+												dropped(0),
+												m_head(0),
+												m_tail(0)
+{
+}
+
+
+/*******************************************************************************************************************
+	Function that adds an event to the buffer - only ever called by the thread that owns it
+*******************************************************************************************************************/
+void EventThread::Push(const unsigned char* event, unsigned int size)
+{
+	unsigned int head = m_head.load(std::memory_order_relaxed);
+
+	//-------------------------------------------- Not enough room - the log thread hasn't caught up, so this event is lost rather than waiting on it
+	if (size > EventLogConstants::ThreadBufferSize - (head - m_tail.load(std::memory_order_acquire))) {
+		dropped.fetch_add(1, std::memory_order_relaxed); return;
+	}
+
+	//-------------------------------------------- The event may run off the end of the buffer, in which case the rest goes at the start
+	unsigned int start = head & BufferMask;
+	unsigned int first = (std::min)(size, EventLogConstants::ThreadBufferSize - start);
+
+	memcpy(m_events + start, event, first);
+	memcpy(m_events, event + first, size - first);
+
+	//-------------------------------------------- Released after the event is written, so the log thread never reads half an event
+	m_head.store(head + size, std::memory_order_release);
+}
+
+
+/*******************************************************************************************************************
+	Function that moves every event in the buffer on to the end of a list - only ever called by the log thread
+*******************************************************************************************************************/
+void EventThread::Pop(std::vector<unsigned char>& events)
+{
+	unsigned int tail = m_tail.load(std::memory_order_relaxed);
+	unsigned int head = m_head.load(std::memory_order_acquire);
+
+	unsigned int size = head - tail;
+	unsigned int start = tail & BufferMask;
+	unsigned int first = (std::min)(size, EventLogConstants::ThreadBufferSize - start);
+
+	events.insert(events.end(), m_events + start, m_events + start + first);
+	events.insert(events.end(), m_events, m_events + (size - first));
+
+	//-------------------------------------------- Released after the events are copied, so the owning thread can't write over them first
+	m_tail.store(head, std::memory_order_release);
+}
+
+
+/*******************************************************************************************************************
+	Function that opens the event file and starts the log thread - events are recorded from now on
+*******************************************************************************************************************/
+bool EventLog::Initialize(const std::string& fileLocation)
+{
+	if (m_isRunning) { return true; }
+
+	m_file = fopen(fileLocation.c_str(), "wb");
+	if (!m_file) { DX_LOG("[EVENT LOG] Couldn't open event file: ", fileLocation.c_str(), LOG_ERROR); return false; }
+
+	long long ticksPerSecond = SystemClock::GetTicksPerSecond();
+	long long startTicks = SystemClock::GetTicks();
+
+	EventFileHeader header;
+	header.magic				= EventFormat::Magic;
+	header.version				= EventFormat::Version;
+	header.ticksPerSecondLow	= (unsigned int)ticksPerSecond;
+	header.ticksPerSecondHigh	= (unsigned int)(ticksPerSecond >> 32);
+	header.startTicksLow		= (unsigned int)startTicks;
+	header.startTicksHigh		= (unsigned int)(startTicks >> 32);
+
+	fwrite(&header, sizeof(header), 1, m_file);
+
+	//-------------------------------------------- A new file knows nothing yet, so every format and string is written again
+	m_writtenFormats.clear();
+	m_writtenStrings.clear();
+
+	m_isClosing = false;
+	m_thread = std::thread(&EventLog::Run);
+	m_isRunning = true;
+
+	return true;
+}
+
+
+/*******************************************************************************************************************
+	Function that stops recording events, writes out everything still waiting and closes the event file
+*******************************************************************************************************************/
+void EventLog::Shutdown()
+{
+	if (!m_isRunning) { return; }
+
+	m_isRunning = false;
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_isClosing = true;
+	}
+
+	m_condition.notify_one();
+	m_thread.join();
+
+	fclose(m_file);
+	m_file = nullptr;
+}
+
+
+/*******************************************************************************************************************
+	Function that registers a call site's format, returning the id its events are recorded with
+*******************************************************************************************************************/
+unsigned int EventLog::Register(const char* format, const char* file, unsigned int line, const EventSignature& signature)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	if (CountArguments(format) != signature.count) {
+		DX_LOG("[EVENT LOG] An event's arguments don't match its format: ", format, LOG_WARN);
+	}
+
+	EventFormatInfo info = { format, file, line, signature };
+	m_formats.push_back(info);
+
+	return (unsigned int)m_formats.size() - 1;
+}
+
+
+/*******************************************************************************************************************
+	Function that gets the calling thread's buffer, making one the first time
+*******************************************************************************************************************/
+EventThread* EventLog::GetThread()
+{
+	if (!t_thread) { t_thread = RegisterThread(); }
+	return t_thread;
+}
+
+
+/*******************************************************************************************************************
+	Function that makes a buffer for a new thread - buffers are kept until the program ends, as threads never say when they've gone
+*******************************************************************************************************************/
+EventThread* EventLog::RegisterThread()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	m_threads.push_back(std::unique_ptr<EventThread>(new EventThread((unsigned int)m_threads.size())));
+
+	return m_threads.back().get();
+}
+
+
+/*******************************************************************************************************************
+	Function that the log thread runs - writes out what's waiting every FlushInterval, then once more when closing
+*******************************************************************************************************************/
+void EventLog::Run()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+
+	while (!m_isClosing) {
+		m_condition.wait_for(lock, std::chrono::milliseconds(EventLogConstants::FlushInterval), [] { return m_isClosing; });
+
+		lock.unlock();
+		WriteWaiting();
+		lock.lock();
+	}
+}
+
+
+/*******************************************************************************************************************
+	Function that writes out each thread's events as a block, with any formats and strings they need first
+*******************************************************************************************************************/
+void EventLog::WriteWaiting()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		m_writeThreads.clear();
+
+		for (unsigned int i = 0; i < m_threads.size(); i++) {
+			m_writeThreads.push_back(m_threads[i].get());
+		}
+	}
+
+	for (unsigned int i = 0; i < m_writeThreads.size(); i++) {
+		EventThread* thread = m_writeThreads[i];
+
+		m_events.clear();
+		thread->Pop(m_events);
+
+		//-------------------------------------------- After the pop, so every format these events were recorded with has been registered
+		WriteFormats();
+
+		if (!m_events.empty()) {
+			WriteStrings(m_events);
+
+			EventBlockRecord block = { thread->id };
+			WriteRecord(EVENT_RECORD_BLOCK, &block, sizeof(block), &m_events[0], (unsigned int)m_events.size());
+		}
+
+		unsigned int dropped = thread->dropped.exchange(0, std::memory_order_relaxed);
+
+		if (dropped > 0) {
+			EventDroppedRecord record = { thread->id, dropped };
+			WriteRecord(EVENT_RECORD_DROPPED, &record, sizeof(record));
+		}
+	}
+
+	fflush(m_file);
+}
+
+
+/*******************************************************************************************************************
+	Function that writes a format record for every call site registered since the last time
+*******************************************************************************************************************/
+void EventLog::WriteFormats()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	for (unsigned int id = m_writtenFormats.size(); id < m_formats.size(); id++) {
+		const EventFormatInfo& info = m_formats[id];
+
+		EventFormatRecord record;
+		record.id				= id;
+		record.line				= info.line;
+		record.argumentCount	= info.signature.count;
+		record.fileLength		= strlen(info.file);
+		record.formatLength		= strlen(info.format);
+
+		//-------------------------------------------- Argument types, file name and format string all follow the record, one after another
+		std::vector<unsigned char> text(info.signature.types, info.signature.types + info.signature.count);
+		text.insert(text.end(), info.file, info.file + record.fileLength);
+		text.insert(text.end(), info.format, info.format + record.formatLength);
+
+		WriteRecord(EVENT_RECORD_FORMAT, &record, sizeof(record), &text[0], (unsigned int)text.size());
+
+		m_writtenFormats.push_back(info);
+	}
+}
+
+
+/*******************************************************************************************************************
+	Function that writes a string record for every string argument in the events that hasn't been written before
+*******************************************************************************************************************/
+void EventLog::WriteStrings(const std::vector<unsigned char>& events)
+{
+	unsigned int offset = 0;
+
+	while (offset + EventFormat::EventHeaderSize <= events.size()) {
+		unsigned int id;
+		memcpy(&id, &events[offset], sizeof(id));
+		offset += EventFormat::EventHeaderSize;
+
+		const EventSignature& signature = m_writtenFormats[id].signature;
+
+		for (unsigned int i = 0; i < signature.count; i++) {
+			if (signature.types[i] == EVENT_STRING) {
+				unsigned long long address;
+				memcpy(&address, &events[offset], sizeof(address));
+
+				if (address && m_writtenStrings.insert(address).second) {
+					const char* text = (const char*)(size_t)address;
+
+					EventStringRecord record = { (unsigned int)address, (unsigned int)(address >> 32) };
+					WriteRecord(EVENT_RECORD_STRING, &record, sizeof(record), text, (unsigned int)strlen(text));
+				}
+			}
+
+			offset += EventArgumentSize(signature.types[i]);
+		}
+	}
+}
+
+
+/*******************************************************************************************************************
+	Function that writes one record - its header, its fixed part, then anything that follows it
+*******************************************************************************************************************/
+void EventLog::WriteRecord(unsigned int type, const void* data, unsigned int size, const void* extra, unsigned int extraSize)
+{
+	EventRecordHeader header = { type, size + extraSize };
+
+	fwrite(&header, sizeof(header), 1, m_file);
+	fwrite(data, size, 1, m_file);
+	if (extraSize > 0) { fwrite(extra, extraSize, 1, m_file); }
+}
+
+
+/*******************************************************************************************************************
+	Accessor Methods
+*******************************************************************************************************************/
+bool EventLog::IsRunning() { return m_isRunning.load(std::memory_order_relaxed); }
+
+#endif
@@ -0,0 +1,226 @@
+#pragma once
+
+/*******************************************************************************************************************
+	EventLog.h, EventLog.cpp
+	Created by Kim Kane
+	Last updated: 19/10/2026
+
+	Static class that records structured events to a binary file, cheaply enough to leave on in release builds.
+
+	DX_EVENT("[QUADTREE] Leaf %u at (%.1f, %.1f)", id, x, z) records an event. The format string is printf's,
+	but it's never formatted in the game - each call site registers its format (and the type of each argument)
+	once, the first time it's reached, and after that an event is just the format's id, the tick it happened
+	on and the raw arguments. EventDecoder turns the file back in to text afterwards.
+
+	Arguments can be any whole number, float, double or pointer. A string argument must be a literal (or live
+	as long as the program), like a profiler zone name - only its address is recorded, and its text is written
+	to the file the first time the address is seen.
+
+	Each thread records its events in its own buffer, which only that thread writes to and only the event log's
+	thread reads from, so recording never takes a lock or waits. If a buffer fills up before the log thread
+	empties it, events are dropped and the file says how many. Events are only recorded between Initialize()
+	and Shutdown().
+
+	Event logging is always compiled in, but the game only records events when it's started with -events - a
+	draw or a terrain leaf is an event, so the file grows by megabytes a second for as long as the game runs.
+	Until then, every DX_EVENT is one check of a flag. Define EVENT_MODE=0 in the project to leave it out
+	altogether - every DX_EVENT is then empty.
+
+*******************************************************************************************************************/
+#if !defined(EVENT_MODE)
+	#define EVENT_MODE 1
+#endif
+
+#if EVENT_MODE == 1
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include "Clock.h"
+#include "Constants.h"
+#include "EventFormat.h"
+
+//-------------------------------------------- The id is made once per call site, the first time it's reached
+#define DX_EVENT(format, ...)	do { static const unsigned int eventId = EventLog::Register(format, __FILE__, __LINE__, EventLog::Signature(__VA_ARGS__)); \
+									 EventLog::Write(eventId, ##__VA_ARGS__); } while (0)
+
+//-------------------------------------------- How each type of argument is stored
+template <typename T> struct EventArgument;
+
+template <> struct EventArgument<bool>					{ enum { type = EVENT_INT };		typedef int Stored; };
+template <> struct EventArgument<char>					{ enum { type = EVENT_INT };		typedef int Stored; };
+template <> struct EventArgument<signed char>			{ enum { type = EVENT_INT };		typedef int Stored; };
+template <> struct EventArgument<unsigned char>			{ enum { type = EVENT_UINT };		typedef unsigned int Stored; };
+template <> struct EventArgument<short>					{ enum { type = EVENT_INT };		typedef int Stored; };
+template <> struct EventArgument<unsigned short>		{ enum { type = EVENT_UINT };		typedef unsigned int Stored; };
+template <> struct EventArgument<int>					{ enum { type = EVENT_INT };		typedef int Stored; };
+template <> struct EventArgument<unsigned int>			{ enum { type = EVENT_UINT };		typedef unsigned int Stored; };
+template <> struct EventArgument<long>					{ enum { type = EVENT_INT64 };		typedef long long Stored; };
+template <> struct EventArgument<unsigned long>			{ enum { type = EVENT_UINT64 };		typedef unsigned long long Stored; };
+template <> struct EventArgument<long long>				{ enum { type = EVENT_INT64 };		typedef long long Stored; };
+template <> struct EventArgument<unsigned long long>	{ enum { type = EVENT_UINT64 };		typedef unsigned long long Stored; };
+template <> struct EventArgument<float>					{ enum { type = EVENT_FLOAT };		typedef float Stored; };
+template <> struct EventArgument<double>				{ enum { type = EVENT_DOUBLE };		typedef double Stored; };
+template <> struct EventArgument<const char*>			{ enum { type = EVENT_STRING };		typedef unsigned long long Stored; };
+template <> struct EventArgument<char*>					{ enum { type = EVENT_STRING };		typedef unsigned long long Stored; };
+template <typename T> struct EventArgument<T*>			{ enum { type = EVENT_POINTER };	typedef unsigned long long Stored; };
+
+//-------------------------------------------- The type of each argument a call site passes
+struct EventSignature
+{
+	unsigned int	count;
+	unsigned char	types[EventLogConstants::MaxArguments];
+};
+
+//-------------------------------------------- A thread's event buffer - a ring of bytes that its own thread pushes on to and the log thread pops off
+class EventThread {
+
+public:
+	explicit EventThread(unsigned int id);
+
+public:
+	void Push(const unsigned char* event, unsigned int size);
+	void Pop(std::vector<unsigned char>& events);
+
+public:
+	unsigned int				id;
+
+	//-------------------------------------------- Events lost because the buffer was full, since the log thread last looked
+	std::atomic<unsigned int>	dropped;
+
+private:
+	EventThread(const EventThread&);
+	EventThread& operator=(const EventThread&);
+
+private:
+	unsigned char				m_events[EventLogConstants::ThreadBufferSize];
+	std::atomic<unsigned int>	m_head;
+	std::atomic<unsigned int>	m_tail;
+};
+
+class EventLog {
+
+public:
+	static bool Initialize(const std::string& fileLocation);
+	static void Shutdown();
+
+public:
+	static unsigned int Register(const char* format, const char* file, unsigned int line, const EventSignature& signature);
+
+	template <typename... Arguments> static EventSignature Signature(Arguments... arguments);
+	template <typename... Arguments> static void Write(unsigned int id, Arguments... arguments);
+
+public:
+	static EventThread* GetThread();
+	static bool IsRunning();
+
+private:
+	EventLog();
+
+private:
+	struct EventFormatInfo
+	{
+		const char*		format;
+		const char*		file;
+		unsigned int	line;
+		EventSignature	signature;
+	};
+
+	//-------------------------------------------- How many bytes a call site's arguments take up, worked out when compiling
+	template <typename... Arguments> struct ArgumentSize;
+
+private:
+	static void Encode(unsigned char*) {}
+	template <typename T, typename... Arguments> static void Encode(unsigned char* event, T argument, Arguments... arguments);
+
+	static EventThread* RegisterThread();
+	static void Run();
+	static void WriteWaiting();
+	static void WriteFormats();
+	static void WriteStrings(const std::vector<unsigned char>& events);
+	static void WriteRecord(unsigned int type, const void* data, unsigned int size, const void* extra = nullptr, unsigned int extraSize = 0);
+
+private:
+	static std::atomic<bool>							m_isRunning;
+	static std::mutex									m_mutex;
+	static std::vector<std::unique_ptr<EventThread>>	m_threads;
+	static std::vector<EventFormatInfo>					m_formats;
+
+	static std::thread									m_thread;
+	static std::condition_variable						m_condition;
+	static bool											m_isClosing;
+
+	//-------------------------------------------- Everything below is only used by the log thread
+	static FILE*										m_file;
+	static std::vector<EventFormatInfo>					m_writtenFormats;
+	static std::vector<EventThread*>					m_writeThreads;
+	static std::unordered_set<unsigned long long>		m_writtenStrings;
+	static std::vector<unsigned char>					m_events;
+};
+
+template <> struct EventLog::ArgumentSize<> { enum { value = 0 }; };
+
+template <typename T, typename... Arguments> struct EventLog::ArgumentSize<T, Arguments...>
+{
+	enum { value = sizeof(typename EventArgument<T>::Stored) + ArgumentSize<Arguments...>::value };
+};
+
+
+/*******************************************************************************************************************
+	Function that gets the type of each argument, to register with a call site's format
+*******************************************************************************************************************/
+template <typename... Arguments> EventSignature EventLog::Signature(Arguments...)
+{
+	static_assert(sizeof...(Arguments) <= EventLogConstants::MaxArguments, "Too many arguments for one event");
+
+	EventSignature signature = { sizeof...(Arguments) };
+	const unsigned char types[] = { 0, (unsigned char)EventArgument<Arguments>::type... };
+
+	memcpy(signature.types, types + 1, sizeof...(Arguments));
+
+	return signature;
+}
+
+
+/*******************************************************************************************************************
+	Function that records one event in the calling thread's buffer - the arguments are stored as they are
+*******************************************************************************************************************/
+template <typename... Arguments> void EventLog::Write(unsigned int id, Arguments... arguments)
+{
+	if (!m_isRunning.load(std::memory_order_relaxed)) { return; }
+
+	unsigned char event[EventFormat::EventHeaderSize + ArgumentSize<Arguments...>::value];
+	long long ticks = SystemClock::GetTicks();
+
+	memcpy(event, &id, sizeof(id));
+	memcpy(event + sizeof(id), &ticks, sizeof(ticks));
+	Encode(event + EventFormat::EventHeaderSize, arguments...);
+
+	GetThread()->Push(event, sizeof(event));
+}
+
+
+/*******************************************************************************************************************
+	Function that packs the arguments one after another - pointers and strings are kept as their address
+*******************************************************************************************************************/
+template <typename T, typename... Arguments> void EventLog::Encode(unsigned char* event, T argument, Arguments... arguments)
+{
+	typename EventArgument<T>::Stored stored = (typename EventArgument<T>::Stored)argument;
+	memcpy(event, &stored, sizeof(stored));
+
+	Encode(event + sizeof(stored), arguments...);
+}
+
+#else
+
+#define DX_EVENT(format, ...)
+
+#endif
@@ -1,193 +1,151 @@
-#include "Font.h"
-#include "GraphicsManager.h"
+#include <algorithm>
+#include <cstring>
 
-Font::Font()
+#include "Font.h"
+#include "Log.h"
+
+/*******************************************************************************************************************
+	Function that orders kerning pairs, so a pair can be found by binary search
+*******************************************************************************************************************/
+static bool ComparePair(const FontKerning& kerning, unsigned int pair) { return kerning.pair < pair; }
+
+
+/*******************************************************************************************************************
+	Constructor with initializer list to set all default values of variables
+*******************************************************************************************************************/
+Font::Font()	:	m_file(INVALID_HANDLE_VALUE),
+					m_mapping(nullptr),
+					m_view(nullptr),
+					m_header(nullptr),
+					m_glyphs(nullptr),
+					m_kerning(nullptr)
 {
-	m_font = 0;
-	m_texture = 0;
+	memset(m_glyphLookup, 0, sizeof(m_glyphLookup));
 }
 
-Font::Font(const Font &)
-{
-}
 
+/*******************************************************************************************************************
+	Shut down all necessary procedures, release resources and clean up memory
+*******************************************************************************************************************/
 Font::~Font()
 {
+	Release();
 }
 
-bool Font::Initialize(char* fontFileLocation, const char* textureFileLocation)
+
+/*******************************************************************************************************************
+	Function that maps a baked font file in to memory and creates its atlas
+*******************************************************************************************************************/
+bool Font::Load(const std::string& fileLocation)
 {
-	bool result;
+	Release();
+
+	m_file = CreateFileA(fileLocation.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (m_file == INVALID_HANDLE_VALUE) { DX_LOG("[FONT] Couldn't open font file: ", fileLocation.c_str(), LOG_ERROR); return false; }
+
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(m_file, &fileSize) || fileSize.QuadPart < (LONGLONG)sizeof(FontHeader)) {
+		DX_LOG("[FONT] Font file is too small: ", fileLocation.c_str(), LOG_ERROR); Release(); return false;
+	}
+
+	m_mapping = CreateFileMappingA(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (m_mapping) { m_view = (const char*)MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0); }
 
+	if (!m_view) { DX_LOG("[FONT] Couldn't map font file: ", fileLocation.c_str(), LOG_ERROR); Release(); return false; }
 
-	// Load in the text file containing the font data.
-	result = LoadFontData(fontFileLocation);
-	if (!result)
-	{
-		return false;
+	//-------------------------------------------- Nothing is copied - the header and tables are read straight out of the mapped file
+	m_header = (const FontHeader*)m_view;
+
+	if (!ValidateHeader((unsigned long long)fileSize.QuadPart)) {
+		DX_LOG("[FONT] Font file is corrupt or out of date: ", fileLocation.c_str(), LOG_ERROR); Release(); return false;
 	}
 
-	// Load the texture that has the font characters on it.
-	result = LoadTexture(textureFileLocation);
-	if (!result)
-	{
-		return false;
+	m_glyphs	= (const FontGlyph*)(m_view + m_header->glyphOffset);
+	m_kerning	= (const FontKerning*)(m_view + m_header->kerningOffset);
+
+	for (unsigned int i = 0; i < m_header->glyphCount; i++) {
+		if (m_glyphs[i].character < 256) { m_glyphLookup[m_glyphs[i].character] = (unsigned short)(i + 1); }
 	}
 
+	//-------------------------------------------- The atlas goes to the GPU from the mapped file too
+	if (!m_atlas.CreateTexture(m_header->atlasWidth, m_header->atlasHeight, DXGI_FORMAT_R8_UNORM, m_view + m_header->atlasOffset, m_header->atlasWidth)) {
+		DX_LOG("[FONT] Couldn't create font atlas: ", fileLocation.c_str(), LOG_ERROR); Release(); return false;
+	}
+
+	DX_LOG("[FONT] Font loaded: ", fileLocation.c_str(), LOG_SUCCESS);
+
 	return true;
 }
 
-void Font::Shutdown()
+
+/*******************************************************************************************************************
+	Function that unmaps the font file
+*******************************************************************************************************************/
+void Font::Release()
 {
-	// Release the font texture.
-	ReleaseTexture();
+	if (m_view)							{ UnmapViewOfFile(m_view); m_view = nullptr; }
+	if (m_mapping)						{ CloseHandle(m_mapping); m_mapping = nullptr; }
+	if (m_file != INVALID_HANDLE_VALUE)	{ CloseHandle(m_file); m_file = INVALID_HANDLE_VALUE; }
 
-	// Release the font data.
-	ReleaseFontData();
-}
+	m_header	= nullptr;
+	m_glyphs	= nullptr;
+	m_kerning	= nullptr;
 
-Texture * Font::GetTexture()
-{
-    return m_texture;
+	memset(m_glyphLookup, 0, sizeof(m_glyphLookup));
 }
 
-void Font::BuildVertexArray(void* vertices, char* sentence, float drawX, float drawY)
-{
-	VertexType* vertexPtr;
-	int numLetters, index, i, letter;
-
-
-	// Coerce the input vertices into a VertexType structure.
-	vertexPtr = (VertexType*)vertices;
-
-	// Get the number of letters in the sentence.
-	numLetters = (int)strlen(sentence);
-
-	// Initialize the index to the vertex array.
-	index = 0;
-
-	// Draw each letter onto a quad.
-	for (i = 0; i<numLetters; i++)
-	{
-		letter = ((int)sentence[i]) - 32;
-
-		// If the letter is a space then just move over three pixels.
-		if (letter == 0)
-		{
-			drawX = drawX + 3.0f;
-		}
-		else
-		{
-			// First triangle in quad.
-			vertexPtr[index].position = XMFLOAT3(drawX, drawY, 0.0f);  // Top left.
-			vertexPtr[index].texture = XMFLOAT2(m_font[letter].left, 0.0f);
-			index++;
-
-			vertexPtr[index].position = XMFLOAT3((drawX + m_font[letter].size), (drawY - 16), 0.0f);  // Bottom right.
-			vertexPtr[index].texture = XMFLOAT2(m_font[letter].right, 1.0f);
-			index++;
-
-			vertexPtr[index].position = XMFLOAT3(drawX, (drawY - 16), 0.0f);  // Bottom left.
-			vertexPtr[index].texture = XMFLOAT2(m_font[letter].left, 1.0f);
-			index++;
-
-			// Second triangle in quad.
-			vertexPtr[index].position = XMFLOAT3(drawX, drawY, 0.0f);  // Top left.
-			vertexPtr[index].texture = XMFLOAT2(m_font[letter].left, 0.0f);
-			index++;
-
-			vertexPtr[index].position = XMFLOAT3(drawX + m_font[letter].size, drawY, 0.0f);  // Top right.
-			vertexPtr[index].texture = XMFLOAT2(m_font[letter].right, 0.0f);
-			index++;
-
-			vertexPtr[index].position = XMFLOAT3((drawX + m_font[letter].size), (drawY - 16), 0.0f);  // Bottom right.
-			vertexPtr[index].texture = XMFLOAT2(m_font[letter].right, 1.0f);
-			index++;
-
-			// Update the x location for drawing by the size of the letter and one pixel.
-			drawX = drawX + m_font[letter].size + 1.0f;
-		}
-	}
-}
 
-bool Font::LoadFontData(char* fileLocation)
+/*******************************************************************************************************************
+	Function that checks the header is one we understand and every table it points at sits inside the file
+*******************************************************************************************************************/
+bool Font::ValidateHeader(unsigned long long fileSize) const
 {
-	std::ifstream fin;
-	int i;
-	char temp;
+	if (m_header->magic != FontFormat::Magic || m_header->version != FontFormat::Version) { return false; }
 
+	unsigned long long glyphEnd		= (unsigned long long)m_header->glyphOffset + (unsigned long long)m_header->glyphCount * sizeof(FontGlyph);
+	unsigned long long kerningEnd	= (unsigned long long)m_header->kerningOffset + (unsigned long long)m_header->kerningCount * sizeof(FontKerning);
+	unsigned long long atlasEnd		= (unsigned long long)m_header->atlasOffset + (unsigned long long)m_header->atlasWidth * m_header->atlasHeight;
 
-	// Create the font spacing buffer.
-	m_font = new FontType[95];
-	if (!m_font)
-	{
-		return false;
-	}
+	if (glyphEnd > fileSize || kerningEnd > fileSize || atlasEnd > fileSize) { return false; }
 
-	// Read in the font size and spacing between chars.
-	fin.open(fileLocation);
-	if (fin.fail())
-	{
-		return false;
-	}
+	//-------------------------------------------- The tables are read in place, so they have to be aligned
+	if (m_header->glyphOffset % 4 != 0 || m_header->kerningOffset % 4 != 0) { return false; }
 
-	// Read in the 95 used ascii characters for text.
-	for (i = 0; i<95; i++)
-	{
-		fin.get(temp);
-		while (temp != ' ')
-		{
-			fin.get(temp);
-		}
-		fin.get(temp);
-		while (temp != ' ')
-		{
-			fin.get(temp);
-		}
-
-		fin >> m_font[i].left;
-		fin >> m_font[i].right;
-		fin >> m_font[i].size;
-	}
-
-	// Close the file.
-	fin.close();
-
-	return true;
+	return m_header->atlasWidth > 0 && m_header->atlasHeight > 0;
 }
 
-void Font::ReleaseFontData()
+
+/*******************************************************************************************************************
+	Function that finds the metrics for a character - returns nullptr if the font has no glyph for it
+*******************************************************************************************************************/
+const FontGlyph* Font::GetGlyph(unsigned char character) const
 {
-	// Release the font data array.
-	if (m_font)
-	{
-		delete[] m_font;
-		m_font = 0;
-	}
+	unsigned short index = m_glyphLookup[character];
 
+	return (index > 0) ? &m_glyphs[index - 1] : nullptr;
 }
 
-bool Font::LoadTexture(const char* fileLocation)
+
+/*******************************************************************************************************************
+	Function that finds how much closer (or further) the second character sits to the first
+*******************************************************************************************************************/
+float Font::GetKerning(unsigned char first, unsigned char second) const
 {
-	// Create the texture object.
-	m_texture = new Texture();
-	if (!m_texture)
-	{
-		return false;
-	}
-    m_texture->LoadTexture(fileLocation);
+	if (!m_header || m_header->kerningCount == 0) { return 0.0f; }
 
-	return true;
-}
+	unsigned int pair = ((unsigned int)first << 16) | second;
 
-void Font::ReleaseTexture()
-{
-	// Release the texture object.
-	if (m_texture)
-	{
-		//m_texture->Shutdown();
-		delete m_texture;
-		m_texture = 0;
-	}
+	const FontKerning* end		= m_kerning + m_header->kerningCount;
+	const FontKerning* kerning	= std::lower_bound(m_kerning, end, pair, ComparePair);
 
+	return (kerning != end && kerning->pair == pair) ? kerning->amount : 0.0f;
 }
+
+
+/*******************************************************************************************************************
+	Accessor Methods
+*******************************************************************************************************************/
+float Font::GetLineHeight() const		{ return m_header ? m_header->lineHeight : 0.0f; }
+float Font::GetAscent() const			{ return m_header ? m_header->ascent : 0.0f; }
+float Font::GetDistanceRange() const	{ return m_header ? m_header->distanceRange : 0.0f; }
+Texture* Font::GetTexture()				{ return &m_atlas; }
@@ -1,46 +1,62 @@
 #pragma once
 
-#include <d3d11.h>
-#include <xnamath.h>
-#include <fstream>
+/*******************************************************************************************************************
+	Font.h, Font.cpp
+	Created by Kim Kane
+	Last updated: 19/10/2026
 
+	A font baked by FontBaker - a signed distance field atlas plus the metrics needed to lay text out.
 
-#include "texture.h"
+	The font file is memory-mapped rather than read in, and the glyph and kerning tables are used straight
+	from the mapped view, so loading a font is just checking its header. The atlas is handed to the GPU from
+	the same view. Glyphs are found through a 256 entry lookup table and kerning pairs by binary search.
 
-class Font
-{
-private:
-	struct FontType
-	{
-		float left, right;
-		int size;
-	};
-
-	struct VertexType
-	{
-		XMFLOAT3 position;
-		XMFLOAT2 texture;
-	};
+*******************************************************************************************************************/
+#include <Windows.h>
+#include <string>
+
+#include "FontFormat.h"
+#include "Texture.h"
+
+class Font {
 
 public:
 	Font();
-	Font(const Font&);
 	~Font();
 
-	bool Initialize(char* fontFileLocation, const char* textureFileLocation);
-	void Shutdown();
+public:
+	bool Load(const std::string& fileLocation);
+	void Release();
+
+public:
+	const FontGlyph* GetGlyph(unsigned char character) const;
+	float GetKerning(unsigned char first, unsigned char second) const;
 
+public:
+	float GetLineHeight() const;
+	float GetAscent() const;
+	float GetDistanceRange() const;
 	Texture* GetTexture();
 
-	void BuildVertexArray(void*, char*, float, float);
+private:
+	Font(const Font&);
+	Font& operator=(const Font&);
 
 private:
-	bool LoadFontData(char* fileLocation);
-	void ReleaseFontData();
-	bool LoadTexture(const char* fileLocation);
-	void ReleaseTexture();
+	bool ValidateHeader(unsigned long long fileSize) const;
 
 private:
-	FontType* m_font;
-	Texture* m_texture;
-};
\ No newline at end of file
+	//-------------------------------------------- The mapped font file, which the tables below point in to
+	HANDLE				m_file;
+	HANDLE				m_mapping;
+	const char*			m_view;
+
+	const FontHeader*	m_header;
+	const FontGlyph*	m_glyphs;
+	const FontKerning*	m_kerning;
+
+	//-------------------------------------------- Index in to the glyph table plus one for every character, 0 where the font has no glyph
+	unsigned short		m_glyphLookup[256];
+
+	Texture				m_atlas;
+};
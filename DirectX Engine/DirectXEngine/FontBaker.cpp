@@ -0,0 +1,319 @@
+#include <windows.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <numeric>
+
+#include "FontBaker.h"
+#include "Log.h"
+
+/*******************************************************************************************************************
+	Function that checks whether a coverage sample is inside the glyph - anything off the bitmap is outside
+*******************************************************************************************************************/
+static bool IsInside(const std::vector<unsigned char>& coverage, int width, int height, int x, int y)
+{
+	if (x < 0 || y < 0 || x >= width || y >= height) { return false; }
+
+	return coverage[y * width + x] >= 128;
+}
+
+
+/*******************************************************************************************************************
+	Function that bakes a font and writes it out to a file
+*******************************************************************************************************************/
+bool FontBaker::Bake(const FontBakeSettings& settings, const std::string& outputFileLocation)
+{
+	FontHeader header;
+	memset(&header, 0, sizeof(header));
+
+	std::vector<BakedGlyph> glyphs;
+	std::vector<FontKerning> kerning;
+
+	if (!RenderGlyphs(settings, header, glyphs, kerning)) { return false; }
+
+	unsigned int atlasHeight = 0;
+	if (!PackAtlas(glyphs, settings.atlasWidth, atlasHeight)) { return false; }
+
+	header.atlasWidth	= settings.atlasWidth;
+	header.atlasHeight	= atlasHeight;
+
+	//-------------------------------------------- Make sure the folder the font is going in exists
+	size_t folderEnd = outputFileLocation.find_last_of('\\');
+	if (folderEnd != std::string::npos) { CreateDirectoryA(outputFileLocation.substr(0, folderEnd).c_str(), nullptr); }
+
+	if (!WriteFontFile(outputFileLocation, header, glyphs, kerning)) {
+		DX_LOG("[FONT BAKER] Couldn't write font file: ", outputFileLocation.c_str(), LOG_ERROR); return false;
+	}
+
+	DX_LOG("[FONT BAKER] Baked font: ", outputFileLocation.c_str(), LOG_SUCCESS);
+
+	return true;
+}
+
+
+/*******************************************************************************************************************
+	Function that rasterizes every glyph with GDI and reads back the font's metrics and kerning pairs
+*******************************************************************************************************************/
+bool FontBaker::RenderGlyphs(const FontBakeSettings& settings, FontHeader& header, std::vector<BakedGlyph>& glyphs, std::vector<FontKerning>& kerning)
+{
+	//-------------------------------------------- Fonts loaded from a file are private to this process - with no file, the face must already be installed
+	if (!settings.fileLocation.empty() && AddFontResourceExA(settings.fileLocation.c_str(), FR_PRIVATE, nullptr) == 0) {
+		DX_LOG("[FONT BAKER] Couldn't load font file: ", settings.fileLocation.c_str(), LOG_ERROR); return false;
+	}
+
+	//-------------------------------------------- Render at a multiple of the baked size, so the distance field has sub-texel detail to measure
+	int renderHeight	= (int)(settings.pixelSize * settings.supersample + 0.5f);
+	float scale			= 1.0f / settings.supersample;
+
+	HDC deviceContext	= CreateCompatibleDC(nullptr);
+	HFONT font			= CreateFontA(-renderHeight, 0, 0, 0, FW_NORMAL, FALSE, FALSE, FALSE, ANSI_CHARSET, OUT_TT_ONLY_PRECIS,
+									  CLIP_DEFAULT_PRECIS, ANTIALIASED_QUALITY, DEFAULT_PITCH | FF_DONTCARE, settings.faceName.c_str());
+
+	if (!deviceContext || !font) {
+		DX_LOG("[FONT BAKER] Couldn't create font: ", settings.faceName.c_str(), LOG_ERROR);
+		if (font) { DeleteObject(font); }
+		if (deviceContext) { DeleteDC(deviceContext); }
+		if (!settings.fileLocation.empty()) { RemoveFontResourceExA(settings.fileLocation.c_str(), FR_PRIVATE, nullptr); }
+		return false;
+	}
+
+	HGDIOBJ previousFont = SelectObject(deviceContext, font);
+
+	TEXTMETRICA textMetrics;
+	GetTextMetricsA(deviceContext, &textMetrics);
+
+	header.pixelSize		= settings.pixelSize;
+	header.ascent			= textMetrics.tmAscent * scale;
+	header.lineHeight		= (textMetrics.tmHeight + textMetrics.tmExternalLeading) * scale;
+	header.distanceRange	= settings.distanceRange;
+
+	float padding = ceil(settings.distanceRange);
+
+	MAT2 identity = { { 0, 1 }, { 0, 0 }, { 0, 0 }, { 0, 1 } };
+
+	bool result = true;
+
+	for (unsigned int character = settings.firstCharacter; character <= settings.lastCharacter; character++) {
+
+		GLYPHMETRICS glyphMetrics;
+		DWORD bufferSize = GetGlyphOutlineA(deviceContext, character, GGO_GRAY8_BITMAP, &glyphMetrics, 0, nullptr, &identity);
+
+		if (bufferSize == GDI_ERROR) {
+			DX_LOG("[FONT BAKER] Couldn't get glyph for character: ", character, LOG_ERROR); result = false; break;
+		}
+
+		std::vector<unsigned char> bitmap(bufferSize);
+		if (bufferSize > 0 && GetGlyphOutlineA(deviceContext, character, GGO_GRAY8_BITMAP, &glyphMetrics, bufferSize, &bitmap[0], &identity) == GDI_ERROR) {
+			DX_LOG("[FONT BAKER] Couldn't render glyph for character: ", character, LOG_ERROR); result = false; break;
+		}
+
+		//-------------------------------------------- Blank glyphs (spaces) come back with no bitmap, they only need an advance
+		int coverageWidth	= (bufferSize > 0) ? glyphMetrics.gmBlackBoxX : 0;
+		int coverageHeight	= (bufferSize > 0) ? glyphMetrics.gmBlackBoxY : 0;
+		int pitch			= (coverageWidth + 3) & ~3;
+
+		//-------------------------------------------- GDI gives 65 levels of grey (0 - 64) in DWORD aligned rows - unpack them to 0 - 255
+		std::vector<unsigned char> coverage(coverageWidth * coverageHeight);
+		for (int y = 0; y < coverageHeight; y++) {
+			for (int x = 0; x < coverageWidth; x++) {
+				coverage[y * coverageWidth + x] = (unsigned char)((std::min<int>)(bitmap[y * pitch + x], 64) * 255 / 64);
+			}
+		}
+
+		BakedGlyph glyph;
+		memset(&glyph.metrics, 0, sizeof(glyph.metrics));
+		glyph.metrics.character	= character;
+		glyph.metrics.advance	= glyphMetrics.gmCellIncX * scale;
+		glyph.fieldWidth		= 0;
+		glyph.fieldHeight		= 0;
+		glyph.atlasX			= 0;
+		glyph.atlasY			= 0;
+
+		if (coverageWidth > 0 && coverageHeight > 0) {
+
+			GenerateDistanceField(coverage, coverageWidth, coverageHeight, settings, glyph);
+
+			//-------------------------------------------- The field is padded out on every side, so move the quad out to match
+			glyph.metrics.bearingX	= glyphMetrics.gmptGlyphOrigin.x * scale - padding;
+			glyph.metrics.bearingY	= glyphMetrics.gmptGlyphOrigin.y * scale + padding;
+			glyph.metrics.width		= (float)glyph.fieldWidth;
+			glyph.metrics.height	= (float)glyph.fieldHeight;
+		}
+
+		glyphs.push_back(glyph);
+	}
+
+	//-------------------------------------------- Keep the kerning pairs between characters we baked, sorted so they can be binary searched
+	DWORD pairCount = (result) ? GetKerningPairsA(deviceContext, 0, nullptr) : 0;
+
+	std::vector<KERNINGPAIR> pairs(pairCount);
+	if (pairCount > 0) { pairCount = GetKerningPairsA(deviceContext, pairCount, &pairs[0]); }
+
+	for (DWORD i = 0; i < pairCount; i++) {
+
+		if (pairs[i].iKernAmount == 0) { continue; }
+		if (pairs[i].wFirst < settings.firstCharacter || pairs[i].wFirst > settings.lastCharacter) { continue; }
+		if (pairs[i].wSecond < settings.firstCharacter || pairs[i].wSecond > settings.lastCharacter) { continue; }
+
+		FontKerning pair;
+		pair.pair	= ((unsigned int)pairs[i].wFirst << 16) | pairs[i].wSecond;
+		pair.amount	= pairs[i].iKernAmount * scale;
+
+		kerning.push_back(pair);
+	}
+
+	std::sort(kerning.begin(), kerning.end(), [](const FontKerning& a, const FontKerning& b) { return a.pair < b.pair; });
+
+	SelectObject(deviceContext, previousFont);
+	DeleteObject(font);
+	DeleteDC(deviceContext);
+
+	if (!settings.fileLocation.empty()) { RemoveFontResourceExA(settings.fileLocation.c_str(), FR_PRIVATE, nullptr); }
+
+	return result;
+}
+
+
+/*******************************************************************************************************************
+	Function that turns a glyph's coverage in to a signed distance field at the baked size
+*******************************************************************************************************************/
+void FontBaker::GenerateDistanceField(const std::vector<unsigned char>& coverage, int coverageWidth, int coverageHeight,
+									  const FontBakeSettings& settings, BakedGlyph& glyph)
+{
+	int supersample		= settings.supersample;
+	int padding			= (int)ceil(settings.distanceRange);
+	int searchRadius	= (int)ceil(settings.distanceRange * supersample);
+
+	glyph.fieldWidth	= (coverageWidth + supersample - 1) / supersample + padding * 2;
+	glyph.fieldHeight	= (coverageHeight + supersample - 1) / supersample + padding * 2;
+	glyph.field.assign(glyph.fieldWidth * glyph.fieldHeight, 0);
+
+	for (unsigned int y = 0; y < glyph.fieldHeight; y++) {
+		for (unsigned int x = 0; x < glyph.fieldWidth; x++) {
+
+			//-------------------------------------------- Find the coverage sample under the middle of this texel
+			int sampleX = (int)floor(((int)x - padding + 0.5f) * supersample);
+			int sampleY = (int)floor(((int)y - padding + 0.5f) * supersample);
+
+			bool inside = IsInside(coverage, coverageWidth, coverageHeight, sampleX, sampleY);
+
+			//-------------------------------------------- Brute force search for the nearest sample on the other side of the edge
+			int nearest = searchRadius * searchRadius;
+
+			for (int offsetY = -searchRadius; offsetY <= searchRadius; offsetY++) {
+				for (int offsetX = -searchRadius; offsetX <= searchRadius; offsetX++) {
+
+					int distance = offsetX * offsetX + offsetY * offsetY;
+					if (distance >= nearest) { continue; }
+
+					if (IsInside(coverage, coverageWidth, coverageHeight, sampleX + offsetX, sampleY + offsetY) != inside) { nearest = distance; }
+				}
+			}
+
+			//-------------------------------------------- Store as 0.5 on the edge, rising to 1 inside and falling to 0 outside, distanceRange texels away
+			float distance	= sqrt((float)nearest) / supersample;
+			float value		= 0.5f + ((inside) ? distance : -distance) / (2.0f * settings.distanceRange);
+
+			value = (std::max)(0.0f, (std::min)(1.0f, value));
+
+			glyph.field[y * glyph.fieldWidth + x] = (unsigned char)(value * 255.0f + 0.5f);
+		}
+	}
+}
+
+
+/*******************************************************************************************************************
+	Function that packs the glyphs in to rows of the atlas, tallest first, and works out their texture coordinates
+*******************************************************************************************************************/
+bool FontBaker::PackAtlas(std::vector<BakedGlyph>& glyphs, unsigned int atlasWidth, unsigned int& atlasHeight)
+{
+	//-------------------------------------------- Leave a texel between glyphs so linear filtering never picks up a neighbour
+	const unsigned int gap = 1;
+
+	std::vector<size_t> order(glyphs.size());
+	std::iota(order.begin(), order.end(), 0);
+	std::sort(order.begin(), order.end(), [&glyphs](size_t a, size_t b) { return glyphs[a].fieldHeight > glyphs[b].fieldHeight; });
+
+	unsigned int x				= gap;
+	unsigned int y				= gap;
+	unsigned int shelfHeight	= 0;
+
+	for (size_t i = 0; i < order.size(); i++) {
+
+		BakedGlyph& glyph = glyphs[order[i]];
+		if (glyph.fieldWidth == 0) { continue; }
+
+		if (glyph.fieldWidth + gap * 2 > atlasWidth) {
+			DX_LOG("[FONT BAKER] Glyph is wider than the atlas: ", glyph.metrics.character, LOG_ERROR); return false;
+		}
+
+		//-------------------------------------------- Out of room on this row, so start a new one under it
+		if (x + glyph.fieldWidth + gap > atlasWidth) {
+			x			= gap;
+			y			+= shelfHeight + gap;
+			shelfHeight	= 0;
+		}
+
+		glyph.atlasX	= x;
+		glyph.atlasY	= y;
+
+		x			+= glyph.fieldWidth + gap;
+		shelfHeight	= (std::max)(shelfHeight, glyph.fieldHeight);
+	}
+
+	//-------------------------------------------- Round the height up to a power of two
+	unsigned int usedHeight = y + shelfHeight + gap;
+
+	atlasHeight = 1;
+	while (atlasHeight < usedHeight) { atlasHeight *= 2; }
+
+	for (size_t i = 0; i < glyphs.size(); i++) {
+
+		BakedGlyph& glyph = glyphs[i];
+		if (glyph.fieldWidth == 0) { continue; }
+
+		glyph.metrics.u0 = (float)glyph.atlasX / atlasWidth;
+		glyph.metrics.v0 = (float)glyph.atlasY / atlasHeight;
+		glyph.metrics.u1 = (float)(glyph.atlasX + glyph.fieldWidth) / atlasWidth;
+		glyph.metrics.v1 = (float)(glyph.atlasY + glyph.fieldHeight) / atlasHeight;
+	}
+
+	return true;
+}
+
+
+/*******************************************************************************************************************
+	Function that copies every glyph in to the atlas and writes the header, tables and atlas out to a file
+*******************************************************************************************************************/
+bool FontBaker::WriteFontFile(const std::string& fileLocation, FontHeader& header, const std::vector<BakedGlyph>& glyphs,
+							  const std::vector<FontKerning>& kerning)
+{
+	header.magic			= FontFormat::Magic;
+	header.version			= FontFormat::Version;
+	header.glyphCount		= glyphs.size();
+	header.kerningCount		= kerning.size();
+	header.glyphOffset		= sizeof(FontHeader);
+	header.kerningOffset	= header.glyphOffset + header.glyphCount * sizeof(FontGlyph);
+	header.atlasOffset		= header.kerningOffset + header.kerningCount * sizeof(FontKerning);
+
+	std::vector<unsigned char> atlas(header.atlasWidth * header.atlasHeight, 0);
+
+	for (size_t i = 0; i < glyphs.size(); i++) {
+		for (unsigned int y = 0; y < glyphs[i].fieldHeight; y++) {
+			memcpy(&atlas[(glyphs[i].atlasY + y) * header.atlasWidth + glyphs[i].atlasX], &glyphs[i].field[y * glyphs[i].fieldWidth], glyphs[i].fieldWidth);
+		}
+	}
+
+	std::ofstream file(fileLocation, std::ios::out | std::ios::binary | std::ios::trunc);
+	if (!file.is_open()) { return false; }
+
+	file.write((const char*)&header, sizeof(header));
+
+	for (size_t i = 0; i < glyphs.size(); i++) { file.write((const char*)&glyphs[i].metrics, sizeof(FontGlyph)); }
+
+	if (!kerning.empty()) { file.write((const char*)&kerning[0], kerning.size() * sizeof(FontKerning)); }
+	if (!atlas.empty()) { file.write((const char*)&atlas[0], atlas.size()); }
+
+	return file.good();
+}
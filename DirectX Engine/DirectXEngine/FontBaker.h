@@ -0,0 +1,65 @@
+#pragma once
+
+/*******************************************************************************************************************
+	FontBaker.h, FontBaker.cpp
+	Created by Kim Kane
+	Last updated: 19/10/2026
+
+	Offline tool that bakes a TrueType font in to a font file Font can memory-map (see FontFormat.h).
+
+	Each glyph is rasterized by GDI at a multiple of the baked size, then turned in to a signed distance field -
+	every texel holds how far it is from the edge of the glyph, with 0.5 on the edge. Because the edge is found
+	in the pixel shader rather than stored as coverage, one small atlas stays sharp at any size on screen.
+	Advances, bearings and kerning pairs are baked alongside it, so laying out text is just table lookups.
+
+	Baking is slow (the distance field is brute forced), so the game never does it. The project's post-build
+	step runs the game with -bakefonts, which bakes any font missing from Assets\Fonts and stops (see BakeFonts()
+	in Main.cpp) - the baked files are build output, so they're not kept in source control.
+
+*******************************************************************************************************************/
+#include <string>
+#include <vector>
+
+#include "FontFormat.h"
+
+struct FontBakeSettings
+{
+	std::string		fileLocation;
+	std::string		faceName;
+	float			pixelSize;
+	float			distanceRange;
+	unsigned int	supersample;
+	unsigned int	atlasWidth;
+	unsigned char	firstCharacter;
+	unsigned char	lastCharacter;
+};
+
+class FontBaker {
+
+public:
+	static bool Bake(const FontBakeSettings& settings, const std::string& outputFileLocation);
+
+private:
+	struct BakedGlyph
+	{
+		FontGlyph					metrics;
+		unsigned int				fieldWidth;
+		unsigned int				fieldHeight;
+		unsigned int				atlasX;
+		unsigned int				atlasY;
+		std::vector<unsigned char>	field;
+	};
+
+private:
+	FontBaker();
+	FontBaker(const FontBaker&);
+	FontBaker& operator=(const FontBaker&);
+
+private:
+	static bool RenderGlyphs(const FontBakeSettings& settings, FontHeader& header, std::vector<BakedGlyph>& glyphs, std::vector<FontKerning>& kerning);
+	static void GenerateDistanceField(const std::vector<unsigned char>& coverage, int coverageWidth, int coverageHeight,
+									  const FontBakeSettings& settings, BakedGlyph& glyph);
+	static bool PackAtlas(std::vector<BakedGlyph>& glyphs, unsigned int atlasWidth, unsigned int& atlasHeight);
+	static bool WriteFontFile(const std::string& fileLocation, FontHeader& header, const std::vector<BakedGlyph>& glyphs,
+							  const std::vector<FontKerning>& kerning);
+};
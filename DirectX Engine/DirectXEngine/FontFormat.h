@@ -0,0 +1,57 @@
+#pragma once
+
+/*******************************************************************************************************************
+	FontFormat.h
+	Created by Kim Kane
+	Last updated: 19/10/2026
+
+	The layout of a baked font file, written by FontBaker and memory-mapped by Font.
+
+	The file is one block that is used exactly as it sits on disk - a header, a table of glyph metrics, a table
+	of kerning pairs sorted by pair, and then the signed distance field atlas (one byte per texel, rows packed
+	tightly). The header holds the offset of each part from the start of the file.
+
+	Every field is 4 bytes, so the structures have no padding and the layout is the same in every build.
+	All metrics are in pixels at the size the font was baked at.
+
+*******************************************************************************************************************/
+
+namespace FontFormat {
+
+	const unsigned int Magic	= 0x4E465844;	// "DXFN"
+	const unsigned int Version	= 1;
+}
+
+struct FontHeader
+{
+	unsigned int	magic;
+	unsigned int	version;
+	unsigned int	glyphCount;
+	unsigned int	kerningCount;
+	unsigned int	atlasWidth;
+	unsigned int	atlasHeight;
+	float			pixelSize;
+	float			lineHeight;
+	float			ascent;
+	float			distanceRange;
+	unsigned int	glyphOffset;
+	unsigned int	kerningOffset;
+	unsigned int	atlasOffset;
+};
+
+struct FontGlyph
+{
+	unsigned int	character;
+	float			advance;
+	float			bearingX;
+	float			bearingY;
+	float			width;
+	float			height;
+	float			u0, v0, u1, v1;
+};
+
+struct FontKerning
+{
+	unsigned int	pair;
+	float			amount;
+};
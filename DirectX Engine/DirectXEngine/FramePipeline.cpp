@@ -0,0 +1,247 @@
+#include <chrono>
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+
+#include "FramePipeline.h"
+#include "Log.h"
+#include "Profiler.h"
+
+/*******************************************************************************************************************
+	Constructor with initializer list to set all default values of variables
+*******************************************************************************************************************/
+RenderSnapshot::RenderSnapshot()	:	state(nullptr),
+										frame(0)
+{
+}
+
+
+/*******************************************************************************************************************
+	Function that sets what a label will say when this snapshot is drawn, printf style
+*******************************************************************************************************************/
+void RenderSnapshot::SetLabel(TextLabel label, const char* format, ...)
+{
+	//-------------------------------------------- Cleared by SubmitLabels() rather than freed, so after the first frame this never allocates
+	m_labels.resize(m_labels.size() + 1);
+
+	SnapshotLabel& entry = m_labels.back();
+	entry.label = label;
+
+	va_list arguments;
+	va_start(arguments, format);
+	if (vsnprintf(entry.contents, sizeof(entry.contents), format, arguments) < 0) { entry.contents[0] = '\0'; }
+	va_end(arguments);
+}
+
+
+/*******************************************************************************************************************
+	Function that gives the labels to the text and submits it to this snapshot's queue - called on the render thread
+*******************************************************************************************************************/
+void RenderSnapshot::SubmitLabels(Text* text)
+{
+	for (unsigned int i = 0; i < m_labels.size(); i++) {
+		text->SetLabel(m_labels[i].label, "%s", m_labels[i].contents);
+	}
+
+	m_labels.clear();
+
+	text->Submit(queue);
+}
+
+
+/*******************************************************************************************************************
+	Constructor with initializer list to set all default values of variables
+*******************************************************************************************************************/
+FramePipeline::FramePipeline()	:	m_snapshotCount(0),
+									m_writeIndex(0),
+									m_readIndex(0),
+									m_inFlight(0),
+									m_frame(0),
+									m_isWriting(false),
+									m_isRunning(false),
+									m_isThreaded(false)
+{
+	memset(&m_stats, 0, sizeof(m_stats));
+}
+
+
+/*******************************************************************************************************************
+	Shut down all necessary procedures, release resources and clean up memory
+*******************************************************************************************************************/
+FramePipeline::~FramePipeline()
+{
+	Shutdown();
+}
+
+
+/*******************************************************************************************************************
+	Function that sets what draws each snapshot and starts the render thread
+*******************************************************************************************************************/
+bool FramePipeline::Initialize(const RenderFunction& render, unsigned int snapshotCount, bool threaded)
+{
+	Shutdown();
+
+	//-------------------------------------------- Less than 2 and the update thread would always be waiting on the render thread anyway
+	if (snapshotCount < 2 || snapshotCount > PipelineConstants::MaxSnapshots) {
+		DX_LOG("[FRAME PIPELINE] Snapshot count must be between 2 and ", PipelineConstants::MaxSnapshots, LOG_ERROR); return false;
+	}
+
+	m_render		= render;
+	m_snapshotCount	= snapshotCount;
+	m_writeIndex	= m_readIndex = m_inFlight = 0;
+	m_isWriting		= false;
+	m_isRunning		= true;
+	m_isThreaded	= threaded && std::thread::hardware_concurrency() > 1;
+
+	if (m_isThreaded) { m_thread = std::thread(&FramePipeline::RenderLoop, this); }
+
+	DX_LOG("[FRAME PIPELINE] Rendering on its own thread: ", (m_isThreaded ? "yes" : "no"), LOG_MESSAGE);
+
+	return true;
+}
+
+
+/*******************************************************************************************************************
+	Function that draws anything still handed over, then stops the render thread
+*******************************************************************************************************************/
+void FramePipeline::Shutdown()
+{
+	if (!m_isRunning) { return; }
+
+	Flush();
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_isRunning = false;
+	}
+
+	m_readyCondition.notify_all();
+
+	if (m_thread.joinable()) { m_thread.join(); }
+}
+
+
+/*******************************************************************************************************************
+	Function that gets the next snapshot to fill in - nullptr if every snapshot is still in use after waiting (in ms)
+*******************************************************************************************************************/
+RenderSnapshot* FramePipeline::BeginSnapshot(unsigned int timeout)
+{
+	if (!m_isRunning || m_isWriting) { return nullptr; }
+
+	std::unique_lock<std::mutex> lock(m_mutex);
+
+	if (!m_doneCondition.wait_for(lock, std::chrono::milliseconds(timeout), [this] { return m_inFlight < m_snapshotCount; })) {
+		return nullptr;
+	}
+
+	m_isWriting = true;
+
+	RenderSnapshot& snapshot = m_snapshots[m_writeIndex];
+	snapshot.frame = m_frame;
+
+	return &snapshot;
+}
+
+
+/*******************************************************************************************************************
+	Function that hands the snapshot being filled in over to be drawn
+*******************************************************************************************************************/
+void FramePipeline::EndSnapshot()
+{
+	if (!m_isWriting) { return; }
+
+	m_isWriting = false;
+	m_frame++;
+
+	if (!m_isThreaded) {
+		Render(m_snapshots[m_writeIndex]);
+		m_writeIndex = (m_writeIndex + 1) % m_snapshotCount;
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_writeIndex = (m_writeIndex + 1) % m_snapshotCount;
+		m_inFlight++;
+	}
+
+	m_readyCondition.notify_one();
+}
+
+
+/*******************************************************************************************************************
+	Function that waits until every snapshot handed over has been drawn
+*******************************************************************************************************************/
+void FramePipeline::Flush()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_doneCondition.wait(lock, [this] { return m_inFlight == 0; });
+}
+
+
+/*******************************************************************************************************************
+	Function that the render thread runs - draws each snapshot as it's handed over, in order
+*******************************************************************************************************************/
+void FramePipeline::RenderLoop()
+{
+	DX_PROFILE_THREAD("Render");
+
+	for (;;) {
+		unsigned int index;
+
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_readyCondition.wait(lock, [this] { return m_inFlight > 0 || !m_isRunning; });
+
+			if (m_inFlight == 0) { return; }
+
+			index = m_readIndex;
+		}
+
+		//-------------------------------------------- Drawn outside the lock - the update thread never touches a snapshot that's in flight
+		Render(m_snapshots[index]);
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_readIndex = (m_readIndex + 1) % m_snapshotCount;
+			m_inFlight--;
+		}
+
+		m_doneCondition.notify_all();
+	}
+}
+
+
+/*******************************************************************************************************************
+	Function that draws one snapshot and keeps its stats, so they can be shown on a later frame
+*******************************************************************************************************************/
+void FramePipeline::Render(RenderSnapshot& snapshot)
+{
+	{
+		DX_PROFILE_SCOPE("Render");
+		m_render(snapshot);
+	}
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_stats = snapshot.queue.GetStats();
+}
+
+
+/*******************************************************************************************************************
+	Accessor Methods
+*******************************************************************************************************************/
+RenderStats FramePipeline::GetStats() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_stats;
+}
+
+
+unsigned int FramePipeline::GetFramesInFlight() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_inFlight;
+}
+
+
+bool FramePipeline::IsThreaded() const { return m_isThreaded; }
@@ -0,0 +1,123 @@
+#pragma once
+
+/*******************************************************************************************************************
+	FramePipeline.h, FramePipeline.cpp
+	Created by Kim Kane
+	Last updated: 19/10/2026
+
+	Runs rendering on its own thread, so the game can update frame N+1 while frame N is being drawn.
+
+	The update thread (the main thread) fills in a RenderSnapshot - the camera, the render queue (which already
+	holds a copy of every visible object's world matrix, and of any pose or bone palette it's drawn with) and
+	any text - and hands it over. From then on the
+	snapshot belongs to the render thread, which draws it and gives it back. Nothing in a snapshot is changed
+	by the update thread while it's being drawn, so the two threads never need to lock anything else.
+
+	There are a fixed number of snapshots, used in turn. With 3, one is being drawn, one is waiting and one
+	is being filled, so what's on screen is never more than 2 updates behind the game. When every snapshot is
+	in use the update thread waits, but only for a moment at a time - so it can keep handling windows messages,
+	which Present() on the render thread may be waiting on.
+
+	The render thread is the only thread that uses the immediate context while the pipeline is running. Flush()
+	waits until everything handed over has been drawn, for anything that has to use it from the main thread
+	(or delete what a snapshot points at). On a single core machine, snapshots are drawn straight away on the
+	update thread instead.
+
+*******************************************************************************************************************/
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Camera.h"
+#include "RenderQueue.h"
+#include "Text.h"
+#include "Constants.h"
+
+class GameState;
+
+//-------------------------------------------- Everything the render thread needs to draw one frame, filled in by the update thread
+struct RenderSnapshot
+{
+public:
+	RenderSnapshot();
+
+public:
+	void SetLabel(TextLabel label, const char* format, ...);
+	void SubmitLabels(Text* text);
+
+public:
+	GameState*		state;
+	unsigned int	frame;
+
+	Camera			camera;
+	RenderQueue		queue;
+
+private:
+	RenderSnapshot(const RenderSnapshot&);
+	RenderSnapshot& operator=(const RenderSnapshot&);
+
+private:
+	//-------------------------------------------- Label text is formatted on the update thread, but only given to the Text on the render thread
+	struct SnapshotLabel
+	{
+		TextLabel	label;
+		char		contents[Text::MAX_LABEL_LENGTH + 1];
+	};
+
+	std::vector<SnapshotLabel>	m_labels;
+};
+
+class FramePipeline {
+
+public:
+	typedef std::function<void(RenderSnapshot&)> RenderFunction;
+
+public:
+	FramePipeline();
+	~FramePipeline();
+
+public:
+	bool Initialize(const RenderFunction& render, unsigned int snapshotCount = PipelineConstants::SnapshotCount, bool threaded = true);
+	void Shutdown();
+
+public:
+	RenderSnapshot* BeginSnapshot(unsigned int timeout);
+	void EndSnapshot();
+	void Flush();
+
+public:
+	RenderStats GetStats() const;
+	unsigned int GetFramesInFlight() const;
+	bool IsThreaded() const;
+
+private:
+	FramePipeline(const FramePipeline&);
+	FramePipeline& operator=(const FramePipeline&);
+
+private:
+	void RenderLoop();
+	void Render(RenderSnapshot& snapshot);
+
+private:
+	RenderFunction				m_render;
+	RenderSnapshot				m_snapshots[PipelineConstants::MaxSnapshots];
+	unsigned int				m_snapshotCount;
+
+	//-------------------------------------------- Snapshots are handed over in order - the next to fill, the next to draw, and how many are handed over but not yet drawn
+	unsigned int				m_writeIndex;
+	unsigned int				m_readIndex;
+	unsigned int				m_inFlight;
+	unsigned int				m_frame;
+	bool						m_isWriting;
+
+	std::thread					m_thread;
+	mutable std::mutex			m_mutex;
+	std::condition_variable		m_readyCondition;
+	std::condition_variable		m_doneCondition;
+	bool						m_isRunning;
+	bool						m_isThreaded;
+
+	RenderStats					m_stats;
+};
@@ -4,6 +4,7 @@
 #include "Frustum.h"
 #include "ScreenManager.h"
 #include "Constants.h"
+#include "Profiler.h"
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 Frustum::Frustum()
@@ -18,6 +19,8 @@ Frustum::~Frustum()
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 void Frustum::Create(XMMATRIX view)
 {
+    DX_PROFILE_FUNCTION();
+
     float zMin, r;
     XMMATRIX matrix, proj;
 
@@ -0,0 +1,114 @@
+#include <algorithm>
+#include <cmath>
+
+#include "GameLoop.h"
+
+/*******************************************************************************************************************
+	Constructor with initializer list to set all default values of variables
+*******************************************************************************************************************/
+GameLoop::GameLoop()	:	m_clock(nullptr),
+							m_timeStep(LoopConstants::TimeStep),
+							m_maxStepsPerFrame(LoopConstants::MaxStepsPerFrame),
+							m_lastTime(0.0),
+							m_accumulator(0.0),
+							m_interpolation(0.0f),
+							m_frameCap(0.0f),
+							m_nextFrameTime(0.0)
+{
+}
+
+
+/*******************************************************************************************************************
+	Shut down all necessary procedures, release resources and clean up memory
+*******************************************************************************************************************/
+GameLoop::~GameLoop()
+{
+	//-------------------------------------------- The clock belongs to whoever handed it over
+}
+
+
+/*******************************************************************************************************************
+	Function that sets the clock the loop runs from and the fixed step it updates by (in seconds)
+*******************************************************************************************************************/
+void GameLoop::Initialize(Clock* clock, float timeStep, unsigned int maxStepsPerFrame)
+{
+	m_clock				= clock;
+	m_timeStep			= timeStep;
+	m_maxStepsPerFrame	= maxStepsPerFrame;
+
+	Reset();
+}
+
+
+/*******************************************************************************************************************
+	Function that starts timing again from now - used when a state starts, so the time it took to load isn't caught up
+*******************************************************************************************************************/
+void GameLoop::Reset()
+{
+	m_lastTime		= m_clock->GetTime();
+	m_nextFrameTime	= m_lastTime;
+	m_accumulator	= 0.0;
+	m_interpolation	= 0.0f;
+}
+
+
+/*******************************************************************************************************************
+	Function that adds the time since the last frame and gives how many fixed steps to update by this frame
+*******************************************************************************************************************/
+unsigned int GameLoop::BeginFrame()
+{
+	double currentTime = m_clock->GetTime();
+
+	m_accumulator += currentTime - m_lastTime;
+	m_lastTime = currentTime;
+
+	unsigned int steps = (unsigned int)(m_accumulator / m_timeStep);
+
+	//-------------------------------------------- After a long stall, drop the time that couldn't be caught up rather than trying to catch up forever
+	if (steps > m_maxStepsPerFrame) {
+		steps			= m_maxStepsPerFrame;
+		m_accumulator	= fmod(m_accumulator, (double)m_timeStep);
+	}
+	else {
+		m_accumulator -= steps * (double)m_timeStep;
+	}
+
+	m_interpolation = (float)(m_accumulator / m_timeStep);
+
+	return steps;
+}
+
+
+/*******************************************************************************************************************
+	Function that waits for this frame's slot to end, if there's a frame cap
+*******************************************************************************************************************/
+void GameLoop::EndFrame()
+{
+	if (m_frameCap <= 0.0f) { return; }
+
+	m_nextFrameTime += 1.0 / m_frameCap;
+
+	//-------------------------------------------- Frames that run late don't get to make it up by running the next ones back to back - the schedule starts again from now
+	double currentTime = m_clock->GetTime();
+
+	if (m_nextFrameTime > currentTime)	{ m_clock->WaitUntil(m_nextFrameTime); }
+	else								{ m_nextFrameTime = currentTime; }
+}
+
+
+/*******************************************************************************************************************
+	Accessor Methods
+*******************************************************************************************************************/
+float GameLoop::GetTimeStep() const			{ return m_timeStep; }
+float GameLoop::GetInterpolation() const	{ return m_interpolation; }
+float GameLoop::GetFrameCap() const			{ return m_frameCap; }
+
+
+/*******************************************************************************************************************
+	Modifier Methods
+*******************************************************************************************************************/
+void GameLoop::SetFrameCap(float framesPerSecond)
+{
+	m_frameCap		= (std::max)(framesPerSecond, 0.0f);
+	m_nextFrameTime	= (m_clock) ? m_clock->GetTime() : 0.0;
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+/*******************************************************************************************************************
+	GameLoop.h, GameLoop.cpp
+	Created by Kim Kane
+	Last updated: 19/10/2026
+
+	Decides how many fixed steps the game state takes each frame, how far between steps each frame is drawn,
+	and how long to wait before the next frame starts.
+
+	Every frame, the time since the last frame is added to an accumulator, and the state is updated once for
+	every whole step that fits - so the game plays the same at 30 or 300 frames per second. What's left over is
+	how far the game is between its last step and its next, and the state draws everything that far along.
+	After a long stall (a breakpoint, a window drag) only a few steps are taken and the rest is dropped, rather
+	than the game trying to catch up forever.
+
+	With a frame cap, each frame is given a slot on a fixed schedule and the loop waits for the next slot. The
+	wait sleeps for most of it and spins for the last moment, as Sleep() can wake up a millisecond or more late.
+
+	Time comes from a Clock, so the loop can be driven by a FakeClock to test it without waiting.
+
+*******************************************************************************************************************/
+#include "Clock.h"
+#include "Constants.h"
+
+class GameLoop {
+
+public:
+	GameLoop();
+	~GameLoop();
+
+public:
+	void Initialize(Clock* clock, float timeStep = LoopConstants::TimeStep, unsigned int maxStepsPerFrame = LoopConstants::MaxStepsPerFrame);
+	void Reset();
+
+public:
+	unsigned int BeginFrame();
+	void EndFrame();
+
+public:
+	float GetTimeStep() const;
+	float GetInterpolation() const;
+	float GetFrameCap() const;
+
+public:
+	void SetFrameCap(float framesPerSecond);
+
+private:
+	GameLoop(const GameLoop&);
+	GameLoop& operator=(const GameLoop&);
+
+private:
+	Clock*			m_clock;
+
+	float			m_timeStep;
+	unsigned int	m_maxStepsPerFrame;
+
+	//-------------------------------------------- Kept in doubles, so hours of small frame times don't drift
+	double			m_lastTime;
+	double			m_accumulator;
+	float			m_interpolation;
+
+	float			m_frameCap;
+	double			m_nextFrameTime;
+};
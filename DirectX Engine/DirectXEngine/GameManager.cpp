@@ -3,6 +3,12 @@
 #include "ScreenManager.h"
 #include "GraphicsManager.h"
 #include "InputManager.h"
+#include "ShaderManager.h"
+#include "AnimationLibrary.h"
+#include "Texture.h"
+#include "Profiler.h"
+#include "EventLog.h"
+#include "EventDecoder.h"
 
 /*******************************************************************************************************************
 	Constructor with initializer list to set default values of data members
@@ -20,10 +26,28 @@ GameManager::GameManager()	:	m_endGame(false),
 *******************************************************************************************************************/
 void GameManager::Shutdown()
 {
+	//---------------------------------------------------------------- Stop the render thread first, as anything after this may be what it's drawing with
+	m_pipeline.Shutdown();
+
+	Animations::Instance()->Shutdown();
+	Shaders::Instance()->Shutdown();
+	Texture::ReleaseSamplerFilters();
+
 	Input::Instance()->Shutdown();
 	Graphics::Instance()->Shutdown();
 	Screen::Instance()->Shutdown();
 
+	//---------------------------------------------------------------- Stop recording events last, so everything up to here is in the file
+	bool wasRecording = EventLog::IsRunning();
+	EventLog::Shutdown();
+
+#if DEBUG_MODE == 1
+	//---------------------------------------------------------------- Turn the events back in to text, ready to read
+	if (wasRecording && !EventDecoder::Decode(EventLogConstants::LogFile, EventLogConstants::TextFile)) {
+		DX_LOG("[GAME] Couldn't decode the event file: ", EventLogConstants::LogFile.c_str(), LOG_WARN);
+	}
+#endif
+
 	DX_LOG("[GAME] Game shutdown successfully", DX_LOG_EMPTY, LOG_SUCCESS);
 }
 
@@ -31,8 +55,11 @@ void GameManager::Shutdown()
 /*******************************************************************************************************************
 	Initialize all start up procedures specific to the game
 *******************************************************************************************************************/
-bool GameManager::Initialize(HINSTANCE instance, LPCSTR title, bool fullScreen, bool vSync)
+bool GameManager::Initialize(HINSTANCE instance, LPCSTR title, bool fullScreen, bool vSync, bool recordEvents)
 {
+	//---------------------------------------------------------------- Start recording events first, so start up is in the file too - the game still runs without it
+	if (recordEvents) { EventLog::Initialize(EventLogConstants::LogFile); }
+
 	//---------------------------------------------------------------- Intialize the window and screen settings
 	Screen::Instance()->Initialize(instance, title,
 								   ScreenConstants::SCREEN_WIDTH,
@@ -45,6 +72,21 @@ bool GameManager::Initialize(HINSTANCE instance, LPCSTR title, bool fullScreen,
 	//---------------------------------------------------------------- Initialize the direct input
 	Input::Instance()->Initialize();
 
+	//---------------------------------------------------------------- Vsync already paces the frames, otherwise cap them so the loop doesn't spin flat out
+	m_loop.Initialize(&m_clock);
+	m_loop.SetFrameCap(vSync ? 0.0f : LoopConstants::FrameCap);
+
+	//---------------------------------------------------------------- Start the render thread - from here on only it uses the immediate context
+	m_pipeline.Initialize([](RenderSnapshot& snapshot) {
+
+#if DEBUG_MODE == 1
+		//---------------------------------------------------------------- Pick up any shader source files that have been edited while the game is running - between frames, so nothing is using the old ones
+		Shaders::Instance()->ReloadModifiedShaders();
+#endif
+
+		snapshot.state->Render(snapshot);
+	});
+
 	//---------------------------------------------------------------- Initialize a new menu state
 	m_gameStates.push_front(new MenuState(nullptr));
 
@@ -58,41 +100,65 @@ bool GameManager::Initialize(HINSTANCE instance, LPCSTR title, bool fullScreen,
 int GameManager::Run() {
 
 	//---------------------------------------------------------------- Initialize all our trackers - Delta time, FPS, CPU
-	Tracker::Initialize();
+	Tracker::Initialize(&m_clock);
+	DX_PROFILE_THREAD("Main");
 
 	MSG message = { 0 };
 
 	//---------------------------------------------------------------- Loop until there is a quit message from the window or the user, or until the game state deque is empty
 	while (!m_endGame)
 	{
-		//---------------------------------------------------------------- Get the state at the front of the deque
+		//---------------------------------------------------------------- Get the state at the front of the deque, and start timing from now so its loading time isn't caught up
 		m_state = m_gameStates.front();
+		m_loop.Reset();
 
 		//---------------------------------------------------------------- Loop as long as atleast one game state is active
 		while (m_state->IsActive()) {
 
-			//---------------------------------------------------------------- Update tracker data every frame
-			Tracker::Update();
+			DX_PROFILE_SCOPE("Frame");
+
+			//---------------------------------------------------------------- If windows signals to end the application then exit out, making sure to kill the current game state so the end game flag is set
+			if (!HandleMessages(message)) { m_state->IsActive() = m_state->IsAlive() = false; break; }
+
+			//---------------------------------------------------------------- Update the current state by fixed steps (in milliseconds), as many as fit in the time since the last frame
+			unsigned int steps = m_loop.BeginFrame();
 
-			//---------------------------------------------------------------- Handle the windows messages
-			if (PeekMessage(&message, nullptr, 0, 0, PM_REMOVE))
+			for (unsigned int i = 0; i < steps && m_state->IsActive(); i++) {
+				DX_PROFILE_SCOPE("Update");
+				m_state->Update(m_loop.GetTimeStep() * 1000.0f);
+			}
+
+			if (!m_state->IsActive()) { break; }
+
+			//---------------------------------------------------------------- Only draw once the render thread has a snapshot free - otherwise go round again, so windows messages are still handled while waiting
+			RenderSnapshot* snapshot = nullptr;
 			{
-				TranslateMessage(&message);
-				DispatchMessage(&message);
+				DX_PROFILE_SCOPE("Wait For Render");
+				snapshot = m_pipeline.BeginSnapshot(PipelineConstants::SnapshotWait);
 			}
 
-			//---------------------------------------------------------------- If windows signals to end the application then exit out, making sure to kill the current game state so the end game flag is set
-			if (message.message == WM_QUIT) { m_state->IsActive() = m_state->IsAlive() = false; }
-			else
+			if (!snapshot) { continue; }
+
+			//---------------------------------------------------------------- Update tracker data every frame
+			Tracker::Update();
+
+			//---------------------------------------------------------------- Fill in the snapshot part way to the state's next step and hand it to the render thread, then wait out the rest of the frame if there is a frame cap
 			{
-				//---------------------------------------------------------------- Otherwise update and render the current active game state
-				m_state->Update(Tracker::GetTime());
-				m_state->Draw();
+				DX_PROFILE_SCOPE("Draw");
+				snapshot->state = m_state;
+				m_state->Draw(*snapshot, m_loop.GetInterpolation());
+				m_pipeline.EndSnapshot();
 			}
+
+			//---------------------------------------------------------------- Collect every thread's profiled zones - the frames before this one, as this one is still being timed
+			DX_PROFILE_FRAME();
+
+			DX_PROFILE_SCOPE("Frame Cap");
+			m_loop.EndFrame();
 		}
 
-		//---------------------------------------------------------------- If a game state is not alive, delete it from heap memory and remove it from the game states deque
-		if (!m_state->IsAlive())	{ RemoveState(); }
+		//---------------------------------------------------------------- If a game state is not alive, wait for the render thread to finish with it, then delete it from heap memory and remove it from the game states deque
+		if (!m_state->IsAlive())	{ m_pipeline.Flush(); RemoveState(); }
 
 		//---------------------------------------------------------------- If no game states are alive or active, set end game to true and exit out of game loop
 		if (m_gameStates.empty())	{ m_endGame = true; }
@@ -106,6 +172,24 @@ int GameManager::Run() {
 }
 
 
+/*******************************************************************************************************************
+	Function that handles every waiting windows message - returns false once windows has asked the game to quit
+*******************************************************************************************************************/
+bool GameManager::HandleMessages(MSG& message)
+{
+	//---------------------------------------------------------------- Empty the whole queue, so input doesn't back up behind a slow frame - once quit has come, it stays, so every state left is ended too
+	while (message.message != WM_QUIT && PeekMessage(&message, nullptr, 0, 0, PM_REMOVE))
+	{
+		if (message.message == WM_QUIT) { break; }
+
+		TranslateMessage(&message);
+		DispatchMessage(&message);
+	}
+
+	return (message.message != WM_QUIT);
+}
+
+
 /*******************************************************************************************************************
 	Function that adds a temporary game state to the front of the deque (e.g. Pause)
 *******************************************************************************************************************/
@@ -118,6 +202,12 @@ void GameManager::TemporaryState(GameState* state) { m_gameStates.push_front(sta
 void GameManager::PermanentState(GameState* state) { m_gameStates.push_back(state); }
 
 
+/*******************************************************************************************************************
+	Function that gets the stats of the last frame the render thread finished drawing
+*******************************************************************************************************************/
+RenderStats GameManager::GetRenderStats() const { return m_pipeline.GetStats(); }
+
+
 /*******************************************************************************************************************
 	Function that deletes the game state at the front of the deque and removes the game state from the deque
 *******************************************************************************************************************/
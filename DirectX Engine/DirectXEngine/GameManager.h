@@ -13,6 +13,8 @@
 
 #include "Singleton.h"
 #include "Tracker.h"
+#include "GameLoop.h"
+#include "FramePipeline.h"
 #include "GameState.h"
 #include "MenuState.h"
 #include "PlayState.h"
@@ -25,7 +27,7 @@ public:
 	friend class Singleton<GameManager>;
 
 public:
-	bool Initialize(HINSTANCE instance, LPCSTR title, bool fullScreen, bool vSync);
+	bool Initialize(HINSTANCE instance, LPCSTR title, bool fullScreen, bool vSync, bool recordEvents = false);
 	void Shutdown();
 	int Run();
 
@@ -33,6 +35,9 @@ public:
 	void TemporaryState(GameState* state);
 	void PermanentState(GameState* state);
 
+public:
+	RenderStats GetRenderStats() const;
+
 private:
 	GameManager();
 	GameManager(const GameManager&);
@@ -40,11 +45,16 @@ private:
 
 private:
 	void RemoveState();
+	bool HandleMessages(MSG& message);
 
 private:
 	bool		m_endGame;
 	GameState*	m_state;
 
+	SystemClock			m_clock;
+	GameLoop			m_loop;
+	FramePipeline		m_pipeline;
+
 private:
 	std::deque<GameState*> m_gameStates;
 };
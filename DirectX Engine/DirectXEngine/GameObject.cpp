@@ -3,59 +3,106 @@
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 #include "GameObject.h"
 #include "GraphicsManager.h"
+#include "ShaderManager.h"
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-GameObject::GameObject() 
+GameObject::GameObject() : _Collider(INVALID_COLLIDER), _ObjectModel(nullptr), _ObjectTexture(nullptr), m_basicShader(nullptr)
 {
+    _Transform = Transforms::Instance()->Create(XMFLOAT3(0.0f, 0.0f, 0.0f));
 }
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-GameObject::GameObject(const XMFLOAT3& Position, Model* Model, Texture* texture)
+GameObject::GameObject(const XMFLOAT3& Position, Model* Model, Texture* texture) : _Collider(INVALID_COLLIDER)
 {
-    _Position = XMLoadFloat3(&Position);
-	_Direction = DEFAULT_FORWARD;
-	_RotationMatrix = XMMatrixIdentity();
-	_WorldMatrix = XMMatrixIdentity();
+    _Transform = Transforms::Instance()->Create(Position);
 	_ObjectModel = Model;
 	_ObjectTexture = texture;
-    _Rotation = XMVectorSet(0,0,0,0);
-    
-    UpdateWorldMatrix();
 
-	//Shouldn't be done here - either a rendering engine or create shaders in gamestates and pass in to
-	//render function of game objects
-	m_basicShader.LoadShader(L"basicShader.vs", L"basicShader.ps");
+	//Every game object shares the same compiled shader, so this only compiles it for the first object
+	m_basicShader = Shaders::Instance()->GetProgram<BasicShader>(L"basicShader.vs", L"basicShader.ps");
 }
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 GameObject::~GameObject()
 {
+    Collisions::Instance()->Release(_Collider);
+    Transforms::Instance()->Release(_Transform);
 }
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-const XMVECTOR& GameObject::GetPosition() const
+XMVECTOR GameObject::GetPosition() const
 {
-	return _Position;
+    XMFLOAT3 position = Transforms::Instance()->GetPosition(_Transform);
+	return XMLoadFloat3(&position);
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+void GameObject::SetPosition(const XMFLOAT3& position)
+{
+    Transforms::Instance()->SetPosition(_Transform, position);
 }
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 const XMFLOAT3 GameObject::GetPositionF() const
 {
-    XMFLOAT3 temp;
-    XMStoreFloat3(&temp, _Position);
-    return temp;
+    return Transforms::Instance()->GetPosition(_Transform);
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+XMMATRIX GameObject::GetRotationY() const
+{
+	return Transforms::Instance()->GetRotationMatrix(_Transform);
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+XMMATRIX GameObject::GetWorldMatrix()
+{
+	return Transforms::Instance()->GetWorldMatrix(_Transform);
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+XMVECTOR GameObject::GetForward() const
+{
+    //worked out from the rotation each time, so it can never drift away from it.
+    return XMVector3Rotate(XMVectorSet(0.0f, 0.0f, 1.0f, 0.0f), Transforms::Instance()->GetRotation(_Transform));
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+XMVECTOR GameObject::GetRight() const
+{
+    return XMVector3Rotate(XMVectorSet(1.0f, 0.0f, 0.0f, 0.0f), Transforms::Instance()->GetRotation(_Transform));
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+XMVECTOR GameObject::GetUp() const
+{
+    return XMVector3Rotate(XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f), Transforms::Instance()->GetRotation(_Transform));
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+TransformHandle GameObject::GetTransform() const
+{
+	return _Transform;
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+void GameObject::AddSphereCollider(const XMFLOAT3& Center, float Radius)
+{
+    Collisions::Instance()->Release(_Collider);
+    _Collider = Collisions::Instance()->CreateSphere(_Transform, Center, Radius);
 }
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-const XMMATRIX& GameObject::GetRotationY()
+void GameObject::AddBoxCollider(const XMFLOAT3& Center, const XMFLOAT3& HalfExtents)
 {
-	return _RotationMatrix;
+    Collisions::Instance()->Release(_Collider);
+    _Collider = Collisions::Instance()->CreateBox(_Transform, Center, HalfExtents);
 }
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-const XMMATRIX& GameObject::GetWorldMatrix()
+Collider GameObject::GetCollider() const
 {
-	return _WorldMatrix;
+	return _Collider;
 }
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
@@ -73,70 +120,43 @@ Texture* GameObject::GetTexture() const
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 void GameObject::RotateX(float angle)
 {
-    _Rotation = XMVectorSet(XMVectorGetX(_Rotation) + angle, XMVectorGetY(_Rotation), XMVectorGetZ(_Rotation), XMVectorGetW(_Rotation));
-    CalculateRotationMatrix();
-    UpdateWorldMatrix();
+    Transforms::Instance()->Rotate(_Transform, XMQuaternionRotationNormal(XMVectorSet(1.0f, 0.0f, 0.0f, 0.0f), angle));
 }
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 void GameObject::RotateY(float angle)
 {
-    _Rotation = XMVectorSet(XMVectorGetX(_Rotation), XMVectorGetY(_Rotation) + angle, XMVectorGetZ(_Rotation), XMVectorGetW(_Rotation));
-    CalculateRotationMatrix();
-	UpdateWorldMatrix();
+    Transforms::Instance()->Rotate(_Transform, XMQuaternionRotationNormal(XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f), angle));
 }
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 void GameObject::RotateZ(float angle)
 {
-    _Rotation = XMVectorSet(XMVectorGetX(_Rotation), XMVectorGetY(_Rotation), XMVectorGetZ(_Rotation) + angle, XMVectorGetW(_Rotation));
-    CalculateRotationMatrix();
-    UpdateWorldMatrix();
+    Transforms::Instance()->Rotate(_Transform, XMQuaternionRotationNormal(XMVectorSet(0.0f, 0.0f, 1.0f, 0.0f), angle));
 }
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 void GameObject::TranslateX(float distance)
 {
-	XMMATRIX translation = XMMatrixTranslation(distance, 0, 0);
-	_Position = XMVector3Transform(_Position, translation);
-	UpdateWorldMatrix();
+    Transforms::Instance()->Translate(_Transform, distance, 0.0f, 0.0f);
 }
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 void GameObject::TranslateY(float distance)
 {
-	XMMATRIX translation = XMMatrixTranslation(0, distance, 0);
-	_Position = XMVector3Transform(_Position, translation);
-	UpdateWorldMatrix();
+    Transforms::Instance()->Translate(_Transform, 0.0f, distance, 0.0f);
 }
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 void GameObject::TranslateZ(float distance)
 {
-	XMMATRIX translation = XMMatrixTranslation(0, 0, distance);
-	_Position = XMVector3Transform(_Position, translation);
-	UpdateWorldMatrix();
+    Transforms::Instance()->Translate(_Transform, 0.0f, 0.0f, distance);
 }
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 void GameObject::Translate(const XMVECTOR & translation)
 {
-    _Position += translation;
-    UpdateWorldMatrix();
-}
-
-//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-void GameObject::UpdateWorldMatrix()
-{
-	XMMATRIX translation = XMMatrixTranslation(XMVectorGetX(_Position), XMVectorGetY(_Position), XMVectorGetZ(_Position));
-	_WorldMatrix = _RotationMatrix*translation;
-}
-
-//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-void GameObject::CalculateRotationMatrix()
-{
-    _RotationMatrix = XMMatrixRotationRollPitchYaw(XMVectorGetX(_Rotation), XMVectorGetY(_Rotation), XMVectorGetZ(_Rotation));
-    _Direction = XMVector3Transform(_Direction, _RotationMatrix);
+    Transforms::Instance()->Translate(_Transform, XMVectorGetX(translation), XMVectorGetY(translation), XMVectorGetZ(translation));
 }
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
@@ -148,11 +168,22 @@ void GameObject::Update()
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 void GameObject::Render(Camera* camera) {
 	
-	m_basicShader.Bind(_WorldMatrix, camera, _ObjectTexture);
+	if (!m_basicShader) { return; }
+
+	XMMATRIX worldMatrix = GetWorldMatrix();
+	m_basicShader->Bind(worldMatrix, camera, _ObjectTexture);
 
 	_ObjectModel->Render();
 }
 
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+void GameObject::Submit(RenderQueue& queue) {
+
+	if (!m_basicShader || !_ObjectModel) { return; }
+
+	queue.Submit(LAYER_OPAQUE, m_basicShader, _ObjectTexture, _ObjectModel, GetWorldMatrix(), GetPositionF());
+}
+
 void GameObject::SetModel(Model * Model)
 {
     _ObjectModel = Model;
@@ -20,11 +20,19 @@
 #include "Model.h"
 #include "Texture.h"
 #include "BasicShader.h"
+#include "RenderQueue.h"
 #include "AlignedAllocationPolicy.h"
+#include "TransformManager.h"
+#include "CollisionWorld.h"
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 //  This class is the base class for all objects in the entire game. This class deals with
 //  the most fundamental data for all game objects. eg.Position, Direction, WorldMatrix etc.
+//
+//  The position, rotation and scale live in the transform manager, not in the object, so
+//  they're packed together with every other object's. Moving or rotating only marks the
+//  transform dirty, the world matrix is rebuilt once when it's next needed. Rotations are
+//  quaternions, and the facing directions are worked out from them when asked for.
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 class GameObject : public AlignedAllocationPolicy<BYTE_16>
 {
@@ -45,19 +53,18 @@ public:
     //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
     //  Default Destructor
     //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-	~GameObject();
+	virtual ~GameObject();
 
     //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
     //  Gets the game objects current position.
     //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-	const XMVECTOR& GetPosition() const;
-
-	//collision test
-	void SetPosition(XMFLOAT3 position) { 
-		
+	XMVECTOR GetPosition() const;
 
-		_Position = XMLoadFloat3(&position);
-	}
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    //  Moves the game object to the position given.
+    //  --Position-- The new position in the game scene.
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+	void SetPosition(const XMFLOAT3& Position);
 
     //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
     //  Gets the game objects current position as a float 3
@@ -67,12 +74,51 @@ public:
     //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
     //  Gets the game objects current rotation matrix for Y axis.
     //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-	const XMMATRIX& GetRotationY();
+	XMMATRIX GetRotationY() const;
 
     //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
     //  Gets the game objects current world matrix.
     //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-	const XMMATRIX& GetWorldMatrix();
+	XMMATRIX GetWorldMatrix();
+
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    //  Gets the direction the game object is facing.
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+	XMVECTOR GetForward() const;
+
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    //  Gets the direction to the game object's right.
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+	XMVECTOR GetRight() const;
+
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    //  Gets the game object's up direction.
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+	XMVECTOR GetUp() const;
+
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    //  Gets the handle to the game objects transform in the transform manager.
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+	TransformHandle GetTransform() const;
+
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    //  Gives the game object a sphere to collide with, replacing any collider it had.
+    //  --Center-- The middle of the sphere, relative to the game objects position.
+    //  --Radius-- The radius of the sphere.
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    void AddSphereCollider(const XMFLOAT3& Center, float Radius);
+
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    //  Gives the game object an axis aligned box to collide with, replacing any collider it had.
+    //  --Center--      The middle of the box, relative to the game objects position.
+    //  --HalfExtents-- Half the size of the box along each axis.
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    void AddBoxCollider(const XMFLOAT3& Center, const XMFLOAT3& HalfExtents);
+
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    //  Gets the handle to the game objects collider, or INVALID_COLLIDER if it has none.
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+	Collider GetCollider() const;
 
     //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
     //  Gets a pointer to the game objects 3D model.
@@ -85,19 +131,19 @@ public:
 	Texture* GetTexture() const;
 
     //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-    //  Rotates the game object about its X axis by the number of degrees supplied.
+    //  Rotates the game object about its own X axis by the number of radians supplied.
     //  --Angle-- The angle to rotate the game object by.
     //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
     void RotateX(float Angle);
 
     //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-    //  Rotates the game object about its Y axis by the number of degrees supplied.
+    //  Rotates the game object about its own Y axis by the number of radians supplied.
     //  --Angle-- The angle to rotate the game object by.
     //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 	void RotateY(float Angle);
 
     //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-    //  Rotates the game object about its Z axis by the number of degrees supplied.
+    //  Rotates the game object about its own Z axis by the number of radians supplied.
     //  --Angle-- The angle to rotate the game object by.
     //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
     void RotateZ(float Angle);
@@ -137,6 +183,12 @@ public:
     //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 	void Render(Camera* Camera);
 
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    //  Adds the game object to the render queue, to be drawn when the queue executes.
+    //  --Queue--  The render queue for this frame.
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+	virtual void Submit(RenderQueue& Queue);
+
 protected:
     //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
     //  Allows the 3D model to be changed, but only by child classes such as the animated object.
@@ -146,32 +198,20 @@ protected:
 
 private:
     //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-    //  Allows the Game Object to change world matrix. Use everytime something is modified.
-    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-	void UpdateWorldMatrix();
-
-    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-    //  Calculates a new rotation matrix. For in class use only.
+    //  Game objects own their transform, so copying one would release it twice.
     //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-    void CalculateRotationMatrix();
+    GameObject(const GameObject&);
+    GameObject& operator=(const GameObject&);
 
     //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
     //  Member Variables.
     //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-	const XMVECTOR DEFAULT_UP = XMVectorSet( 0.0f, 1.0f, 0.0f , 0.0f);      // Game Object Default Up Direction
-	const XMVECTOR DEFAULT_FORWARD = XMVectorSet(0.0f, 0.0f, 1.0f, 0.0f);   // Game Object Default Forward Direction
-	const XMVECTOR DEFAULT_RIGHT = XMVectorSet(1.0f, 0.0f, 0.0f, 0.0f);     // Game Object Default Right Direction
-
-    XMVECTOR _Rotation;         // Game Object Pitch/Yaw/Roll Rotation
-
-	XMVECTOR _Position;         // Game Object Position Vector
-	XMVECTOR _Direction;        // Game Object Direction Vector
-	XMMATRIX _RotationMatrix;   // Game Object Y Axis Rotational Matrix
-	XMMATRIX _WorldMatrix;      // Game Object World Matrix
+    TransformHandle _Transform; // Game Object Position/Rotation/Scale in the transform manager
+    Collider        _Collider;  // Game Object bounding volume in the collision world
 
 	Model*			_ObjectModel;   // Game Object 3D Model Pointer
 	Texture*		_ObjectTexture; // Game Object Model Texture Pointer
 
 	ID3D11Buffer*	m_worldBuffer;
-	BasicShader		m_basicShader;
+	BasicShader*	m_basicShader;  // Shared shader owned by the shader manager
 };
\ No newline at end of file
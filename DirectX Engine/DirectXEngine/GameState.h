@@ -10,6 +10,8 @@
 *******************************************************************************************************************/
 #include "Camera.h"
 
+struct RenderSnapshot;
+
 class GameState {
 
 public:
@@ -18,8 +20,11 @@ public:
 	GameState(const GameState& other);
 
 public:
-	virtual void Update(float deltaTime)	= 0;
-	virtual void Draw()						= 0;
+	virtual void Update(float deltaTime)							= 0;
+
+	//-------------------------------------------- Draw fills in a snapshot on the main thread, Render draws it later on the render thread
+	virtual void Draw(RenderSnapshot& snapshot, float interpolation)	= 0;
+	virtual void Render(RenderSnapshot& snapshot)						= 0;
 
 public:
 	bool& IsActive();
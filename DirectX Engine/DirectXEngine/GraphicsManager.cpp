@@ -1,7 +1,10 @@
 #include "GraphicsManager.h"
 #include "ScreenManager.h"
+#include "RenderContext.h"
 #include "Log.h"
 
+#include <thread>
+
 /*******************************************************************************************************************
 	Constructor with initializer list to set all default values of variables
 *******************************************************************************************************************/
@@ -17,9 +20,13 @@ GraphicsManager::GraphicsManager()	:	m_videoCardMemory(0),
 										m_depthStencilView(nullptr),
 										m_rasterState(nullptr),
 										m_depthDisabledStencilState(nullptr),
+										m_depthReadOnlyStencilState(nullptr),
 										m_alphaEnableBlendingState(nullptr),
-										m_alphaDisableBlendingState(nullptr)
+										m_alphaDisableBlendingState(nullptr),
+										m_immediateContext(nullptr)
 {
+	ZeroMemory(&m_viewport, sizeof(m_viewport));
+
 	DX_LOG("[GRAPHICS] Graphics constructor initialized", DX_LOG_EMPTY, LOG_MESSAGE);
 }
 
@@ -32,8 +39,15 @@ void GraphicsManager::Shutdown()
 	//---------------------------------------------------------------- Before shutting down set to windowed mode or when you release the swap chain it will throw an exception
 	if (m_swapChain)					{ m_swapChain->SetFullscreenState(false, nullptr); }
 
+	//---------------------------------------------------------------- The render contexts hold references to the device context, so release them first
+	for (unsigned int i = 0; i < m_deferredContexts.size(); i++) { delete m_deferredContexts[i]; }
+	m_deferredContexts.clear();
+
+	if (m_immediateContext)				{ delete m_immediateContext; m_immediateContext = nullptr; }
+
 	if (m_alphaDisableBlendingState)	{ m_alphaDisableBlendingState->Release(); m_alphaDisableBlendingState = nullptr; }
 	if (m_alphaEnableBlendingState)		{ m_alphaEnableBlendingState->Release(); m_alphaEnableBlendingState = nullptr; }
+	if (m_depthReadOnlyStencilState)	{ m_depthReadOnlyStencilState->Release(); m_depthReadOnlyStencilState = nullptr; }
 	if (m_depthDisabledStencilState)	{ m_depthDisabledStencilState->Release(); m_depthDisabledStencilState = nullptr; }
 	if (m_rasterState)					{ m_rasterState->Release(); m_rasterState = nullptr; }
 	if (m_depthStencilView)				{ m_depthStencilView->Release(); m_depthStencilView = nullptr; }
@@ -61,6 +75,7 @@ bool GraphicsManager::Initialize()
 	InitializeViewport();
 
 	if (!InitializeAlphaBlendingState())	{ return false; }
+	if (!InitializeRenderContexts())		{ return false; }
 	
 	DX_LOG("[GRAPHICS] Video Card Information: ", GetVideoCardInfo(), LOG_MESSAGE);
 	DX_LOG("[GRAPHICS] Video Card Memory (MB): ", GetVideoCardMemory(), LOG_MESSAGE);
@@ -310,6 +325,15 @@ bool GraphicsManager::InitializeDepthStencilFilters()
 	result = m_device->CreateDepthStencilState(&depthDisabledStencilDescription, &m_depthDisabledStencilState);
 	if (FAILED(result)) { DX_LOG("[GRAPHICS] Couldn't create disabled depth stencil state", DX_LOG_EMPTY, LOG_ERROR); return false; }
 
+	//---------------------------------------------------------------- A third state for transparent geometry - it is still hidden behind opaque geometry, but doesn't write depth, so
+	//---------------------------------------------------------------- transparent surfaces drawn after it (further forward) aren't hidden behind it. The same as the first state otherwise.
+	D3D11_DEPTH_STENCIL_DESC depthReadOnlyStencilDescription	= depthStencilDescription;
+	depthReadOnlyStencilDescription.DepthWriteMask				= D3D11_DEPTH_WRITE_MASK_ZERO;
+
+	//---------------------------------------------------------------- Create the read only depth stencil state
+	result = m_device->CreateDepthStencilState(&depthReadOnlyStencilDescription, &m_depthReadOnlyStencilState);
+	if (FAILED(result)) { DX_LOG("[GRAPHICS] Couldn't create read only depth stencil state", DX_LOG_EMPTY, LOG_ERROR); return false; }
+
 	DX_LOG("[GRAPHICS] Depth stencil filters set successfully", DX_LOG_EMPTY, LOG_SUCCESS);
 
 	return true;
@@ -357,17 +381,15 @@ bool GraphicsManager::InitializeRasterizerState()
 *******************************************************************************************************************/
 void GraphicsManager::InitializeViewport()
 {
-	D3D11_VIEWPORT viewport = { 0 };
+	m_viewport.Width	= (float)Screen::Instance()->GetWidth();
+	m_viewport.Height	= (float)Screen::Instance()->GetHeight();
+	m_viewport.MinDepth	= 0.0f;
+	m_viewport.MaxDepth	= 1.0f;
+	m_viewport.TopLeftX	= 0.0f;
+	m_viewport.TopLeftY	= 0.0f;
 
-	viewport.Width		= (float)Screen::Instance()->GetWidth();
-	viewport.Height		= (float)Screen::Instance()->GetHeight();
-	viewport.MinDepth	= 0.0f;
-	viewport.MaxDepth	= 1.0f;
-	viewport.TopLeftX	= 0.0f;
-	viewport.TopLeftY	= 0.0f;
-
-	//---------------------------------------------------------------- Create the viewport
-	m_deviceContext->RSSetViewports(1, &viewport);
+	//---------------------------------------------------------------- Create the viewport - kept so deferred contexts can be given the same one
+	m_deviceContext->RSSetViewports(1, &m_viewport);
 
 	DX_LOG("[GRAPHICS] Viewport initialized successfully", DX_LOG_EMPTY, LOG_SUCCESS);
 }
@@ -410,6 +432,40 @@ bool GraphicsManager::InitializeAlphaBlendingState()
 }
 
 
+/*******************************************************************************************************************
+	Function that wraps the immediate context and creates a deferred context for each render thread
+*******************************************************************************************************************/
+bool GraphicsManager::InitializeRenderContexts()
+{
+	m_immediateContext = new RenderContext;
+	if (!m_immediateContext->Create(m_deviceContext)) { return false; }
+
+	//---------------------------------------------------------------- Without driver command lists the runtime emulates them - still correct, but recording gains less
+	D3D11_FEATURE_DATA_THREADING threading = { 0 };
+	if (SUCCEEDED(m_device->CheckFeatureSupport(D3D11_FEATURE_THREADING, &threading, sizeof(threading)))) {
+		DX_LOG("[GRAPHICS] Driver command lists supported: ", (threading.DriverCommandLists ? "yes" : "no"), LOG_MESSAGE);
+	}
+
+	//---------------------------------------------------------------- One deferred context per core, leaving one for the main thread to execute on
+	unsigned int contextCount = std::thread::hardware_concurrency();
+	contextCount = (contextCount > 1) ? contextCount - 1 : 1;
+	if (contextCount > GraphicConstants::MAX_RENDER_THREADS) { contextCount = GraphicConstants::MAX_RENDER_THREADS; }
+
+	for (unsigned int i = 0; i < contextCount; i++) {
+
+		RenderContext* deferredContext = new RenderContext;
+
+		if (!deferredContext->CreateDeferred()) { delete deferredContext; return false; }
+
+		m_deferredContexts.push_back(deferredContext);
+	}
+
+	DX_LOG("[GRAPHICS] Deferred render contexts created: ", contextCount, LOG_SUCCESS);
+
+	return true;
+}
+
+
 /*******************************************************************************************************************
 	Function that initializes the interface (video card) and monitor in use
 *******************************************************************************************************************/
@@ -528,8 +584,7 @@ void GraphicsManager::EndScene()
 void GraphicsManager::EnableDepthBuffer(bool enable3D)
 {
 	//---------------------------------------------------------------- If enable3D is true, then the depth buffer will be active
-	(enable3D)	? m_deviceContext->OMSetDepthStencilState(m_depthStencilState, 1)
-				: m_deviceContext->OMSetDepthStencilState(m_depthDisabledStencilState, 1);
+	m_immediateContext->SetDepthStencilState(GetDepthStencilState(enable3D));
 }
 
 
@@ -538,16 +593,19 @@ void GraphicsManager::EnableDepthBuffer(bool enable3D)
 *******************************************************************************************************************/
 void GraphicsManager::EnableAlphaBlending(bool render2D)
 {
-	float blendFactor[4];
+	//---------------------------------------------------------------- If render2D is true, then alpha blending will be active
+	m_immediateContext->SetBlendState(GetBlendState(render2D));
+}
 
-	blendFactor[0] = 0.0f;
-	blendFactor[1] = 0.0f;
-	blendFactor[2] = 0.0f;
-	blendFactor[3] = 0.0f;
 
-	//---------------------------------------------------------------- If render2D is true, then alpha blending will be active
-	(render2D)	? m_deviceContext->OMSetBlendState(m_alphaEnableBlendingState, blendFactor, 0xffffffff)
-				: m_deviceContext->OMSetBlendState(m_alphaDisableBlendingState, blendFactor, 0xffffffff);
+/*******************************************************************************************************************
+	Function that gives a context the back buffer, viewport and rasterizer state - deferred contexts start with none set
+*******************************************************************************************************************/
+void GraphicsManager::PrepareContext(RenderContext& context)
+{
+	context.GetDeviceContext()->OMSetRenderTargets(1, &m_renderTargetView, m_depthStencilView);
+	context.GetDeviceContext()->RSSetViewports(1, &m_viewport);
+	context.GetDeviceContext()->RSSetState(m_rasterState);
 }
 
 
@@ -556,5 +614,12 @@ void GraphicsManager::EnableAlphaBlending(bool render2D)
 *******************************************************************************************************************/
 ID3D11Device* GraphicsManager::GetDevice()	const				{ return m_device; }
 ID3D11DeviceContext* GraphicsManager::GetDeviceContext() const	{ return m_deviceContext; }
+RenderContext& GraphicsManager::GetImmediateContext() const		{ return *m_immediateContext; }
+RenderContext& GraphicsManager::GetDeferredContext(unsigned int index) const	{ return *m_deferredContexts[index]; }
+unsigned int GraphicsManager::GetDeferredContextCount() const	{ return m_deferredContexts.size(); }
+
+ID3D11DepthStencilState* GraphicsManager::GetDepthStencilState(bool enable3D) const	{ return (enable3D) ? m_depthStencilState : m_depthDisabledStencilState; }
+ID3D11DepthStencilState* GraphicsManager::GetReadOnlyDepthStencilState() const		{ return m_depthReadOnlyStencilState; }
+ID3D11BlendState* GraphicsManager::GetBlendState(bool render2D) const				{ return (render2D) ? m_alphaEnableBlendingState : m_alphaDisableBlendingState; }
 const char* GraphicsManager::GetVideoCardInfo() const			{ return &m_videoCardInfo[0]; }
 int GraphicsManager::GetVideoCardMemory() const					{ return m_videoCardMemory; }
\ No newline at end of file
@@ -3,7 +3,7 @@
 /*******************************************************************************************************************
 	GraphicsManager.h, GraphicsManager.cpp
 	Created by Kim Kane
-	Last updated: 09/02/2018
+	Last updated: 19/10/2026
 
 	Singleton class that creates and initializes the DirectX graphics API.
 	
@@ -15,8 +15,11 @@
 #include <d3dcompiler.h>
 #include <dxgi.h>
 #include <array>
+#include <vector>
 #include "Constants.h"
 
+class RenderContext;
+
 class GraphicsManager {
 
 public:
@@ -33,6 +36,10 @@ public:
 public:
 	ID3D11Device* GetDevice() const;
 	ID3D11DeviceContext* GetDeviceContext() const;
+
+	RenderContext& GetImmediateContext() const;
+	RenderContext& GetDeferredContext(unsigned int index) const;
+	unsigned int GetDeferredContextCount() const;
 	
 	const char* GetVideoCardInfo() const;
 	int GetVideoCardMemory() const;
@@ -41,6 +48,11 @@ public:
 	void EnableDepthBuffer(bool enable3D);
 	void EnableAlphaBlending(bool render2D);
 
+	void PrepareContext(RenderContext& context);
+	ID3D11DepthStencilState* GetDepthStencilState(bool enable3D) const;
+	ID3D11DepthStencilState* GetReadOnlyDepthStencilState() const;
+	ID3D11BlendState* GetBlendState(bool render2D) const;
+
 private:
 	bool InitializeInterface();
 	bool StoreVideoCardInfo(IDXGIAdapter* adapter);
@@ -50,6 +62,7 @@ private:
 	bool InitializeRasterizerState();
 	void InitializeViewport();
 	bool InitializeAlphaBlendingState();
+	bool InitializeRenderContexts();
 
 private:
 	GraphicsManager();
@@ -69,8 +82,13 @@ private:
 	ID3D11DepthStencilView*		m_depthStencilView;
 	ID3D11RasterizerState*		m_rasterState;
 	ID3D11DepthStencilState*	m_depthDisabledStencilState;
+	ID3D11DepthStencilState*	m_depthReadOnlyStencilState;
 	ID3D11BlendState*			m_alphaEnableBlendingState;
 	ID3D11BlendState*			m_alphaDisableBlendingState;
+	D3D11_VIEWPORT				m_viewport;
+
+	RenderContext*				m_immediateContext;
+	std::vector<RenderContext*>	m_deferredContexts;
 
 private:
 	std::array<char, GraphicConstants::BUFFER_SIZE>	m_videoCardInfo;
@@ -1,14 +1,409 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <thread>
 
 #include "Log.h"
+#include "Constants.h"
+
+namespace {
+
+	//---------------------------------------------------------------- One message, ready to be written out
+	struct LogRecord
+	{
+		LogType			type;
+		unsigned int	length;
+		char			text[LogConstants::MaxLength + 1];
+	};
+
+	//---------------------------------------------------------------- A place in the queue - its sequence says whether it's free for a producer, or ready for the log thread
+	struct LogSlot
+	{
+		std::atomic<unsigned int>	sequence;
+		LogRecord					record;
+	};
+
+	/*******************************************************************************************************************
+		The queue between every thread that logs and the log thread that writes the messages out. A bounded ring,
+		where each producer claims a slot by moving the tail on, fills it in and then marks it ready - so producers
+		never wait on each other, or on the log thread. Only the log thread takes messages off the head.
+	*******************************************************************************************************************/
+	class LogQueue {
+
+	public:
+		LogQueue();
+		~LogQueue();
+
+	public:
+		void Push(const LogRecord& record);
+		void Flush();
+		unsigned int GetDropped() const;
+
+	private:
+		LogQueue(const LogQueue&);
+		LogQueue& operator=(const LogQueue&);
+
+	private:
+		bool Pop(LogRecord& record);
+		void Run();
+		void WriteWaiting();
+		void Write(const LogRecord& record);
+
+	private:
+		static const unsigned int Mask = LogConstants::QueueSize - 1;
+
+		LogSlot						m_slots[LogConstants::QueueSize];
+		std::atomic<unsigned int>	m_tail;
+		std::atomic<unsigned int>	m_dropped;
+		std::atomic<unsigned int>	m_totalDropped;
+		std::atomic<bool>			m_wake;
+
+		//---------------------------------------------------------------- Only the log thread uses these
+		unsigned int				m_head;
+		LogType						m_lastType;
+		FILE*						m_file;
+
+		std::atomic<unsigned int>	m_written;
+		bool						m_isClosing;
+		std::mutex					m_mutex;
+		std::condition_variable		m_condition;
+		std::condition_variable		m_flushed;
+		std::thread					m_thread;
+	};
+
+	static_assert((LogConstants::QueueSize & (LogConstants::QueueSize - 1)) == 0, "The log queue size must be a power of 2");
+
+	//---------------------------------------------------------------- The message each thread is building
+	thread_local LogRecord threadRecord;
+
+	//---------------------------------------------------------------- Set once the queue has gone at exit, so anything logged after that is written straight out
+	bool isShutdown = false;
+
+	const char* const typeNames[] = { "[MESSAGE] ", "[WARNING] ", "[ERROR] ", "[SUCCESS] ", "[MEMORY] ", "[COPY CONSTRUCTOR] ", "[RESOURCE] " };
+	const LogColour typeColours[] = { GREY, YELLOW, RED, GREEN, PINK, CYAN, BLUE };
+
+
+	/*******************************************************************************************************************
+		Function that gets the queue, made (and the log thread started) the first time anything is logged
+	*******************************************************************************************************************/
+	LogQueue& GetQueue()
+	{
+		static LogQueue queue;
+		return queue;
+	}
+
+
+	/*******************************************************************************************************************
+		Function that adds formatted text on to the end of the calling thread's message, cutting it short if it won't fit
+	*******************************************************************************************************************/
+	void AppendFormat(const char* format, ...)
+	{
+		unsigned int room = LogConstants::MaxLength - threadRecord.length;
+		if (room == 0) { return; }
+
+		va_list arguments;
+		va_start(arguments, format);
+		int length = vsnprintf(threadRecord.text + threadRecord.length, room + 1, format, arguments);
+		va_end(arguments);
+
+		if (length > 0) { threadRecord.length += (std::min)((unsigned int)length, room); }
+	}
+}
+
+
+/*******************************************************************************************************************
+	Constructor with initializer list to set all default values of variables - opens the log file and starts the log thread
+*******************************************************************************************************************/
+LogQueue::LogQueue()	:	m_tail(0),
+							m_dropped(0),
+							m_totalDropped(0),
+							m_wake(false),
+							m_head(0),
+							m_lastType(LOG_MESSAGE),
+							m_file(nullptr),
+							m_written(0),
+							m_isClosing(false)
+{
+	for (unsigned int i = 0; i < LogConstants::QueueSize; i++) { m_slots[i].sequence.store(i, std::memory_order_relaxed); }
+
+	m_file = fopen(LogConstants::LogFile.c_str(), "w");
+
+	Colour(typeColours[m_lastType]);
+	m_thread = std::thread(&LogQueue::Run, this);
+}
+
+
+/*******************************************************************************************************************
+	Shut down all necessary procedures, release resources and clean up memory - writes out anything still waiting
+*******************************************************************************************************************/
+LogQueue::~LogQueue()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_isClosing = true;
+	}
+
+	m_condition.notify_one();
+	if (m_thread.joinable()) { m_thread.join(); }
+
+	if (m_file) { fclose(m_file); }
+
+	isShutdown = true;
+}
+
+
+/*******************************************************************************************************************
+	Function that adds a message to the queue - if it's full the message is dropped, so the calling thread never waits
+*******************************************************************************************************************/
+void LogQueue::Push(const LogRecord& record)
+{
+	unsigned int position = m_tail.load(std::memory_order_relaxed);
+	LogSlot* slot;
+
+	//---------------------------------------------------------------- Claim the slot at the tail - if another thread gets there first, try again at the new tail
+	while (true) {
+		slot = &m_slots[position & Mask];
+		int difference = (int)(slot->sequence.load(std::memory_order_acquire) - position);
+
+		if (difference == 0) {
+			if (m_tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) { break; }
+		}
+		else if (difference < 0) {
+			m_dropped.fetch_add(1, std::memory_order_relaxed);
+			m_totalDropped.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+		else {
+			position = m_tail.load(std::memory_order_relaxed);
+		}
+	}
+
+	//---------------------------------------------------------------- Only copy the text that's been used, then hand the slot over to the log thread
+	slot->record.type	= record.type;
+	slot->record.length	= record.length;
+	memcpy(slot->record.text, record.text, record.length + 1);
+
+	slot->sequence.store(position + 1, std::memory_order_release);
+
+	//---------------------------------------------------------------- The log thread wakes up by itself every FlushInterval - only wake it early for errors, or before the queue fills
+	if (record.type == LOG_ERROR || position - m_written.load(std::memory_order_relaxed) > LogConstants::QueueSize / 2) {
+		if (!m_wake.exchange(true, std::memory_order_relaxed)) { m_condition.notify_one(); }
+	}
+}
+
+
+/*******************************************************************************************************************
+	Function that waits until everything logged before it was called has been written out
+*******************************************************************************************************************/
+void LogQueue::Flush()
+{
+	if (std::this_thread::get_id() == m_thread.get_id()) { return; }
+
+	unsigned int target = m_tail.load(std::memory_order_acquire);
+
+	m_wake.store(true, std::memory_order_relaxed);
+	m_condition.notify_one();
+
+	//---------------------------------------------------------------- Don't hang on a log thread that's stopped (it only stops at exit), just give up after a second
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_flushed.wait_for(lock, std::chrono::seconds(1), [&] { return (int)(m_written.load() - target) >= 0; });
+}
+
+
+/*******************************************************************************************************************
+	Function that takes the oldest message off the queue, if there is one ready - only the log thread calls this
+*******************************************************************************************************************/
+bool LogQueue::Pop(LogRecord& record)
+{
+	LogSlot& slot = m_slots[m_head & Mask];
+	if (slot.sequence.load(std::memory_order_acquire) != m_head + 1) { return false; }
+
+	record.type		= slot.record.type;
+	record.length	= slot.record.length;
+	memcpy(record.text, slot.record.text, slot.record.length + 1);
+
+	//---------------------------------------------------------------- Free the slot for when the tail comes back round to it
+	slot.sequence.store(m_head + LogConstants::QueueSize, std::memory_order_release);
+	m_head++;
+
+	return true;
+}
+
+
+/*******************************************************************************************************************
+	Function that the log thread runs - writes out what's waiting every FlushInterval, or sooner when woken
+*******************************************************************************************************************/
+void LogQueue::Run()
+{
+	bool isClosing = false;
+
+	while (!isClosing) {
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_condition.wait_for(lock, std::chrono::milliseconds(LogConstants::FlushInterval), [this] { return m_isClosing || m_wake.load(std::memory_order_relaxed); });
+
+			m_wake.store(false, std::memory_order_relaxed);
+			isClosing = m_isClosing;
+		}
+
+		WriteWaiting();
+	}
+}
+
+
+/*******************************************************************************************************************
+	Function that writes out every message waiting, then lets anything waiting in Flush() know how far it got
+*******************************************************************************************************************/
+void LogQueue::WriteWaiting()
+{
+	LogRecord record;
+	bool hasWritten = false;
+
+	while (Pop(record)) { Write(record); hasWritten = true; }
+
+	unsigned int dropped = m_dropped.exchange(0, std::memory_order_relaxed);
+
+	if (dropped > 0) {
+		record.type		= LOG_WARN;
+		record.length	= (unsigned int)snprintf(record.text, sizeof(record.text), "[LOG] %u messages were dropped - the log queue was full", dropped);
+		Write(record);
+		hasWritten = true;
+	}
+
+	if (hasWritten) {
+		fflush(stdout);
+		if (m_file) { fflush(m_file); }
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_written.store(m_head, std::memory_order_relaxed);
+	}
+
+	m_flushed.notify_all();
+}
+
+
+/*******************************************************************************************************************
+	Function that writes one message to the console (complete with pretty colours) and the log file
+*******************************************************************************************************************/
+void LogQueue::Write(const LogRecord& record)
+{
+	//---------------------------------------------------------------- Only change the colour when it's different, as it's a call in to windows each time
+	if (record.type != m_lastType) { Colour(typeColours[record.type]); m_lastType = record.type; }
+
+	fputs(typeNames[record.type], stdout);
+	fwrite(record.text, 1, record.length, stdout);
+	fputc('\n', stdout);
+
+	if (m_file) {
+		fputs(typeNames[record.type], m_file);
+		fwrite(record.text, 1, record.length, m_file);
+		fputc('\n', m_file);
+	}
+}
+
+
+/*******************************************************************************************************************
+	Function that gets how many messages have been dropped since the program started
+*******************************************************************************************************************/
+unsigned int LogQueue::GetDropped() const
+{
+	return m_totalDropped.load(std::memory_order_relaxed);
+}
+
 
 /*******************************************************************************************************************
 	Handles the text colour and colour intensity of the console window text using a Win32 handle
 *******************************************************************************************************************/
 void Colour(LogColour colour, bool intensity)
 {
+#if defined(_WIN32)
 	//---------------------------------------------------------------- Checks the intensity (bool) of the colour (true is bright, false is dark)
 	WORD colourIntesity = (intensity) ? FOREGROUND_INTENSITY : 0;
 
 	//---------------------------------------------------------------- Set the text attribute for the console using the handle and pass in the colour and the intensity we want
 	SetConsoleTextAttribute(GetStdHandle(STD_OUTPUT_HANDLE), colour | colourIntesity);
-}
\ No newline at end of file
+#endif
+}
+
+
+/*******************************************************************************************************************
+	Function that starts a new message in the calling thread's buffer
+*******************************************************************************************************************/
+void Logger::Begin(LogType type)
+{
+	threadRecord.type		= type;
+	threadRecord.length		= 0;
+	threadRecord.text[0]	= '\0';
+}
+
+
+/*******************************************************************************************************************
+	Function that hands the calling thread's message over to the log thread
+*******************************************************************************************************************/
+void Logger::End()
+{
+	//---------------------------------------------------------------- Once the log thread has gone at exit, there's nothing to wait on anymore - write it out here
+	if (isShutdown) {
+		fputs(typeNames[threadRecord.type], stdout);
+		fwrite(threadRecord.text, 1, threadRecord.length, stdout);
+		fputc('\n', stdout);
+		return;
+	}
+
+	GetQueue().Push(threadRecord);
+}
+
+
+/*******************************************************************************************************************
+	Functions that add text, or a variable written as text, on to the end of the calling thread's message
+*******************************************************************************************************************/
+void Logger::Append(const char* text)
+{
+	if (!text) { text = "(null)"; }
+
+	unsigned int length = (std::min)((unsigned int)strlen(text), LogConstants::MaxLength - threadRecord.length);
+
+	memcpy(threadRecord.text + threadRecord.length, text, length);
+	threadRecord.length += length;
+	threadRecord.text[threadRecord.length] = '\0';
+}
+
+void Logger::Append(const std::string& text)	{ Append(text.c_str()); }
+void Logger::Append(char* text)					{ Append((const char*)text); }
+void Logger::Append(bool value)					{ AppendFormat("%d", (int)value); }
+void Logger::Append(char value)					{ AppendFormat("%c", value); }
+void Logger::Append(signed char value)			{ AppendFormat("%c", value); }
+void Logger::Append(unsigned char value)		{ AppendFormat("%c", value); }
+void Logger::Append(short value)				{ AppendFormat("%hd", value); }
+void Logger::Append(unsigned short value)		{ AppendFormat("%hu", value); }
+void Logger::Append(int value)					{ AppendFormat("%d", value); }
+void Logger::Append(unsigned int value)			{ AppendFormat("%u", value); }
+void Logger::Append(long value)					{ AppendFormat("%ld", value); }
+void Logger::Append(unsigned long value)		{ AppendFormat("%lu", value); }
+void Logger::Append(long long value)			{ AppendFormat("%lld", value); }
+void Logger::Append(unsigned long long value)	{ AppendFormat("%llu", value); }
+void Logger::Append(float value)				{ AppendFormat("%g", value); }
+void Logger::Append(double value)				{ AppendFormat("%g", value); }
+void Logger::Append(const void* value)			{ AppendFormat("%p", value); }
+
+
+/*******************************************************************************************************************
+	Function that waits until everything logged so far has been written out - call it before the program stops
+*******************************************************************************************************************/
+void Logger::Flush()
+{
+	if (!isShutdown) { GetQueue().Flush(); }
+}
+
+
+/*******************************************************************************************************************
+	Accessor Methods
+*******************************************************************************************************************/
+unsigned int Logger::GetDropped() { return isShutdown ? 0 : GetQueue().GetDropped(); }
@@ -3,26 +3,34 @@
 /*******************************************************************************************************************
 	Log.h, Log.cpp
 	Created by Kim Kane
-	Last updated: 04/01/2018
+	Last updated: 19/10/2026
 	
 	A simple logging system that displays a message to the console window in a number of different colours.
 	The colour intesity can be changed by passing true or false as an argument to the Colour function.
 	
 	More log types can be added to the LogType enum if necessary.
-	This must also be updated within the switch statement in the Debug function.
+	This must also be updated within LogLevel below and the type names in Log.cpp.
 	
 	Supports variables of other data types (int, float, etc.) - when not passing a variable use EMPTY.
-	A macro can also be used for simplicity: #define Log(message) std::cout << message << std::endl;
+
+	Logging never waits on anything. Each message is written in to a buffer that belongs to the thread logging
+	it (nothing is allocated), then handed to a queue that any thread can add to without a lock. A thread of
+	the logger's own writes the queue out, to the console and to LogConstants::LogFile. If the queue is full
+	the message is dropped and counted, rather than making the thread that logged it wait - the log thread
+	reports how many were lost. Logger::Flush() waits until everything logged so far has been written out.
+
+	Messages come out in order for each thread, but messages from different threads can be mixed together.
 
 	Also supports OpenGL error messages (see defined macros below) (been removed in DirectX)
 
 *******************************************************************************************************************/
-#define WIN32_LEAN_AND_MEAN
+#if defined(_WIN32)
+	#define WIN32_LEAN_AND_MEAN
+
+	#include <Windows.h>
+#endif
 
-#include <Windows.h>
-#include <iostream>
 #include <string>
-#include <sstream>
 
 #define DX_LOG_EMPTY -1
 
@@ -30,10 +38,17 @@
 	Macros have been defined for differentiating between Debug and Release modes.
 	The Debug and OpenGLDebug functions will only be called during Debug mode.
 
+	DX_LOG_LEVEL leaves out the less important messages when compiling - 0 keeps everything, 1 only keeps
+	warnings and errors, 2 only keeps errors and 3 keeps nothing. Define it in the project to change it.
+
 	You could also use ASSERT(function) if(!(function)) __debugbreak(); to generate a breakpoint.
 *******************************************************************************************************************/
+#ifndef DX_LOG_LEVEL
+	#define DX_LOG_LEVEL 0
+#endif
+
 #if DEBUG_MODE == 1
-	#define DX_LOG(message, variable, type) Debug(message, variable, type)
+	#define DX_LOG(message, variable, type) do { if (LogLevel(type) >= DX_LOG_LEVEL) { Debug(message, variable, type); } } while (0)
 #elif defined(RELEASE_MODE)
 	#define DX_LOG(message, variable, type)
 #endif
@@ -46,33 +61,56 @@ enum LogColour	{ GREY, BLUE, GREEN, CYAN, RED, PINK, YELLOW, WHITE };
 
 void Colour(LogColour colour, bool intensity = true);
 
+//---------------------------------------------------------------- How important each log type is, for DX_LOG_LEVEL
+constexpr int LogLevel(LogType type) { return (type == LOG_ERROR) ? 2 : (type == LOG_WARN) ? 1 : 0; }
+
+/*******************************************************************************************************************
+	Static class that builds each message in the calling thread's buffer and hands it over to the log thread
+*******************************************************************************************************************/
+class Logger {
+
+public:
+	static void Begin(LogType type);
+	static void End();
+
+public:
+	static void Append(const char* text);
+	static void Append(const std::string& text);
+	static void Append(bool value);
+	static void Append(char value);
+	static void Append(signed char value);
+	static void Append(unsigned char value);
+	static void Append(short value);
+	static void Append(unsigned short value);
+	static void Append(int value);
+	static void Append(unsigned int value);
+	static void Append(long value);
+	static void Append(unsigned long value);
+	static void Append(long long value);
+	static void Append(unsigned long long value);
+	static void Append(float value);
+	static void Append(double value);
+	static void Append(char* text);
+	static void Append(const void* value);
+
+public:
+	static void Flush();
+	static unsigned int GetDropped();
+
+private:
+	Logger();
+};
+
 /*******************************************************************************************************************
 	Debug function that outputs text to the console window. Replaces std::cout << for faster debugging
 *******************************************************************************************************************/
-template <typename T> inline void Debug(const std::string& message, T variable, LogType type)
+template <typename T> inline void Debug(const char* message, T variable, LogType type)
 {
-	//---------------------------------------------------------------- Create a local string to hold final debug message
-	std::string outputString; 
+	Logger::Begin(type);
+	Logger::Append(message);
 
-	//---------------------------------------------------------------- Create a local sstream that holds the T variable data (int, float, char, etc.)
-	std::stringstream tempVariable;
+	//---------------------------------------------------------------- If variable is EMPTY, just log the message. Otherwise, add the variable on the end
+	if (variable != (T)DX_LOG_EMPTY) { Logger::Append(variable); }
 
-	//---------------------------------------------------------------- Store this data in our sstream so we can return a string copy of it using .str()
-	tempVariable << variable; 
-	
-	//---------------------------------------------------------------- If variable is EMPTY, just return the message. Otherwise, concatenate the strings
-	if (variable != (T)DX_LOG_EMPTY)	{ outputString = message + tempVariable.str(); } 
-	else								{ outputString = message; }
-
-	//---------------------------------------------------------------- Switch to check the passed in LogType and output the passed in message and/or variable (complete with pretty colours), to make debugging easy and fast
-	switch (type)  {
-
-		case LOG_MESSAGE:	{ Colour(GREY); std::cout << "[MESSAGE] " << outputString << std::endl;	break; }
-		case LOG_WARN:		{ Colour(YELLOW); std::cout << "[WARNING] " << outputString << std::endl; break; }
-		case LOG_ERROR:		{ Colour(RED); std::cout << "[ERROR] " << outputString << std::endl; break; }
-		case LOG_SUCCESS:	{ Colour(GREEN); std::cout << "[SUCCESS] " << outputString << std::endl; break; }
-		case LOG_MEMORY:	{ Colour(PINK); std::cout << "[MEMORY] " << outputString << std::endl; break; }
-		case LOG_COPY:		{ Colour(CYAN); std::cout << "[COPY CONSTRUCTOR] " << outputString << std::endl; break; }
-		case LOG_RESOURCE:	{ Colour(BLUE); std::cout << "[RESOURCE] " << outputString << std::endl; break; }
-	}
-}
\ No newline at end of file
+	Logger::End();
+}
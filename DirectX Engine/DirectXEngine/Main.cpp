@@ -1,10 +1,111 @@
+#include <cstdio>
+#include <string>
+
 #include "GameManager.h"
+#include "Log.h"
+#include "ScreenManager.h"
+#include "GraphicsManager.h"
+#include "InputManager.h"
+#include "FileManager.h"
+#include "ShaderManager.h"
+#include "AnimationLibrary.h"
+#include "TransformManager.h"
+#include "CollisionWorld.h"
+#include "PhysicsWorld.h"
+#include "Benchmark.h"
+#include "EventDecoder.h"
+#include "FontBaker.h"
+#include "Constants.h"
+
+/*******************************************************************************************************************
+	Create every manager before anything uses them - each one is made after the managers it depends on
+*******************************************************************************************************************/
+void CreateManagers()
+{
+	Screen::Create();
+	Graphics::Create();
+	Input::Create();
+	File::Create();
+	Shaders::Create();
+	Animations::Create();
+	Transforms::Create();
+	Collisions::Create();
+	Physics::Create();
+	Game::Create();
+}
+
+/*******************************************************************************************************************
+	Destroy every manager in the opposite order, once the game and all its threads have stopped
+*******************************************************************************************************************/
+void DestroyManagers()
+{
+	Game::Destroy();
+	Physics::Destroy();
+	Collisions::Destroy();
+	Transforms::Destroy();
+	Animations::Destroy();
+	Shaders::Destroy();
+	File::Destroy();
+	Input::Destroy();
+	Graphics::Destroy();
+	Screen::Destroy();
+}
+
+/*******************************************************************************************************************
+	Bake every font the game uses that isn't baked yet - run by the project's post-build step, so the game only loads them
+*******************************************************************************************************************/
+bool BakeFonts()
+{
+	std::string fontFileLocation = FontConstants::Directory + FontConstants::HudFont;
+
+	//---------------------------------------------------------------- Baking is slow, so a font that's already there is kept - delete it to bake it again
+	if (GetFileAttributesA(fontFileLocation.c_str()) != INVALID_FILE_ATTRIBUTES) { return true; }
+
+	FontBakeSettings settings;
+	settings.faceName		= FontConstants::FaceName;
+	settings.pixelSize		= FontConstants::PixelSize;
+	settings.distanceRange	= FontConstants::DistanceRange;
+	settings.supersample	= FontConstants::Supersample;
+	settings.atlasWidth		= FontConstants::AtlasWidth;
+	settings.firstCharacter	= FontConstants::FirstCharacter;
+	settings.lastCharacter	= FontConstants::LastCharacter;
+
+	printf("Baking %s\n", fontFileLocation.c_str());
+
+	return FontBaker::Bake(settings, fontFileLocation);
+}
+
+int main(int argc, char* argv[]) {
 
-int main() {
+	//---------------------------------------------------------------- Run the headless benchmarks instead of the game - they make the worlds they need themselves
+	if (argc > 1 && std::string(argv[1]) == "-benchmark") {
+		int result = Benchmark::Run(argc - 2, argv + 2);
+		Logger::Flush();
+		return result;
+	}
 
-	wWinMain(GetModuleHandle(NULL), NULL, NULL, 1);
+	//---------------------------------------------------------------- Bake the fonts and stop - a failed bake fails the build
+	if (argc > 1 && std::string(argv[1]) == "-bakefonts") {
+		bool baked = BakeFonts();
+		Logger::Flush();
+		return baked ? 0 : 1;
+	}
+
+	//---------------------------------------------------------------- Turn an event file back in to text - the event file and the text file default to the ones the game writes
+	if (argc > 1 && std::string(argv[1]) == "-decode") {
+		std::string input	= (argc > 2) ? argv[2] : EventLogConstants::LogFile;
+		std::string output	= (argc > 3) ? argv[3] : EventLogConstants::TextFile;
+
+		if (!EventDecoder::Decode(input, output)) { printf("Couldn't decode the event file: %s\n", input.c_str()); return 1; }
+
+		printf("Decoded %s in to %s\n", input.c_str(), output.c_str());
+		return 0;
+	}
+
+	wWinMain(GetModuleHandle(NULL), NULL, GetCommandLineW(), 1);
 
 #if DEBUG_MODE == 1
+	Logger::Flush();
 	system("pause");
 #endif
 
@@ -14,15 +115,21 @@ int main() {
 int WINAPI wWinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance, _In_ LPWSTR lpCmdLine, _In_ int nCmdShow)
 {
 	UNREFERENCED_PARAMETER(hPrevInstance);
-	UNREFERENCED_PARAMETER(lpCmdLine);
 
-	//---------------------------------------------------------------- Game title, fullscreen, vSync
-	if (!Game::Instance()->Initialize(hInstance, "DirectX Game", false, true)) { 
-		Game::Instance()->Shutdown(); return 0; 
+	//---------------------------------------------------------------- Events are only recorded when asked for, as the file grows for as long as the game runs
+	bool recordEvents = (lpCmdLine && wcsstr(lpCmdLine, L"-events"));
+
+	CreateManagers();
+
+	//---------------------------------------------------------------- Game title, fullscreen, vSync, record events
+	if (!Game::Instance()->Initialize(hInstance, "DirectX Game", false, true, recordEvents)) { 
+		Game::Instance()->Shutdown(); DestroyManagers(); return 0; 
 	}
 	
 	Game::Instance()->Run();
 	Game::Instance()->Shutdown();
 
+	DestroyManagers();
+
 	return 0;
-}
\ No newline at end of file
+}
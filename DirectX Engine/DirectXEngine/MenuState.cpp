@@ -3,14 +3,21 @@
 #include "ScreenManager.h"
 #include "GraphicsManager.h"
 #include "InputManager.h"
+#include "PhysicsWorld.h"
+#include "CollisionWorld.h"
+#include "AnimationLibrary.h"
+#include "Constants.h"
 #include "Log.h"
 
 
 /*******************************************************************************************************************
 	Constructor with initializer list to set default values of data members
 *******************************************************************************************************************/
-MenuState::MenuState(GameState* previousState)	:	GameState(previousState)
+MenuState::MenuState(GameState* previousState)	:	GameState(previousState),
+													m_laraObject(nullptr),
+													m_renderDevice(Graphics::Instance()->GetImmediateContext())
 {
+	for (int i = 0; i < 20; i++) { m_Sphere[i] = nullptr; }
 
 	DX_LOG("[MENU STATE] MenuState constructor initialized", DX_LOG_EMPTY, LOG_MESSAGE);
 	
@@ -25,10 +32,24 @@ MenuState::~MenuState() {
 	
 	//if (m_terrain) { delete m_terrain; m_terrain = nullptr; }
     delete _Text;
-    delete _FontTexture;
+    delete _Font;
 	delete _BadassQuads;
 	delete _CullFrustum;
 
+	//---------------------------------------------------------------- Deleting the objects releases their colliders and bodies, so none are left behind in the worlds when the state is gone
+	delete m_laraObject;
+	m_laraObject = nullptr;
+
+	for (int i = 0; i < 20; i++) { delete m_Sphere[i]; m_Sphere[i] = nullptr; }
+
+	//---------------------------------------------------------------- Stop the render threads before the devices they record with are deleted
+	m_renderThreads.Shutdown();
+	for (unsigned int i = 0; i < m_workerDevices.size(); i++) { delete m_workerDevices[i]; }
+	m_workerDevices.clear();
+
+	//---------------------------------------------------------------- The physics world outlives this state, but its threads were started for it
+	Physics::Instance()->Shutdown();
+
 	DX_LOG("[MENU STATE] MenuState destructor initialized", DX_LOG_EMPTY, LOG_MESSAGE);
 }
 
@@ -56,13 +77,48 @@ bool MenuState::Initialize() {
 	m_laraObject = new Actor(XMFLOAT3(50.0, 10.5, 20.0), &m_laraModel, &m_laraTexture);
     m_laraObject->RotateY(XM_PIDIV2);
 
+	//---------------------------------------------------------------- Physics is in units per second - these match how Lara handled when she was moved once per frame at 60 FPS
+	m_laraObject->SetMass(10.0f);
+	m_laraObject->SetFriction(48.0f);
+	m_laraObject->SetMaxSpeed(30.0f);
+	m_laraObject->SetMaxForce(5000.0f);
+	m_laraObject->AddBoxCollider(XMFLOAT3(0.0f, 0.95f, 0.0f), XMFLOAT3(0.35f, 0.95f, 0.35f));
+
     for (int i = 0; i < 20; i++) {
         m_Sphere[i] = new GameObject(XMFLOAT3(100.0f / (1.5f * i), 100.0f / (1.5f * i), 100.0f / (1.5f * i)), &m_SphereModel, &m_sphereTexture);
+        m_Sphere[i]->AddSphereCollider(XMFLOAT3(0.0f, 4.0f, 0.0f), 5.0f);
     }
 
-    _FontTexture = new Texture();
-    _FontTexture->LoadTexture("Fonts\\oriental.png");
-    _Text = new Text(_FontTexture, nullptr);
+	//---------------------------------------------------------------- The HUD font is baked by the project's post-build step (see BakeFonts() in Main.cpp), never by the game
+	std::string fontFileLocation = FontConstants::Directory + FontConstants::HudFont;
+
+	_Font = new Font();
+	if (!_Font->Load(fontFileLocation)) {
+		DX_LOG("[MENU STATE] HUD font missing - build the project, or run the game with -bakefonts: ", fontFileLocation.c_str(), LOG_ERROR);
+		return false;
+	}
+
+    _Text = new Text(_Font, nullptr);
+
+	//---------------------------------------------------------------- The HUD is the same every frame apart from its numbers, so keep it as labels that are only rebuilt when they change
+	m_hudLabels[HUD_FPS]			= _Text->CreateLabel(32, -0.9f, 0.83f, XMFLOAT3(1.0f, 0.0f, 0.0f));
+	m_hudLabels[HUD_FRAME_TIME]		= _Text->CreateLabel(32, -0.9f, 0.75f);
+	m_hudLabels[HUD_FRAME_STATS]	= _Text->CreateLabel(32, -0.9f, 0.67f, XMFLOAT3(1.0f, 0.0f, 0.0f));
+	m_hudLabels[HUD_CPU]			= _Text->CreateLabel(32, -0.9f, 0.59f);
+	m_hudLabels[HUD_RENDER_COUNT]	= _Text->CreateLabel(32, -0.9f, 0.51f);
+	m_hudLabels[HUD_VELOCITY]		= _Text->CreateLabel(32, -0.9f, 0.43f, XMFLOAT3(0.0f, 0.0f, 1.0f));
+	m_hudLabels[HUD_ACCELERATION]	= _Text->CreateLabel(32, -0.9f, 0.35f, XMFLOAT3(1.0f, 0.0f, 1.0f));
+	m_hudLabels[HUD_DRAWS]			= _Text->CreateLabel(32, -0.9f, 0.27f);
+	m_hudLabels[HUD_STATE_CHANGES]	= _Text->CreateLabel(32, -0.9f, 0.19f);
+	m_hudLabels[HUD_CONTACTS]		= _Text->CreateLabel(32, -0.9f, 0.11f);
+
+#if PROFILE_MODE == 1
+	//---------------------------------------------------------------- Where each frame's time goes, down the right hand side
+	for (unsigned int i = 0; i < ProfilerConstants::SummaryLines; i++) {
+		m_profileLabels[i] = _Text->CreateLabel(40, 0.1f, 0.83f - 0.08f * i, XMFLOAT3(1.0f, 1.0f, 0.0f));
+	}
+#endif
+
     _CullFrustum = new Frustum();
 
 	_BadassQuads = new QuadTree();
@@ -71,6 +127,17 @@ bool MenuState::Initialize() {
 	_tempCam->SetRotation(15.0f, 180.0f, 0.0f);
 	m_camera->SetRotation(15.0f, 0.0f, 0.0f);
 
+	//---------------------------------------------------------------- One device per deferred context - the main thread records the first chunk itself, so it needs one less worker
+	for (unsigned int i = 0; i < Graphics::Instance()->GetDeferredContextCount(); i++) {
+		m_workerDevices.push_back(new DirectXRenderDevice(Graphics::Instance()->GetDeferredContext(i)));
+	}
+
+	if (!m_workerDevices.empty()) { m_renderThreads.Initialize(m_workerDevices.size() - 1); }
+
+	//---------------------------------------------------------------- Physics islands are solved across every core, the main thread included
+	unsigned int physicsThreads = std::thread::hardware_concurrency();
+	Physics::Instance()->Initialize((physicsThreads > 1) ? physicsThreads - 1 : 0);
+
 	return true;
 }
 
@@ -90,88 +157,131 @@ void MenuState::Update(float deltaTime) {
 		IsActive() = IsAlive() = false;
 	}
 
-    m_camera->SetPosition(m_laraObject->GetPositionF().x, m_laraObject->GetPositionF().y + 5, m_laraObject->GetPositionF().z - 12);
-	_tempCam->SetPosition(m_laraObject->GetPositionF().x, m_laraObject->GetPositionF().y + 5, m_laraObject->GetPositionF().z + 12);
-    
-
-    m_laraObject->SetMass(10.0f);
 
-    if (Input::Instance()->IsKeyPressed(DIK_A)) { m_laraObject->ApplyForce(XMVectorSet(-0.25f, 0, 0, 0)); } //LEFT
-    if (Input::Instance()->IsKeyPressed(DIK_D)) { m_laraObject->ApplyForce(XMVectorSet(0.25f, 0, 0, 0)); } //RIGHT
-    if (Input::Instance()->IsKeyPressed(DIK_W)) { m_laraObject->ApplyForce(XMVectorSet(0, 0, 0.25f, 0)); } //FORWARD
-    if (Input::Instance()->IsKeyPressed(DIK_S)) { m_laraObject->ApplyForce(XMVectorSet(0, 0, -0.25f, 0)); } //BACK
-    if (Input::Instance()->IsKeyPressed(DIK_SPACE)) { m_laraObject->ApplyForce(XMVectorSet(0, 0.8f, 0, 0)); } //UP
-    if (Input::Instance()->IsKeyPressed(DIK_LCONTROL)) { m_laraObject->ApplyForce(XMVectorSet(0, -0.8f, 0, 0)); } //DOWN
+    if (Input::Instance()->IsKeyPressed(DIK_A)) { m_laraObject->ApplyForce(XMVectorSet(-900.0f, 0, 0, 0)); } //LEFT
+    if (Input::Instance()->IsKeyPressed(DIK_D)) { m_laraObject->ApplyForce(XMVectorSet(900.0f, 0, 0, 0)); } //RIGHT
+    if (Input::Instance()->IsKeyPressed(DIK_W)) { m_laraObject->ApplyForce(XMVectorSet(0, 0, 900.0f, 0)); } //FORWARD
+    if (Input::Instance()->IsKeyPressed(DIK_S)) { m_laraObject->ApplyForce(XMVectorSet(0, 0, -900.0f, 0)); } //BACK
+    if (Input::Instance()->IsKeyPressed(DIK_SPACE)) { m_laraObject->ApplyForce(XMVectorSet(0, 2880.0f, 0, 0)); } //UP
+    if (Input::Instance()->IsKeyPressed(DIK_LCONTROL)) { m_laraObject->ApplyForce(XMVectorSet(0, -2880.0f, 0, 0)); } //DOWN
 
 	if(Input::Instance()->IsKeyPressed(DIK_V)) { camflipped = !camflipped; } //DOWN
 
+	//---------------------------------------------------------------- Record the next few frames for chrome://tracing - ignored while one is already recording
+	if (Input::Instance()->IsKeyPressed(DIK_P)) { DX_PROFILE_CAPTURE(ProfilerConstants::CaptureFrames, ProfilerConstants::CaptureFile); }
+
+	//---------------------------------------------------------------- Write out the latest frame times - once per press, not once per update while it's held
+	bool isFramesKeyDown = (Input::Instance()->IsKeyPressed(DIK_F) != 0);
+	if (isFramesKeyDown && !m_isWritingFrameTimes) { Tracker::WriteFrameTimes(TrackerConstants::FrameTimesFile); }
+	m_isWritingFrameTimes = isFramesKeyDown;
+
     m_laraObject->Update();
-    m_laraObject->ApplyFriction(0.8f);
 
-	// Get the current position of the camera.
-	XMVECTOR position = m_laraObject->GetPosition();
+	//---------------------------------------------------------------- Step the physics world - the game loop updates at the physics rate, so this is always one step (the time is in milliseconds)
+	Physics::Instance()->Update(deltaTime / 1000.0f);
+
+	// Get the current simulated position of lara.
+	XMFLOAT3 position = m_laraObject->GetSimulatedPosition();
 	float height;
-	// Get the height of the triangle that is directly underneath the given camera position.
-	bool foundHeight = _BadassQuads->GetHeightAtPosition(XMVectorGetX(position), XMVectorGetZ(position), height);
+	// Get the height of the triangle that is directly underneath the given position.
+	bool foundHeight = _BadassQuads->GetHeightAtPosition(position.x, position.z, height);
 	if (foundHeight)
 	{
-		// If there was a triangle under the camera then position the camera just above it by two units.
-		m_laraObject->SetPosition(XMFLOAT3(XMVectorGetX(position), height + 0.0f, XMVectorGetZ(position)));
+		// If there was a triangle under lara then snap her on to it.
+		m_laraObject->Teleport(XMFLOAT3(position.x, height + 0.0f, position.z));
 	}
 
-    _CullFrustum->Create(m_camera->GetViewMatrix());
+	//---------------------------------------------------------------- Move every animated object's playhead on together
+	Animations::Instance()->Update(deltaTime / 1000.0f);
 }
 
 
 /*******************************************************************************************************************
-	Function that renders all menu state graphics to the screen
+	Function that fills in a snapshot of everything to draw this frame - runs on the main thread
 *******************************************************************************************************************/
-void MenuState::Draw() {
-	
-	//---------------------------------------------------------------- Clear the screen
-	Graphics::Instance()->BeginScene(0.2f, 0.2f, 0.4f, 1.0f);
-	Graphics::Instance()->EnableDepthBuffer(true);
-	Graphics::Instance()->EnableAlphaBlending(false);
+void MenuState::Draw(RenderSnapshot& snapshot, float interpolation) {
 
-	Camera* swapCam;
+	//---------------------------------------------------------------- Place everything between its last two steps, after any snapping, so it's drawn smoothly
+	Physics::Instance()->Interpolate(interpolation);
 
-	if (!camflipped) {
-		swapCam = m_camera;
-	}
-	else {
-		swapCam = _tempCam;
-	}
-	
-	////////////////////////////////////////////////
-	//  BEGIN 3D RENDERING
-	////////////////////////////////////////////////
-	
-	_BadassQuads->Render(_CullFrustum, nullptr, swapCam);
+	//---------------------------------------------------------------- Follow where lara is drawn, not where she was simulated
+    m_camera->SetPosition(m_laraObject->GetPositionF().x, m_laraObject->GetPositionF().y + 5, m_laraObject->GetPositionF().z - 12);
+	_tempCam->SetPosition(m_laraObject->GetPositionF().x, m_laraObject->GetPositionF().y + 5, m_laraObject->GetPositionF().z + 12);
+
+    _CullFrustum->Create(m_camera->GetViewMatrix());
+
+	//---------------------------------------------------------------- The snapshot keeps its own copy of the camera, so the next update can move this one while it's drawn
+	snapshot.camera = (!camflipped) ? *m_camera : *_tempCam;
+
+	//---------------------------------------------------------------- Bring every moved object's world matrix up to date in one pass, before anything asks for one
+	Transforms::Instance()->UpdateWorldMatrices();
+
+	//---------------------------------------------------------------- Queue everything for this frame - the queue copies each world matrix, and sorts it and sets the depth/blend state per layer when drawn
+	snapshot.queue.Begin(&snapshot.camera);
+
+	_BadassQuads->Submit(snapshot.queue, _CullFrustum);
 	//m_terrain->Render(m_camera);
 
-	m_laraObject->Render(swapCam);
+	m_laraObject->Submit(snapshot.queue);
 
-    int renderCount = 0;
+	//---------------------------------------------------------------- The stats shown are from the last frame the render thread finished
+	RenderStats stats = Game::Instance()->GetRenderStats();
 
+	snapshot.SetLabel(m_hudLabels[HUD_FPS], "FPS: %d", Tracker::GetFps());
+	snapshot.SetLabel(m_hudLabels[HUD_FRAME_TIME], "Frame Time: %f", Tracker::GetTime());
 
-    ////////////////////////////////////////////////
-    //  BEGIN 2D RENDERING
-    ////////////////////////////////////////////////
-    Graphics::Instance()->EnableDepthBuffer(false);
-    Graphics::Instance()->EnableAlphaBlending(true);
+	//---------------------------------------------------------------- The FPS hides the odd slow frame - 1 frame in 100 is slower than the 99th percentile
+	const FrameStats& frameStats = Tracker::GetFrameStats();
+	snapshot.SetLabel(m_hudLabels[HUD_FRAME_STATS], "p99: %.2fms Worst: %.2fms", frameStats.p99, frameStats.max);
+	snapshot.SetLabel(m_hudLabels[HUD_CPU], "CPU%%: %d (Game: %d)", Tracker::GetCpuPercentage(), Tracker::GetProcessCpuPercentage());
+	snapshot.SetLabel(m_hudLabels[HUD_RENDER_COUNT], "Render Count: %d", _BadassQuads->GetDrawCount());
 
-    _Text->DrawString("FPS: " + std::to_string(Tracker::GetFps()), -0.9f, 0.83f, XMFLOAT3(1.0f, 0.0f, 0.0f));
-    _Text->DrawString("Frame Time: " + std::to_string(Tracker::GetTime()), -0.9f, 0.75f);
-    _Text->DrawString("CPU%: " + std::to_string(Tracker::GetCpuPercentage()), -0.9f, 0.67f);
-    _Text->DrawString("Render Count: " + std::to_string(_BadassQuads->GetDrawCount()), -0.9f, 0.59f);
+	snapshot.SetLabel(m_hudLabels[HUD_VELOCITY], "VelocityX: %f", XMVectorGetX(m_laraObject->GetVelocity()));
+	snapshot.SetLabel(m_hudLabels[HUD_ACCELERATION], "AccelX: %f", XMVectorGetX(m_laraObject->GetAcceleration()));
 
-    _Text->DrawString("VelocityX: " + std::to_string(XMVectorGetX(m_laraObject->GetVelocity())), -0.9f, 0.51f, XMFLOAT3(0.0f, 0.0f, 1.0f));
-    _Text->DrawString("AccelX: " + std::to_string(XMVectorGetX(m_laraObject->GetAcceleration())), -0.9f, 0.43f, XMFLOAT3(1.0f, 0.0f, 1.0f));
+	snapshot.SetLabel(m_hudLabels[HUD_DRAWS], "Draws: %u", stats.draws);
+	snapshot.SetLabel(m_hudLabels[HUD_STATE_CHANGES], "State Changes: %u", stats.stateChanges);
+	snapshot.SetLabel(m_hudLabels[HUD_CONTACTS], "Contacts: %u", (unsigned int)Collisions::Instance()->GetContacts().size());
+
+#if PROFILE_MODE == 1
+	//---------------------------------------------------------------- Each thread, then its zones indented under it - the deepest zones are left off so the busiest ones fit
+	const std::vector<ProfileNode>& summary = Profiler::GetSummary();
+	unsigned int line = 0;
+
+	for (unsigned int i = 0; i < summary.size() && line < ProfilerConstants::SummaryLines; i++) {
+		const ProfileNode& zone = summary[i];
+		if (zone.depth > ProfilerConstants::SummaryDepth) { continue; }
+
+		if (zone.depth == 0)	{ snapshot.SetLabel(m_profileLabels[line++], "%s: %.2fms", zone.name, zone.time); }
+		else					{ snapshot.SetLabel(m_profileLabels[line++], "%*s%s: %.2fms x%.1f", zone.depth * 2, "", zone.name, zone.time, zone.calls); }
+	}
+
+	for (; line < ProfilerConstants::SummaryLines; line++) { snapshot.SetLabel(m_profileLabels[line], "%s", ""); }
+#endif
+}
+
+
+/*******************************************************************************************************************
+	Function that renders a snapshot of the menu state to the screen - runs on the render thread
+*******************************************************************************************************************/
+void MenuState::Render(RenderSnapshot& snapshot) {
+
+	//---------------------------------------------------------------- Clear the screen
+	Graphics::Instance()->BeginScene(0.2f, 0.2f, 0.4f, 1.0f);
+
+	//---------------------------------------------------------------- The text is only ever touched here, as updating its labels uploads them on the immediate context
+	snapshot.SubmitLabels(_Text);
+
+	//---------------------------------------------------------------- Record the sorted draws across the render threads, or on this thread if there are no deferred contexts
+	if (!m_workerDevices.empty()) {
+		snapshot.queue.Execute(&m_workerDevices[0], m_workerDevices.size(), m_renderThreads, GraphicConstants::MIN_COMMANDS_PER_THREAD);
+	}
+	else {
+		snapshot.queue.Execute(m_renderDevice);
+	}
 
-	
 	//---------------------------------------------------------------- Present the rendered scene to the screen
 	Graphics::Instance()->EndScene();
-
 }
 
 
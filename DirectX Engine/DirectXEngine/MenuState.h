@@ -19,6 +19,13 @@
 #include "Text.h"
 #include "Frustum.h"
 #include "QuadTree.h"
+#include "RenderQueue.h"
+#include "RenderDevice.h"
+#include "ThreadPool.h"
+#include "FramePipeline.h"
+#include "Profiler.h"
+
+#include <vector>
 
 
 class MenuState : public GameState {
@@ -29,7 +36,8 @@ public:
 
 public:
 	virtual void Update(float deltaTime) override;
-	virtual void Draw() override;
+	virtual void Draw(RenderSnapshot& snapshot, float interpolation) override;
+	virtual void Render(RenderSnapshot& snapshot) override;
 	
 private:
 	bool Initialize();
@@ -48,12 +56,25 @@ private:
 	GameObject* m_Sphere[20];
 
     Text* _Text;
-    Texture* _FontTexture;
+    Font* _Font;
+
+	enum HudLine { HUD_FPS, HUD_FRAME_TIME, HUD_FRAME_STATS, HUD_CPU, HUD_RENDER_COUNT, HUD_VELOCITY, HUD_ACCELERATION, HUD_DRAWS, HUD_STATE_CHANGES, HUD_CONTACTS, HUD_TOTAL };
+	TextLabel m_hudLabels[HUD_TOTAL];
+
+#if PROFILE_MODE == 1
+	TextLabel m_profileLabels[ProfilerConstants::SummaryLines];
+#endif
 
     Frustum* _CullFrustum;
 	QuadTree* _BadassQuads;
 
 	Camera* _tempCam;
 	bool camflipped = false;
+	bool m_isWritingFrameTimes = false;
+
+	DirectXRenderDevice m_renderDevice;
+
+	ThreadPool m_renderThreads;
+	std::vector<RenderDevice*> m_workerDevices;
 
 };
\ No newline at end of file
@@ -50,3 +50,9 @@ void Model::Render() const
 {
 	m_buffer.Render(m_stride, m_offset);
 }
+
+
+void Model::Render(RenderContext& context, const void*) const
+{
+	m_buffer.Render(context, m_stride, m_offset);
+}
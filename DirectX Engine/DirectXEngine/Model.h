@@ -3,16 +3,18 @@
 #include <d3d11.h>
 #include <vector>
 #include "Buffer.h"
+#include "RenderQueue.h"
 
-class Model {
+class Model : public Renderable {
 
 public:
 	Model();
-	~Model();
+	virtual ~Model();
 
 	bool Load(const char* fileLocation);
 
 	void Render() const;
+	virtual void Render(RenderContext& context, const void* data) const override;
 	void Update(); //May not need
 
 private:
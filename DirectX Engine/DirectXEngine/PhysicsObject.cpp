@@ -4,25 +4,22 @@
 #include "PhysicsObject.h"
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-PhysicsObject::PhysicsObject() :
-    _Velocity(XMVectorSet(0, 0, 0, 0)),
-    _Desired(XMVectorSet(0, 0, 0, 0)),
-    _Acceleration(XMVectorSet(0, 0, 0, 0)),
-    _Mass(1.0f),
-    _MaxForce(1.0f),
-    _MaxSpeed(1.0f)
+PhysicsObject::PhysicsObject(TransformHandle Transform) :
+    _Desired(XMVectorSet(0, 0, 0, 0))
 {
+    _Body = Physics::Instance()->Create(Transform);
 }
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 PhysicsObject::~PhysicsObject()
 {
+    Physics::Instance()->Release(_Body);
 }
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 void PhysicsObject::SetVelocity(const XMVECTOR Velocity)
 {
-    _Velocity = Velocity;
+    Physics::Instance()->SetVelocity(_Body, Velocity);
 }
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
@@ -31,104 +28,98 @@ void PhysicsObject::SetDesiredVelocity(const XMVECTOR Velocity)
     _Desired = Velocity;
 }
 
-//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-void PhysicsObject::SetAcceleration(const XMVECTOR Acceleration)
-{
-    _Acceleration = Acceleration;
-}
-
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 void PhysicsObject::SetMass(float Mass)
 {
-    _Mass = Mass;
+    Physics::Instance()->SetMass(_Body, Mass);
 }
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 void PhysicsObject::SetMaxSpeed(float MaxSpeed)
 {
-    _MaxSpeed = MaxSpeed;
+    Physics::Instance()->SetMaxSpeed(_Body, MaxSpeed);
 }
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 void PhysicsObject::SetMaxForce(float MaxForce)
 {
-    _MaxForce = MaxForce;
+    Physics::Instance()->SetMaxForce(_Body, MaxForce);
 }
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-void PhysicsObject::AddVelocity(const XMVECTOR Velocity)
+void PhysicsObject::SetFriction(float Coeficient)
 {
-    _Velocity += Velocity;
+    //Law of Dry Friction, applied by the physics world every step:
+    //Force = -1 * Coeficient of Friction * Normal Force * Velocity. Assume normal force is 1(flat surface).
+    Physics::Instance()->SetFriction(_Body, Coeficient);
 }
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-const XMVECTOR& PhysicsObject::GetVelocity() const
+void PhysicsObject::SetDrag(float Coeficient)
 {
-    return _Velocity;
+    //Law of drag, applied by the physics world every step:
+    //Force = -1/2 * Fluid Density * (Magnitude of Velocity)^2 * Surface Area of Object * Coeficient of Drag * Unit Length Velocity.
+    //Assume Density and Surface Area = 1 for simplicity.
+    Physics::Instance()->SetDrag(_Body, Coeficient);
 }
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-const XMVECTOR & PhysicsObject::GetDesiredVelocity() const
+void PhysicsObject::AddVelocity(const XMVECTOR Velocity)
 {
-    return _Desired;
+    Physics::Instance()->AddVelocity(_Body, Velocity);
 }
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-const XMVECTOR & PhysicsObject::GetAcceleration() const
+void PhysicsObject::Teleport(const XMFLOAT3& Position)
 {
-    return _Acceleration;
+    Physics::Instance()->Teleport(_Body, Position);
 }
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-float PhysicsObject::GetMass() const
+XMVECTOR PhysicsObject::GetVelocity() const
 {
-    return _Mass;
+    return Physics::Instance()->GetVelocity(_Body);
 }
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-float PhysicsObject::GetMaxSpeed() const
+const XMVECTOR & PhysicsObject::GetDesiredVelocity() const
 {
-    return _MaxSpeed;
+    return _Desired;
 }
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-float PhysicsObject::GetMaxForce() const
+XMVECTOR PhysicsObject::GetAcceleration() const
 {
-    return _MaxForce;
+    return Physics::Instance()->GetAcceleration(_Body);
 }
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-void PhysicsObject::ApplyForce(const XMVECTOR Force)
+XMFLOAT3 PhysicsObject::GetSimulatedPosition() const
 {
-    //Newtons 2nd Law: Force = Mass * Acceleration
-    //Therefore:
-    _Acceleration += (Force / _Mass);
+    return Physics::Instance()->GetPosition(_Body);
 }
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-void PhysicsObject::ApplyFriction(float Coeficient)
+float PhysicsObject::GetMass() const
 {
-    //Law of Dry Friction:
-    //Force = -1 * Coeficient of Friction * Normal Force * Unit Length Velocity.
+    return Physics::Instance()->GetMass(_Body);
+}
 
-    XMVECTOR force = _Velocity;
-    //force = XMVector4Normalize(force);   //Get Unit Length of current velocity.
-    force *= Coeficient;                 //Multiply by friction coeficient. Assume normal force is 1(flat surface).
-    force *= -1.0f;                      //Negate friction so it acts in opposite direction to movement.
-    ApplyForce(force);                   //Apply friction force.
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+float PhysicsObject::GetMaxSpeed() const
+{
+    return Physics::Instance()->GetMaxSpeed(_Body);
 }
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-void PhysicsObject::ApplyDrag(float Coeficient)
+float PhysicsObject::GetMaxForce() const
 {
-    //Law of drag:
-    //Force = -1/2 * Fluid Density * (Magnitude of Velocity)^2 * Surface Area of Object * Coeficient of Drag * Unit Length Velocity.
-    XMVECTOR force = _Velocity;
-    float magSq = XMVectorGetX(XMVector4LengthSq(force)); //Gets the Magnitude of the velocity squared.
-    force = XMVector4Normalize(force);                    //Get Unit Length of current Velocity.
-    float negCo = -Coeficient;                            //Negate coeficient to reverse direction of force.
-    force *= negCo;                                       //Finish Equation.
-    force *= magSq;                                       //Assume Density and Surface Area = 1 for simplicity.
-    ApplyForce(force);                                    //Apply drag force.
+    return Physics::Instance()->GetMaxForce(_Body);
+}
 
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+void PhysicsObject::ApplyForce(const XMVECTOR Force)
+{
+    //Newtons 2nd Law: Force = Mass * Acceleration, worked out by the physics world when it steps.
+    Physics::Instance()->ApplyForce(_Body, Force);
 }
@@ -2,7 +2,7 @@
 //  PhysicsObject.h, PhysicsObject.cpp
 //
 //  Created By:     Chris Hargove
-//  Last Updated:   10/02/2018
+//  Last Updated:   19/10/2026
 //  
 //  This class is the base class for all objects that require physics to be handled.
 //  It is the base class that the physics manager class will use to get physics data
@@ -16,18 +16,25 @@
 #include <d3d11.h>
 #include <xnamath.h>
 
+#include "PhysicsWorld.h"
+
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 //  This class is the base class for all objects that require physics to be handled.
 //  It is the base class that the physics manager class will use to get physics data
 //  and manipulate objects.
+//
+//  The physics data itself lives in the physics world, this is a handle in to it. The
+//  world moves every physics object together on a fixed time step, so all units are per
+//  second - velocity in units per second, forces in newtons.
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 class PhysicsObject
 {
 public:
     //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-    //  Default Constructor
+    //  Constructor
+    //  --Transform-- The transform the physics world should move.
     //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-    PhysicsObject();
+    PhysicsObject(TransformHandle Transform);
 
     //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
     //  Default Destructor
@@ -46,12 +53,6 @@ public:
     //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
     void SetDesiredVelocity(const XMVECTOR Velocity);
 
-    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-    //  Sets the acceleration of the physics object to that supplied.
-    //  --Acceleration-- The new acceleration for the object.
-    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-    void SetAcceleration(const XMVECTOR Acceleration);
-
     //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
     //  Sets the mass of the physics object to that supplied in Kg.
     //  --Mass-- The new mass for the object.
@@ -70,16 +71,35 @@ public:
     //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
     void SetMaxForce(float MaxForce);
 
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    //  Sets the friction acting on the physics object every step.
+    //  --Coeficient-- The friction coeficient to apply.
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    void SetFriction(float Coeficient);
+
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    //  Sets the drag acting on the physics object every step.
+    //  --Coeficient-- The drag coeficient to apply.
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    void SetDrag(float Coeficient);
+
     //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
     //  Adds the velocity supplied to the physics objects current velocity.
     //  --Velocity-- The velocity to add to the object.
     //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
     void AddVelocity(const XMVECTOR Velocity);
 
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    //  Moves the physics object straight to a position, without blending from
+    //  where it was.
+    //  --Position-- The new position for the object.
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    void Teleport(const XMFLOAT3& Position);
+
     //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
     //  Gets the current velocity of the physics object.
     //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-    const XMVECTOR& GetVelocity() const;
+    XMVECTOR GetVelocity() const;
 
     //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
     //  Gets the current desired velocity of the physics object.
@@ -87,9 +107,15 @@ public:
     const XMVECTOR& GetDesiredVelocity() const;
 
     //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-    //  Gets the current acceleration of the physics object.
+    //  Gets the acceleration of the physics object over the last step.
     //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-    const XMVECTOR& GetAcceleration() const;
+    XMVECTOR GetAcceleration() const;
+
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    //  Gets the position of the physics object as of the last step. The
+    //  transform lags slightly behind, as it's blended between steps.
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    XMFLOAT3 GetSimulatedPosition() const;
 
     //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
     //  Gets the current mass of the physics object.
@@ -107,33 +133,22 @@ public:
     float GetMaxForce() const;
 
     //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-    //  Applies a force to the physics object.
+    //  Applies a force to the physics object for the next steps.
     //  --Force-- The force to apply to the physics object.
     //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
     void ApplyForce(const XMVECTOR Force);
 
+private:
     //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-    //  Applies a friction force to the physics object.
-    //  --Coeficient-- The friction coeficient to apply.
-    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-    void ApplyFriction(float Coeficient);
-
-    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-    //  Applies a drag force to the physics object.
-    //  --Coeficient-- The drag coeficient to apply.
+    //  Physics objects own their body, so copying one would release it twice.
     //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-    void ApplyDrag(float Coeficient);
+    PhysicsObject(const PhysicsObject&);
+    PhysicsObject& operator=(const PhysicsObject&);
 
-private:
     //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
     //  Member Variables.
     //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-    XMVECTOR    _Velocity;      // Physics Object current Velocity.
+    PhysicsBody _Body;          // Physics Object body in the physics world.
     XMVECTOR    _Desired;       // Physics Object current Desired Velocity.
-    XMVECTOR    _Acceleration;  // Physics Object current Acceleration.
-    float       _Mass;          // Physics Object current Mass in Kg.
-    float       _MaxSpeed;      // Physics Object Maximum Speed.
-    float       _MaxForce;      // Physics Object Maximum Force.
 
 };
-
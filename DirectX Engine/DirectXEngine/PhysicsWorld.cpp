@@ -0,0 +1,644 @@
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+#include "PhysicsWorld.h"
+#include "CollisionWorld.h"
+#include "Constants.h"
+
+/*******************************************************************************************************************
+	Function that loads 4 bodies' worth of one component in to a vector
+*******************************************************************************************************************/
+static XMVECTOR LoadGroup(const std::vector<float>& component, unsigned int first)
+{
+	return XMLoadFloat4((const XMFLOAT4*)&component[first]);
+}
+
+
+/*******************************************************************************************************************
+	Function that stores a vector back over 4 bodies' worth of one component
+*******************************************************************************************************************/
+static void StoreGroup(std::vector<float>& component, unsigned int first, FXMVECTOR value)
+{
+	XMStoreFloat4((XMFLOAT4*)&component[first], value);
+}
+
+
+/*******************************************************************************************************************
+	Function that scales a group of 3D vectors down so none are longer than their limit
+*******************************************************************************************************************/
+static void ClampLength(XMVECTOR& x, XMVECTOR& y, XMVECTOR& z, FXMVECTOR limit)
+{
+	XMVECTOR lengthSq	= x * x + y * y + z * z;
+	XMVECTOR tooLong	= XMVectorGreater(lengthSq, limit * limit);
+	XMVECTOR scale		= XMVectorSelect(XMVectorSplatOne(), limit * XMVectorReciprocalSqrt(lengthSq), tooLong);
+
+	x *= scale;
+	y *= scale;
+	z *= scale;
+}
+
+
+/*******************************************************************************************************************
+	Constructor with initializer list to set all default values of variables
+*******************************************************************************************************************/
+PhysicsWorld::PhysicsWorld()	:	m_count(0),
+									m_islandCount(0),
+									m_accumulator(0.0f),
+									m_interpolation(0.0f)
+{
+}
+
+
+/*******************************************************************************************************************
+	Function that starts the threads that help step the world - with none, the calling thread does it all
+*******************************************************************************************************************/
+bool PhysicsWorld::Initialize(unsigned int threadCount)
+{
+	return m_threads.Initialize(threadCount);
+}
+
+
+/*******************************************************************************************************************
+	Function that stops the threads that help step the world
+*******************************************************************************************************************/
+void PhysicsWorld::Shutdown()
+{
+	m_threads.Shutdown();
+}
+
+
+/*******************************************************************************************************************
+	Function that creates a body at rest at the transform's position, with a mass of 1 and no limits
+*******************************************************************************************************************/
+PhysicsBody PhysicsWorld::Create(TransformHandle transform)
+{
+	PhysicsBody body = m_count;
+
+	//-------------------------------------------- Reuse a released slot if there is one, otherwise take the next one on the end
+	if (!m_freeBodies.empty()) {
+		body = m_freeBodies.back();
+		m_freeBodies.pop_back();
+	}
+	else {
+		if (m_count == m_positionX.size()) {
+
+			//-------------------------------------------- Double the room each time, keeping every array a whole number of SIMD groups
+			size_t capacity = (m_count < 4) ? 4 : m_count * 2;
+
+			m_positionX.resize(capacity, 0.0f);		m_positionY.resize(capacity, 0.0f);		m_positionZ.resize(capacity, 0.0f);
+			m_previousX.resize(capacity, 0.0f);		m_previousY.resize(capacity, 0.0f);		m_previousZ.resize(capacity, 0.0f);
+			m_velocityX.resize(capacity, 0.0f);		m_velocityY.resize(capacity, 0.0f);		m_velocityZ.resize(capacity, 0.0f);
+			m_forceX.resize(capacity, 0.0f);		m_forceY.resize(capacity, 0.0f);		m_forceZ.resize(capacity, 0.0f);
+			m_accelerationX.resize(capacity, 0.0f);	m_accelerationY.resize(capacity, 0.0f);	m_accelerationZ.resize(capacity, 0.0f);
+
+			//-------------------------------------------- Unused slots have no inverse mass, so they never move
+			m_inverseMass.resize(capacity, 0.0f);
+			m_maxSpeed.resize(capacity, FLT_MAX);
+			m_maxForce.resize(capacity, FLT_MAX);
+			m_friction.resize(capacity, 0.0f);
+			m_drag.resize(capacity, 0.0f);
+
+			m_transforms.resize(capacity, INVALID_TRANSFORM);
+		}
+
+		m_count++;
+	}
+
+	XMFLOAT3 position = Transforms::Instance()->GetPosition(transform);
+
+	m_positionX[body] = m_previousX[body] = position.x;
+	m_positionY[body] = m_previousY[body] = position.y;
+	m_positionZ[body] = m_previousZ[body] = position.z;
+
+	m_velocityX[body] = m_velocityY[body] = m_velocityZ[body] = 0.0f;
+	m_forceX[body] = m_forceY[body] = m_forceZ[body] = 0.0f;
+	m_accelerationX[body] = m_accelerationY[body] = m_accelerationZ[body] = 0.0f;
+
+	m_inverseMass[body]	= 1.0f;
+	m_maxSpeed[body]	= FLT_MAX;
+	m_maxForce[body]	= FLT_MAX;
+	m_friction[body]	= 0.0f;
+	m_drag[body]		= 0.0f;
+	m_transforms[body]	= transform;
+
+	if (transform >= m_bodyOfTransform.size()) { m_bodyOfTransform.resize(transform + 1, INVALID_BODY); }
+	m_bodyOfTransform[transform] = body;
+
+	return body;
+}
+
+
+/*******************************************************************************************************************
+	Function that stops a body and hands its slot back to be reused
+*******************************************************************************************************************/
+void PhysicsWorld::Release(PhysicsBody body)
+{
+	if (body >= m_count || m_transforms[body] == INVALID_TRANSFORM) { return; }
+
+	//-------------------------------------------- The slot is still stepped with the rest, so make sure it stays put
+	m_velocityX[body] = m_velocityY[body] = m_velocityZ[body] = 0.0f;
+	m_forceX[body] = m_forceY[body] = m_forceZ[body] = 0.0f;
+	m_inverseMass[body] = 0.0f;
+
+	m_bodyOfTransform[m_transforms[body]]	= INVALID_BODY;
+	m_transforms[body]						= INVALID_TRANSFORM;
+
+	//-------------------------------------------- Anything it was linked to is let go
+	for (unsigned int i = 0; i < m_links.size(); ) {
+		if (m_links[i].first == body || m_links[i].second == body) { m_links[i] = m_links.back(); m_links.pop_back(); }
+		else { i++; }
+	}
+
+	m_freeBodies.push_back(body);
+}
+
+
+/*******************************************************************************************************************
+	Function that keeps two bodies the distance apart they are now - linked bodies always share an island
+*******************************************************************************************************************/
+void PhysicsWorld::Link(PhysicsBody first, PhysicsBody second)
+{
+	if (first == second) { return; }
+
+	float x = m_positionX[second] - m_positionX[first];
+	float y = m_positionY[second] - m_positionY[first];
+	float z = m_positionZ[second] - m_positionZ[first];
+
+	BodyLink link = { first, second, sqrtf(x * x + y * y + z * z) };
+	m_links.push_back(link);
+}
+
+
+/*******************************************************************************************************************
+	Function that steps the world by as many fixed steps as fit in the time passed (in seconds)
+*******************************************************************************************************************/
+void PhysicsWorld::Update(float deltaTime)
+{
+	m_accumulator += deltaTime;
+
+	unsigned int steps = 0;
+
+	while (m_accumulator >= PhysicsConstants::TimeStep && steps < PhysicsConstants::MaxStepsPerFrame) {
+		Step(PhysicsConstants::TimeStep);
+		m_accumulator -= PhysicsConstants::TimeStep;
+		steps++;
+	}
+
+	//-------------------------------------------- After a long stall, drop the time that couldn't be caught up rather than trying to catch up forever
+	if (m_accumulator >= PhysicsConstants::TimeStep) { m_accumulator = 0.0f; }
+
+	//-------------------------------------------- Forces are applied for every step in the frame, then used up
+	if (steps > 0) {
+		std::fill(m_forceX.begin(), m_forceX.end(), 0.0f);
+		std::fill(m_forceY.begin(), m_forceY.end(), 0.0f);
+		std::fill(m_forceZ.begin(), m_forceZ.end(), 0.0f);
+	}
+
+	m_interpolation = m_accumulator / PhysicsConstants::TimeStep;
+}
+
+
+/*******************************************************************************************************************
+	Function that moves every body forward by one step (in seconds), then pushes apart anything touching
+*******************************************************************************************************************/
+void PhysicsWorld::Step(float timeStep)
+{
+	//-------------------------------------------- Bodies move on their own until they touch, so integration is split in to blocks across the threads
+	unsigned int blockSize	= PhysicsConstants::IntegrateBlockSize;
+	unsigned int blockCount	= (m_count + blockSize - 1) / blockSize;
+
+	m_threads.Dispatch(blockCount, [this, blockSize, timeStep](unsigned int block) {
+		Integrate(block * blockSize, (std::min)((block + 1) * blockSize, m_count), timeStep);
+	});
+
+	//-------------------------------------------- Find what's touching where the bodies have just moved to
+	TransformManager* transforms = Transforms::Instance();
+
+	for (unsigned int body = 0; body < m_count; body++) {
+		if (m_transforms[body] != INVALID_TRANSFORM) { transforms->SetPosition(m_transforms[body], GetPosition(body)); }
+	}
+
+	Collisions::Instance()->Update();
+
+	FindContacts();
+	BuildIslands();
+
+	//-------------------------------------------- Islands can't affect each other, so each run of them is solved on whichever thread gets to it
+	m_threads.Dispatch(m_batchStart.size() - 1, [this](unsigned int batch) {
+		for (unsigned int island = m_batchStart[batch]; island < m_batchStart[batch + 1]; island++) { SolveIsland(island); }
+	});
+}
+
+
+/*******************************************************************************************************************
+	Function that integrates a run of bodies - first has to be the start of a group of 4
+*******************************************************************************************************************/
+void PhysicsWorld::Integrate(unsigned int first, unsigned int last, float timeStep)
+{
+	XMVECTOR deltaTime = XMVectorReplicate(timeStep);
+
+	for (; first < last; first += 4) {
+
+		XMVECTOR velocityX = LoadGroup(m_velocityX, first);
+		XMVECTOR velocityY = LoadGroup(m_velocityY, first);
+		XMVECTOR velocityZ = LoadGroup(m_velocityZ, first);
+
+		XMVECTOR forceX = LoadGroup(m_forceX, first);
+		XMVECTOR forceY = LoadGroup(m_forceY, first);
+		XMVECTOR forceZ = LoadGroup(m_forceZ, first);
+
+		ClampLength(forceX, forceY, forceZ, LoadGroup(m_maxForce, first));
+
+		//-------------------------------------------- Friction pushes back in proportion to velocity, drag in proportion to velocity squared
+		XMVECTOR speed		= XMVectorSqrt(velocityX * velocityX + velocityY * velocityY + velocityZ * velocityZ);
+		XMVECTOR resistance	= LoadGroup(m_friction, first) + LoadGroup(m_drag, first) * speed;
+		XMVECTOR inverseMass = LoadGroup(m_inverseMass, first);
+
+		//-------------------------------------------- Newtons 2nd Law: Acceleration = Force / Mass
+		XMVECTOR accelerationX = (forceX - resistance * velocityX) * inverseMass;
+		XMVECTOR accelerationY = (forceY - resistance * velocityY) * inverseMass;
+		XMVECTOR accelerationZ = (forceZ - resistance * velocityZ) * inverseMass;
+
+		//-------------------------------------------- Velocity first, then position from the new velocity
+		velocityX += accelerationX * deltaTime;
+		velocityY += accelerationY * deltaTime;
+		velocityZ += accelerationZ * deltaTime;
+
+		ClampLength(velocityX, velocityY, velocityZ, LoadGroup(m_maxSpeed, first));
+
+		XMVECTOR positionX = LoadGroup(m_positionX, first);
+		XMVECTOR positionY = LoadGroup(m_positionY, first);
+		XMVECTOR positionZ = LoadGroup(m_positionZ, first);
+
+		StoreGroup(m_previousX, first, positionX);
+		StoreGroup(m_previousY, first, positionY);
+		StoreGroup(m_previousZ, first, positionZ);
+
+		StoreGroup(m_positionX, first, positionX + velocityX * deltaTime);
+		StoreGroup(m_positionY, first, positionY + velocityY * deltaTime);
+		StoreGroup(m_positionZ, first, positionZ + velocityZ * deltaTime);
+
+		StoreGroup(m_velocityX, first, velocityX);
+		StoreGroup(m_velocityY, first, velocityY);
+		StoreGroup(m_velocityZ, first, velocityZ);
+
+		StoreGroup(m_accelerationX, first, accelerationX);
+		StoreGroup(m_accelerationY, first, accelerationY);
+		StoreGroup(m_accelerationZ, first, accelerationZ);
+	}
+}
+
+
+/*******************************************************************************************************************
+	Function that turns the collision world's contacts in to contacts between bodies, dropping any with nothing to move
+*******************************************************************************************************************/
+void PhysicsWorld::FindContacts()
+{
+	CollisionWorld* collisions = Collisions::Instance();
+	const std::vector<Contact>& contacts = collisions->GetContacts();
+
+	m_contacts.clear();
+
+	for (unsigned int i = 0; i < contacts.size(); i++) {
+		TransformHandle firstTransform	= collisions->GetTransform(contacts[i].first);
+		TransformHandle secondTransform	= collisions->GetTransform(contacts[i].second);
+
+		PhysicsBody first	= (firstTransform < m_bodyOfTransform.size()) ? m_bodyOfTransform[firstTransform] : INVALID_BODY;
+		PhysicsBody second	= (secondTransform < m_bodyOfTransform.size()) ? m_bodyOfTransform[secondTransform] : INVALID_BODY;
+
+		if (!IsMoving(first) && !IsMoving(second)) { continue; }
+
+		BodyContact contact = { first, second, contacts[i].normal, contacts[i].depth, 0.0f };
+		contact.separation = GetSeparation(first, second, contact.normal);
+
+		m_contacts.push_back(contact);
+	}
+}
+
+
+/*******************************************************************************************************************
+	Function that groups the moving bodies in to islands, and sorts every contact and link in to its island
+*******************************************************************************************************************/
+void PhysicsWorld::BuildIslands()
+{
+	m_parents.resize(m_count);
+	for (unsigned int body = 0; body < m_count; body++) { m_parents[body] = body; }
+
+	//-------------------------------------------- Join every pair of moving bodies that touch or are linked - the lowest body is always the root
+	for (unsigned int i = 0; i < m_contacts.size() + m_links.size(); i++) {
+		PhysicsBody first	= (i < m_contacts.size()) ? m_contacts[i].first : m_links[i - m_contacts.size()].first;
+		PhysicsBody second	= (i < m_contacts.size()) ? m_contacts[i].second : m_links[i - m_contacts.size()].second;
+
+		//-------------------------------------------- Something that doesn't move can't pass a push on, so it doesn't join islands together
+		if (!IsMoving(first) || !IsMoving(second)) { continue; }
+
+		unsigned int firstRoot	= FindRoot(first);
+		unsigned int secondRoot	= FindRoot(second);
+
+		if (firstRoot < secondRoot)			{ m_parents[secondRoot] = firstRoot; }
+		else if (secondRoot < firstRoot)	{ m_parents[firstRoot] = secondRoot; }
+	}
+
+	//-------------------------------------------- Number the islands in order of their lowest body, so the numbering never depends on what was found first
+	m_islandOf.resize(m_count);
+	m_islandCount = 0;
+
+	for (unsigned int body = 0; body < m_count; body++) {
+		if (!IsMoving(body)) { continue; }
+
+		unsigned int root = FindRoot(body);
+		m_islandOf[body] = (root == body) ? m_islandCount++ : m_islandOf[root];
+	}
+
+	//-------------------------------------------- Counting sort contacts and links by island - it keeps them in the order they were found within each one
+	m_islandContactStart.assign(m_islandCount + 1, 0);
+	m_islandLinkStart.assign(m_islandCount + 1, 0);
+
+	for (unsigned int i = 0; i < m_contacts.size(); i++) {
+		m_islandContactStart[m_islandOf[IsMoving(m_contacts[i].first) ? m_contacts[i].first : m_contacts[i].second] + 1]++;
+	}
+
+	for (unsigned int i = 0; i < m_links.size(); i++) {
+		if (IsMoving(m_links[i].first) || IsMoving(m_links[i].second)) {
+			m_islandLinkStart[m_islandOf[IsMoving(m_links[i].first) ? m_links[i].first : m_links[i].second] + 1]++;
+		}
+	}
+
+	for (unsigned int island = 0; island < m_islandCount; island++) {
+		m_islandContactStart[island + 1]	+= m_islandContactStart[island];
+		m_islandLinkStart[island + 1]		+= m_islandLinkStart[island];
+	}
+
+	m_islandContacts.resize(m_contacts.size());
+	m_cursors.assign(m_islandContactStart.begin(), m_islandContactStart.end() - 1);
+
+	for (unsigned int i = 0; i < m_contacts.size(); i++) {
+		m_islandContacts[m_cursors[m_islandOf[IsMoving(m_contacts[i].first) ? m_contacts[i].first : m_contacts[i].second]]++] = i;
+	}
+
+	m_islandLinks.resize(m_islandLinkStart[m_islandCount]);
+	m_cursors.assign(m_islandLinkStart.begin(), m_islandLinkStart.end() - 1);
+
+	for (unsigned int i = 0; i < m_links.size(); i++) {
+		if (IsMoving(m_links[i].first) || IsMoving(m_links[i].second)) {
+			m_islandLinks[m_cursors[m_islandOf[IsMoving(m_links[i].first) ? m_links[i].first : m_links[i].second]]++] = i;
+		}
+	}
+
+	//-------------------------------------------- Gather islands in to batches with enough to solve to be worth handing to a thread
+	m_batchStart.clear();
+	m_batchStart.push_back(0);
+
+	unsigned int work = 0;
+
+	for (unsigned int island = 0; island < m_islandCount; island++) {
+		work += (m_islandContactStart[island + 1] - m_islandContactStart[island]) + (m_islandLinkStart[island + 1] - m_islandLinkStart[island]);
+
+		if (work >= PhysicsConstants::IslandBatchSize) {
+			m_batchStart.push_back(island + 1);
+			work = 0;
+		}
+	}
+
+	if (m_batchStart.back() != m_islandCount) { m_batchStart.push_back(m_islandCount); }
+}
+
+
+/*******************************************************************************************************************
+	Function that pushes apart everything touching in an island, and pulls its links back to length
+*******************************************************************************************************************/
+void PhysicsWorld::SolveIsland(unsigned int island)
+{
+	//-------------------------------------------- Pushing one pair apart can push another together, so go round a few times
+	for (unsigned int iteration = 0; iteration < PhysicsConstants::SolverIterations; iteration++) {
+
+		for (unsigned int i = m_islandContactStart[island]; i < m_islandContactStart[island + 1]; i++) {
+			SolveContact(m_contacts[m_islandContacts[i]]);
+		}
+
+		for (unsigned int i = m_islandLinkStart[island]; i < m_islandLinkStart[island + 1]; i++) {
+			SolveLink(m_links[m_islandLinks[i]]);
+		}
+	}
+}
+
+
+/*******************************************************************************************************************
+	Function that separates two things that overlap, and stops them moving any further in to each other
+*******************************************************************************************************************/
+void PhysicsWorld::SolveContact(const BodyContact& contact)
+{
+	float inverseFirst	= IsMoving(contact.first) ? m_inverseMass[contact.first] : 0.0f;
+	float inverseSecond	= IsMoving(contact.second) ? m_inverseMass[contact.second] : 0.0f;
+	float inverseTotal	= inverseFirst + inverseSecond;
+
+	//-------------------------------------------- How much they still overlap, after what's already been pushed this step
+	float depth = contact.depth - (GetSeparation(contact.first, contact.second, contact.normal) - contact.separation);
+
+	//-------------------------------------------- Leave a sliver of overlap, so resting objects stay touching rather than flickering in and out of contact
+	if (depth > PhysicsConstants::ContactSlop) {
+		float push = (depth - PhysicsConstants::ContactSlop) / inverseTotal;
+
+		MoveAlong(contact.first, contact.normal, -push * inverseFirst, 0.0f);
+		MoveAlong(contact.second, contact.normal, push * inverseSecond, 0.0f);
+	}
+
+	//-------------------------------------------- Nothing bounces - only the speed they're closing at is taken away
+	float closing = GetSpeedAlong(contact.second, contact.normal) - GetSpeedAlong(contact.first, contact.normal);
+
+	if (closing < 0.0f) {
+		float impulse = -closing / inverseTotal;
+
+		MoveAlong(contact.first, contact.normal, 0.0f, -impulse * inverseFirst);
+		MoveAlong(contact.second, contact.normal, 0.0f, impulse * inverseSecond);
+	}
+}
+
+
+/*******************************************************************************************************************
+	Function that pulls or pushes two linked bodies back to the link's length, like a rigid rod
+*******************************************************************************************************************/
+void PhysicsWorld::SolveLink(const BodyLink& link)
+{
+	float inverseFirst	= IsMoving(link.first) ? m_inverseMass[link.first] : 0.0f;
+	float inverseSecond	= IsMoving(link.second) ? m_inverseMass[link.second] : 0.0f;
+	float inverseTotal	= inverseFirst + inverseSecond;
+
+	float x = m_positionX[link.second] - m_positionX[link.first];
+	float y = m_positionY[link.second] - m_positionY[link.first];
+	float z = m_positionZ[link.second] - m_positionZ[link.first];
+
+	float distance = sqrtf(x * x + y * y + z * z);
+
+	if (distance <= 0.0f || inverseTotal <= 0.0f) { return; }
+
+	XMFLOAT3 direction(x / distance, y / distance, z / distance);
+
+	float stretch = (distance - link.length) / inverseTotal;
+
+	MoveAlong(link.first, direction, stretch * inverseFirst, 0.0f);
+	MoveAlong(link.second, direction, -stretch * inverseSecond, 0.0f);
+
+	//-------------------------------------------- A rod can't stretch or squash, so any speed along it is shared out between the two
+	float separating	= GetSpeedAlong(link.second, direction) - GetSpeedAlong(link.first, direction);
+	float impulse		= separating / inverseTotal;
+
+	MoveAlong(link.first, direction, 0.0f, impulse * inverseFirst);
+	MoveAlong(link.second, direction, 0.0f, -impulse * inverseSecond);
+}
+
+
+/*******************************************************************************************************************
+	Function that moves a body and changes its velocity along a direction - does nothing to things that don't move
+*******************************************************************************************************************/
+void PhysicsWorld::MoveAlong(PhysicsBody body, const XMFLOAT3& direction, float distance, float speed)
+{
+	if (!IsMoving(body)) { return; }
+
+	m_positionX[body] += direction.x * distance;
+	m_positionY[body] += direction.y * distance;
+	m_positionZ[body] += direction.z * distance;
+
+	m_velocityX[body] += direction.x * speed;
+	m_velocityY[body] += direction.y * speed;
+	m_velocityZ[body] += direction.z * speed;
+}
+
+
+/*******************************************************************************************************************
+	Function that finds how fast a body is moving along a direction - things without a body aren't moving
+*******************************************************************************************************************/
+float PhysicsWorld::GetSpeedAlong(PhysicsBody body, const XMFLOAT3& direction) const
+{
+	if (body == INVALID_BODY) { return 0.0f; }
+
+	return m_velocityX[body] * direction.x + m_velocityY[body] * direction.y + m_velocityZ[body] * direction.z;
+}
+
+
+/*******************************************************************************************************************
+	Function that finds how far apart two things are along a direction, leaving out anything without a body
+*******************************************************************************************************************/
+float PhysicsWorld::GetSeparation(PhysicsBody first, PhysicsBody second, const XMFLOAT3& normal) const
+{
+	float separation = 0.0f;
+
+	if (second != INVALID_BODY)	{ separation += m_positionX[second] * normal.x + m_positionY[second] * normal.y + m_positionZ[second] * normal.z; }
+	if (first != INVALID_BODY)	{ separation -= m_positionX[first] * normal.x + m_positionY[first] * normal.y + m_positionZ[first] * normal.z; }
+
+	return separation;
+}
+
+
+/*******************************************************************************************************************
+	Function that finds the lowest body in a body's island so far, flattening the path to it as it goes
+*******************************************************************************************************************/
+unsigned int PhysicsWorld::FindRoot(unsigned int body)
+{
+	while (m_parents[body] != body) {
+		m_parents[body] = m_parents[m_parents[body]];
+		body = m_parents[body];
+	}
+
+	return body;
+}
+
+
+/*******************************************************************************************************************
+	Function that checks whether a body exists and can be moved by anything
+*******************************************************************************************************************/
+bool PhysicsWorld::IsMoving(PhysicsBody body) const
+{
+	return body != INVALID_BODY && m_inverseMass[body] > 0.0f;
+}
+
+
+/*******************************************************************************************************************
+	Function that places every body's transform between its last two steps, ready to be drawn
+*******************************************************************************************************************/
+void PhysicsWorld::Interpolate()
+{
+	Interpolate(m_interpolation);
+}
+
+
+/*******************************************************************************************************************
+	Function that places every body the given fraction of the way from its last step to its latest one
+*******************************************************************************************************************/
+void PhysicsWorld::Interpolate(float interpolation)
+{
+	TransformManager* transforms = Transforms::Instance();
+
+	for (unsigned int body = 0; body < m_count; body++) {
+		if (m_transforms[body] == INVALID_TRANSFORM) { continue; }
+
+		transforms->SetPosition(m_transforms[body], XMFLOAT3(m_previousX[body] + (m_positionX[body] - m_previousX[body]) * interpolation,
+															 m_previousY[body] + (m_positionY[body] - m_previousY[body]) * interpolation,
+															 m_previousZ[body] + (m_positionZ[body] - m_previousZ[body]) * interpolation));
+	}
+}
+
+
+/*******************************************************************************************************************
+	Function that moves a body straight to a position, without blending from where it was
+*******************************************************************************************************************/
+void PhysicsWorld::Teleport(PhysicsBody body, const XMFLOAT3& position)
+{
+	m_positionX[body] = m_previousX[body] = position.x;
+	m_positionY[body] = m_previousY[body] = position.y;
+	m_positionZ[body] = m_previousZ[body] = position.z;
+}
+
+
+/*******************************************************************************************************************
+	Function that adds a force (in newtons) to be applied over the next steps
+*******************************************************************************************************************/
+void PhysicsWorld::ApplyForce(PhysicsBody body, FXMVECTOR force)
+{
+	m_forceX[body] += XMVectorGetX(force);
+	m_forceY[body] += XMVectorGetY(force);
+	m_forceZ[body] += XMVectorGetZ(force);
+}
+
+
+/*******************************************************************************************************************
+	Function that adds straight to a body's velocity (in units per second)
+*******************************************************************************************************************/
+void PhysicsWorld::AddVelocity(PhysicsBody body, FXMVECTOR velocity)
+{
+	m_velocityX[body] += XMVectorGetX(velocity);
+	m_velocityY[body] += XMVectorGetY(velocity);
+	m_velocityZ[body] += XMVectorGetZ(velocity);
+}
+
+
+/*******************************************************************************************************************
+	Modifier Methods
+*******************************************************************************************************************/
+void PhysicsWorld::SetVelocity(PhysicsBody body, FXMVECTOR velocity)
+{
+	m_velocityX[body] = XMVectorGetX(velocity);
+	m_velocityY[body] = XMVectorGetY(velocity);
+	m_velocityZ[body] = XMVectorGetZ(velocity);
+}
+
+void PhysicsWorld::SetMass(PhysicsBody body, float mass)				{ m_inverseMass[body] = (mass > 0.0f) ? 1.0f / mass : 0.0f; }
+void PhysicsWorld::SetMaxSpeed(PhysicsBody body, float maxSpeed)		{ m_maxSpeed[body] = maxSpeed; }
+void PhysicsWorld::SetMaxForce(PhysicsBody body, float maxForce)		{ m_maxForce[body] = maxForce; }
+void PhysicsWorld::SetFriction(PhysicsBody body, float coefficient)		{ m_friction[body] = coefficient; }
+void PhysicsWorld::SetDrag(PhysicsBody body, float coefficient)			{ m_drag[body] = coefficient; }
+
+
+/*******************************************************************************************************************
+	Accessor Methods
+*******************************************************************************************************************/
+XMFLOAT3 PhysicsWorld::GetPosition(PhysicsBody body) const		{ return XMFLOAT3(m_positionX[body], m_positionY[body], m_positionZ[body]); }
+XMVECTOR PhysicsWorld::GetVelocity(PhysicsBody body) const		{ return XMVectorSet(m_velocityX[body], m_velocityY[body], m_velocityZ[body], 0.0f); }
+XMVECTOR PhysicsWorld::GetAcceleration(PhysicsBody body) const	{ return XMVectorSet(m_accelerationX[body], m_accelerationY[body], m_accelerationZ[body], 0.0f); }
+float PhysicsWorld::GetMass(PhysicsBody body) const				{ return (m_inverseMass[body] > 0.0f) ? 1.0f / m_inverseMass[body] : 0.0f; }
+float PhysicsWorld::GetMaxSpeed(PhysicsBody body) const			{ return m_maxSpeed[body]; }
+float PhysicsWorld::GetMaxForce(PhysicsBody body) const			{ return m_maxForce[body]; }
+float PhysicsWorld::GetInterpolation() const					{ return m_interpolation; }
+unsigned int PhysicsWorld::GetIslandCount() const				{ return m_islandCount; }
+unsigned int PhysicsWorld::GetCount() const						{ return m_count - m_freeBodies.size(); }
@@ -0,0 +1,169 @@
+#pragma once
+
+/*******************************************************************************************************************
+	PhysicsWorld.h, PhysicsWorld.cpp
+	Created by Kim Kane
+	Last updated: 19/10/2026
+
+	Singleton class that owns the physics data of every physics object and moves them all together.
+
+	Velocity, forces, mass, speed and force limits, friction and drag are kept in packed arrays (see
+	TransformManager.h), and a physics object only holds a handle in to them. Each step integrates every body
+	in one pass, 4 at a time with SIMD: forces are clamped to the body's max force, friction and drag are
+	added, velocity is integrated and clamped to the max speed, then position (semi-implicit Euler).
+
+	The world always steps by the same fixed amount of time. Update() adds the frame's time to an accumulator
+	and takes as many steps as fit, so objects move the same however fast the game runs. What's left over is
+	how far the game is between the last step and the next, and Interpolate() uses it to blend each body's
+	last two positions in to the transform manager - so movement is smooth even when a frame has no step.
+	When the game loop already runs on the same fixed step, each Update() is exactly one step, and the loop's
+	own fraction is passed to Interpolate() instead.
+
+	Forces build up between frames and are applied for every step taken, then cleared once a step has run.
+
+	Each step then finds what's touching in the collision world and splits the bodies in to islands - groups
+	that touch or are linked to each other, directly or through other bodies. No island can push on another,
+	so islands are solved side by side on the worker threads, with the work stolen between threads so one big
+	pile doesn't hold everyone else up. Integration runs across the threads in blocks too.
+
+	Results don't depend on how many threads there are or which one solved what. Islands are numbered by their
+	lowest body, their contacts are solved in the order they were found, and each island only ever writes to
+	its own bodies - so there's nothing to merge, and a replay steps exactly the same every time.
+
+*******************************************************************************************************************/
+#include <d3d11.h>
+#include <xnamath.h>
+#include <vector>
+
+#include "Singleton.h"
+#include "ThreadPool.h"
+#include "TransformManager.h"
+
+typedef unsigned int PhysicsBody;
+
+const PhysicsBody INVALID_BODY = 0xFFFFFFFF;
+
+class PhysicsWorld {
+
+public:
+	friend class Singleton<PhysicsWorld>;
+
+public:
+	bool Initialize(unsigned int threadCount);
+	void Shutdown();
+
+public:
+	PhysicsBody Create(TransformHandle transform);
+	void Release(PhysicsBody body);
+	void Link(PhysicsBody first, PhysicsBody second);
+
+public:
+	void Update(float deltaTime);
+	void Step(float timeStep);
+	void Interpolate();
+	void Interpolate(float interpolation);
+
+public:
+	void Teleport(PhysicsBody body, const XMFLOAT3& position);
+	void ApplyForce(PhysicsBody body, FXMVECTOR force);
+	void AddVelocity(PhysicsBody body, FXMVECTOR velocity);
+
+public:
+	void SetVelocity(PhysicsBody body, FXMVECTOR velocity);
+	void SetMass(PhysicsBody body, float mass);
+	void SetMaxSpeed(PhysicsBody body, float maxSpeed);
+	void SetMaxForce(PhysicsBody body, float maxForce);
+	void SetFriction(PhysicsBody body, float coefficient);
+	void SetDrag(PhysicsBody body, float coefficient);
+
+public:
+	XMFLOAT3 GetPosition(PhysicsBody body) const;
+	XMVECTOR GetVelocity(PhysicsBody body) const;
+	XMVECTOR GetAcceleration(PhysicsBody body) const;
+	float GetMass(PhysicsBody body) const;
+	float GetMaxSpeed(PhysicsBody body) const;
+	float GetMaxForce(PhysicsBody body) const;
+	float GetInterpolation() const;
+	unsigned int GetIslandCount() const;
+	unsigned int GetCount() const;
+
+private:
+	//-------------------------------------------- Two things touching - a side with no body (INVALID_BODY) is something that doesn't move
+	struct BodyContact
+	{
+		PhysicsBody	first;
+		PhysicsBody	second;
+		XMFLOAT3	normal;
+		float		depth;
+		float		separation;
+	};
+
+	//-------------------------------------------- Two bodies kept the same distance apart
+	struct BodyLink
+	{
+		PhysicsBody	first;
+		PhysicsBody	second;
+		float		length;
+	};
+
+private:
+	void Integrate(unsigned int first, unsigned int last, float timeStep);
+	void FindContacts();
+	void BuildIslands();
+	void SolveIsland(unsigned int island);
+	void SolveContact(const BodyContact& contact);
+	void SolveLink(const BodyLink& link);
+	void MoveAlong(PhysicsBody body, const XMFLOAT3& direction, float distance, float speed);
+	float GetSpeedAlong(PhysicsBody body, const XMFLOAT3& direction) const;
+	unsigned int FindRoot(unsigned int body);
+	float GetSeparation(PhysicsBody first, PhysicsBody second, const XMFLOAT3& normal) const;
+	bool IsMoving(PhysicsBody body) const;
+
+private:
+	PhysicsWorld();
+	PhysicsWorld(const PhysicsWorld&);
+	PhysicsWorld& operator=(const PhysicsWorld&);
+
+private:
+	//-------------------------------------------- One array per component, always a multiple of 4 long so the SIMD pass never reads off the end
+	std::vector<float>				m_positionX, m_positionY, m_positionZ;
+	std::vector<float>				m_previousX, m_previousY, m_previousZ;
+	std::vector<float>				m_velocityX, m_velocityY, m_velocityZ;
+	std::vector<float>				m_forceX, m_forceY, m_forceZ;
+	std::vector<float>				m_accelerationX, m_accelerationY, m_accelerationZ;
+	std::vector<float>				m_inverseMass;
+	std::vector<float>				m_maxSpeed;
+	std::vector<float>				m_maxForce;
+	std::vector<float>				m_friction;
+	std::vector<float>				m_drag;
+
+	//-------------------------------------------- The transform each body moves, or INVALID_TRANSFORM for a released slot
+	std::vector<TransformHandle>	m_transforms;
+
+	std::vector<PhysicsBody>		m_freeBodies;
+	unsigned int					m_count;
+
+	//-------------------------------------------- The body moving each transform, so contacts between colliders can be turned in to contacts between bodies
+	std::vector<PhysicsBody>		m_bodyOfTransform;
+
+	std::vector<BodyContact>		m_contacts;
+	std::vector<BodyLink>			m_links;
+
+	//-------------------------------------------- Rebuilt every step - each island's contacts and links are stored one island after another
+	std::vector<unsigned int>		m_parents;
+	std::vector<unsigned int>		m_islandOf;
+	std::vector<unsigned int>		m_islandContactStart, m_islandLinkStart;
+	std::vector<unsigned int>		m_islandContacts, m_islandLinks;
+	std::vector<unsigned int>		m_cursors;
+
+	//-------------------------------------------- Runs of islands handed to a thread at once, so thousands of tiny islands aren't handed over one by one
+	std::vector<unsigned int>		m_batchStart;
+	unsigned int					m_islandCount;
+
+	ThreadPool						m_threads;
+
+	float							m_accumulator;
+	float							m_interpolation;
+};
+
+typedef Singleton<PhysicsWorld> Physics;
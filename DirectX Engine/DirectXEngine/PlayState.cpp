@@ -69,9 +69,18 @@ void PlayState::Update(float deltaTime) {
 
 
 /*******************************************************************************************************************
-	Function that renders all play state graphics to the screen
+	Function that fills in a snapshot of everything to draw this frame - runs on the main thread
 *******************************************************************************************************************/
-void PlayState::Draw() {
+void PlayState::Draw(RenderSnapshot& snapshot, float interpolation) {
+
+	snapshot.camera = *m_camera;
+}
+
+
+/*******************************************************************************************************************
+	Function that renders a snapshot of the play state to the screen - runs on the render thread
+*******************************************************************************************************************/
+void PlayState::Render(RenderSnapshot& snapshot) {
 
 	//---------------------------------------------------------------- Clear the screen
 	Graphics::Instance()->BeginScene(0.2f, 0.2f, 0.4f, 1.0f);
@@ -19,7 +19,8 @@ public:
 
 public:
 	virtual void Update(float deltaTime) override;
-	virtual void Draw() override;
+	virtual void Draw(RenderSnapshot& snapshot, float interpolation) override;
+	virtual void Render(RenderSnapshot& snapshot) override;
 	
 private:
 	bool Initialize();
@@ -0,0 +1,378 @@
+#include "Profiler.h"
+
+#if PROFILE_MODE == 1
+
+#include <algorithm>
+#include <climits>
+#include <cstdio>
+#include <cstring>
+
+#include "Log.h"
+
+namespace {
+
+	//-------------------------------------------- Each thread's buffer, found the first time the thread makes a zone
+	thread_local ProfileThread* t_thread = nullptr;
+
+	//-------------------------------------------- Parents before their children when zones start at the same tick
+	bool StartsBefore(const ProfileEvent& first, const ProfileEvent& second)
+	{
+		if (first.start != second.start) { return first.start < second.start; }
+		return first.depth < second.depth;
+	}
+
+	//-------------------------------------------- Zone names are literals, so the same name from two files may not be the same pointer
+	bool SameName(const char* first, const char* second)
+	{
+		return first == second || strcmp(first, second) == 0;
+	}
+
+	//-------------------------------------------- Writes a name as a JSON string
+	void WriteName(FILE* file, const char* name)
+	{
+		fputc('"', file);
+
+		for (const char* letter = name; *letter; letter++) {
+			if (*letter == '"' || *letter == '\\')	{ fputc('\\', file); fputc(*letter, file); }
+			else if ((unsigned char)*letter >= 32)	{ fputc(*letter, file); }
+		}
+
+		fputc('"', file);
+	}
+}
+
+
+/*******************************************************************************************************************
+	Constructor with initializer list to set all default values of variables
+*******************************************************************************************************************/
+ProfileThread::ProfileThread(unsigned int id)	:	id(id),
+													name("Thread"),
+													depth(0),
+													dropped(0),
+													m_head(0),
+													m_tail(0)
+{
+}
+
+
+/*******************************************************************************************************************
+	Function that adds an ended zone to the buffer - only ever called by the thread that owns it
+*******************************************************************************************************************/
+void ProfileThread::Push(const ProfileEvent& event)
+{
+	unsigned int head = m_head.load(std::memory_order_relaxed);
+
+	//-------------------------------------------- Full - the main thread hasn't caught up, so this zone is lost rather than waiting on it
+	if (head - m_tail.load(std::memory_order_acquire) == ProfilerConstants::EventBufferSize) {
+		dropped.fetch_add(1, std::memory_order_relaxed); return;
+	}
+
+	m_events[head & (ProfilerConstants::EventBufferSize - 1)] = event;
+
+	//-------------------------------------------- Released after the zone is written, so the main thread never reads half a zone
+	m_head.store(head + 1, std::memory_order_release);
+}
+
+
+/*******************************************************************************************************************
+	Function that moves every zone in the buffer on to the end of a list - only ever called by the main thread
+*******************************************************************************************************************/
+void ProfileThread::Pop(std::vector<ProfileEvent>& events)
+{
+	unsigned int tail = m_tail.load(std::memory_order_relaxed);
+	unsigned int head = m_head.load(std::memory_order_acquire);
+
+	for (; tail != head; tail++) {
+		events.push_back(m_events[tail & (ProfilerConstants::EventBufferSize - 1)]);
+	}
+
+	//-------------------------------------------- Released after the zones are copied, so the owning thread can't write over them first
+	m_tail.store(tail, std::memory_order_release);
+}
+
+
+/*******************************************************************************************************************
+	Function that gets the calling thread's buffer, making one the first time
+*******************************************************************************************************************/
+ProfileThread* Profiler::GetThread()
+{
+	if (!t_thread) { t_thread = RegisterThread(); }
+	return t_thread;
+}
+
+
+/*******************************************************************************************************************
+	Function that names the calling thread in the summary and in captures
+*******************************************************************************************************************/
+void Profiler::SetThreadName(const char* name)
+{
+	GetThread()->name.store(name);
+}
+
+
+/*******************************************************************************************************************
+	Function that makes a buffer for a new thread - buffers are kept until the program ends, as threads never say when they've gone
+*******************************************************************************************************************/
+ProfileThread* Profiler::RegisterThread()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	m_threads.push_back(std::unique_ptr<ProfileThread>(new ProfileThread((unsigned int)m_threads.size())));
+
+	return m_threads.back().get();
+}
+
+
+/*******************************************************************************************************************
+	Function that copies the list of threads - new threads can be added at any time, so it's only locked long enough to copy it
+*******************************************************************************************************************/
+void Profiler::CopyThreads()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	m_frameThreads.clear();
+
+	for (unsigned int i = 0; i < m_threads.size(); i++) {
+		m_frameThreads.push_back(m_threads[i].get());
+	}
+}
+
+
+/*******************************************************************************************************************
+	Function that collects every thread's zones for the frame - called once a frame, on the main thread
+*******************************************************************************************************************/
+void Profiler::EndFrame()
+{
+	long long frequency = SystemClock::GetTicksPerSecond();
+
+	CopyThreads();
+
+	if (m_pending.size() < m_frameThreads.size()) { m_pending.resize(m_frameThreads.size()); }
+
+	for (unsigned int i = 0; i < m_frameThreads.size(); i++) {
+		ProfileThread& thread = *m_frameThreads[i];
+
+		m_events.clear();
+		thread.Pop(m_events);
+
+		unsigned int dropped = thread.dropped.exchange(0);
+		if (dropped > 0) { DX_LOG("[PROFILER] Zone buffer full, zones dropped: ", dropped, LOG_WARN); }
+
+		//-------------------------------------------- Captures keep every zone as it comes, as they don't need to wait for the tree
+		if (m_captureFrames > 0) {
+			for (unsigned int j = 0; j < m_events.size() && m_capture.size() < ProfilerConstants::MaxCaptureEvents; j++) {
+				if (m_events[j].end < m_captureStart) { continue; }
+
+				CapturedEvent captured = { m_events[j], thread.id };
+				m_capture.push_back(captured);
+			}
+		}
+
+		m_pending[i].insert(m_pending[i].end(), m_events.begin(), m_events.end());
+		AddToTree(thread, m_pending[i]);
+	}
+
+	//-------------------------------------------- Average the tree over the last few frames, so the numbers can be read on screen
+	if (++m_frames >= ProfilerConstants::SummaryFrames) {
+		m_summary.clear();
+
+		for (unsigned int i = 0; i < m_roots.size(); i++) {
+			if (m_roots[i] != UINT_MAX) { m_tree[m_roots[i]].name = m_frameThreads[i]->name.load(); BuildSummary(m_roots[i], frequency); }
+		}
+
+		m_frames = 0;
+	}
+
+	if (m_captureFrames > 0 && --m_captureFrames == 0) { WriteCapture(); }
+}
+
+
+/*******************************************************************************************************************
+	Function that adds a thread's ended zones to its tree, leaving any whose outermost zone hasn't ended yet
+*******************************************************************************************************************/
+void Profiler::AddToTree(ProfileThread& thread, std::vector<ProfileEvent>& pending)
+{
+	//-------------------------------------------- A zone inside an outermost zone that has ended can't still be waiting on a parent - everything else has to wait
+	long long ended = 0;
+	bool hasEnded = false;
+
+	for (unsigned int i = 0; i < pending.size(); i++) {
+		if (pending[i].depth == 0 && (!hasEnded || pending[i].end > ended)) { ended = pending[i].end; hasEnded = true; }
+	}
+
+	if (!hasEnded) {
+		//-------------------------------------------- Never let a thread whose outer zone never ends fill up memory
+		if (pending.size() > ProfilerConstants::EventBufferSize) {
+			DX_LOG("[PROFILER] A thread's outermost zone never ends, zones dropped: ", pending.size(), LOG_WARN);
+			pending.clear();
+		}
+		return;
+	}
+
+	std::vector<ProfileEvent>::iterator waiting = std::partition(pending.begin(), pending.end(), [ended](const ProfileEvent& event) { return event.start < ended; });
+	std::sort(pending.begin(), waiting, StartsBefore);
+
+	if (m_roots.size() <= thread.id) { m_roots.resize(thread.id + 1, UINT_MAX); }
+
+	if (m_roots[thread.id] == UINT_MAX) {
+		TreeNode root = { thread.name.load(), 0, 0, 0 };
+		m_roots[thread.id] = (unsigned int)m_tree.size();
+		m_tree.push_back(root);
+	}
+
+	//-------------------------------------------- In start order, the zone each zone is inside is always the last one seen one level up
+	for (std::vector<ProfileEvent>::iterator event = pending.begin(); event != waiting; ++event) {
+
+		//-------------------------------------------- Cut back to this zone's parent - or as close as there is, if a parent was dropped
+		m_path.resize((std::min)((unsigned int)m_path.size(), event->depth + 1));
+		if (m_path.empty()) { m_path.push_back(m_roots[thread.id]); }
+
+		unsigned int node = FindChild(m_path.back(), event->name);
+		m_tree[node].ticks += event->end - event->start;
+		m_tree[node].calls++;
+
+		if (event->depth == 0) { m_tree[m_roots[thread.id]].ticks += event->end - event->start; }
+
+		m_path.push_back(node);
+	}
+
+	m_path.clear();
+	pending.erase(pending.begin(), waiting);
+}
+
+
+/*******************************************************************************************************************
+	Function that finds the child of a node with a name, adding one if there isn't one yet
+*******************************************************************************************************************/
+unsigned int Profiler::FindChild(unsigned int parent, const char* name)
+{
+	for (unsigned int i = 0; i < m_tree[parent].children.size(); i++) {
+		unsigned int child = m_tree[parent].children[i];
+		if (SameName(m_tree[child].name, name)) { return child; }
+	}
+
+	TreeNode node = { name, m_tree[parent].depth + 1, 0, 0 };
+	unsigned int index = (unsigned int)m_tree.size();
+
+	m_tree.push_back(node);
+	m_tree[parent].children.push_back(index);
+
+	return index;
+}
+
+
+/*******************************************************************************************************************
+	Function that adds a node and everything under it to the summary, per frame, then starts its times again
+*******************************************************************************************************************/
+void Profiler::BuildSummary(unsigned int node, long long frequency)
+{
+	TreeNode& tree = m_tree[node];
+
+	ProfileNode line;
+	line.name	= tree.name;
+	line.depth	= tree.depth;
+	line.time	= (float)((double)tree.ticks * 1000.0 / (double)frequency / (double)m_frames);
+	line.calls	= (float)tree.calls / (float)m_frames;
+	m_summary.push_back(line);
+
+	tree.ticks = 0;
+	tree.calls = 0;
+
+	for (unsigned int i = 0; i < m_tree[node].children.size(); i++) {
+		BuildSummary(m_tree[node].children[i], frequency);
+	}
+}
+
+
+/*******************************************************************************************************************
+	Function that starts recording every zone for a number of frames, then writes them to a file - false if already recording
+*******************************************************************************************************************/
+bool Profiler::Capture(unsigned int frames, const std::string& fileLocation)
+{
+	if (m_captureFrames > 0 || frames == 0) { return false; }
+
+	m_capture.clear();
+	m_captureFile	= fileLocation;
+	m_captureFrames	= frames;
+	m_captureStart = SystemClock::GetTicks();
+
+	DX_LOG("[PROFILER] Capturing frames: ", frames, LOG_MESSAGE);
+
+	return true;
+}
+
+
+/*******************************************************************************************************************
+	Function that writes out a capture in the Chrome trace format - times are in microseconds from the start of the capture
+*******************************************************************************************************************/
+bool Profiler::WriteCapture()
+{
+	long long frequency = SystemClock::GetTicksPerSecond();
+
+	FILE* file = fopen(m_captureFile.c_str(), "w");
+	if (!file) { DX_LOG("[PROFILER] Couldn't write capture: ", m_captureFile.c_str(), LOG_ERROR); m_capture.clear(); return false; }
+
+	fputs("{\"traceEvents\":[\n", file);
+
+	//-------------------------------------------- Name every thread first, so the viewer can label its row
+	for (unsigned int i = 0; i < m_frameThreads.size(); i++) {
+		fprintf(file, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%u,\"args\":{\"name\":", i);
+		WriteName(file, m_frameThreads[i]->name.load());
+		fputs("}},\n", file);
+	}
+
+	//-------------------------------------------- Each zone is a complete event - a start and a length
+	const double toMicroseconds = 1000000.0 / (double)frequency;
+
+	for (unsigned int i = 0; i < m_capture.size(); i++) {
+		const ProfileEvent& event = m_capture[i].event;
+
+		fputs("{\"name\":", file);
+		WriteName(file, event.name);
+		fprintf(file, ",\"ph\":\"X\",\"pid\":0,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f},\n", m_capture[i].thread,
+				(double)(event.start - m_captureStart) * toMicroseconds, (double)(event.end - event.start) * toMicroseconds);
+	}
+
+	//-------------------------------------------- JSON doesn't allow a comma after the last event, so finish with one that draws nothing
+	fputs("{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":0,\"args\":{\"name\":\"DirectXEngine\"}}\n]}\n", file);
+
+	bool isWritten = (ferror(file) == 0);
+	fclose(file);
+
+	DX_LOG("[PROFILER] Capture written to: ", m_captureFile.c_str(), LOG_SUCCESS);
+
+	m_capture.clear();
+	m_capture.shrink_to_fit();
+
+	return isWritten;
+}
+
+
+/*******************************************************************************************************************
+	Accessor Methods
+*******************************************************************************************************************/
+const std::vector<ProfileNode>& Profiler::GetSummary()	{ return m_summary; }
+bool Profiler::IsCapturing()							{ return m_captureFrames > 0; }
+
+
+/*******************************************************************************************************************
+	Static variables initialization
+*******************************************************************************************************************/
+std::mutex Profiler::m_mutex;
+std::vector<std::unique_ptr<ProfileThread>> Profiler::m_threads;
+
+std::vector<ProfileThread*> Profiler::m_frameThreads;
+std::vector<ProfileEvent> Profiler::m_events;
+std::vector<std::vector<ProfileEvent>> Profiler::m_pending;
+std::vector<Profiler::TreeNode> Profiler::m_tree;
+std::vector<unsigned int> Profiler::m_roots;
+std::vector<unsigned int> Profiler::m_path;
+std::vector<ProfileNode> Profiler::m_summary;
+unsigned int Profiler::m_frames						= 0;
+
+std::vector<Profiler::CapturedEvent> Profiler::m_capture;
+std::string Profiler::m_captureFile;
+unsigned int Profiler::m_captureFrames				= 0;
+long long Profiler::m_captureStart					= 0;
+
+#endif
@@ -0,0 +1,205 @@
+#pragma once
+
+/*******************************************************************************************************************
+	Profiler.h, Profiler.cpp
+	Created by Kim Kane
+	Last updated: 19/10/2026
+
+	Static class that times named zones of code on any thread, where Tracker only times the whole frame.
+
+	A zone is timed from where DX_PROFILE_SCOPE("Name") is placed to the end of that scope, and zones inside
+	other zones become their children. The name must be a string literal (or live as long as the program), as
+	only the pointer is kept. DX_PROFILE_FUNCTION() names a zone after the function it's in.
+
+	Each thread records its zones in its own buffer, which only that thread writes to and only the main thread
+	reads from, so recording never takes a lock. DX_PROFILE_FRAME() is called once a frame on the main thread -
+	it empties every buffer and adds the zones to a tree per thread. The tree is averaged over a number of
+	frames (like the FPS) and GetSummary() gives it back, one line per zone, for drawing on the screen.
+
+	DX_PROFILE_CAPTURE(frames, file) records every zone for that many frames, then writes them out as a
+	Chrome trace, which can be opened in chrome://tracing or ui.perfetto.dev.
+
+	Profiling is on in debug builds. Define PROFILE_MODE=1 in the project to profile a release build, or 0 to
+	leave it out of a debug one. When it's off every DX_PROFILE macro is empty, so none of this is compiled in.
+
+	A zone only reaches the tree once the outermost zone around it on its thread has ended, so a thread's main
+	loop shouldn't be wrapped in a zone of its own - zone what happens each time round instead.
+
+*******************************************************************************************************************/
+#if !defined(PROFILE_MODE) && DEBUG_MODE == 1
+	#define PROFILE_MODE 1
+#endif
+
+#if PROFILE_MODE == 1
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "Clock.h"
+#include "Constants.h"
+
+#define DX_PROFILE_JOIN_NAME(name, line)	name##line
+#define DX_PROFILE_JOIN(name, line)			DX_PROFILE_JOIN_NAME(name, line)
+
+#define DX_PROFILE_SCOPE(name)				ProfileZone DX_PROFILE_JOIN(profileZone, __LINE__)(name)
+#define DX_PROFILE_FUNCTION()				DX_PROFILE_SCOPE(__FUNCTION__)
+#define DX_PROFILE_THREAD(name)				Profiler::SetThreadName(name)
+#define DX_PROFILE_FRAME()					Profiler::EndFrame()
+#define DX_PROFILE_CAPTURE(frames, file)	Profiler::Capture(frames, file)
+
+//-------------------------------------------- One zone that has ended - times are in SystemClock ticks
+struct ProfileEvent
+{
+	const char*		name;
+	long long		start;
+	long long		end;
+	unsigned int	depth;
+};
+
+//-------------------------------------------- One line of the summary - a thread (depth 0) or a zone, with its time and calls per frame
+struct ProfileNode
+{
+	const char*		name;
+	unsigned int	depth;
+	float			time;
+	float			calls;
+};
+
+//-------------------------------------------- A thread's zone buffer - a ring that its own thread pushes on to and the main thread pops off
+class ProfileThread {
+
+public:
+	explicit ProfileThread(unsigned int id);
+
+public:
+	void Push(const ProfileEvent& event);
+	void Pop(std::vector<ProfileEvent>& events);
+
+public:
+	unsigned int				id;
+	std::atomic<const char*>	name;
+
+	//-------------------------------------------- How many zones this thread is inside right now - only its own thread uses this
+	unsigned int				depth;
+
+	//-------------------------------------------- Zones lost because the buffer was full, since the main thread last looked
+	std::atomic<unsigned int>	dropped;
+
+private:
+	ProfileThread(const ProfileThread&);
+	ProfileThread& operator=(const ProfileThread&);
+
+private:
+	ProfileEvent				m_events[ProfilerConstants::EventBufferSize];
+	std::atomic<unsigned int>	m_head;
+	std::atomic<unsigned int>	m_tail;
+};
+
+class Profiler {
+
+public:
+	static ProfileThread* GetThread();
+	static void SetThreadName(const char* name);
+
+public:
+	static void EndFrame();
+	static bool Capture(unsigned int frames, const std::string& fileLocation);
+
+public:
+	static const std::vector<ProfileNode>& GetSummary();
+	static bool IsCapturing();
+
+private:
+	Profiler();
+
+private:
+	//-------------------------------------------- A zone in a thread's tree, with its times added up since the summary was last made
+	struct TreeNode
+	{
+		const char*					name;
+		unsigned int				depth;
+		long long					ticks;
+		unsigned int				calls;
+		std::vector<unsigned int>	children;
+	};
+
+	struct CapturedEvent
+	{
+		ProfileEvent	event;
+		unsigned int	thread;
+	};
+
+private:
+	static ProfileThread* RegisterThread();
+	static void CopyThreads();
+	static void AddToTree(ProfileThread& thread, std::vector<ProfileEvent>& pending);
+	static unsigned int FindChild(unsigned int parent, const char* name);
+	static void BuildSummary(unsigned int node, long long frequency);
+	static bool WriteCapture();
+
+private:
+	static std::mutex								m_mutex;
+	static std::vector<std::unique_ptr<ProfileThread>>	m_threads;
+
+	//-------------------------------------------- Everything below is only used by the main thread
+	static std::vector<ProfileThread*>				m_frameThreads;
+	static std::vector<ProfileEvent>				m_events;
+	static std::vector<std::vector<ProfileEvent>>	m_pending;
+	static std::vector<TreeNode>					m_tree;
+	static std::vector<unsigned int>				m_roots;
+	static std::vector<unsigned int>				m_path;
+	static std::vector<ProfileNode>					m_summary;
+	static unsigned int								m_frames;
+
+	static std::vector<CapturedEvent>				m_capture;
+	static std::string								m_captureFile;
+	static unsigned int								m_captureFrames;
+	static long long								m_captureStart;
+};
+
+//-------------------------------------------- Times from where it's made to the end of its scope - made by DX_PROFILE_SCOPE
+class ProfileZone {
+
+public:
+	explicit ProfileZone(const char* name) : m_name(name), m_thread(Profiler::GetThread())
+	{
+		m_depth = m_thread->depth++;
+		m_start = SystemClock::GetTicks();
+	}
+
+	~ProfileZone()
+	{
+		ProfileEvent event;
+		event.end = SystemClock::GetTicks();
+
+		event.name	= m_name;
+		event.start	= m_start;
+		event.depth	= m_depth;
+
+		m_thread->depth--;
+		m_thread->Push(event);
+	}
+
+private:
+	ProfileZone(const ProfileZone&);
+	ProfileZone& operator=(const ProfileZone&);
+
+private:
+	const char*		m_name;
+	ProfileThread*	m_thread;
+	unsigned int	m_depth;
+	long long		m_start;
+};
+
+#else
+
+#define DX_PROFILE_SCOPE(name)
+#define DX_PROFILE_FUNCTION()
+#define DX_PROFILE_THREAD(name)
+#define DX_PROFILE_FRAME()
+#define DX_PROFILE_CAPTURE(frames, file)
+
+#endif
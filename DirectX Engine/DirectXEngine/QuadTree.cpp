@@ -1,6 +1,8 @@
 #include "QuadTree.h"
 #include "Camera.h"
 #include "Log.h"
+#include "Profiler.h"
+#include "EventLog.h"
 
 #include <iostream>
 
@@ -275,12 +277,14 @@ bool QuadTree::Initialize(Terrain * terrain)
 	return true;
 }
 
-void QuadTree::Render(Frustum * frustum, TerrainShader * shader, Camera* camera)
+void QuadTree::Submit(RenderQueue& queue, Frustum * frustum)
 {
+	DX_PROFILE_FUNCTION();
+
 	//reset the num triangles drawn
 	_DrawCount = 0;
-	//draw all quads.
-	RenderQuad(_ParentQuad, frustum, _Terrain->GetShader(), camera);
+	//queue all visible quads.
+	SubmitQuad(_ParentQuad, frustum, queue);
 }
 
 void QuadTree::CalculateMeshDimensions(int vertexCount, float& centerX, float& centerZ, float& meshWidth)
@@ -506,11 +510,10 @@ void QuadTree::ReleaseQuad(QuadType * parent)
 	}
 }
 
-void QuadTree::RenderQuad(QuadType * quad, Frustum * frustum, TerrainShader * shader, Camera* camera)
+void QuadTree::SubmitQuad(QuadType * quad, Frustum * frustum, RenderQueue& queue)
 {
 	bool result;
-	int count, i, indexCount;
-	unsigned int stride, offset;
+	int count, i;
 
 	// Check to see if the node can be viewed, height doesn't matter in a quad tree.
 	result = frustum->CheckCube(quad->_Position.x, 0.0f, quad->_Position.y, (quad->_Width / 2.0f));
@@ -527,7 +530,7 @@ void QuadTree::RenderQuad(QuadType * quad, Frustum * frustum, TerrainShader * sh
 		if (quad->_ChildQuads[i] != 0)
 		{
 			count++;
-			RenderQuad(quad->_ChildQuads[i], frustum, shader, camera);
+			SubmitQuad(quad->_ChildQuads[i], frustum, queue);
 		}
 	}
 
@@ -536,13 +539,11 @@ void QuadTree::RenderQuad(QuadType * quad, Frustum * frustum, TerrainShader * sh
 	{
 		return;
 	}
-	// Otherwise if this node can be seen and has triangles in it then render these triangles.
-
-	stride = sizeof(BufferConstants::PackedTerrainVertex);
-
+	// Otherwise if this node can be seen and has triangles in it then queue these triangles, sorted front-to-back by the quad's centre.
+	queue.Submit(LAYER_OPAQUE, _Terrain->GetShader(), _Terrain->GetPackage(), quad, XMMatrixIdentity(),
+				 XMFLOAT3(quad->_Position.x, 0.0f, quad->_Position.y));
 
-	shader->Bind(XMMatrixIdentity(), camera, _Terrain->GetPackage());
-	quad->_Buffer.Render(stride, 0);
+	DX_EVENT("[QUADTREE] Leaf at (%.1f, %.1f), width %.1f - %u triangles", quad->_Position.x, quad->_Position.y, quad->_Width, quad->_Buffer.GetIndexCount() / 3);
 
 	// Increase the count of the number of polygons that have been rendered during this frame.
 	_DrawCount += quad->_Buffer.GetIndexCount() / 3;
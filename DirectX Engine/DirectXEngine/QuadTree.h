@@ -5,6 +5,7 @@
 #include "Buffer.h"
 #include "Frustum.h"
 #include "Constants.h"
+#include "RenderQueue.h"
 
 #include <vector>
 
@@ -13,7 +14,9 @@ class Camera;
 class QuadTree
 {
 private:
-	struct QuadType{
+	struct QuadType : public Renderable {
+		virtual void Render(RenderContext& context, const void*) const override { _Buffer.Render(context, sizeof(BufferConstants::PackedTerrainVertex), 0); }
+
 		XMFLOAT2 _Position;
 		float	_Width;
 		Buffer	_Buffer;
@@ -31,7 +34,7 @@ public:
 	bool CheckHeightOfTriangle(float, float, float&, float[3], float[3], float[3]);
 
 	bool Initialize(Terrain* terrain);
-	void Render(Frustum* frustum, TerrainShader* shader, Camera* camera);
+	void Submit(RenderQueue& queue, Frustum* frustum);
 	int GetDrawCount() { return _DrawCount; }
 
 private:
@@ -41,7 +44,7 @@ private:
 	bool IsTriangleContained(int, float, float, float);
 
 	void ReleaseQuad(QuadType*);
-	void RenderQuad(QuadType*, Frustum*, TerrainShader* shader, Camera* camera);
+	void SubmitQuad(QuadType*, Frustum*, RenderQueue& queue);
 
 private:
 	std::vector<BufferConstants::PackedTerrainVertex> _VertexList;
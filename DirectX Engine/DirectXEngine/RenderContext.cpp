@@ -0,0 +1,399 @@
+#include <cstring>
+
+#include "RenderContext.h"
+#include "GraphicsManager.h"
+#include "Buffer.h"
+#include "Log.h"
+
+using namespace RenderContextConstants;
+
+/*******************************************************************************************************************
+	Constructor with initializer list to set all default values of variables
+*******************************************************************************************************************/
+RenderContext::RenderContext()	:	m_deviceContext(nullptr),
+									m_deviceContext1(nullptr),
+									m_commandList(nullptr),
+									m_isDeferred(false)
+{
+	memset(m_constantBuffers, 0, sizeof(m_constantBuffers));
+	memset(m_constantSizes, 0, sizeof(m_constantSizes));
+
+	Reset();
+}
+
+
+/*******************************************************************************************************************
+	Shut down all necessary procedures, release resources and clean up memory
+*******************************************************************************************************************/
+RenderContext::~RenderContext()
+{
+	Release();
+}
+
+
+/*******************************************************************************************************************
+	Function that wraps the immediate context - the context is shared with the graphics manager, so hold a reference
+*******************************************************************************************************************/
+bool RenderContext::Create(ID3D11DeviceContext* immediateContext)
+{
+	if (!immediateContext) {
+		DX_LOG("[RENDER CONTEXT] No immediate context to wrap", DX_LOG_EMPTY, LOG_ERROR); return false;
+	}
+
+	Release();
+
+	m_deviceContext = immediateContext;
+	m_deviceContext->AddRef();
+	m_isDeferred	= false;
+
+	Reset();
+
+	return CreateConstantRing();
+}
+
+
+/*******************************************************************************************************************
+	Function that creates a deferred context, which a worker thread can record a command list in to
+*******************************************************************************************************************/
+bool RenderContext::CreateDeferred()
+{
+	Release();
+
+	HRESULT result = Graphics::Instance()->GetDevice()->CreateDeferredContext(0, &m_deviceContext);
+	if (FAILED(result)) {
+		DX_LOG("[RENDER CONTEXT] Couldn't create deferred context", DX_LOG_EMPTY, LOG_ERROR); return false;
+	}
+
+	m_isDeferred = true;
+
+	Reset();
+
+	return CreateConstantRing();
+}
+
+
+/*******************************************************************************************************************
+	Function that creates this context's constant ring, checking what the driver lets us do with it
+*******************************************************************************************************************/
+bool RenderContext::CreateConstantRing()
+{
+	//-------------------------------------------- The 11.1 options can only be queried on an 11.1 runtime - if the query fails, assume none of them
+	D3D11_FEATURE_DATA_D3D11_OPTIONS options;
+	ZeroMemory(&options, sizeof(options));
+
+	bool hasOptions = SUCCEEDED(Graphics::Instance()->GetDevice()->CheckFeatureSupport(D3D11_FEATURE_D3D11_OPTIONS, &options, sizeof(options)));
+
+	//-------------------------------------------- Binding constants at an offset needs the 11.1 context, and the driver has to support both offsets and no-overwrite maps
+	if (hasOptions && options.ConstantBufferOffsetting && options.MapNoOverwriteOnDynamicConstantBuffer) {
+
+		if (SUCCEEDED(m_deviceContext->QueryInterface(__uuidof(ID3D11DeviceContext1), (void**)&m_deviceContext1))) {
+			if (!m_constantRing.Create(CONSTANT_RING_SIZE, D3D11_BIND_CONSTANT_BUFFER, true)) { return false; }
+		}
+	}
+
+	if (!m_deviceContext1) {
+		DX_LOG("[RENDER CONTEXT] Constant buffer offsets not supported, using a buffer per slot", DX_LOG_EMPTY, LOG_WARN);
+	}
+
+	return true;
+}
+
+
+/*******************************************************************************************************************
+	Function that releases the context, any unexecuted command list and this context's constant buffers
+*******************************************************************************************************************/
+void RenderContext::Release()
+{
+	for (int stage = 0; stage < STAGE_TOTAL; stage++) {
+		for (int slot = 0; slot < MAX_CONSTANT_SLOTS; slot++) {
+			if (m_constantBuffers[stage][slot]) { m_constantBuffers[stage][slot]->Release(); m_constantBuffers[stage][slot] = nullptr; }
+			m_constantSizes[stage][slot] = 0;
+		}
+	}
+
+	m_constantRing.Release();
+
+	if (m_commandList)		{ m_commandList->Release(); m_commandList = nullptr; }
+	if (m_deviceContext1)	{ m_deviceContext1->Release(); m_deviceContext1 = nullptr; }
+	if (m_deviceContext)	{ m_deviceContext->Release(); m_deviceContext = nullptr; }
+}
+
+
+/*******************************************************************************************************************
+	Function that forgets everything bound - call whenever the context's state has been cleared behind its back
+*******************************************************************************************************************/
+void RenderContext::Reset()
+{
+	m_layout			= nullptr;
+	m_topology			= D3D11_PRIMITIVE_TOPOLOGY_UNDEFINED;
+	m_vertexShader		= nullptr;
+	m_pixelShader		= nullptr;
+	m_vertexBuffer		= nullptr;
+	m_vertexStride		= 0;
+	m_vertexOffset		= 0;
+	m_indexBuffer		= nullptr;
+	m_depthStencilState	= nullptr;
+	m_blendState		= nullptr;
+
+	memset(m_samplers, 0, sizeof(m_samplers));
+	memset(m_resources, 0, sizeof(m_resources));
+	memset(m_vertexResources, 0, sizeof(m_vertexResources));
+	memset(m_constantsBound, 0, sizeof(m_constantsBound));
+
+	//-------------------------------------------- A cleared context is about to start a new recording, and each recording must discard before it can no-overwrite
+	m_constantRing.Discard();
+}
+
+
+/*******************************************************************************************************************
+	Functions that bind state, only calling DirectX when the state actually changes
+*******************************************************************************************************************/
+void RenderContext::SetInputLayout(ID3D11InputLayout* layout)
+{
+	if (m_layout == layout) { return; }
+
+	m_deviceContext->IASetInputLayout(layout);
+	m_layout = layout;
+}
+
+
+void RenderContext::SetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY topology)
+{
+	if (m_topology == topology) { return; }
+
+	m_deviceContext->IASetPrimitiveTopology(topology);
+	m_topology = topology;
+}
+
+
+void RenderContext::SetVertexShader(ID3D11VertexShader* vertexShader)
+{
+	if (m_vertexShader == vertexShader) { return; }
+
+	m_deviceContext->VSSetShader(vertexShader, nullptr, 0);
+	m_vertexShader = vertexShader;
+}
+
+
+void RenderContext::SetPixelShader(ID3D11PixelShader* pixelShader)
+{
+	if (m_pixelShader == pixelShader) { return; }
+
+	m_deviceContext->PSSetShader(pixelShader, nullptr, 0);
+	m_pixelShader = pixelShader;
+}
+
+
+void RenderContext::SetSampler(unsigned int slot, ID3D11SamplerState* sampler)
+{
+	if (slot >= MAX_SAMPLER_SLOTS || m_samplers[slot] == sampler) { return; }
+
+	m_deviceContext->PSSetSamplers(slot, 1, &sampler);
+	m_samplers[slot] = sampler;
+}
+
+
+void RenderContext::SetShaderResource(unsigned int slot, ID3D11ShaderResourceView* resource)
+{
+	if (slot >= MAX_RESOURCE_SLOTS || m_resources[slot] == resource) { return; }
+
+	m_deviceContext->PSSetShaderResources(slot, 1, &resource);
+	m_resources[slot] = resource;
+}
+
+
+void RenderContext::SetVertexShaderResource(unsigned int slot, ID3D11ShaderResourceView* resource)
+{
+	if (slot >= MAX_RESOURCE_SLOTS || m_vertexResources[slot] == resource) { return; }
+
+	m_deviceContext->VSSetShaderResources(slot, 1, &resource);
+	m_vertexResources[slot] = resource;
+}
+
+
+void RenderContext::SetVertexBuffer(ID3D11Buffer* vertexBuffer, unsigned int stride, unsigned int offset)
+{
+	if (m_vertexBuffer == vertexBuffer && m_vertexStride == stride && m_vertexOffset == offset) { return; }
+
+	m_deviceContext->IASetVertexBuffers(0, 1, &vertexBuffer, &stride, &offset);
+	m_vertexBuffer	= vertexBuffer;
+	m_vertexStride	= stride;
+	m_vertexOffset	= offset;
+}
+
+
+void RenderContext::SetIndexBuffer(ID3D11Buffer* indexBuffer, DXGI_FORMAT format)
+{
+	if (m_indexBuffer == indexBuffer) { return; }
+
+	m_deviceContext->IASetIndexBuffer(indexBuffer, format, 0);
+	m_indexBuffer = indexBuffer;
+}
+
+
+void RenderContext::SetDepthStencilState(ID3D11DepthStencilState* depthStencilState)
+{
+	if (m_depthStencilState == depthStencilState) { return; }
+
+	m_deviceContext->OMSetDepthStencilState(depthStencilState, 1);
+	m_depthStencilState = depthStencilState;
+}
+
+
+void RenderContext::SetBlendState(ID3D11BlendState* blendState)
+{
+	if (m_blendState == blendState) { return; }
+
+	float blendFactor[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+
+	m_deviceContext->OMSetBlendState(blendState, blendFactor, 0xffffffff);
+	m_blendState = blendState;
+}
+
+
+/*******************************************************************************************************************
+	Functions that copy constant data in to this context's own constant buffer for a shader stage and slot
+*******************************************************************************************************************/
+bool RenderContext::UploadVertexConstants(unsigned int slot, const void* data, unsigned int size)
+{
+	return UploadConstants(STAGE_VERTEX, slot, data, size);
+}
+
+
+bool RenderContext::UploadPixelConstants(unsigned int slot, const void* data, unsigned int size)
+{
+	return UploadConstants(STAGE_PIXEL, slot, data, size);
+}
+
+
+bool RenderContext::UploadConstants(ShaderStage stage, unsigned int slot, const void* data, unsigned int size)
+{
+	if (slot >= MAX_CONSTANT_SLOTS) {
+		DX_LOG("[RENDER CONTEXT] Constant buffer slot out of range: ", slot, LOG_ERROR); return false;
+	}
+
+	if (m_deviceContext1) { return UploadRingConstants(stage, slot, data, size); }
+
+	ID3D11Buffer*& constantBuffer = m_constantBuffers[stage][slot];
+
+	//-------------------------------------------- Constant buffers must be a multiple of 16 bytes - grow the buffer if this upload doesn't fit
+	if (m_constantSizes[stage][slot] < size) {
+
+		unsigned int bufferSize = (size + 15) & ~15u;
+
+		if (constantBuffer) { constantBuffer->Release(); constantBuffer = nullptr; }
+		if (!Buffer::CreateConstantBuffer(&constantBuffer, bufferSize)) { m_constantSizes[stage][slot] = 0; return false; }
+
+		m_constantSizes[stage][slot]	= bufferSize;
+		m_constantsBound[stage][slot]	= false;
+	}
+
+	//-------------------------------------------- Deferred contexts must discard the first time they map a dynamic buffer, so always discard
+	D3D11_MAPPED_SUBRESOURCE mappedResource = { 0 };
+	if (FAILED(m_deviceContext->Map(constantBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedResource))) {
+		DX_LOG("[RENDER CONTEXT] Problem writing to the constant buffer", DX_LOG_EMPTY, LOG_ERROR); return false;
+	}
+
+	memcpy(mappedResource.pData, data, size);
+	m_deviceContext->Unmap(constantBuffer, 0);
+
+	if (!m_constantsBound[stage][slot]) {
+		(stage == STAGE_VERTEX)	? m_deviceContext->VSSetConstantBuffers(slot, 1, &constantBuffer)
+								: m_deviceContext->PSSetConstantBuffers(slot, 1, &constantBuffer);
+		m_constantsBound[stage][slot] = true;
+	}
+
+	return true;
+}
+
+
+/*******************************************************************************************************************
+	Function that writes constants in to the ring and binds the slot to just that part of it
+*******************************************************************************************************************/
+bool RenderContext::UploadRingConstants(ShaderStage stage, unsigned int slot, const void* data, unsigned int size)
+{
+	//-------------------------------------------- Offsets are counted in 16 byte shader constants and must be a multiple of 16 constants (256 bytes)
+	unsigned int offset			= 0;
+	unsigned int alignedSize	= (size + CONSTANT_ALIGNMENT - 1) & ~(CONSTANT_ALIGNMENT - 1);
+
+	void* destination = m_constantRing.Map(m_deviceContext, alignedSize, CONSTANT_ALIGNMENT, offset);
+	if (!destination) { return false; }
+
+	memcpy(destination, data, size);
+	m_constantRing.Unmap(m_deviceContext);
+
+	ID3D11Buffer*	constantBuffer	= m_constantRing.GetBuffer();
+	UINT			firstConstant	= offset / SHADER_CONSTANT_SIZE;
+	UINT			constantCount	= alignedSize / SHADER_CONSTANT_SIZE;
+
+	(stage == STAGE_VERTEX)	? m_deviceContext1->VSSetConstantBuffers1(slot, 1, &constantBuffer, &firstConstant, &constantCount)
+							: m_deviceContext1->PSSetConstantBuffers1(slot, 1, &constantBuffer, &firstConstant, &constantCount);
+
+	return true;
+}
+
+
+/*******************************************************************************************************************
+	Functions that issue draw calls
+*******************************************************************************************************************/
+void RenderContext::Draw(unsigned int vertexCount, unsigned int startVertex)
+{
+	m_deviceContext->Draw(vertexCount, startVertex);
+}
+
+
+void RenderContext::DrawIndexed(unsigned int indexCount, unsigned int startIndex, int baseVertex)
+{
+	m_deviceContext->DrawIndexed(indexCount, startIndex, baseVertex);
+}
+
+
+void RenderContext::DrawInstanced(unsigned int vertexCount, unsigned int instanceCount, unsigned int startVertex, unsigned int startInstance)
+{
+	m_deviceContext->DrawInstanced(vertexCount, instanceCount, startVertex, startInstance);
+}
+
+
+/*******************************************************************************************************************
+	Function that closes a deferred context's recording in to a command list, ready to be executed
+*******************************************************************************************************************/
+bool RenderContext::FinishCommandList()
+{
+	if (!m_isDeferred) { return true; }
+
+	if (m_commandList) { m_commandList->Release(); m_commandList = nullptr; }
+
+	//-------------------------------------------- Finishing clears the deferred context's state, so the next recording starts from scratch
+	HRESULT result = m_deviceContext->FinishCommandList(FALSE, &m_commandList);
+	Reset();
+
+	if (FAILED(result)) {
+		DX_LOG("[RENDER CONTEXT] Couldn't finish command list", DX_LOG_EMPTY, LOG_ERROR); return false;
+	}
+
+	return true;
+}
+
+
+/*******************************************************************************************************************
+	Function that plays back this context's command list on the immediate context - main thread only
+*******************************************************************************************************************/
+void RenderContext::ExecuteCommandList(RenderContext& immediateContext)
+{
+	if (!m_commandList) { return; }
+
+	immediateContext.GetDeviceContext()->ExecuteCommandList(m_commandList, FALSE);
+
+	m_commandList->Release();
+	m_commandList = nullptr;
+
+	//-------------------------------------------- Executing without restoring leaves the immediate context cleared, so it has to forget what it had bound
+	immediateContext.Reset();
+}
+
+
+/*******************************************************************************************************************
+	Accessor Methods
+*******************************************************************************************************************/
+ID3D11DeviceContext* RenderContext::GetDeviceContext() const	{ return m_deviceContext; }
+bool RenderContext::IsDeferred() const							{ return m_isDeferred; }
@@ -0,0 +1,127 @@
+#pragma once
+
+/*******************************************************************************************************************
+	RenderContext.h, RenderContext.cpp
+	Created by Kim Kane
+	Last updated: 19/10/2026
+
+	Wraps a DirectX device context - either the immediate context, or a deferred context that a worker thread
+	records a command list in to.
+
+	Every bind goes through here, so the context can remember what is already bound and skip calls that would
+	not change anything. Each context also owns its own dynamic buffers, so worker threads never map the same
+	buffer at the same time.
+
+	Constants are carved out of a ring buffer (see DynamicRingBuffer.h), and bound with an offset in to it using
+	the Direct3D 11.1 *SetConstantBuffers1 calls - where the driver can't do that, each stage and slot falls
+	back to its own small buffer that is discarded per upload.
+
+	A context must only be used by one thread at a time.
+
+*******************************************************************************************************************/
+#include <d3d11.h>
+#include <d3d11_1.h>
+
+#include "DynamicRingBuffer.h"
+
+namespace RenderContextConstants {
+
+	enum ShaderStage {
+		STAGE_VERTEX		= 0,
+		STAGE_PIXEL			= 1,
+		STAGE_TOTAL			= 2
+	};
+
+	enum ContextLimits {
+		MAX_CONSTANT_SLOTS	= 4,
+		MAX_SAMPLER_SLOTS	= 1,
+		MAX_RESOURCE_SLOTS	= 8
+	};
+
+	enum RingBufferSettings {
+		CONSTANT_RING_SIZE	= 256 * 1024,
+		CONSTANT_ALIGNMENT	= 256,
+		SHADER_CONSTANT_SIZE = 16
+	};
+}
+
+class RenderContext {
+
+public:
+	RenderContext();
+	~RenderContext();
+
+public:
+	bool Create(ID3D11DeviceContext* immediateContext);
+	bool CreateDeferred();
+	void Release();
+	void Reset();
+
+public:
+	void SetInputLayout(ID3D11InputLayout* layout);
+	void SetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY topology);
+	void SetVertexShader(ID3D11VertexShader* vertexShader);
+	void SetPixelShader(ID3D11PixelShader* pixelShader);
+	void SetSampler(unsigned int slot, ID3D11SamplerState* sampler);
+	void SetShaderResource(unsigned int slot, ID3D11ShaderResourceView* resource);
+	void SetVertexShaderResource(unsigned int slot, ID3D11ShaderResourceView* resource);
+	void SetVertexBuffer(ID3D11Buffer* vertexBuffer, unsigned int stride, unsigned int offset);
+	void SetIndexBuffer(ID3D11Buffer* indexBuffer, DXGI_FORMAT format);
+	void SetDepthStencilState(ID3D11DepthStencilState* depthStencilState);
+	void SetBlendState(ID3D11BlendState* blendState);
+
+public:
+	bool UploadVertexConstants(unsigned int slot, const void* data, unsigned int size);
+	bool UploadPixelConstants(unsigned int slot, const void* data, unsigned int size);
+
+public:
+	void Draw(unsigned int vertexCount, unsigned int startVertex);
+	void DrawIndexed(unsigned int indexCount, unsigned int startIndex, int baseVertex);
+	void DrawInstanced(unsigned int vertexCount, unsigned int instanceCount, unsigned int startVertex, unsigned int startInstance);
+
+public:
+	bool FinishCommandList();
+	void ExecuteCommandList(RenderContext& immediateContext);
+
+public:
+	ID3D11DeviceContext* GetDeviceContext() const;
+	bool IsDeferred() const;
+
+private:
+	RenderContext(const RenderContext&);
+	RenderContext& operator=(const RenderContext&);
+
+private:
+	bool CreateConstantRing();
+	bool UploadConstants(RenderContextConstants::ShaderStage stage, unsigned int slot, const void* data, unsigned int size);
+	bool UploadRingConstants(RenderContextConstants::ShaderStage stage, unsigned int slot, const void* data, unsigned int size);
+
+private:
+	ID3D11DeviceContext*		m_deviceContext;
+	ID3D11DeviceContext1*		m_deviceContext1;
+	ID3D11CommandList*			m_commandList;
+	bool						m_isDeferred;
+
+	//-------------------------------------------- What is currently bound, so repeated binds can be skipped
+	ID3D11InputLayout*			m_layout;
+	D3D11_PRIMITIVE_TOPOLOGY	m_topology;
+	ID3D11VertexShader*			m_vertexShader;
+	ID3D11PixelShader*			m_pixelShader;
+	ID3D11SamplerState*			m_samplers[RenderContextConstants::MAX_SAMPLER_SLOTS];
+	ID3D11ShaderResourceView*	m_resources[RenderContextConstants::MAX_RESOURCE_SLOTS];
+	ID3D11ShaderResourceView*	m_vertexResources[RenderContextConstants::MAX_RESOURCE_SLOTS];
+	ID3D11Buffer*				m_vertexBuffer;
+	unsigned int				m_vertexStride;
+	unsigned int				m_vertexOffset;
+	ID3D11Buffer*				m_indexBuffer;
+	ID3D11DepthStencilState*	m_depthStencilState;
+	ID3D11BlendState*			m_blendState;
+	bool						m_constantsBound[RenderContextConstants::STAGE_TOTAL][RenderContextConstants::MAX_CONSTANT_SLOTS];
+
+	//-------------------------------------------- This context's own ring buffer for constants
+	DynamicRingBuffer			m_constantRing;
+
+	//-------------------------------------------- Fallback constant buffers, one per stage and slot, for drivers without constant buffer offsets
+	ID3D11Buffer*				m_constantBuffers[RenderContextConstants::STAGE_TOTAL][RenderContextConstants::MAX_CONSTANT_SLOTS];
+	unsigned int				m_constantSizes[RenderContextConstants::STAGE_TOTAL][RenderContextConstants::MAX_CONSTANT_SLOTS];
+};
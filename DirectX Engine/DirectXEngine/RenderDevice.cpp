@@ -0,0 +1,91 @@
+#include "RenderDevice.h"
+#include "RenderContext.h"
+#include "GraphicsManager.h"
+#include "ShaderProgram.h"
+
+/*******************************************************************************************************************
+	Constructor - the device draws through the context passed in, which must outlive it
+*******************************************************************************************************************/
+DirectXRenderDevice::DirectXRenderDevice(RenderContext& context)	:	m_context(context),
+																	m_graphics(Graphics::Instance())
+{
+
+}
+
+
+/*******************************************************************************************************************
+	Function that gets a deferred context ready to record - they start with no render target or viewport set
+*******************************************************************************************************************/
+void DirectXRenderDevice::BeginRecording()
+{
+	if (m_context.IsDeferred()) { m_graphics->PrepareContext(m_context); }
+}
+
+
+/*******************************************************************************************************************
+	Function that closes a deferred context's recording in to a command list
+*******************************************************************************************************************/
+void DirectXRenderDevice::FinishRecording()
+{
+	m_context.FinishCommandList();
+}
+
+
+/*******************************************************************************************************************
+	Function that plays back the recorded command list - main thread only
+*******************************************************************************************************************/
+void DirectXRenderDevice::Submit()
+{
+	if (!m_context.IsDeferred()) { return; }
+
+	RenderContext& immediateContext = m_graphics->GetImmediateContext();
+
+	m_context.ExecuteCommandList(immediateContext);
+
+	//-------------------------------------------- Executing a command list clears the immediate context, so put the back buffer and viewport back
+	m_graphics->PrepareContext(immediateContext);
+}
+
+
+/*******************************************************************************************************************
+	Function that sets the depth and blend state for a layer
+*******************************************************************************************************************/
+void DirectXRenderDevice::SetLayer(RenderLayer layer)
+{
+	//-------------------------------------------- Opaque geometry writes depth with no blending, transparent geometry tests depth without writing it and blends, overlays blend with depth off
+	switch (layer) {
+		case LAYER_OPAQUE:		m_context.SetDepthStencilState(m_graphics->GetDepthStencilState(true)); break;
+		case LAYER_TRANSPARENT:	m_context.SetDepthStencilState(m_graphics->GetReadOnlyDepthStencilState()); break;
+		default:				m_context.SetDepthStencilState(m_graphics->GetDepthStencilState(false)); break;
+	}
+
+	m_context.SetBlendState(m_graphics->GetBlendState(layer != LAYER_OPAQUE));
+}
+
+
+/*******************************************************************************************************************
+	Function that binds a shader's program, layout and sampler
+*******************************************************************************************************************/
+void DirectXRenderDevice::SetShader(ShaderProgram* shader)
+{
+	shader->BindProgram(m_context);
+}
+
+
+/*******************************************************************************************************************
+	Function that binds the texture used by the following draws
+*******************************************************************************************************************/
+void DirectXRenderDevice::SetTexture(ShaderProgram* shader, Texture* texture)
+{
+	shader->BindTexture(m_context, texture);
+}
+
+
+/*******************************************************************************************************************
+	Function that sends a draw's per-object constants and draws it
+*******************************************************************************************************************/
+void DirectXRenderDevice::Draw(const RenderCommand& command, Camera* camera)
+{
+	command.shader->BindObject(m_context, command, camera);
+	command.renderable->Render(m_context, command.data);
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+/*******************************************************************************************************************
+	RenderDevice.h, RenderDevice.cpp
+	Created by Kim Kane
+	Last updated: 19/10/2026
+
+	The calls the render queue makes to get its commands on screen.
+
+	When the queue is executed across several threads, each thread is given its own device. The device records
+	between BeginRecording() and FinishRecording() on that thread, then Submit() is called for each device
+	in order back on the main thread.
+
+	DirectXRenderDevice forwards the calls to the shaders through a render context. Given a deferred context it
+	records a command list, and Submit() plays that list back on the immediate context.
+	RecordingRenderDevice just keeps a list of the calls it receives, so the queue's sorting and batching
+	can be checked without a window or a graphics card.
+
+*******************************************************************************************************************/
+#include <vector>
+
+#include "RenderQueue.h"
+
+class GraphicsManager;
+
+class RenderDevice {
+
+public:
+	virtual ~RenderDevice() {}
+
+public:
+	virtual void BeginRecording() {}
+	virtual void FinishRecording() {}
+	virtual void Submit() {}
+
+public:
+	virtual void SetLayer(RenderLayer layer) = 0;
+	virtual void SetShader(ShaderProgram* shader) = 0;
+	virtual void SetTexture(ShaderProgram* shader, Texture* texture) = 0;
+	virtual void Draw(const RenderCommand& command, Camera* camera) = 0;
+};
+
+
+class DirectXRenderDevice : public RenderDevice {
+
+public:
+	explicit DirectXRenderDevice(RenderContext& context);
+
+public:
+	virtual void BeginRecording() override;
+	virtual void FinishRecording() override;
+	virtual void Submit() override;
+
+public:
+	virtual void SetLayer(RenderLayer layer) override;
+	virtual void SetShader(ShaderProgram* shader) override;
+	virtual void SetTexture(ShaderProgram* shader, Texture* texture) override;
+	virtual void Draw(const RenderCommand& command, Camera* camera) override;
+
+private:
+	RenderContext&		m_context;
+
+	//-------------------------------------------- Kept from when the device is made - the graphics manager is there until the game shuts down
+	GraphicsManager*	m_graphics;
+};
+
+
+class RecordingRenderDevice : public RenderDevice {
+
+public:
+	enum CallType { CALL_BEGIN_RECORDING, CALL_FINISH_RECORDING, CALL_SUBMIT, CALL_SET_LAYER, CALL_SET_SHADER, CALL_SET_TEXTURE, CALL_DRAW };
+
+	struct Call
+	{
+		CallType			type;
+		RenderLayer			layer;
+		ShaderProgram*		shader;
+		Texture*			texture;
+		const Renderable*	renderable;
+	};
+
+public:
+	virtual void BeginRecording() override								{ Record(CALL_BEGIN_RECORDING, LAYER_TOTAL, nullptr, nullptr, nullptr); }
+	virtual void FinishRecording() override								{ Record(CALL_FINISH_RECORDING, LAYER_TOTAL, nullptr, nullptr, nullptr); }
+	virtual void Submit() override										{ Record(CALL_SUBMIT, LAYER_TOTAL, nullptr, nullptr, nullptr); }
+
+public:
+	virtual void SetLayer(RenderLayer layer) override					{ Record(CALL_SET_LAYER, layer, nullptr, nullptr, nullptr); }
+	virtual void SetShader(ShaderProgram* shader) override				{ Record(CALL_SET_SHADER, LAYER_TOTAL, shader, nullptr, nullptr); }
+	virtual void SetTexture(ShaderProgram* shader, Texture* texture) override	{ Record(CALL_SET_TEXTURE, LAYER_TOTAL, shader, texture, nullptr); }
+	virtual void Draw(const RenderCommand& command, Camera*) override	{ Record(CALL_DRAW, LAYER_TOTAL, command.shader, command.texture, command.renderable); }
+
+public:
+	const std::vector<Call>& GetCalls() const	{ return m_calls; }
+	void Clear()								{ m_calls.clear(); }
+
+private:
+	void Record(CallType type, RenderLayer layer, ShaderProgram* shader, Texture* texture, const Renderable* renderable)
+	{
+		Call call = { type, layer, shader, texture, renderable };
+		m_calls.push_back(call);
+	}
+
+private:
+	std::vector<Call> m_calls;
+};
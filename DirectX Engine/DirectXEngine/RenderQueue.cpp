@@ -0,0 +1,298 @@
+#include <algorithm>
+#include <cstring>
+
+#include "RenderQueue.h"
+#include "RenderDevice.h"
+#include "ShaderProgram.h"
+#include "Texture.h"
+#include "Camera.h"
+#include "ThreadPool.h"
+#include "Clock.h"
+#include "EventLog.h"
+#include "Constants.h"
+
+/*******************************************************************************************************************
+	Constructor with initializer list to set all default values of variables
+*******************************************************************************************************************/
+RenderQueue::RenderQueue()	:	m_camera(nullptr)
+{
+	XMStoreFloat4x4(&m_viewMatrix, XMMatrixIdentity());
+	memset(&m_stats, 0, sizeof(m_stats));
+}
+
+
+/*******************************************************************************************************************
+	Destructor
+*******************************************************************************************************************/
+RenderQueue::~RenderQueue()
+{
+
+}
+
+
+/*******************************************************************************************************************
+	Function that starts a new frame of submissions, viewed through the camera passed in
+*******************************************************************************************************************/
+void RenderQueue::Begin(Camera* camera)
+{
+	m_camera = camera;
+	XMStoreFloat4x4(&m_viewMatrix, camera->GetViewMatrix());
+
+	//-------------------------------------------- Clearing keeps the capacity, so after the first few frames submitting never allocates
+	m_commands.clear();
+	m_data.clear();
+	m_dataEntries.clear();
+}
+
+
+/*******************************************************************************************************************
+	Function that adds a draw to this frame - nothing is bound or drawn until Execute() is called
+	Any data given is copied, so the renderable can change it straight away without changing what gets drawn
+*******************************************************************************************************************/
+void RenderQueue::Submit(RenderLayer layer, ShaderProgram* shader, Texture* texture, const Renderable* renderable,
+						 CXMMATRIX world, const XMFLOAT3& position, const XMFLOAT4& color, const void* data, unsigned int dataSize)
+{
+	if (!shader || !renderable) { return; }
+
+	//-------------------------------------------- Distance from the camera along its view direction, used for front-to-back/back-to-front ordering
+	float depth = 0.0f;
+
+	if (layer != LAYER_OVERLAY) {
+		XMVECTOR viewPosition = XMVector3TransformCoord(XMLoadFloat3(&position), XMLoadFloat4x4(&m_viewMatrix));
+		depth = XMVectorGetZ(viewPosition);
+	}
+
+	RenderCommand command;
+	command.shader		= shader;
+	command.texture		= texture;
+	command.renderable	= renderable;
+	command.data		= nullptr;
+	command.color		= color;
+	XMStoreFloat4x4(&command.world, world);
+
+	//-------------------------------------------- The copy may move as more are added, so only its offset is kept until the queue is executed
+	if (data && dataSize > 0) {
+		DataEntry dataEntry;
+		dataEntry.command	= (unsigned int)m_commands.size();
+		dataEntry.offset	= ((unsigned int)m_data.size() + GraphicConstants::COMMAND_DATA_ALIGNMENT - 1) & ~(GraphicConstants::COMMAND_DATA_ALIGNMENT - 1);
+
+		m_data.resize(dataEntry.offset + dataSize);
+		memcpy(&m_data[dataEntry.offset], data, dataSize);
+
+		m_dataEntries.push_back(dataEntry);
+	}
+
+	SortEntry entry;
+	entry.key	= GenerateSortKey(layer, shader->GetSortId(), texture ? texture->GetSortId() : 0, depth);
+	entry.index	= (unsigned int)m_commands.size();
+
+	m_commands.push_back(command);
+
+	if (m_sortEntries.size() < m_commands.size())	{ m_sortEntries.push_back(entry); }
+	else											{ m_sortEntries[entry.index] = entry; }
+}
+
+
+/*******************************************************************************************************************
+	Function that sorts this frame's draws and sends them to the device, only changing state when it has to
+*******************************************************************************************************************/
+void RenderQueue::Execute(RenderDevice& device)
+{
+	BeginExecute();
+
+	device.BeginRecording();
+	ExecuteRange(device, 0, m_commands.size(), m_stats);
+	device.FinishRecording();
+	device.Submit();
+}
+
+
+/*******************************************************************************************************************
+	Function that sorts this frame's draws and records them across several devices at once, one per thread
+*******************************************************************************************************************/
+void RenderQueue::Execute(RenderDevice* const* devices, unsigned int deviceCount, ThreadPool& threads, unsigned int minCommandsPerDevice)
+{
+	if (deviceCount == 0) { return; }
+
+	BeginExecute();
+
+	//-------------------------------------------- Don't hand out chunks so small that recording them costs less than waking a thread
+	const unsigned int commandCount = m_commands.size();
+
+	if (minCommandsPerDevice == 0) { minCommandsPerDevice = 1; }
+
+	unsigned int chunkCount = commandCount / minCommandsPerDevice;
+	if (chunkCount > deviceCount)	{ chunkCount = deviceCount; }
+	if (chunkCount == 0)			{ chunkCount = 1; }
+
+	const unsigned int chunkSize = (commandCount + chunkCount - 1) / chunkCount;
+
+	m_chunkStats.resize(chunkCount);
+
+	//-------------------------------------------- Each chunk starts with nothing bound, so it binds its own state - the workers never share a device
+	threads.Dispatch(chunkCount, [&](unsigned int chunk) {
+
+		unsigned int begin	= chunk * chunkSize;
+		unsigned int end	= (begin + chunkSize < commandCount) ? begin + chunkSize : commandCount;
+
+		memset(&m_chunkStats[chunk], 0, sizeof(RenderStats));
+
+		devices[chunk]->BeginRecording();
+		if (begin < end) { ExecuteRange(*devices[chunk], begin, end, m_chunkStats[chunk]); }
+		devices[chunk]->FinishRecording();
+	});
+
+	//-------------------------------------------- Submit in chunk order, so the frame is drawn in the same order it was sorted in
+	for (unsigned int chunk = 0; chunk < chunkCount; chunk++) {
+
+		devices[chunk]->Submit();
+
+		m_stats.draws			+= m_chunkStats[chunk].draws;
+		m_stats.stateChanges	+= m_chunkStats[chunk].stateChanges;
+	}
+}
+
+
+/*******************************************************************************************************************
+	Function that resets the frame's stats and sorts the keys, timing how long the sort takes
+*******************************************************************************************************************/
+void RenderQueue::BeginExecute()
+{
+	memset(&m_stats, 0, sizeof(m_stats));
+	m_stats.commands = (unsigned int)m_commands.size();
+
+	//-------------------------------------------- Time the sort, so it can be shown next to the other frame stats
+	long long sortStart = SystemClock::GetTicks();
+
+	Sort();
+
+	m_stats.sortTime = (float)(SystemClock::GetTicks() - sortStart) * 1000.0f / (float)SystemClock::GetTicksPerSecond();
+
+	ResolveData();
+}
+
+
+/*******************************************************************************************************************
+	Function that points each draw at its copied data - nothing more can be submitted, so the copies won't move now
+*******************************************************************************************************************/
+void RenderQueue::ResolveData()
+{
+	const unsigned int count = m_dataEntries.size();
+
+	for (unsigned int i = 0; i < count; i++) {
+		m_commands[m_dataEntries[i].command].data = &m_data[m_dataEntries[i].offset];
+	}
+}
+
+
+/*******************************************************************************************************************
+	Function that sends a run of sorted draws to a device - safe to call from several threads for different runs
+*******************************************************************************************************************/
+void RenderQueue::ExecuteRange(RenderDevice& device, unsigned int begin, unsigned int end, RenderStats& stats) const
+{
+	RenderLayer		currentLayer	= LAYER_TOTAL;
+	ShaderProgram*	currentShader	= nullptr;
+	Texture*		currentTexture	= nullptr;
+	bool			textureBound	= false;
+
+	for (unsigned int i = begin; i < end; i++) {
+
+		const SortEntry&		entry	= m_sortEntries[i];
+		const RenderCommand&	command	= m_commands[entry.index];
+
+		//-------------------------------------------- Each layer has its own depth/blend state
+		RenderLayer layer = (RenderLayer)(entry.key >> 60);
+
+		if (layer != currentLayer) {
+			device.SetLayer(layer);
+			currentLayer = layer;
+			stats.stateChanges++;
+		}
+
+		//-------------------------------------------- Different shaders may use the texture slots differently, so a new shader always rebinds the texture
+		if (command.shader != currentShader) {
+			device.SetShader(command.shader);
+			currentShader	= command.shader;
+			textureBound	= false;
+			stats.stateChanges++;
+		}
+
+		if (!textureBound || command.texture != currentTexture) {
+			device.SetTexture(command.shader, command.texture);
+			currentTexture	= command.texture;
+			textureBound	= true;
+			stats.stateChanges++;
+		}
+
+		DX_EVENT("[RENDER QUEUE] Draw %u - layer %u, shader %p, texture %p", i, (unsigned int)layer, command.shader, command.texture);
+
+		device.Draw(command, m_camera);
+		stats.draws++;
+	}
+}
+
+
+/*******************************************************************************************************************
+	Accessor Methods
+*******************************************************************************************************************/
+const RenderStats& RenderQueue::GetStats() const { return m_stats; }
+
+
+/*******************************************************************************************************************
+	Function that packs a draw's state in to a key - sorting the keys groups draws by layer, shader, texture then depth
+*******************************************************************************************************************/
+unsigned long long RenderQueue::GenerateSortKey(RenderLayer layer, unsigned int shaderId, unsigned int textureId, float depth)
+{
+	//-------------------------------------------- Depths in front of the camera are positive, and positive floats sort the same way as their bit patterns
+	if (depth < 0.0f) { depth = 0.0f; }
+
+	unsigned int depthBits = 0;
+	memcpy(&depthBits, &depth, sizeof(depthBits));
+
+	//-------------------------------------------- Transparent draws blend with what is behind them, so they are drawn back-to-front instead
+	if (layer == LAYER_TRANSPARENT) { depthBits = ~depthBits; }
+
+	return ((unsigned long long)(layer & 0xF)		<< 60) |
+		   ((unsigned long long)(shaderId & 0xFFF)	<< 48) |
+		   ((unsigned long long)(textureId & 0xFFFF)	<< 32) |
+		   ((unsigned long long)depthBits);
+}
+
+
+/*******************************************************************************************************************
+	Function that radix sorts the frame's keys (8 passes of 8 bits) - stable, so equal keys keep submission order
+*******************************************************************************************************************/
+void RenderQueue::Sort()
+{
+	const size_t count = m_commands.size();
+	if (count < 2) { return; }
+
+	m_sortScratch.resize(m_sortEntries.size());
+
+	SortEntry* source		= m_sortEntries.data();
+	SortEntry* destination	= m_sortScratch.data();
+
+	for (unsigned int shift = 0; shift < 64; shift += 8) {
+
+		size_t histogram[256] = { 0 };
+
+		for (size_t i = 0; i < count; i++) { histogram[(source[i].key >> shift) & 0xFF]++; }
+
+		//-------------------------------------------- If every key has the same byte here this pass would not move anything, so skip it
+		if (histogram[(source[0].key >> shift) & 0xFF] == count) { continue; }
+
+		size_t offset = 0;
+		for (size_t bucket = 0; bucket < 256; bucket++) {
+			size_t bucketCount	= histogram[bucket];
+			histogram[bucket]	= offset;
+			offset				+= bucketCount;
+		}
+
+		for (size_t i = 0; i < count; i++) { destination[histogram[(source[i].key >> shift) & 0xFF]++] = source[i]; }
+
+		std::swap(source, destination);
+	}
+
+	//-------------------------------------------- Make sure the sorted result ends up back in the main array
+	if (source != m_sortEntries.data()) { memcpy(m_sortEntries.data(), source, count * sizeof(SortEntry)); }
+}
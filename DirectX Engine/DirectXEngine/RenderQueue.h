@@ -0,0 +1,140 @@
+#pragma once
+
+/*******************************************************************************************************************
+	RenderQueue.h, RenderQueue.cpp
+	Created by Kim Kane
+	Last updated: 19/10/2026
+
+	Collects every draw for a frame, sorts them and executes them with as few state changes as possible.
+
+	Game objects, terrain leaves and text submit a RenderCommand rather than binding state and drawing
+	straight away. Each command gets a 64-bit sort key:
+
+		| layer (4 bits) | shader (12 bits) | texture (16 bits) | depth (32 bits) |
+
+	The keys are radix sorted once per frame, so draws are grouped by layer, then shader, then texture -
+	and within a group, opaque geometry is drawn front-to-back so early-Z can reject hidden pixels.
+	Transparent geometry is drawn back-to-front and overlay (2D) draws keep the order they were submitted in.
+
+	The queue never talks to DirectX itself - it issues calls through a RenderDevice, so it can be run
+	headless with a device that just records what it was asked to do.
+
+	Given several devices and a thread pool, the sorted commands are split in to contiguous chunks and each
+	chunk is recorded on its own thread. The chunks are then submitted in order on the calling thread, so the
+	result is drawn exactly as if it had been recorded on one thread.
+
+	The queue may be drawn on another thread while the game moves on (see FramePipeline.h), so a draw can't read
+	anything the game changes from one frame to the next. A renderable that needs more than its world matrix -
+	a pose or a bone palette - hands it to Submit(), which copies it in to the queue for Render() to draw from.
+
+*******************************************************************************************************************/
+#include <d3d11.h>
+#include <xnamath.h>
+#include <vector>
+
+class Camera;
+class Texture;
+class ShaderProgram;
+class RenderDevice;
+class RenderContext;
+class ThreadPool;
+
+/*******************************************************************************************************************
+	Layers are drawn in this order, each with its own depth/blend state
+*******************************************************************************************************************/
+enum RenderLayer { LAYER_OPAQUE, LAYER_TRANSPARENT, LAYER_OVERLAY, LAYER_TOTAL };
+
+/*******************************************************************************************************************
+	Anything that owns geometry and can issue its own draw call (models, terrain leaves, text, etc.)
+	The data passed to Render() is the copy the queue made when it was submitted, or nullptr if there wasn't any
+*******************************************************************************************************************/
+class Renderable {
+
+public:
+	virtual ~Renderable() {}
+
+public:
+	virtual void Render(RenderContext& context, const void* data) const = 0;
+};
+
+/*******************************************************************************************************************
+	A single submitted draw - everything needed to bind its state and draw it later in the frame
+*******************************************************************************************************************/
+struct RenderCommand
+{
+	ShaderProgram*		shader;
+	Texture*			texture;
+	const Renderable*	renderable;
+	const void*			data;
+	XMFLOAT4X4			world;
+	XMFLOAT4			color;
+};
+
+/*******************************************************************************************************************
+	Per-frame numbers, so the cost of a frame's submission can be shown on screen
+*******************************************************************************************************************/
+struct RenderStats
+{
+	unsigned int	commands;
+	unsigned int	draws;
+	unsigned int	stateChanges;
+	float			sortTime;
+};
+
+class RenderQueue {
+
+public:
+	RenderQueue();
+	~RenderQueue();
+
+public:
+	void Begin(Camera* camera);
+	void Submit(RenderLayer layer, ShaderProgram* shader, Texture* texture, const Renderable* renderable,
+				CXMMATRIX world, const XMFLOAT3& position, const XMFLOAT4& color = XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f),
+				const void* data = nullptr, unsigned int dataSize = 0);
+	void Execute(RenderDevice& device);
+	void Execute(RenderDevice* const* devices, unsigned int deviceCount, ThreadPool& threads, unsigned int minCommandsPerDevice = 1);
+
+public:
+	const RenderStats& GetStats() const;
+
+public:
+	static unsigned long long GenerateSortKey(RenderLayer layer, unsigned int shaderId, unsigned int textureId, float depth);
+
+private:
+	RenderQueue(const RenderQueue&);
+
+private:
+	void Sort();
+	void ExecuteRange(RenderDevice& device, unsigned int begin, unsigned int end, RenderStats& stats) const;
+	void BeginExecute();
+	void ResolveData();
+
+private:
+	struct SortEntry
+	{
+		unsigned long long	key;
+		unsigned int		index;
+	};
+
+	struct DataEntry
+	{
+		unsigned int		command;
+		unsigned int		offset;
+	};
+
+private:
+	Camera*						m_camera;
+	XMFLOAT4X4					m_viewMatrix;
+
+	std::vector<RenderCommand>	m_commands;
+	std::vector<SortEntry>		m_sortEntries;
+	std::vector<SortEntry>		m_sortScratch;
+
+	//-------------------------------------------- Copies of each draw's data, packed together - the offsets are turned in to pointers once nothing more can be added
+	std::vector<unsigned char>	m_data;
+	std::vector<DataEntry>		m_dataEntries;
+
+	RenderStats					m_stats;
+	std::vector<RenderStats>	m_chunkStats;
+};
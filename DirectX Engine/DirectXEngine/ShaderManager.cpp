@@ -0,0 +1,476 @@
+#include <d3dcompiler.h>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <vector>
+
+#include "ShaderManager.h"
+#include "GraphicsManager.h"
+#include "ScreenManager.h"
+#include "Constants.h"
+#include "Log.h"
+
+/*******************************************************************************************************************
+	Constructor with initializer list to set all default values of variables
+*******************************************************************************************************************/
+ShaderManager::ShaderManager()	:	m_lastReloadCheck(0)
+{
+	//-------------------------------------------- Make sure the byte code cache folder exists, it is created on the first run
+	CreateDirectory(ToString(ShaderConstants::CacheDirectory).c_str(), nullptr);
+
+	DX_LOG("[SHADERS] Shader manager constructor initialized", DX_LOG_EMPTY, LOG_MESSAGE);
+}
+
+
+/*******************************************************************************************************************
+	Release every cached program, input layout and shader stage - must be called before the device is released
+*******************************************************************************************************************/
+void ShaderManager::Shutdown()
+{
+	std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
+	//-------------------------------------------- Programs first, as they hold constant buffers and borrow the stages below
+	m_programs.clear();
+
+	for (auto& layout : m_layouts) {
+		if (layout.second) { layout.second->Release(); layout.second = nullptr; }
+	}
+
+	for (auto& shader : m_shaders) {
+		if (shader.second.shader)	{ shader.second.shader->Release(); shader.second.shader = nullptr; }
+		if (shader.second.byteCode)	{ shader.second.byteCode->Release(); shader.second.byteCode = nullptr; }
+	}
+
+	m_layouts.clear();
+	m_shaders.clear();
+
+	DX_LOG("[SHADERS] Shader manager shutdown successfully", DX_LOG_EMPTY, LOG_SUCCESS);
+}
+
+
+#if DEBUG_MODE == 1
+/*******************************************************************************************************************
+	Function that recompiles any shader whose source file has been edited, then reloads the programs using it
+*******************************************************************************************************************/
+void ShaderManager::ReloadModifiedShaders()
+{
+	//-------------------------------------------- Only poll the file system a couple of times a second, this is called every frame
+	unsigned long long currentTime = GetTickCount64();
+	if (currentTime - m_lastReloadCheck < ShaderConstants::ReloadInterval) { return; }
+	m_lastReloadCheck = currentTime;
+
+	std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
+	bool reloaded = false;
+
+	for (auto& entry : m_shaders) {
+
+		CompiledShader& shader = entry.second;
+
+		FILETIME lastWriteTime = GetLastWriteTime(shader.fileLocation);
+		if (CompareFileTime(&lastWriteTime, &shader.lastWriteTime) == 0) { continue; }
+
+		shader.lastWriteTime = lastWriteTime;
+
+		//-------------------------------------------- Build the new shader into a copy, so a typo in the source leaves the old shader running
+		CompiledShader reloadedShader = shader;
+		reloadedShader.byteCode	= nullptr;
+		reloadedShader.shader	= nullptr;
+
+		if (!CreateShader(reloadedShader, false)) { continue; }
+
+		//-------------------------------------------- The old input layout was validated against the old vertex shader, so it has to go too
+		auto layout = m_layouts.find(static_cast<ID3D11VertexShader*>(shader.shader));
+		if (layout != m_layouts.end()) { layout->second->Release(); m_layouts.erase(layout); }
+
+		if (shader.shader)		{ shader.shader->Release(); }
+		if (shader.byteCode)	{ shader.byteCode->Release(); }
+
+		shader = reloadedShader;
+		reloaded = true;
+
+		DX_LOG("[SHADERS] Hot reloaded shader: ", entry.first.c_str(), LOG_RESOURCE);
+	}
+
+	//-------------------------------------------- Programs hold the old stage pointers, so reload them to pick up the new shaders and layouts
+	if (reloaded) {
+		for (auto& program : m_programs) {
+			program.second.program->LoadShader(program.second.vertexFileLocation, program.second.pixelFileLocation);
+		}
+	}
+}
+#endif
+
+
+/*******************************************************************************************************************
+	Function that returns a shared vertex shader, compiling it the first time this variant is requested
+*******************************************************************************************************************/
+ID3D11VertexShader* ShaderManager::GetVertexShader(const std::wstring& fileLocation, const std::string& entryPoint, const ShaderDefines& defines)
+{
+	return static_cast<ID3D11VertexShader*>(GetShader(fileLocation, entryPoint, "vs_4_0", defines));
+}
+
+
+/*******************************************************************************************************************
+	Function that returns a shared pixel shader, compiling it the first time this variant is requested
+*******************************************************************************************************************/
+ID3D11PixelShader* ShaderManager::GetPixelShader(const std::wstring& fileLocation, const std::string& entryPoint, const ShaderDefines& defines)
+{
+	return static_cast<ID3D11PixelShader*>(GetShader(fileLocation, entryPoint, "ps_4_0", defines));
+}
+
+
+/*******************************************************************************************************************
+	Function that returns the shared input layout for a vertex shader (every vertex shader has exactly one layout)
+*******************************************************************************************************************/
+ID3D11InputLayout* ShaderManager::GetInputLayout(ID3D11VertexShader* vertexShader, const D3D11_INPUT_ELEMENT_DESC* layout, unsigned int elementCount)
+{
+	if (!vertexShader) { return nullptr; }
+
+	std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
+	auto cachedLayout = m_layouts.find(vertexShader);
+	if (cachedLayout != m_layouts.end()) { return cachedLayout->second; }
+
+	//-------------------------------------------- Find the byte code this vertex shader was created from
+	ID3D10Blob* byteCode = nullptr;
+
+	for (auto& shader : m_shaders) {
+		if (shader.second.shader == vertexShader) { byteCode = shader.second.byteCode; break; }
+	}
+
+	if (!byteCode) {
+		DX_LOG("[SHADERS] Input layout requested for a vertex shader the manager does not own", DX_LOG_EMPTY, LOG_ERROR); return nullptr;
+	}
+
+	ID3D11InputLayout* inputLayout = nullptr;
+
+	//-------------------------------------------- Create vertex input layout
+	HRESULT result = Graphics::Instance()->GetDevice()->CreateInputLayout(layout, elementCount, byteCode->GetBufferPointer(),
+		byteCode->GetBufferSize(), &inputLayout);
+	if (FAILED(result)) {
+		DX_LOG("[SHADERS] Can't create the input layout", DX_LOG_EMPTY, LOG_ERROR); return nullptr;
+	}
+
+	m_layouts[vertexShader] = inputLayout;
+
+	return inputLayout;
+}
+
+
+/*******************************************************************************************************************
+	Function that returns a cached shader stage, creating it the first time this variant is requested
+*******************************************************************************************************************/
+ID3D11DeviceChild* ShaderManager::GetShader(const std::wstring& fileLocation, const std::string& entryPoint, const char* profile, const ShaderDefines& defines)
+{
+	std::string key = GenerateKey(fileLocation, entryPoint, defines);
+
+	std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
+	auto cachedShader = m_shaders.find(key);
+	if (cachedShader != m_shaders.end()) { return cachedShader->second.shader; }
+
+	CompiledShader shader;
+	shader.fileLocation		= fileLocation;
+	shader.entryPoint		= entryPoint;
+	shader.profile			= profile;
+	shader.defines			= defines;
+	shader.lastWriteTime	= GetLastWriteTime(fileLocation);
+	shader.byteCode			= nullptr;
+	shader.shader			= nullptr;
+
+	if (!CreateShader(shader, true)) { return nullptr; }
+
+	m_shaders[key] = shader;
+
+	return shader.shader;
+}
+
+
+/*******************************************************************************************************************
+	Function that loads the byte code for a shader stage and creates the DirectX shader object from it
+*******************************************************************************************************************/
+bool ShaderManager::CreateShader(CompiledShader& shader, bool reportErrors)
+{
+	ID3D10Blob* byteCode = nullptr;
+	std::string cacheFile;
+	bool isCached = false;
+
+	if (!LoadByteCode(shader, &byteCode, reportErrors, true, cacheFile, isCached)) { return false; }
+
+	HRESULT result = CreateStage(shader, byteCode);
+
+	//-------------------------------------------- The device wouldn't take the cached byte code, so it's damaged - throw it away and compile the source again
+	if (FAILED(result) && isCached) {
+		DX_LOG("[SHADERS] Cached shader is damaged, compiling it again: ", cacheFile.c_str(), LOG_WARN);
+
+		byteCode->Release(); byteCode = nullptr;
+		DeleteFile(cacheFile.c_str());
+
+		if (!LoadByteCode(shader, &byteCode, reportErrors, false, cacheFile, isCached)) { return false; }
+
+		result = CreateStage(shader, byteCode);
+	}
+
+	if (FAILED(result)) {
+		DX_LOG("[SHADERS] Can't create shader: ", ToString(shader.fileLocation).c_str(), LOG_ERROR);
+		byteCode->Release(); return false;
+	}
+
+	//-------------------------------------------- Vertex shader byte code is kept, as input layouts are validated against its signature
+	if (shader.profile[0] == 'v')	{ shader.byteCode = byteCode; }
+	else							{ byteCode->Release(); }
+
+	return true;
+}
+
+
+/*******************************************************************************************************************
+	Function that creates the vertex or pixel shader from its byte code
+*******************************************************************************************************************/
+HRESULT ShaderManager::CreateStage(CompiledShader& shader, ID3D10Blob* byteCode)
+{
+	HRESULT result = S_OK;
+
+	if (shader.profile[0] == 'v') {
+		ID3D11VertexShader* vertexShader = nullptr;
+		result = Graphics::Instance()->GetDevice()->CreateVertexShader(byteCode->GetBufferPointer(), byteCode->GetBufferSize(), nullptr, &vertexShader);
+		shader.shader = vertexShader;
+	}
+	else {
+		ID3D11PixelShader* pixelShader = nullptr;
+		result = Graphics::Instance()->GetDevice()->CreatePixelShader(byteCode->GetBufferPointer(), byteCode->GetBufferSize(), nullptr, &pixelShader);
+		shader.shader = pixelShader;
+	}
+
+	return result;
+}
+
+
+/*******************************************************************************************************************
+	Function that loads the byte code for a shader stage from the disk cache, only compiling it on a cache miss
+	(or when told not to use the cache) - says which cache file it used, and whether the byte code came from it
+*******************************************************************************************************************/
+bool ShaderManager::LoadByteCode(const CompiledShader& shader, ID3D10Blob** byteCode, bool reportErrors, bool useCache, std::string& cacheFile, bool& isCached)
+{
+	isCached = false;
+
+	std::string shaderFile = ToString(ShaderConstants::Directory + shader.fileLocation);
+
+	//-------------------------------------------- Read in the source, as its contents are part of the cache key
+	std::string source;
+	if (!ReadBinaryFile(shaderFile, source)) {
+		if (reportErrors)	{ MessageBox(Screen::Instance()->GetWindow(), shaderFile.c_str(), "Missing Shader File", MB_OK); }
+		else				{ DX_LOG("[SHADERS] Missing shader file: ", shaderFile.c_str(), LOG_ERROR); }
+		return false;
+	}
+
+	const unsigned int compileFlags = D3D10_SHADER_ENABLE_STRICTNESS;
+
+	//-------------------------------------------- Hash everything that changes the compiled output - source, entry point, profile, defines and flags
+	unsigned long long hash = Hash(source.data(), source.size());
+	hash = Hash(shader.entryPoint.data(), shader.entryPoint.size(), hash);
+	hash = Hash(shader.profile, strlen(shader.profile), hash);
+	hash = Hash(&compileFlags, sizeof(compileFlags), hash);
+
+	for (auto& define : shader.defines) {
+		hash = Hash(define.first.data(), define.first.size() + 1, hash);
+		hash = Hash(define.second.data(), define.second.size() + 1, hash);
+	}
+
+	std::stringstream cacheName;
+	cacheName << ToString(ShaderConstants::CacheDirectory) << std::hex << std::setw(16) << std::setfill('0') << hash << ".cso";
+	cacheFile = cacheName.str();
+
+	//-------------------------------------------- Cache hit - hand the stored blob straight to the device, no compiling needed. A file cut short is treated as a miss
+	std::string cachedByteCode;
+	if (useCache && ReadBinaryFile(cacheFile, cachedByteCode) && IsByteCodeComplete(cachedByteCode)) {
+		if (SUCCEEDED(D3DCreateBlob(cachedByteCode.size(), byteCode))) {
+			memcpy((*byteCode)->GetBufferPointer(), cachedByteCode.data(), cachedByteCode.size());
+			isCached = true;
+			return true;
+		}
+	}
+
+	//-------------------------------------------- Cache miss - build a null terminated macro list from the defines, as the compiler expects
+	std::vector<D3D_SHADER_MACRO> macros;
+	for (auto& define : shader.defines) { macros.push_back({ define.first.c_str(), define.second.c_str() }); }
+	macros.push_back({ nullptr, nullptr });
+
+	ID3D10Blob* errorMessage = nullptr;
+
+	//-------------------------------------------- Compile the shader code
+	HRESULT result = D3DCompile(source.data(), source.size(), shaderFile.c_str(), macros.data(), D3D_COMPILE_STANDARD_FILE_INCLUDE,
+		shader.entryPoint.c_str(), shader.profile, compileFlags, 0, byteCode, &errorMessage);
+
+	if (FAILED(result)) {
+		if (errorMessage) { OutputShaderErrorMessage(errorMessage, shaderFile, reportErrors); }
+		return false;
+	}
+
+	//-------------------------------------------- Store the compiled blob so the next run can skip the compiler
+	if (!WriteBinaryFile(cacheFile, (*byteCode)->GetBufferPointer(), (*byteCode)->GetBufferSize())) {
+		DX_LOG("[SHADERS] Can't write shader cache file: ", cacheFile.c_str(), LOG_WARN);
+	}
+
+	DX_LOG("[SHADERS] Compiled shader: ", GenerateKey(shader.fileLocation, shader.entryPoint, shader.defines).c_str(), LOG_RESOURCE);
+
+	return true;
+}
+
+
+/*******************************************************************************************************************
+	Function that outputs any shader errors generated to a file
+*******************************************************************************************************************/
+void ShaderManager::OutputShaderErrorMessage(ID3D10Blob* errorMessage, const std::string& fileLocation, bool reportErrors)
+{
+	std::ofstream file;
+
+	//-------------------------------------------- Get a pointer to the error message text buffer
+	char* compileErrors = (char*)(errorMessage->GetBufferPointer());
+
+	//-------------------------------------------- Get the length of the message
+	unsigned long bufferSize = errorMessage->GetBufferSize();
+
+	//-------------------------------------------- Open a file to write the error message to
+	file.open("ShaderErrors.txt");
+
+	//-------------------------------------------- Write out the error message
+	for (unsigned long i = 0; i < bufferSize; i++) { file << compileErrors[i]; }
+
+	//-------------------------------------------- Close file and release error message pointer
+	file.close();
+	errorMessage->Release();
+	errorMessage = nullptr;
+
+	//-------------------------------------------- A failed hot reload just logs, rather than stopping the game with a message box
+	if (!reportErrors) {
+		DX_LOG("[SHADERS] Error compiling shader, check ShaderErrors.txt: ", fileLocation.c_str(), LOG_ERROR); return;
+	}
+
+	//-------------------------------------------- Pop a message up on the screen to notify the user to check the text file for compile errors
+	MessageBox(Screen::Instance()->GetWindow(), "Error compiling shader.  Check ShaderErrors.txt for message.", fileLocation.c_str(), MB_OK);
+}
+
+
+/*******************************************************************************************************************
+	Function that reads a whole file in binary mode
+*******************************************************************************************************************/
+bool ShaderManager::ReadBinaryFile(const std::string& fileLocation, std::string& data)
+{
+	std::ifstream file(fileLocation, std::ios::in | std::ios::binary);
+	if (!file.is_open()) { return false; }
+
+	std::stringstream contents;
+	contents << file.rdbuf();
+	data = contents.str();
+
+	return true;
+}
+
+
+/*******************************************************************************************************************
+	Function that writes a block of memory out to a file in binary mode - written to a temporary file first, then
+	renamed over the real one, so a crash part way through never leaves half a file behind
+*******************************************************************************************************************/
+bool ShaderManager::WriteBinaryFile(const std::string& fileLocation, const void* data, size_t size)
+{
+	std::stringstream temporaryName;
+	temporaryName << fileLocation << "." << GetCurrentProcessId() << ".tmp";
+	std::string temporaryFile = temporaryName.str();
+
+	{
+		std::ofstream file(temporaryFile, std::ios::out | std::ios::binary | std::ios::trunc);
+		if (!file.is_open()) { return false; }
+
+		file.write((const char*)data, size);
+		file.close();
+
+		if (file.fail()) { DeleteFile(temporaryFile.c_str()); return false; }
+	}
+
+	if (!MoveFileEx(temporaryFile.c_str(), fileLocation.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH)) {
+		DeleteFile(temporaryFile.c_str()); return false;
+	}
+
+	return true;
+}
+
+
+/*******************************************************************************************************************
+	Function that checks compiled byte code is all there - it starts with "DXBC", and holds its own total size
+	after the 16 byte checksum and a 4 byte version
+*******************************************************************************************************************/
+bool ShaderManager::IsByteCodeComplete(const std::string& byteCode)
+{
+	const size_t headerSize = 32;
+	if (byteCode.size() < headerSize || byteCode.compare(0, 4, "DXBC") != 0) { return false; }
+
+	unsigned int totalSize;
+	memcpy(&totalSize, byteCode.data() + 24, sizeof(totalSize));
+
+	return totalSize == byteCode.size();
+}
+
+
+/*******************************************************************************************************************
+	Function that returns when a shader source file was last written to (zero if it can't be found)
+*******************************************************************************************************************/
+FILETIME ShaderManager::GetLastWriteTime(const std::wstring& fileLocation)
+{
+	FILETIME lastWriteTime = { 0 };
+
+	WIN32_FILE_ATTRIBUTE_DATA attributes;
+	if (GetFileAttributesExW((ShaderConstants::Directory + fileLocation).c_str(), GetFileExInfoStandard, &attributes)) {
+		lastWriteTime = attributes.ftLastWriteTime;
+	}
+
+	return lastWriteTime;
+}
+
+
+/*******************************************************************************************************************
+	Function that hashes a block of memory (64-bit FNV-1a) - pass the previous result in to chain hashes together
+*******************************************************************************************************************/
+unsigned long long ShaderManager::Hash(const void* data, size_t size, unsigned long long hash)
+{
+	const unsigned char* bytes = (const unsigned char*)data;
+
+	for (size_t i = 0; i < size; i++) {
+		hash ^= bytes[i];
+		hash *= 1099511628211ULL;
+	}
+
+	return hash;
+}
+
+
+/*******************************************************************************************************************
+	Function that builds the cache key for a shader variant - file|entry point|NAME=VALUE;NAME=VALUE;
+*******************************************************************************************************************/
+std::string ShaderManager::GenerateKey(const std::wstring& fileLocation, const std::string& entryPoint, const ShaderDefines& defines)
+{
+	std::string key = ToString(fileLocation) + "|" + entryPoint + "|";
+
+	//-------------------------------------------- The defines are held in a sorted map, so the same set always produces the same key
+	for (auto& define : defines) { key += define.first + "=" + define.second + ";"; }
+
+	return key;
+}
+
+
+/*******************************************************************************************************************
+	Function that converts a wide file name into a multi-byte string (the project uses the multi-byte character set)
+*******************************************************************************************************************/
+std::string ShaderManager::ToString(const std::wstring& text)
+{
+	if (text.empty()) { return std::string(); }
+
+	int size = WideCharToMultiByte(CP_ACP, 0, text.c_str(), (int)text.size(), nullptr, 0, nullptr, nullptr);
+
+	std::string result(size, '\0');
+	WideCharToMultiByte(CP_ACP, 0, text.c_str(), (int)text.size(), &result[0], size, nullptr, nullptr);
+
+	return result;
+}
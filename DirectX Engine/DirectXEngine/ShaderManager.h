@@ -0,0 +1,140 @@
+#pragma once
+
+/*******************************************************************************************************************
+	ShaderManager.h, ShaderManager.cpp
+	Created by Kim Kane
+	Last updated: 19/10/2026
+
+	Singleton class that compiles each shader variant once and hands out shared references to it.
+
+	Shader stages are keyed by file, entry point and preprocessor defines, so every object using the same
+	variant shares one compiled vertex shader, pixel shader and input layout. Whole shader programs
+	(BasicShader, TerrainShader, etc.) are cached the same way, so creating a game object no longer compiles
+	anything or allocates any GPU memory - cost is O(shader variants) rather than O(objects).
+
+	Compiled byte code is also cached on disk (Assets\Shaders\Cache), keyed by a hash of the shader source,
+	entry point, profile and defines. After the first run the HLSL compiler is never invoked - the blobs are
+	loaded straight from disk - and compilation only happens when a source file or its defines have changed.
+	In debug builds ReloadModifiedShaders() watches the source files and hot-reloads any that are edited.
+
+	The caches are locked, as shaders are reloaded on the render thread while game states (and the programs
+	they ask for) are created on the main thread. The lock is only taken when a shader or program is looked
+	up or made, never while drawing.
+
+	All cached resources are owned by the manager and released in Shutdown(), before the device goes away.
+
+*******************************************************************************************************************/
+#include <d3d11.h>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <typeinfo>
+
+#include "Singleton.h"
+#include "ShaderProgram.h"
+
+typedef std::map<std::string, std::string> ShaderDefines;
+
+class ShaderManager {
+
+public:
+	friend class Singleton<ShaderManager>;
+
+public:
+	void Shutdown();
+
+#if DEBUG_MODE == 1
+	void ReloadModifiedShaders();
+#endif
+
+public:
+	ID3D11VertexShader* GetVertexShader(const std::wstring& fileLocation, const std::string& entryPoint = "VertexMain", const ShaderDefines& defines = ShaderDefines());
+	ID3D11PixelShader* GetPixelShader(const std::wstring& fileLocation, const std::string& entryPoint = "PixelMain", const ShaderDefines& defines = ShaderDefines());
+	ID3D11InputLayout* GetInputLayout(ID3D11VertexShader* vertexShader, const D3D11_INPUT_ELEMENT_DESC* layout, unsigned int elementCount);
+
+	template <class T> T* GetProgram(const std::wstring& vertexFileLocation, const std::wstring& pixelFileLocation);
+
+private:
+	struct CompiledShader
+	{
+		std::wstring		fileLocation;
+		std::string			entryPoint;
+		const char*			profile;
+		ShaderDefines		defines;
+		FILETIME			lastWriteTime;
+
+		ID3D10Blob*			byteCode;
+		ID3D11DeviceChild*	shader;
+	};
+
+	struct CachedProgram
+	{
+		std::wstring					vertexFileLocation;
+		std::wstring					pixelFileLocation;
+		std::unique_ptr<ShaderProgram>	program;
+	};
+
+private:
+	ID3D11DeviceChild* GetShader(const std::wstring& fileLocation, const std::string& entryPoint, const char* profile, const ShaderDefines& defines);
+	bool CreateShader(CompiledShader& shader, bool reportErrors);
+	HRESULT CreateStage(CompiledShader& shader, ID3D10Blob* byteCode);
+	bool LoadByteCode(const CompiledShader& shader, ID3D10Blob** byteCode, bool reportErrors, bool useCache, std::string& cacheFile, bool& isCached);
+	void OutputShaderErrorMessage(ID3D10Blob* errorMessage, const std::string& fileLocation, bool reportErrors);
+
+	static bool ReadBinaryFile(const std::string& fileLocation, std::string& data);
+	static bool WriteBinaryFile(const std::string& fileLocation, const void* data, size_t size);
+	static bool IsByteCodeComplete(const std::string& byteCode);
+	static FILETIME GetLastWriteTime(const std::wstring& fileLocation);
+	static unsigned long long Hash(const void* data, size_t size, unsigned long long hash = 14695981039346656037ULL);
+
+	static std::string GenerateKey(const std::wstring& fileLocation, const std::string& entryPoint, const ShaderDefines& defines);
+	static std::string ToString(const std::wstring& text);
+
+private:
+	ShaderManager();
+	ShaderManager(const ShaderManager&);
+	ShaderManager& operator=(const ShaderManager&) {}
+
+private:
+	std::map<std::string, CompiledShader>				m_shaders;
+	std::map<ID3D11VertexShader*, ID3D11InputLayout*>	m_layouts;
+	std::map<std::string, CachedProgram>				m_programs;
+
+	unsigned long long									m_lastReloadCheck;
+
+	//-------------------------------------------- Recursive, as reloading a program asks for its shaders again
+	std::recursive_mutex								m_mutex;
+};
+
+typedef Singleton<ShaderManager> Shaders;
+
+
+/*******************************************************************************************************************
+	Function that returns a shared shader program, loading it the first time it is requested
+*******************************************************************************************************************/
+template <class T> T* ShaderManager::GetProgram(const std::wstring& vertexFileLocation, const std::wstring& pixelFileLocation)
+{
+	std::string key = std::string(typeid(T).name()) + "|" + ToString(vertexFileLocation) + "|" + ToString(pixelFileLocation);
+
+	std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
+	auto program = m_programs.find(key);
+	if (program != m_programs.end()) { return static_cast<T*>(program->second.program.get()); }
+
+	//-------------------------------------------- First request for this program, so load it in and keep hold of it for everyone else
+	std::unique_ptr<T> newProgram(new T());
+	if (!newProgram->LoadShader(vertexFileLocation, pixelFileLocation)) { return nullptr; }
+
+	T* sharedProgram = newProgram.get();
+
+	//-------------------------------------------- Give each program a small id, the render queue sorts draws by it
+	sharedProgram->SetSortId((unsigned int)m_programs.size() + 1);
+
+	CachedProgram& cachedProgram		= m_programs[key];
+	cachedProgram.vertexFileLocation	= vertexFileLocation;
+	cachedProgram.pixelFileLocation		= pixelFileLocation;
+	cachedProgram.program				= std::move(newProgram);
+
+	return sharedProgram;
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+/*******************************************************************************************************************
+	ShaderProgram.h
+	Created by Kim Kane
+	Last updated: 19/10/2026
+
+	Base class for all vertex/pixel shader pairs (basic, terrain, text, etc.).
+	Gives the shader manager one type it can cache and destroy, regardless of which shader it is holding,
+	and gives the render queue one way to bind any shader - split into the program itself, its texture and
+	the per-object constants, so each part is only bound when it actually changes.
+	Everything is bound through a RenderContext, so a shader can be used from any render thread.
+
+*******************************************************************************************************************/
+#include <string>
+
+class Camera;
+class Texture;
+class RenderContext;
+struct RenderCommand;
+
+class ShaderProgram {
+
+public:
+	ShaderProgram() : m_sortId(0) {}
+	virtual ~ShaderProgram() {}
+
+public:
+	virtual bool LoadShader(const std::wstring& vertexFileLocation, const std::wstring& pixelFileLocation) = 0;
+
+public:
+	virtual void BindProgram(RenderContext& context) = 0;
+	virtual void BindTexture(RenderContext& context, Texture* texture) = 0;
+	virtual void BindObject(RenderContext& context, const RenderCommand& command, Camera* camera) = 0;
+
+public:
+	unsigned int GetSortId() const		{ return m_sortId; }
+	void SetSortId(unsigned int sortId)	{ m_sortId = sortId; }
+
+private:
+	unsigned int m_sortId;
+};
@@ -1,56 +1,49 @@
 #pragma once
 
 /*******************************************************************************************************************
-	Singleton.h, Singleton.cpp
+	Singleton.h
 	Created by Kim Kane
-	Last updated: 06/01/2018
+	Last updated: 19/10/2026
 	Class finalized: 18/01/1018
 
-	A thread-safe singleton class that generates one instance of a template object on the heap.
-	
-	I use a Windows defined CRITICAL_SECTION for the following reasons:
-	A critical section object provides synchronization similar to that provided by a mutex object,
-	except that a critical section can be used only by the threads of a single process. 
-	Critical section objects cannot be shared across processes.
+	A singleton class that holds one instance of a template object on the heap.
 
-	Event, mutex, and semaphore objects can also be used in a single-process application,
-	but critical section objects provide a slightly faster, more efficient mechanism for mutual-exclusion synchronization 
-	(a processor-specific test and set instruction). Like a mutex object, a critical section object can be owned by only 
-	one thread at a time, which makes it useful for protecting a shared resource from simultaneous access. 
+	The instance is made with Create() and deleted with Destroy(), both called from the main thread before any
+	other thread starts and after they have all stopped (see Main.cpp, which creates every manager in the order
+	they depend on each other and destroys them in the opposite order). In between, Instance() is nothing more
+	than reading a pointer - there is no lock, and nothing is checked in a release build.
 
-	Using a critical section, I am able to generate a lock and unlock mechanism.
-	This means that in the event of using multiple threads, if both threads try to access the Instance() function
-	at the same time, only one instance will ever be created due to the lock and unlock procedures.
+	I used to lock a Windows CRITICAL_SECTION around a function-local static on every call to Instance(), so
+	only one instance could ever be made if two threads got there at the same time. But the managers are used
+	many times per draw and per line of a file, and they all exist for the whole game anyway, so making them up
+	front at a known point is both cheaper and clearer - it also means they're destroyed at a known point, rather
+	than whenever the program's statics are.
 
-	Effectively, the first thread to reach the lock will create the instance. The other thread will 'wait'
-	for the lock to be unlocked, and then as the instance has already been created, will just return that instance.
+	As the instance is there from Create() until Destroy(), anything that's used a lot (on the render thread
+	especially) can keep hold of the pointer, or of the device and context the manager hands out.
 
-	I am also using an unique_ptr* to eliminate memory leaks, as we create the singleton object on the heap.
-
-	*std::unique_ptr is responsible for managing dynamically allocated memory and automatically 
-	 calls delete to free the dynamic memory when the unique_ptr is destroyed or goes out of scope.
+	In debug mode, Instance() checks the instance is there - it logs an error and breaks in to the debugger if
+	the singleton hasn't been created yet, or has already been destroyed.
 
 *******************************************************************************************************************/
-#define WIN32_LEAN_AND_MEAN
-#include <Windows.h>
-#include <memory>
+#if defined(_WIN32)
+	#define WIN32_LEAN_AND_MEAN
 
-class CriticalSection : public CRITICAL_SECTION {
+	#include <Windows.h>
+#endif
 
-public:
-	CriticalSection()	{ InitializeCriticalSection(this); }
-	~CriticalSection()	{ DeleteCriticalSection(this); }
+#include <typeinfo>
 
-private:
-	CriticalSection(CriticalSection const&)				= delete;
-	CriticalSection& operator=(CriticalSection const&)	= delete;
-};
+#include "Log.h"
 
 template <class T>
 class Singleton {
 
 public:
 	static T* Instance();
+	static T* Create();
+	static void Destroy();
+	static bool Exists();
 
 private:
 	Singleton()								= default;
@@ -58,22 +51,86 @@ private:
 	Singleton(Singleton const&)				= delete;
 	Singleton& operator=(Singleton const&)	= delete;
 
-	static CriticalSection s_singletonLock;
+#if DEBUG_MODE == 1
+	static void ReportMissing();
+#endif
+
+	static T* s_singletonObject;
+
+#if DEBUG_MODE == 1
+	static bool s_isDestroyed;
+#endif
 };
 
 /*******************************************************************************************************************
-	Create a static lock object, which is initialized before main() is called
+	Static variables initialization - the pointer is set to null before main() is called
+*******************************************************************************************************************/
+template <class T> T* Singleton<T>::s_singletonObject = nullptr;
+
+#if DEBUG_MODE == 1
+	template <class T> bool Singleton<T>::s_isDestroyed = false;
+#endif
+
+/*******************************************************************************************************************
+	Return the instance - only valid between Create() and Destroy()
+*******************************************************************************************************************/
+template <class T> inline T* Singleton<T>::Instance()
+{
+#if DEBUG_MODE == 1
+	if (!s_singletonObject) { ReportMissing(); }
+#endif
+
+	return s_singletonObject;
+}
+
+/*******************************************************************************************************************
+	Create the instance on the heap - main thread only, before anything uses it
+*******************************************************************************************************************/
+template <class T> T* Singleton<T>::Create()
+{
+	if (!s_singletonObject) { s_singletonObject = new T(); }
+
+#if DEBUG_MODE == 1
+	s_isDestroyed = false;
+#endif
+
+	return s_singletonObject;
+}
+
+/*******************************************************************************************************************
+	Delete the instance - main thread only, once nothing is using it anymore
 *******************************************************************************************************************/
-template <class T> CriticalSection Singleton<T>::s_singletonLock;
+template <class T> void Singleton<T>::Destroy()
+{
+	delete s_singletonObject;
+	s_singletonObject = nullptr;
+
+#if DEBUG_MODE == 1
+	s_isDestroyed = true;
+#endif
+}
 
 /*******************************************************************************************************************
-	Lock the procedure, check to see if we need to create a new instance, then unlock procedure
+	Check whether the instance is there, without the debug check Instance() makes
 *******************************************************************************************************************/
-template <class T> T* Singleton<T>::Instance()
+template <class T> inline bool Singleton<T>::Exists()
 {
-	EnterCriticalSection(&s_singletonLock);
-		static std::unique_ptr<T> s_singletonObject(new T());
-	LeaveCriticalSection(&s_singletonLock);
+	return s_singletonObject != nullptr;
+}
+
+#if DEBUG_MODE == 1
+/*******************************************************************************************************************
+	Log which singleton was used when it wasn't there, then stop in the debugger
+*******************************************************************************************************************/
+template <class T> void Singleton<T>::ReportMissing()
+{
+	if (s_isDestroyed)	{ DX_LOG("[SINGLETON] Used after it was destroyed: ", typeid(T).name(), LOG_ERROR); }
+	else				{ DX_LOG("[SINGLETON] Used before it was created: ", typeid(T).name(), LOG_ERROR); }
+
+	Logger::Flush();
 
-	return s_singletonObject.get();
-}
\ No newline at end of file
+#if defined(_WIN32)
+	__debugbreak();
+#endif
+}
+#endif
@@ -0,0 +1,299 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+#include "SkeletalClip.h"
+#include "Log.h"
+
+using namespace SkeletonFormat;
+
+
+/*******************************************************************************************************************
+	Constructor with initializer list to set all default values of variables
+*******************************************************************************************************************/
+SkeletalClip::SkeletalClip()
+{
+	memset(&m_header, 0, sizeof(m_header));
+}
+
+
+/*******************************************************************************************************************
+	Shut down all necessary procedures, release resources and clean up memory
+*******************************************************************************************************************/
+SkeletalClip::~SkeletalClip()
+{
+}
+
+
+/*******************************************************************************************************************
+	Function that quantizes a clip from every joint's local pose on every frame, stored frame by frame
+*******************************************************************************************************************/
+bool SkeletalClip::Create(unsigned int jointCount, unsigned int frameCount, float frameRate, const std::vector<JointPose>& keys)
+{
+	if (jointCount == 0 || frameCount == 0 || frameRate <= 0.0f || keys.size() != jointCount * frameCount) {
+		DX_LOG("[SKELETAL CLIP] A clip needs a key for every joint on every frame, and a frame rate", DX_LOG_EMPTY, LOG_ERROR); return false;
+	}
+
+	memset(&m_header, 0, sizeof(m_header));
+	m_header.magic				= SkeletonFormat::ClipMagic;
+	m_header.version			= SkeletonFormat::Version;
+	m_header.jointCount			= jointCount;
+	m_header.frameCount			= frameCount;
+	m_header.frameRate			= frameRate;
+	m_header.rotationOffset		= sizeof(ClipHeader);
+	m_header.translationOffset	= m_header.rotationOffset + keys.size() * sizeof(ClipRotation);
+
+	//-------------------------------------------- Translations are spread across the box holding all of them, so find it first
+	XMFLOAT3 minimum = keys[0].translation;
+	XMFLOAT3 maximum = minimum;
+
+	for (unsigned int i = 0; i < keys.size(); i++) {
+		minimum.x = (std::min)(minimum.x, keys[i].translation.x);	maximum.x = (std::max)(maximum.x, keys[i].translation.x);
+		minimum.y = (std::min)(minimum.y, keys[i].translation.y);	maximum.y = (std::max)(maximum.y, keys[i].translation.y);
+		minimum.z = (std::min)(minimum.z, keys[i].translation.z);	maximum.z = (std::max)(maximum.z, keys[i].translation.z);
+	}
+
+	//-------------------------------------------- An axis that never moves still needs a size to divide by - every key sits at 0 on it anyway
+	m_header.translationMin[0]	= minimum.x;
+	m_header.translationMin[1]	= minimum.y;
+	m_header.translationMin[2]	= minimum.z;
+	m_header.translationSize[0]	= (maximum.x > minimum.x) ? maximum.x - minimum.x : 1.0f;
+	m_header.translationSize[1]	= (maximum.y > minimum.y) ? maximum.y - minimum.y : 1.0f;
+	m_header.translationSize[2]	= (maximum.z > minimum.z) ? maximum.z - minimum.z : 1.0f;
+
+	m_rotations.resize(keys.size());
+	m_translations.resize(keys.size());
+
+	for (unsigned int i = 0; i < keys.size(); i++) {
+		EncodeRotation(keys[i].rotation, m_rotations[i]);
+		EncodeTranslation(keys[i].translation, m_translations[i]);
+	}
+
+	return true;
+}
+
+
+/*******************************************************************************************************************
+	Function that loads a clip file
+*******************************************************************************************************************/
+bool SkeletalClip::Load(const std::string& fileLocation)
+{
+	std::ifstream file(fileLocation, std::ios::in | std::ios::binary);
+	if (!file.is_open()) { DX_LOG("[SKELETAL CLIP] Couldn't open clip file: ", fileLocation.c_str(), LOG_ERROR); return false; }
+
+	std::stringstream contents;
+	contents << file.rdbuf();
+	std::string data = contents.str();
+
+	if (data.size() < sizeof(ClipHeader)) {
+		DX_LOG("[SKELETAL CLIP] Clip file is too small: ", fileLocation.c_str(), LOG_ERROR); return false;
+	}
+
+	ClipHeader header;
+	memcpy(&header, data.data(), sizeof(header));
+
+	unsigned long long keyCount			= (unsigned long long)header.jointCount * header.frameCount;
+	unsigned long long rotationEnd		= header.rotationOffset + keyCount * sizeof(ClipRotation);
+	unsigned long long translationEnd	= header.translationOffset + keyCount * sizeof(ClipTranslation);
+
+	if (header.magic != SkeletonFormat::ClipMagic || header.version != SkeletonFormat::Version ||
+		keyCount == 0 || header.frameRate <= 0.0f || rotationEnd > data.size() || translationEnd > data.size()) {
+		DX_LOG("[SKELETAL CLIP] Clip file is corrupt or out of date: ", fileLocation.c_str(), LOG_ERROR); return false;
+	}
+
+	m_header = header;
+
+	m_rotations.resize((size_t)keyCount);
+	m_translations.resize((size_t)keyCount);
+
+	memcpy(&m_rotations[0], data.data() + header.rotationOffset, (size_t)keyCount * sizeof(ClipRotation));
+	memcpy(&m_translations[0], data.data() + header.translationOffset, (size_t)keyCount * sizeof(ClipTranslation));
+
+	return true;
+}
+
+
+/*******************************************************************************************************************
+	Function that writes the clip out to a file
+*******************************************************************************************************************/
+bool SkeletalClip::Save(const std::string& fileLocation) const
+{
+	if (m_rotations.empty()) { return false; }
+
+	std::ofstream file(fileLocation, std::ios::out | std::ios::binary | std::ios::trunc);
+	if (!file.is_open()) { return false; }
+
+	file.write((const char*)&m_header, sizeof(m_header));
+	file.write((const char*)&m_rotations[0], m_rotations.size() * sizeof(ClipRotation));
+	file.write((const char*)&m_translations[0], m_translations.size() * sizeof(ClipTranslation));
+
+	return file.good();
+}
+
+
+/*******************************************************************************************************************
+	Function that gives every joint's local pose at the time given - the clip loops, blending its last frame in to its first
+*******************************************************************************************************************/
+void SkeletalClip::Sample(float time, JointPose* localPose) const
+{
+	if (m_rotations.empty()) { return; }
+
+	float frame = fmodf(time * m_header.frameRate, (float)m_header.frameCount);
+	if (frame < 0.0f) { frame += (float)m_header.frameCount; }
+
+	unsigned int frameA	= (std::min)((unsigned int)frame, m_header.frameCount - 1);
+	unsigned int frameB	= (frameA + 1) % m_header.frameCount;
+	float blend			= frame - (float)frameA;
+
+	const ClipRotation* rotationsA			= &m_rotations[frameA * m_header.jointCount];
+	const ClipRotation* rotationsB			= &m_rotations[frameB * m_header.jointCount];
+	const ClipTranslation* translationsA	= &m_translations[frameA * m_header.jointCount];
+	const ClipTranslation* translationsB	= &m_translations[frameB * m_header.jointCount];
+
+	XMVECTOR weight = XMVectorReplicate(blend);
+
+	for (unsigned int i = 0; i < m_header.jointCount; i++) {
+		XMVECTOR rotationA = DecodeRotation(rotationsA[i]);
+		XMVECTOR rotationB = DecodeRotation(rotationsB[i]);
+
+		//-------------------------------------------- Take the shorter way round - q and -q are the same rotation, but lerp between them passes through nothing
+		if (XMVectorGetX(XMVector4Dot(rotationA, rotationB)) < 0.0f) { rotationB = XMVectorNegate(rotationB); }
+
+		XMVECTOR translationA = DecodeTranslation(translationsA[i]);
+		XMVECTOR translationB = DecodeTranslation(translationsB[i]);
+
+		XMStoreFloat4(&localPose[i].rotation, XMQuaternionNormalize(XMVectorLerpV(rotationA, rotationB, weight)));
+		XMStoreFloat3(&localPose[i].translation, XMVectorLerpV(translationA, translationB, weight));
+	}
+}
+
+
+/*******************************************************************************************************************
+	Function that blends two local poses - weight 0 gives the first, 1 gives the second
+*******************************************************************************************************************/
+void SkeletalClip::Blend(const JointPose* first, const JointPose* second, float weight, unsigned int jointCount, JointPose* localPose)
+{
+	XMVECTOR blend = XMVectorReplicate(weight);
+
+	for (unsigned int i = 0; i < jointCount; i++) {
+		XMVECTOR rotationA = XMLoadFloat4(&first[i].rotation);
+		XMVECTOR rotationB = XMLoadFloat4(&second[i].rotation);
+
+		if (XMVectorGetX(XMVector4Dot(rotationA, rotationB)) < 0.0f) { rotationB = XMVectorNegate(rotationB); }
+
+		XMVECTOR translationA = XMLoadFloat3(&first[i].translation);
+		XMVECTOR translationB = XMLoadFloat3(&second[i].translation);
+
+		XMStoreFloat4(&localPose[i].rotation, XMQuaternionNormalize(XMVectorLerpV(rotationA, rotationB, blend)));
+		XMStoreFloat3(&localPose[i].translation, XMVectorLerpV(translationA, translationB, blend));
+	}
+}
+
+
+/*******************************************************************************************************************
+	Function that packs a rotation as its three smallest components, with the index of the one left out
+*******************************************************************************************************************/
+void SkeletalClip::EncodeRotation(const XMFLOAT4& rotation, ClipRotation& key) const
+{
+	XMFLOAT4 unit;
+	XMStoreFloat4(&unit, XMQuaternionNormalize(XMLoadFloat4(&rotation)));
+
+	float components[4] = { unit.x, unit.y, unit.z, unit.w };
+
+	unsigned int largest = 0;
+	for (unsigned int i = 1; i < 4; i++) {
+		if (fabsf(components[i]) > fabsf(components[largest])) { largest = i; }
+	}
+
+	//-------------------------------------------- Make the largest positive, so only its size needs rebuilding
+	float sign = (components[largest] < 0.0f) ? -1.0f : 1.0f;
+
+	unsigned long long bits = largest;
+	unsigned int shift = 2;
+
+	for (unsigned int i = 0; i < 4; i++) {
+		if (i == largest) { continue; }
+
+		float value = (components[i] * sign + RotationRange) / (2.0f * RotationRange);
+		value = (std::min)((std::max)(value, 0.0f), 1.0f);
+
+		bits |= (unsigned long long)(unsigned int)(value * RotationMax + 0.5f) << shift;
+		shift += RotationBits;
+	}
+
+	key.low		= (unsigned int)(bits & 0xFFFFFFFF);
+	key.high	= (unsigned int)(bits >> 32);
+}
+
+
+/*******************************************************************************************************************
+	Function that packs a translation as 16 bits per axis inside the clip's box
+*******************************************************************************************************************/
+void SkeletalClip::EncodeTranslation(const XMFLOAT3& translation, ClipTranslation& key) const
+{
+	float values[3] = { translation.x, translation.y, translation.z };
+	unsigned short packed[3];
+
+	for (unsigned int i = 0; i < 3; i++) {
+		float value = (values[i] - m_header.translationMin[i]) / m_header.translationSize[i];
+		value = (std::min)((std::max)(value, 0.0f), 1.0f);
+
+		packed[i] = (unsigned short)(value * TranslationMax + 0.5f);
+	}
+
+	key.x = packed[0];
+	key.y = packed[1];
+	key.z = packed[2];
+}
+
+
+/*******************************************************************************************************************
+	Function that unpacks a rotation, rebuilding the component that was left out
+*******************************************************************************************************************/
+XMVECTOR SkeletalClip::DecodeRotation(const ClipRotation& key) const
+{
+	unsigned long long bits = (unsigned long long)key.low | ((unsigned long long)key.high << 32);
+
+	unsigned int largest = (unsigned int)(bits & 3);
+	const float scale = (2.0f * RotationRange) / RotationMax;
+
+	float components[4];
+	float sum = 0.0f;
+	unsigned int shift = 2;
+
+	for (unsigned int i = 0; i < 4; i++) {
+		if (i == largest) { continue; }
+
+		components[i] = (float)((bits >> shift) & RotationMax) * scale - RotationRange;
+		sum += components[i] * components[i];
+		shift += RotationBits;
+	}
+
+	components[largest] = sqrtf((std::max)(1.0f - sum, 0.0f));
+
+	return XMVectorSet(components[0], components[1], components[2], components[3]);
+}
+
+
+/*******************************************************************************************************************
+	Function that unpacks a translation
+*******************************************************************************************************************/
+XMVECTOR SkeletalClip::DecodeTranslation(const ClipTranslation& key) const
+{
+	const float scale = 1.0f / TranslationMax;
+
+	return XMVectorSet(m_header.translationMin[0] + key.x * scale * m_header.translationSize[0],
+					   m_header.translationMin[1] + key.y * scale * m_header.translationSize[1],
+					   m_header.translationMin[2] + key.z * scale * m_header.translationSize[2], 0.0f);
+}
+
+
+/*******************************************************************************************************************
+	Accessor Methods
+*******************************************************************************************************************/
+unsigned int SkeletalClip::GetJointCount() const	{ return m_header.jointCount; }
+unsigned int SkeletalClip::GetFrameCount() const	{ return m_header.frameCount; }
+float SkeletalClip::GetFrameRate() const			{ return m_header.frameRate; }
+float SkeletalClip::GetDuration() const				{ return (m_header.frameRate > 0.0f) ? (float)m_header.frameCount / m_header.frameRate : 0.0f; }
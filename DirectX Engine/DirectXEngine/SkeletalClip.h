@@ -0,0 +1,63 @@
+#pragma once
+
+/*******************************************************************************************************************
+	SkeletalClip.h, SkeletalClip.cpp
+	Created by Kim Kane
+	Last updated: 19/10/2026
+
+	One skeletal animation - every joint's rotation and translation on every frame, quantized (see
+	SkeletonFormat.h). A clip is never changed once made, so any number of characters can play it at once.
+
+	Sample() gives the local pose at any time, blending the two frames either side of it: translations are
+	lerped and rotations are nlerped (normalized after a lerp, taking the shorter way round), which is close
+	enough to a slerp between frames this near each other and far cheaper. Blend() mixes two poses the same way,
+	which is how one clip cross-fades in to another.
+
+	Nothing here needs the graphics device, so clips can be made, saved, loaded and sampled on their own.
+
+*******************************************************************************************************************/
+#include <d3d11.h>
+#include <xnamath.h>
+#include <string>
+#include <vector>
+
+#include "Skeleton.h"
+
+class SkeletalClip {
+
+public:
+	SkeletalClip();
+	~SkeletalClip();
+
+public:
+	bool Create(unsigned int jointCount, unsigned int frameCount, float frameRate, const std::vector<JointPose>& keys);
+	bool Load(const std::string& fileLocation);
+	bool Save(const std::string& fileLocation) const;
+
+public:
+	void Sample(float time, JointPose* localPose) const;
+	static void Blend(const JointPose* first, const JointPose* second, float weight, unsigned int jointCount, JointPose* localPose);
+
+public:
+	unsigned int GetJointCount() const;
+	unsigned int GetFrameCount() const;
+	float GetFrameRate() const;
+	float GetDuration() const;
+
+private:
+	SkeletalClip(const SkeletalClip&);
+	SkeletalClip& operator=(const SkeletalClip&);
+
+private:
+	void EncodeRotation(const XMFLOAT4& rotation, ClipRotation& key) const;
+	void EncodeTranslation(const XMFLOAT3& translation, ClipTranslation& key) const;
+	XMVECTOR DecodeRotation(const ClipRotation& key) const;
+	XMVECTOR DecodeTranslation(const ClipTranslation& key) const;
+
+private:
+	ClipHeader						m_header;
+
+	//-------------------------------------------- Frame by frame - every joint's key for frame 0, then every joint's key for frame 1, etc.
+	std::vector<ClipRotation>		m_rotations;
+	std::vector<ClipTranslation>	m_translations;
+};
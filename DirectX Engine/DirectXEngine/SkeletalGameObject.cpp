@@ -0,0 +1,134 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Headers
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+#include "SkeletalGameObject.h"
+#include "SkinnedShader.h"
+#include "ShaderManager.h"
+#include "RenderContext.h"
+#include "Buffer.h"
+#include "Log.h"
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+SkeletalGameObject::SkeletalGameObject(const XMFLOAT3& Position, const Skeleton* Skeleton, const Buffer* Mesh, Texture* texture) :
+	GameObject(Position, nullptr, texture),
+	_Skeleton(Skeleton),
+	_Mesh(Mesh),
+	_Clip(nullptr),
+	_Time(0.0f),
+	_FadeClip(nullptr),
+	_FadeClipTime(0.0f),
+	_Fade(0.0f),
+	_FadeTime(0.0f),
+	_Speed(1.0f)
+{
+	_SkinnedShader = Shaders::Instance()->GetProgram<SkinnedShader>(L"skinnedShader.vs", L"basicShader.ps");
+
+	//Draw in the bind pose until a clip is played
+	for (unsigned int i = 0; i < SkinningConstants::MaxJoints; i++)
+	{
+		XMStoreFloat4x4(&_Palette[i], XMMatrixIdentity());
+	}
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+SkeletalGameObject::~SkeletalGameObject()
+{
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+bool SkeletalGameObject::Play(const SkeletalClip* Clip, float FadeTime)
+{
+	if (Clip && (!_Skeleton || Clip->GetJointCount() != _Skeleton->GetJointCount()))
+	{
+		DX_LOG("[SKELETAL OBJECT] Clip was made for a different skeleton", DX_LOG_EMPTY, LOG_ERROR);
+		return false;
+	}
+
+	//Only fade if there is something to fade out of - otherwise the new clip starts at full weight
+	if (_Clip && Clip && FadeTime > 0.0f)
+	{
+		_FadeClip = _Clip;
+		_FadeClipTime = _Time;
+		_Fade = 0.0f;
+		_FadeTime = FadeTime;
+	}
+	else
+	{
+		_FadeClip = nullptr;
+	}
+
+	_Clip = Clip;
+	_Time = 0.0f;
+
+	return true;
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+void SkeletalGameObject::SetSpeed(float Speed)
+{
+	_Speed = Speed;
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+void SkeletalGameObject::Animate(float DeltaTime)
+{
+	if (!_Clip || !_Skeleton) { return; }
+
+	//Clips loop when sampled, so the times just keep running
+	_Time += DeltaTime * _Speed;
+
+	JointPose localPose[SkinningConstants::MaxJoints];
+	_Clip->Sample(_Time, localPose);
+
+	if (_FadeClip)
+	{
+		_FadeClipTime += DeltaTime * _Speed;
+		_Fade += DeltaTime;
+
+		if (_Fade >= _FadeTime)
+		{
+			_FadeClip = nullptr;
+		}
+		else
+		{
+			JointPose fadePose[SkinningConstants::MaxJoints];
+			_FadeClip->Sample(_FadeClipTime, fadePose);
+			SkeletalClip::Blend(fadePose, localPose, _Fade / _FadeTime, _Skeleton->GetJointCount(), localPose);
+		}
+	}
+
+	XMFLOAT4X4 modelPose[SkinningConstants::MaxJoints];
+	_Skeleton->LocalToModel(localPose, modelPose);
+	_Skeleton->BuildPalette(modelPose, _Palette);
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+const SkeletalClip* SkeletalGameObject::GetClip() const
+{
+	return _Clip;
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+const XMFLOAT4X4* SkeletalGameObject::GetPalette() const
+{
+	return _Palette;
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+void SkeletalGameObject::Submit(RenderQueue& Queue)
+{
+	if (!_SkinnedShader || !_Mesh) { return; }
+
+	Queue.Submit(LAYER_OPAQUE, _SkinnedShader, GetTexture(), this, GetWorldMatrix(), GetPositionF(),
+				 XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f), _Palette, sizeof(_Palette));
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+void SkeletalGameObject::Render(RenderContext& Context, const void* Data) const
+{
+	//The whole palette goes up, so the buffer is always the size the shader declares - rows are already in the order HLSL expects
+	//It's the copy made at submit, as Animate() may be rebuilding _Palette for the next frame by now
+	Context.UploadVertexConstants(1, Data, sizeof(_Palette));
+
+	_Mesh->Render(Context, sizeof(BufferConstants::PackedSkinnedVertex), 0);
+}
@@ -0,0 +1,111 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//  SkeletalGameObject.h, SkeletalGameObject.cpp
+//
+//  Created By:     Chris Hargove
+//  Last Updated:   19/10/2026
+//
+//  This class is a game object drawn as a skinned mesh, posed by a skeleton playing
+//  skeletal clips.
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+#pragma once
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Headers
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+#include "GameObject.h"
+#include "Skeleton.h"
+#include "SkeletalClip.h"
+
+class Buffer;
+class SkinnedShader;
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//  This class is a game object drawn as a skinned mesh, posed by a skeleton playing
+//  skeletal clips.
+//
+//  The skeleton, clips and mesh are shared by every character using them. Each object
+//  only keeps its own time through the clip, and its bone palette, which is rebuilt in
+//  Animate() and copied in to the render queue when the object is submitted - the next
+//  Animate() can run while the frame is still being drawn from that copy.
+//
+//  Starting a clip with a fade time cross-fades the old clip in to the new one, both
+//  playing on while the fade lasts.
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+class SkeletalGameObject : public GameObject, public Renderable
+{
+public:
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    //  Constructor
+    //  --Position-- The Objects position in the game scene.
+    //  --Skeleton-- The skeleton the mesh was skinned to.
+    //  --Mesh-- Buffer holding the mesh as skinned vertices and indices.
+    //  --texture-- Pointer to a texture for this object.
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+	SkeletalGameObject(const XMFLOAT3& Position, const Skeleton* Skeleton, const Buffer* Mesh, Texture* texture);
+
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    //  Default Destructor
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+	virtual ~SkeletalGameObject();
+
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    //  Starts playing a clip from the beginning, fading out of the current one.
+    //  --Clip-- The clip to play. Must have a key for every joint in the skeleton.
+    //  --FadeTime-- Seconds to cross-fade over, 0 to switch straight away.
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+	bool Play(const SkeletalClip* Clip, float FadeTime = 0.0f);
+
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    //  Sets how fast clips play, 1 being normal speed and negative playing backwards.
+    //  --Speed-- The new playback speed.
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+	void SetSpeed(float Speed);
+
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    //  Moves the clips on and rebuilds the bone palette. Call once per frame.
+    //  --DeltaTime-- Seconds since the last call.
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+	void Animate(float DeltaTime);
+
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    //  Gets the clip being played, or nullptr if nothing is playing.
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+	const SkeletalClip* GetClip() const;
+
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    //  Gets the bone palette from the last Animate(), one matrix per joint.
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+	const XMFLOAT4X4* GetPalette() const;
+
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    //  Adds the game object to the render queue, drawn with the skinned shader, along with
+    //  a copy of the bone palette.
+    //  --Queue--  The render queue for this frame.
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+	virtual void Submit(RenderQueue& Queue) override;
+
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    //  Uploads the bone palette and draws the mesh. Called by the queue.
+    //  --Context-- The render context to draw with.
+    //  --Data-- The palette copied in to the queue by Submit.
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+	virtual void Render(RenderContext& Context, const void* Data) const override;
+
+private:
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    //  Member Variables.
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+	const Skeleton*     _Skeleton;      // Shared joint hierarchy and bind pose
+	const Buffer*       _Mesh;          // Shared skinned vertices and indices
+	SkinnedShader*      _SkinnedShader; // Shared shader owned by the shader manager
+
+	const SkeletalClip* _Clip;          // The clip being played
+	float               _Time;          // Seconds in to the clip being played
+	const SkeletalClip* _FadeClip;      // The clip being faded out of, or nullptr
+	float               _FadeClipTime;  // Seconds in to the clip being faded out of
+	float               _Fade;          // Seconds the fade has run for
+	float               _FadeTime;      // Seconds the fade lasts
+	float               _Speed;         // Playback speed of both clips
+
+	XMFLOAT4X4          _Palette[SkinningConstants::MaxJoints]; // Bind pose to current pose, per joint
+};
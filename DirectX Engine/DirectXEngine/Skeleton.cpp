@@ -0,0 +1,245 @@
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+#include "Skeleton.h"
+#include "Constants.h"
+#include "Log.h"
+
+/*******************************************************************************************************************
+	Constructor with initializer list to set all default values of variables
+*******************************************************************************************************************/
+Skeleton::Skeleton()
+{
+}
+
+
+/*******************************************************************************************************************
+	Shut down all necessary procedures, release resources and clean up memory
+*******************************************************************************************************************/
+Skeleton::~Skeleton()
+{
+}
+
+
+/*******************************************************************************************************************
+	Function that builds a skeleton from each joint's parent (-1 for a root) and its bind pose relative to that parent
+*******************************************************************************************************************/
+bool Skeleton::Create(const std::vector<int>& parents, const std::vector<JointPose>& bindPose)
+{
+	if (parents.empty() || parents.size() != bindPose.size()) {
+		DX_LOG("[SKELETON] Every joint needs a parent and a bind pose", DX_LOG_EMPTY, LOG_ERROR); return false;
+	}
+
+	if (parents.size() > SkinningConstants::MaxJoints) {
+		DX_LOG("[SKELETON] Skeleton has more joints than fit in the bone palette", DX_LOG_EMPTY, LOG_ERROR); return false;
+	}
+
+	//-------------------------------------------- Parents have to come first, so a pose can always be built from the root down
+	for (unsigned int i = 0; i < parents.size(); i++) {
+		if (parents[i] >= (int)i || parents[i] < -1) {
+			DX_LOG("[SKELETON] A joint's parent must come before it", DX_LOG_EMPTY, LOG_ERROR); return false;
+		}
+	}
+
+	m_parents	= parents;
+	m_bindPose	= bindPose;
+
+	std::vector<XMFLOAT4X4> modelPose(m_parents.size());
+	LocalToModel(&m_bindPose[0], &modelPose[0]);
+
+	m_inverseBind.resize(m_parents.size());
+
+	for (unsigned int i = 0; i < m_parents.size(); i++) {
+		XMVECTOR determinant;
+		XMMATRIX inverse = XMMatrixInverse(&determinant, XMLoadFloat4x4(&modelPose[i]));
+		XMStoreFloat4x4(&m_inverseBind[i], inverse);
+	}
+
+	return true;
+}
+
+
+/*******************************************************************************************************************
+	Function that loads a skeleton file
+*******************************************************************************************************************/
+bool Skeleton::Load(const std::string& fileLocation)
+{
+	std::ifstream file(fileLocation, std::ios::in | std::ios::binary);
+	if (!file.is_open()) { DX_LOG("[SKELETON] Couldn't open skeleton file: ", fileLocation.c_str(), LOG_ERROR); return false; }
+
+	std::stringstream contents;
+	contents << file.rdbuf();
+	std::string data = contents.str();
+
+	if (data.size() < sizeof(SkeletonHeader)) {
+		DX_LOG("[SKELETON] Skeleton file is too small: ", fileLocation.c_str(), LOG_ERROR); return false;
+	}
+
+	SkeletonHeader header;
+	memcpy(&header, data.data(), sizeof(header));
+
+	unsigned long long jointEnd = (unsigned long long)header.jointOffset + (unsigned long long)header.jointCount * sizeof(SkeletonJoint);
+
+	if (header.magic != SkeletonFormat::SkeletonMagic || header.version != SkeletonFormat::Version || jointEnd > data.size()) {
+		DX_LOG("[SKELETON] Skeleton file is corrupt or out of date: ", fileLocation.c_str(), LOG_ERROR); return false;
+	}
+
+	std::vector<int> parents(header.jointCount);
+	std::vector<JointPose> bindPose(header.jointCount);
+
+	for (unsigned int i = 0; i < header.jointCount; i++) {
+		SkeletonJoint joint;
+		memcpy(&joint, data.data() + header.jointOffset + i * sizeof(SkeletonJoint), sizeof(joint));
+
+		parents[i]	= joint.parent;
+		bindPose[i].translation	= XMFLOAT3(joint.translation[0], joint.translation[1], joint.translation[2]);
+		bindPose[i].rotation	= XMFLOAT4(joint.rotation[0], joint.rotation[1], joint.rotation[2], joint.rotation[3]);
+	}
+
+	return Create(parents, bindPose);
+}
+
+
+/*******************************************************************************************************************
+	Function that writes the skeleton out to a file
+*******************************************************************************************************************/
+bool Skeleton::Save(const std::string& fileLocation) const
+{
+	SkeletonHeader header;
+	header.magic		= SkeletonFormat::SkeletonMagic;
+	header.version		= SkeletonFormat::Version;
+	header.jointCount	= m_parents.size();
+	header.jointOffset	= sizeof(SkeletonHeader);
+
+	std::ofstream file(fileLocation, std::ios::out | std::ios::binary | std::ios::trunc);
+	if (!file.is_open()) { return false; }
+
+	file.write((const char*)&header, sizeof(header));
+
+	for (unsigned int i = 0; i < m_parents.size(); i++) {
+		SkeletonJoint joint;
+		joint.parent			= m_parents[i];
+		joint.translation[0]	= m_bindPose[i].translation.x;
+		joint.translation[1]	= m_bindPose[i].translation.y;
+		joint.translation[2]	= m_bindPose[i].translation.z;
+		joint.rotation[0]		= m_bindPose[i].rotation.x;
+		joint.rotation[1]		= m_bindPose[i].rotation.y;
+		joint.rotation[2]		= m_bindPose[i].rotation.z;
+		joint.rotation[3]		= m_bindPose[i].rotation.w;
+
+		file.write((const char*)&joint, sizeof(joint));
+	}
+
+	return file.good();
+}
+
+
+/*******************************************************************************************************************
+	Function that turns a local pose in to each joint's transform relative to the model, one joint per entry
+*******************************************************************************************************************/
+void Skeleton::LocalToModel(const JointPose* localPose, XMFLOAT4X4* modelPose) const
+{
+	for (unsigned int i = 0; i < m_parents.size(); i++) {
+
+		//-------------------------------------------- Rotate then move, relative to the parent - which has always been done already
+		XMMATRIX local = XMMatrixRotationQuaternion(XMLoadFloat4(&localPose[i].rotation));
+		local.r[3] = XMVectorSet(localPose[i].translation.x, localPose[i].translation.y, localPose[i].translation.z, 1.0f);
+
+		if (m_parents[i] >= 0) { local = XMMatrixMultiply(local, XMLoadFloat4x4(&modelPose[m_parents[i]])); }
+
+		XMStoreFloat4x4(&modelPose[i], local);
+	}
+}
+
+
+/*******************************************************************************************************************
+	Function that builds the bone palette - the matrix that takes a vertex from its bind pose to each joint's pose
+*******************************************************************************************************************/
+void Skeleton::BuildPalette(const XMFLOAT4X4* modelPose, XMFLOAT4X4* palette) const
+{
+	for (unsigned int i = 0; i < m_parents.size(); i++) {
+		XMMATRIX skin = XMMatrixMultiply(XMLoadFloat4x4(&m_inverseBind[i]), XMLoadFloat4x4(&modelPose[i]));
+		XMStoreFloat4x4(&palette[i], skin);
+	}
+}
+
+
+/*******************************************************************************************************************
+	Function that checks every joint a vertex names is in the skeleton, and its weights add up to one - false if not
+*******************************************************************************************************************/
+bool Skeleton::CheckVertices(const BufferConstants::PackedSkinnedVertex* vertices, unsigned int vertexCount) const
+{
+	for (unsigned int i = 0; i < vertexCount; i++) {
+		unsigned int total = 0;
+
+		//-------------------------------------------- Every slot is checked, even unweighted ones - the first joint's matrix is always read
+		for (unsigned int j = 0; j < SkinningConstants::MaxInfluences; j++) {
+			if (vertices[i].joints[j] >= m_parents.size()) {
+				DX_LOG("[SKELETON] Vertex names a joint the skeleton doesn't have: ", i, LOG_ERROR); return false;
+			}
+
+			total += vertices[i].weights[j];
+		}
+
+		if (total != 255) { DX_LOG("[SKELETON] Vertex weights don't add up to 255: ", i, LOG_ERROR); return false; }
+	}
+
+	return true;
+}
+
+
+/*******************************************************************************************************************
+	Function that moves each vertex by the joints that hold it, blended by their weights - vertices must have passed
+	CheckVertices(), and the palette needs an entry for every joint
+*******************************************************************************************************************/
+void Skeleton::SkinVertices(const BufferConstants::PackedSkinnedVertex* vertices, unsigned int vertexCount, const XMFLOAT4X4* palette,
+							XMFLOAT3* positions, XMFLOAT3* normals)
+{
+	const XMVECTOR toWeight = XMVectorReplicate(1.0f / 255.0f);
+
+	for (unsigned int i = 0; i < vertexCount; i++) {
+		const BufferConstants::PackedSkinnedVertex& vertex = vertices[i];
+
+		//-------------------------------------------- Blend the joints' matrices first, so the vertex is only transformed once
+		XMVECTOR weight = XMVectorMultiply(XMVectorReplicate((float)vertex.weights[0]), toWeight);
+		XMMATRIX joint = XMLoadFloat4x4(&palette[vertex.joints[0]]);
+
+		XMVECTOR row0 = XMVectorMultiply(joint.r[0], weight);
+		XMVECTOR row1 = XMVectorMultiply(joint.r[1], weight);
+		XMVECTOR row2 = XMVectorMultiply(joint.r[2], weight);
+		XMVECTOR row3 = XMVectorMultiply(joint.r[3], weight);
+
+		for (unsigned int j = 1; j < SkinningConstants::MaxInfluences; j++) {
+			if (vertex.weights[j] == 0) { continue; }
+
+			weight = XMVectorMultiply(XMVectorReplicate((float)vertex.weights[j]), toWeight);
+			joint = XMLoadFloat4x4(&palette[vertex.joints[j]]);
+
+			row0 = XMVectorMultiplyAdd(joint.r[0], weight, row0);
+			row1 = XMVectorMultiplyAdd(joint.r[1], weight, row1);
+			row2 = XMVectorMultiplyAdd(joint.r[2], weight, row2);
+			row3 = XMVectorMultiplyAdd(joint.r[3], weight, row3);
+		}
+
+		//-------------------------------------------- Row vectors, like the rest of the engine - the position picks up the translation row, the normal doesn't
+		XMVECTOR position	= XMVectorMultiplyAdd(XMVectorReplicate(vertex.position.x), row0, row3);
+		position			= XMVectorMultiplyAdd(XMVectorReplicate(vertex.position.y), row1, position);
+		position			= XMVectorMultiplyAdd(XMVectorReplicate(vertex.position.z), row2, position);
+
+		XMVECTOR normal		= XMVectorMultiply(XMVectorReplicate(vertex.normal.x), row0);
+		normal				= XMVectorMultiplyAdd(XMVectorReplicate(vertex.normal.y), row1, normal);
+		normal				= XMVectorMultiplyAdd(XMVectorReplicate(vertex.normal.z), row2, normal);
+
+		XMStoreFloat3(&positions[i], position);
+		XMStoreFloat3(&normals[i], XMVector3Normalize(normal));
+	}
+}
+
+
+/*******************************************************************************************************************
+	Accessor Methods
+*******************************************************************************************************************/
+unsigned int Skeleton::GetJointCount() const			{ return m_parents.size(); }
+int Skeleton::GetParent(unsigned int joint) const		{ return m_parents[joint]; }
+const JointPose* Skeleton::GetBindPose() const			{ return m_bindPose.empty() ? nullptr : &m_bindPose[0]; }
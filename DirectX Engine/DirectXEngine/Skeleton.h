@@ -0,0 +1,73 @@
+#pragma once
+
+/*******************************************************************************************************************
+	Skeleton.h, Skeleton.cpp
+	Created by Kim Kane
+	Last updated: 19/10/2026
+
+	A joint hierarchy and its bind pose, shared by every character that uses it.
+
+	Each joint has a parent that comes before it, so a pose made of each joint relative to its parent (a local
+	pose - what clips store) is turned in to each joint relative to the model in one pass from the root down.
+	The bone palette is then each joint's model pose with the bind pose taken back off, which is what moves a
+	vertex from where it was modelled to where the joint has taken it.
+
+	Skinning normally happens in the vertex shader, with the palette uploaded as constants. SkinVertices() does
+	the same on the CPU, 4 floats at a time with SIMD, for anything that needs the skinned positions themselves
+	(picking, collision, tests). Neither checks the joints a vertex names, so a mesh goes through CheckVertices()
+	once, when it's loaded for a skeleton, rather than every vertex being checked every frame.
+
+	Nothing here needs the graphics device, so poses can be built and tested on their own.
+
+*******************************************************************************************************************/
+#include <d3d11.h>
+#include <xnamath.h>
+#include <string>
+#include <vector>
+
+#include "Constants.h"
+#include "SkeletonFormat.h"
+
+//-------------------------------------------- One joint's rotation and translation relative to its parent
+struct JointPose
+{
+	XMFLOAT4	rotation;
+	XMFLOAT3	translation;
+};
+
+class Skeleton {
+
+public:
+	Skeleton();
+	~Skeleton();
+
+public:
+	bool Create(const std::vector<int>& parents, const std::vector<JointPose>& bindPose);
+	bool Load(const std::string& fileLocation);
+	bool Save(const std::string& fileLocation) const;
+
+public:
+	void LocalToModel(const JointPose* localPose, XMFLOAT4X4* modelPose) const;
+	void BuildPalette(const XMFLOAT4X4* modelPose, XMFLOAT4X4* palette) const;
+
+public:
+	bool CheckVertices(const BufferConstants::PackedSkinnedVertex* vertices, unsigned int vertexCount) const;
+	static void SkinVertices(const BufferConstants::PackedSkinnedVertex* vertices, unsigned int vertexCount, const XMFLOAT4X4* palette,
+							 XMFLOAT3* positions, XMFLOAT3* normals);
+
+public:
+	unsigned int GetJointCount() const;
+	int GetParent(unsigned int joint) const;
+	const JointPose* GetBindPose() const;
+
+private:
+	Skeleton(const Skeleton&);
+	Skeleton& operator=(const Skeleton&);
+
+private:
+	std::vector<int>			m_parents;
+	std::vector<JointPose>		m_bindPose;
+
+	//-------------------------------------------- Takes a vertex from where it was modelled to where it is relative to each joint
+	std::vector<XMFLOAT4X4>		m_inverseBind;
+};
@@ -0,0 +1,78 @@
+#pragma once
+
+/*******************************************************************************************************************
+	SkeletonFormat.h
+	Created by Kim Kane
+	Last updated: 19/10/2026
+
+	The layout of skeleton and skeletal clip files, written and read by Skeleton and SkeletalClip.
+
+	A skeleton file is a header followed by one entry per joint - its parent and its bind pose relative to the
+	parent. Parents always come before their children, so a pose can be built in one pass from the root down.
+
+	A clip file is a header followed by a table of rotations, then a table of translations. Every joint has a
+	key on every frame (sampled at the clip's frame rate), stored frame by frame, so one point in time only
+	reads two runs of keys that sit next to each other.
+
+	Keys are quantized to keep clips small - 14 bytes per joint per frame rather than 28:
+		- Rotations are "smallest three" quaternions in 64 bits: the index of the largest component in the
+		  low 2 bits, then the other three in 20 bits each. The largest is rebuilt from the three, and its
+		  sign is always made positive, as q and -q are the same rotation.
+		- Translations are 16 bits per axis, spread across the box holding every translation in the clip.
+
+	Header fields are all 4 bytes, so the headers have no padding and the layout is the same in every build.
+
+*******************************************************************************************************************/
+
+namespace SkeletonFormat {
+
+	const unsigned int SkeletonMagic	= 0x4B535844;	// "DXSK"
+	const unsigned int ClipMagic		= 0x4C435844;	// "DXCL"
+	const unsigned int Version			= 1;
+
+	//-------------------------------------------- The three smallest components of a unit quaternion are never bigger than 1 / sqrt(2)
+	const unsigned int RotationBits		= 20;
+	const unsigned int RotationMax		= (1u << RotationBits) - 1;
+	const float RotationRange			= 0.70710678f;
+
+	const unsigned int TranslationMax	= 0xFFFF;
+}
+
+struct SkeletonHeader
+{
+	unsigned int	magic;
+	unsigned int	version;
+	unsigned int	jointCount;
+	unsigned int	jointOffset;
+};
+
+struct SkeletonJoint
+{
+	int				parent;
+	float			translation[3];
+	float			rotation[4];
+};
+
+struct ClipHeader
+{
+	unsigned int	magic;
+	unsigned int	version;
+	unsigned int	jointCount;
+	unsigned int	frameCount;
+	float			frameRate;
+	float			translationMin[3];
+	float			translationSize[3];
+	unsigned int	rotationOffset;
+	unsigned int	translationOffset;
+};
+
+struct ClipRotation
+{
+	unsigned int	low;
+	unsigned int	high;
+};
+
+struct ClipTranslation
+{
+	unsigned short	x, y, z;
+};
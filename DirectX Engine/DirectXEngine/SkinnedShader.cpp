@@ -0,0 +1,132 @@
+#include "SkinnedShader.h"
+#include "ScreenManager.h"
+#include "ShaderManager.h"
+#include "Camera.h"
+#include "Log.h"
+#include "Profiler.h"
+#include "Texture.h"
+#include "RenderQueue.h"
+#include "RenderContext.h"
+
+/*******************************************************************************************************************
+	Constructor with initializer list to set all default values of variables
+*******************************************************************************************************************/
+SkinnedShader::SkinnedShader()	:	m_vertexShader(nullptr),
+									m_pixelShader(nullptr),
+									m_layout(nullptr)
+{
+
+}
+
+
+/*******************************************************************************************************************
+	Shut down all necessary procedures, release resources and clean up memory
+*******************************************************************************************************************/
+SkinnedShader::~SkinnedShader()
+{
+	//-------------------------------------------- The shaders and layout belong to the shader manager, and the constant buffers to the render contexts
+}
+
+
+/*******************************************************************************************************************
+	Function that loads in a vertex and pixel shader
+*******************************************************************************************************************/
+bool SkinnedShader::LoadShader(const std::wstring& vertexFileLocation, const std::wstring& pixelFileLocation)
+{
+	//-------------------------------------------- Get the compiled shaders from the shader manager - only compiled the first time they are requested
+	m_vertexShader	= Shaders::Instance()->GetVertexShader(vertexFileLocation);
+	m_pixelShader	= Shaders::Instance()->GetPixelShader(pixelFileLocation);
+
+	if (!m_vertexShader || !m_pixelShader) {
+		DX_LOG("[SKINNED SHADER] Can't load shader files", DX_LOG_EMPTY, LOG_ERROR); return false;
+	}
+
+	//-------------------------------------------- Create the layout description - matches BufferConstants::PackedSkinnedVertex, weights come in as 0 to 1
+	D3D11_INPUT_ELEMENT_DESC layout[] = {
+		{ "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+		{ "TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+		{ "NORMAL", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+		{ "BLENDINDICES", 0, DXGI_FORMAT_R8G8B8A8_UINT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+		{ "BLENDWEIGHT", 0, DXGI_FORMAT_R8G8B8A8_UNORM, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+	};
+
+	//-------------------------------------------- Get the vertex input layout
+	m_layout = Shaders::Instance()->GetInputLayout(m_vertexShader, layout, _countof(layout));
+	if (!m_layout) {
+		DX_LOG("[SKINNED SHADER] Can't create the input layout", DX_LOG_EMPTY, LOG_ERROR); return false;
+	}
+
+	//-------------------------------------------- Generate the default sampler filter settings for the textures used within this shader
+	if (!Texture::GenerateSamplerFilters()) { return false; }
+
+	return true;
+}
+
+
+/*******************************************************************************************************************
+	Function that updates all of the constant buffers within the shader
+*******************************************************************************************************************/
+bool SkinnedShader::UpdateConstantBuffers(RenderContext& context, XMMATRIX& world, Camera* camera)
+{
+	//-------------------------------------------- Check a shader exists first before trying to update it
+	if (m_vertexShader == nullptr || m_pixelShader == nullptr) {
+		DX_LOG("[SKINNED SHADER] Trying to set constant buffers before loading in a shader file", DX_LOG_EMPTY, LOG_ERROR);
+		return false;
+	}
+
+	//-------------------------------------------- Get the model transform matrix, camera view matrix, and screen projection matrix
+	ScreenManager* screen		= Screen::Instance();
+	XMMATRIX projectionMatrix	= (screen->Is3dEnabled())	? screen->GetPerspectiveMatrix()
+															: screen->GetOrthographicMatrix();
+
+	//-------------------------------------------- Transpose these matrices to prepare them for the shader
+	MatrixBufferData data;
+	data.world			= XMMatrixTranspose(world);
+	data.view			= XMMatrixTranspose(camera->GetViewMatrix());
+	data.projection		= XMMatrixTranspose(projectionMatrix);
+
+	//-------------------------------------------- Copy the matrices in to the context's constant buffer and set it in the vertex shader
+	return context.UploadVertexConstants(0, &data, sizeof(data));
+}
+
+
+/*******************************************************************************************************************
+	Function that sets this shader, its vertex layout and sampler as active - used by the render queue once per shader change
+*******************************************************************************************************************/
+void SkinnedShader::BindProgram(RenderContext& context)
+{
+	DX_PROFILE_FUNCTION();
+
+	context.SetInputLayout(m_layout);
+	context.SetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+
+	context.SetVertexShader(m_vertexShader);
+	context.SetPixelShader(m_pixelShader);
+
+	context.SetSampler(0, *Texture::GetSampler());
+}
+
+
+/*******************************************************************************************************************
+	Function that sets the texture used by the following draws - used by the render queue once per texture change
+*******************************************************************************************************************/
+void SkinnedShader::BindTexture(RenderContext& context, Texture* texture)
+{
+	DX_PROFILE_FUNCTION();
+
+	if (texture != nullptr) {
+		context.SetShaderResource(0, *texture->GetTexture());
+	}
+}
+
+
+/*******************************************************************************************************************
+	Function that sets the per-object constants for a single queued draw
+*******************************************************************************************************************/
+void SkinnedShader::BindObject(RenderContext& context, const RenderCommand& command, Camera* camera)
+{
+	DX_PROFILE_FUNCTION();
+
+	XMMATRIX world = XMLoadFloat4x4(&command.world);
+	UpdateConstantBuffers(context, world, camera);
+}
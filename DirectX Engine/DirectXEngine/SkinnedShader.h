@@ -0,0 +1,58 @@
+#pragma once
+/*******************************************************************************************************************
+	SkinnedShader.h, SkinnedShader.cpp
+	Created by Kim Kane
+	Last updated: 19/10/2026
+
+	Loads in a skinned vertex shader and a pixel shader.
+	Attributes available: world, view, projection matrices, model position, texture, normal, and the joints
+	holding each vertex with their weights
+
+	The bone palette is not set here - it belongs to each character, so it is uploaded when the character draws.
+
+	The compiled shaders and input layout are owned by the shader manager and shared between all instances.
+	Constant buffers belong to the render context the shader is bound through.
+
+*******************************************************************************************************************/
+#include <d3d11.h>
+#include <xnamath.h>
+#include <d3dx11async.h>
+#include <string>
+
+#include "ShaderProgram.h"
+
+class Texture;
+class Camera;
+
+class SkinnedShader : public ShaderProgram {
+
+public:
+	SkinnedShader();
+	virtual ~SkinnedShader();
+
+	virtual bool LoadShader(const std::wstring& vertexFileLocation, const std::wstring& pixelFileLocation);
+
+public:
+	virtual void BindProgram(RenderContext& context);
+	virtual void BindTexture(RenderContext& context, Texture* texture);
+	virtual void BindObject(RenderContext& context, const RenderCommand& command, Camera* camera);
+
+private:
+	SkinnedShader(const SkinnedShader&);
+
+private:
+	bool UpdateConstantBuffers(RenderContext& context, XMMATRIX& world, Camera* camera);
+
+private:
+	ID3D11VertexShader*		m_vertexShader;
+	ID3D11PixelShader*		m_pixelShader;
+	ID3D11InputLayout*		m_layout;
+
+private:
+	struct MatrixBufferData
+	{
+		XMMATRIX world;
+		XMMATRIX view;
+		XMMATRIX projection;
+	};
+};
@@ -1,6 +1,7 @@
 #include <fstream>
 #include "Terrain.h"
 #include "GraphicsManager.h"
+#include "ShaderManager.h"
 #include "Constants.h"
 #include "Camera.h"
 #include "Log.h"
@@ -30,6 +31,7 @@ Terrain::Terrain()	:	m_terrainWidth(0),
 						m_terrainLevel(15.0f),
 						m_stride(sizeof(BufferConstants::PackedTerrainVertex)),
 						m_offset(0),
+						m_terrainShader(nullptr),
 						m_transform(XMMatrixIdentity())
 {
 	DX_LOG("[TERRAIN] Terrain constructor initialized", DX_LOG_EMPTY, LOG_MESSAGE);
@@ -53,8 +55,9 @@ bool Terrain::Initialize(const char* fileLocation)
 	//---------------------------------------------------------------- Load in the texture/texture package used for the terrain
 	if (!m_packedTextures.LoadTexturePackage("Bricks.jpg", "Grass.jpg", "Grass2.jpg", "Dirt.jpg", "BlendMap2.jpg")) { return false; }
 
-	//---------------------------------------------------------------- Load in the shaders used for the terrain
-	if (!m_terrainShader.LoadShader(L"terrainShader.vs", L"terrainShader.ps")) { return false; }
+	//---------------------------------------------------------------- Get the shared shaders used for the terrain
+	m_terrainShader = Shaders::Instance()->GetProgram<TerrainShader>(L"terrainShader.vs", L"terrainShader.ps");
+	if (!m_terrainShader) { return false; }
 
 	//---------------------------------------------------------------- Load in the heightmap for the terrain
 	if (!LoadHeightMap(fileLocation)) { return false; }
@@ -381,7 +384,7 @@ bool Terrain::InitializeBuffers()
 *******************************************************************************************************************/
 void Terrain::Render(Camera* camera)
 {
-	m_terrainShader.Bind(m_transform, camera, &m_packedTextures);
+	m_terrainShader->Bind(m_transform, camera, &m_packedTextures);
 		m_buffer.Render(m_stride, m_offset);
 }
 
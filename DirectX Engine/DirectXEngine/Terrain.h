@@ -38,7 +38,7 @@ public:
 
 
 	//we are not keeping this!!! >:( :)
-	TerrainShader* GetShader() { return &m_terrainShader; }
+	TerrainShader* GetShader() { return m_terrainShader; }
 	TexturePackage* GetPackage() { return &m_packedTextures; }
 
 private:
@@ -57,7 +57,7 @@ private:
 	unsigned int	m_stride;
 	unsigned int	m_offset;
 
-	TerrainShader	m_terrainShader;
+	TerrainShader*	m_terrainShader;
 
 	XMMATRIX		m_transform;
 
@@ -2,46 +2,53 @@
 /*******************************************************************************************************************
 	TerrainShader.h, TerrainShader.cpp
 	Created by Kim Kane
-	Last updated: 09/02/2018
+	Last updated: 19/10/2026
 
 	Loads in a terrain vertex and pixel shader.
 	Attributes available: world, view, projection matrices, position and texture of terrain
 
+	The compiled shaders and input layout are owned by the shader manager and shared between all instances.
+	Constant buffers belong to the render context the shader is bound through.
+
 *******************************************************************************************************************/
 #include <d3d11.h>
 #include <xnamath.h>
 #include <d3dx11async.h>
 #include <string>
 
+#include "ShaderProgram.h"
+
 class TexturePackage;
 class Camera;
 
-class TerrainShader {
+class TerrainShader : public ShaderProgram {
 
 public:
 	TerrainShader();
-	~TerrainShader();
+	virtual ~TerrainShader();
 
-	bool LoadShader(const std::wstring& vertexFileLocation, const std::wstring& pixelFileLocation);
+	virtual bool LoadShader(const std::wstring& vertexFileLocation, const std::wstring& pixelFileLocation);
 	void Bind(XMMATRIX& world, Camera* camera, TexturePackage* texturePackage, D3D_PRIMITIVE_TOPOLOGY renderMode = D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 
+public:
+	virtual void BindProgram(RenderContext& context);
+	virtual void BindTexture(RenderContext& context, Texture* texture);
+	virtual void BindObject(RenderContext& context, const RenderCommand& command, Camera* camera);
+
 private:
 	TerrainShader(const TerrainShader&);
 
 private:
-	void OutputShaderErrorMessage(ID3D10Blob* errorMessage, const std::wstring& fileLocation);
-	bool UpdateConstantBuffers(XMMATRIX& world, Camera* camera, bool enableBlending = true);
-	void SetTexturePackage(TexturePackage* texturePackage);
+	bool UpdateConstantBuffers(RenderContext& context, XMMATRIX& world, Camera* camera, bool enableBlending = true);
+	bool UpdateMatrixBuffer(RenderContext& context, XMMATRIX& world, Camera* camera);
+	bool UpdateLightBuffers(RenderContext& context, bool enableBlending = true);
+	void SetTexturePackage(RenderContext& context, TexturePackage* texturePackage);
 
 private:
 	ID3D11VertexShader*		m_vertexShader;
 	ID3D11PixelShader*		m_pixelShader;
 	ID3D11InputLayout*		m_layout;
 
-	ID3D11Buffer*			m_matrixBuffer;
-	ID3D11Buffer*			m_lightBuffer;
-	ID3D11Buffer*			m_textureBuffer;
-
 private:
 	struct MatrixBufferData
 	{
@@ -4,119 +4,483 @@
 #include "Text.h"
 #include "GraphicsManager.h"
 #include "ScreenManager.h"
+#include "ShaderManager.h"
+#include "RenderContext.h"
 #include "Log.h"
 
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Statics
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ID3D11Buffer* Text::_IndexBuffer = nullptr;
+unsigned int Text::_IndexBufferUsers = 0;
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//  Packs a value from -1 to 1 in to 16 bits.
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-Text::Text(Texture* texture, TextShader* shaderPtr)
+static short PackSigned(float value)
 {
-    //Get the texture.
-    _Texture = texture;
-    //sort of buffer description for vertex.
-    D3D11_BUFFER_DESC textVertexDesc;
-    ZeroMemory(&textVertexDesc, sizeof(textVertexDesc));
-    textVertexDesc.Usage = D3D11_USAGE_DYNAMIC;
-    textVertexDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
-    textVertexDesc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
-    textVertexDesc.ByteWidth = SPRITE_SIZE * MAX_LENGTH;
+    if (value > 1.0f) value = 1.0f;
+    if (value < -1.0f) value = -1.0f;
+    return static_cast<short>(value * 32767.0f + ((value < 0.0f) ? -0.5f : 0.5f));
+}
 
-    //create the buffer for the vertices on GPU
-    if (FAILED(Graphics::Instance()->GetDevice()->CreateBuffer(&textVertexDesc, 0, &_TextBuffer))) {
-        DX_LOG("Text failed to create Buffer", DX_LOG_EMPTY, LOG_ERROR);
-    }
-    //Load the shader.
-    _Shader.LoadShader(L"fontShader.vs", L"fontShader.ps");
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//  Packs a value from 0 to 1 in to 16 bits.
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+static unsigned short PackUnsigned(float value)
+{
+    if (value > 1.0f) value = 1.0f;
+    if (value < 0.0f) value = 0.0f;
+    return static_cast<unsigned short>(value * 65535.0f + 0.5f);
+}
 
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//  Packs a color in to 8 bits per channel, red in the lowest byte to match R8G8B8A8.
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+static unsigned int PackColor(const XMFLOAT3& color)
+{
+    unsigned int red = PackUnsigned(color.x) >> 8;
+    unsigned int green = PackUnsigned(color.y) >> 8;
+    unsigned int blue = PackUnsigned(color.z) >> 8;
+    return red | (green << 8) | (blue << 16) | (0xFFu << 24);
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+Text::Text(Font* font, TextShader* shaderPtr, bool useInstancing) :   _Instanced(useInstancing),
+                                                                        _TextBuffer(nullptr),
+                                                                        _BufferCapacity(0),
+                                                                        _Submitted(false),
+                                                                        _LabelBuffer(nullptr),
+                                                                        _LabelCapacity(0),
+                                                                        _LabelDrawCount(0),
+                                                                        _LabelsDirty(false)
+{
+    //Get the font and its atlas.
+    _Font = font;
+    _Texture = font->GetTexture();
+    //Get the shared shader, only loaded the first time any text asks for it.
+    if (_Instanced) {
+        _Shader = Shaders::Instance()->GetProgram<TextInstanceShader>(L"fontInstanceShader.vs", L"fontShader.ps");
+        _Stride = sizeof(GlyphInstance);
+        _LetterSize = sizeof(GlyphInstance);
+    }
+    else {
+        _Shader = Shaders::Instance()->GetProgram<TextShader>(L"fontShader.vs", L"fontShader.ps");
+        _Stride = sizeof(GlyphVertex);
+        _LetterSize = sizeof(GlyphVertex) * VERTS_PER_LETTER;
+        //only indexed quads need the index buffer, hold on to it until this text is gone.
+        _IndexBufferUsers++;
+        CreateIndexBuffer();
+    }
+    //create the buffer up front so a normal frame of text never has to grow it.
+    _Glyphs.reserve(MIN_CAPACITY);
+    ReserveBuffer();
 }
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 Text::~Text()
 {
-    //get rid of texture pointer but dont remove from memory
+    //get rid of font and texture pointers but dont remove from memory
+    _Font = nullptr;
     _Texture = nullptr;
     //release the vertex buffer from GPU as not needed.
     if (_TextBuffer) _TextBuffer->Release();
     //clear pointer.
     _TextBuffer = nullptr;
+    //same for the labels.
+    if (_LabelBuffer) _LabelBuffer->Release();
+    _LabelBuffer = nullptr;
+    //the last text using the shared index buffer lets go of it.
+    if (!_Instanced && --_IndexBufferUsers == 0 && _IndexBuffer) {
+        _IndexBuffer->Release();
+        _IndexBuffer = nullptr;
+    }
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+void Text::DrawString(const std::string& message, float posX, float posY, XMFLOAT3 color)
+{
+    //the last batch has been drawn, so start a new one reusing its storage.
+    if (_Submitted) { _Glyphs.clear(); _Submitted = false; }
+
+    if (message.empty()) return;
+
+    //make room on the end of the batch and write the letters straight in to it.
+    size_t first = _Glyphs.size();
+    _Glyphs.resize(first + message.size());
+
+    BuildString(message.c_str(), message.size(), posX, posY, PackColor(color), &_Glyphs[first]);
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+TextLabel Text::CreateLabel(unsigned int maxLength, float posX, float posY, XMFLOAT3 color)
+{
+    if (maxLength > MAX_LABEL_LENGTH) maxLength = MAX_LABEL_LENGTH;
+
+    //give the label its own run of letters on the end of the others, zero sized until it has something to say.
+    Label label;
+    label._First = _LabelGlyphs.size();
+    label._Capacity = maxLength;
+    label._PosX = posX;
+    label._PosY = posY;
+    label._Color = PackColor(color);
+    label._Contents[0] = '\0';
+    label._Dirty = true;
+
+    _LabelGlyphs.resize(label._First + label._Capacity);
+    _Labels.push_back(label);
+    _LabelsDirty = true;
+
+    return _Labels.size() - 1;
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+void Text::SetLabel(TextLabel label, const char* format, ...)
+{
+    if (label >= _Labels.size()) return;
+
+    Label& target = _Labels[label];
+
+    //format on the stack, so updating a number never touches the heap.
+    char contents[MAX_LABEL_LENGTH + 1];
+
+    va_list arguments;
+    va_start(arguments, format);
+    if (vsnprintf(contents, sizeof(contents), format, arguments) < 0) contents[0] = '\0';
+    va_end(arguments);
+
+    contents[target._Capacity] = '\0';
+
+    //most frames nothing has changed, so there's nothing to rebuild or upload.
+    if (strcmp(contents, target._Contents) == 0) return;
+
+    strcpy(target._Contents, contents);
+    RebuildLabel(target);
 }
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-bool Text::DrawString(const std::string& message, float posX, float posY, XMFLOAT3 color)
+void Text::SetLabelColor(TextLabel label, XMFLOAT3 color)
 {
-    //get string length
-    int length = message.size();
-    //cap string length to max size.
-    if (length > MAX_LENGTH) length = MAX_LENGTH;
+    if (label >= _Labels.size()) return;
+
+    unsigned int packedColor = PackColor(color);
+    if (_Labels[label]._Color == packedColor) return;
+
+    _Labels[label]._Color = packedColor;
+    RebuildLabel(_Labels[label]);
+}
 
-    //calculate all sprite info.
-    float charWidth = _Texture->GetHeight() / Screen::Instance()->GetWidth();
-    float charHeight = _Texture->GetHeight() / Screen::Instance()->GetHeight();
-    float texelWidth = _Texture->GetHeight() / _Texture->GetWidth();
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+void Text::Submit(RenderQueue& queue)
+{
+    //grow the buffer and upload changed labels here, before the queue is executed. This is called on the render thread
+    //(RenderSnapshot::SubmitLabels() from MenuState::Render()), as the upload uses the immediate context - the queue
+    //may then record the draw itself on a worker.
+    bool hasBatch = !_Glyphs.empty() && ReserveBuffer();
+    bool hasLabels = UpdateLabels() && _LabelDrawCount > 0;
 
-    //create mapped resource to upload vertex data to GPU
-    D3D11_MAPPED_SUBRESOURCE mapResource;
-    if (FAILED(Graphics::Instance()->GetDeviceContext()->Map(_TextBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mapResource))){
-        DX_LOG("Text failed to map resource", DX_LOG_EMPTY, LOG_ERROR);
+    if (hasBatch || hasLabels) {
+        queue.Submit(LAYER_OVERLAY, _Shader, _Texture, this, XMMatrixIdentity(), XMFLOAT3(0.0f, 0.0f, 0.0f));
     }
 
-    //create a vertex array
-    TextVertexPos* spritePtr = (TextVertexPos*)mapResource.pData;
+    _Submitted = true;
+}
 
-    const int indexSpace = static_cast<char>(' ');
-    const int indexA = static_cast<char>('A');
-    const int indexZ = static_cast<char>('Z');
-    const int indexSquare = static_cast<char>(127);
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+bool Text::Flush()
+{
+    if (!ReserveBuffer() || !UpdateLabels()) return false;
+    if (_Glyphs.empty() && _LabelDrawCount == 0) return true;
 
-    //for each character in string create all 6 vertices.
-    for (int i = 0; i < length; ++i)
-    {
-        float thisStartX = posX + (charWidth * static_cast<float>(i));
-        float thisEndX = thisStartX + charWidth;
-        float thisEndY = posY + charHeight;
-
-        spritePtr[0].pos = XMFLOAT3(thisEndX, thisEndY, 1.0f);
-        spritePtr[1].pos = XMFLOAT3(thisEndX, posY, 1.0f);
-        spritePtr[2].pos = XMFLOAT3(thisStartX, posY, 1.0f);
-        spritePtr[3].pos = XMFLOAT3(thisStartX, posY, 1.0f);
-        spritePtr[4].pos = XMFLOAT3(thisStartX, thisEndY, 1.0f);
-        spritePtr[5].pos = XMFLOAT3(thisEndX, thisEndY, 1.0f);
-
-        int texLookup = 0;
-        int letter = static_cast<char>(message[i]);
-        
-        //if you try to draw character not on the range will default to square
-        if (letter < indexSpace || letter > indexSquare)
-        {
-            texLookup = indexSquare;
+    RenderContext& context = Graphics::Instance()->GetImmediateContext();
+
+    //bind shader and texture once for the whole batch, then draw it.
+    _Shader->BindProgram(context);
+    _Shader->BindTexture(context, _Texture);
+    Render(context, nullptr);
+
+    _Glyphs.clear();
+    _Submitted = false;
+
+    return true;
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+void Text::Render(RenderContext& context, const void*) const
+{
+    if (!_Instanced && !_IndexBuffer) return;
+
+    UINT letterCount = _Glyphs.size();
+    if (letterCount > 0 && letterCount <= _BufferCapacity) {
+
+        //the whole batch is uploaded in one go, so discarding once a frame is all that's needed.
+        D3D11_MAPPED_SUBRESOURCE mapResource;
+        if (FAILED(context.GetDeviceContext()->Map(_TextBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mapResource))) {
+            DX_LOG("Text failed to map resource", DX_LOG_EMPTY, LOG_ERROR);
+            return;
         }
-        else
-        {
-            texLookup = (letter - indexSpace);
+
+        //instances go up exactly as they are, indexed quads need their corners working out.
+        if (_Instanced) {
+            memcpy(mapResource.pData, _Glyphs.data(), letterCount * sizeof(GlyphInstance));
+        }
+        else {
+            ExpandGlyphs(_Glyphs.data(), letterCount, (GlyphVertex*)mapResource.pData);
         }
 
-        //calculate the texture UV's for each vertex.
-        float tuStart = 0.0f + (texelWidth * static_cast<float>(texLookup));
-        float tuEnd = tuStart + texelWidth;
+        context.GetDeviceContext()->Unmap(_TextBuffer, 0);
 
-        spritePtr[0].tex = XMFLOAT2(tuEnd, 0.0f);
-        spritePtr[1].tex = XMFLOAT2(tuEnd, 1.0f);
-        spritePtr[2].tex = XMFLOAT2(tuStart, 1.0f);
-        spritePtr[3].tex = XMFLOAT2(tuStart, 1.0f);
-        spritePtr[4].tex = XMFLOAT2(tuStart, 0.0f);
-        spritePtr[5].tex = XMFLOAT2(tuEnd, 0.0f);
+        context.SetVertexBuffer(_TextBuffer, _Stride, 0);
+        DrawLetters(context, letterCount);
+    }
 
-        spritePtr += 6;
+    //the labels are already on the GPU, so all they need is drawing.
+    if (_LabelDrawCount > 0) {
+        context.SetVertexBuffer(_LabelBuffer, _Stride, 0);
+        DrawLetters(context, _LabelDrawCount);
+    }
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+void Text::DrawLetters(RenderContext& context, UINT letterCount) const
+{
+    if (_Instanced) {
+        context.DrawInstanced(VERTS_PER_LETTER, letterCount, 0, 0);
+        return;
     }
-    //finish sorting the vertex info.
-    Graphics::Instance()->GetDeviceContext()->Unmap(_TextBuffer, 0);
 
-    //bind shader and setup all buffers sending data to GPU
-    _Shader.Bind(_Texture);
-    _Shader.UpdateConstantBuffers(XMFLOAT4(color.x, color.y, color.z, 0.0f));
+    //16-bit indices only reach so far, so a huge batch is drawn in parts by moving the base vertex along.
+    context.SetIndexBuffer(_IndexBuffer, DXGI_FORMAT_R16_UINT);
 
-    Graphics::Instance()->GetDeviceContext()->IASetVertexBuffers(0, 1, &_TextBuffer, &STRIDE, &OFFSET);
+    for (UINT first = 0; first < letterCount; first += MAX_LETTERS_PER_DRAW) {
+        UINT count = letterCount - first;
+        if (count > MAX_LETTERS_PER_DRAW) count = MAX_LETTERS_PER_DRAW;
 
-    //Draw the string.
-    Graphics::Instance()->GetDeviceContext()->Draw(VERTS_PER_LETTER * length, 0);
+        context.DrawIndexed(count * INDICES_PER_LETTER, 0, first * VERTS_PER_LETTER);
+    }
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+void Text::RebuildLabel(Label& label)
+{
+    //clear the whole label first, so letters past the end of a shorter string draw nothing.
+    GlyphInstance* glyphPtr = &_LabelGlyphs[label._First];
+    memset(glyphPtr, 0, label._Capacity * sizeof(GlyphInstance));
+
+    BuildString(label._Contents, strlen(label._Contents), label._PosX, label._PosY, label._Color, glyphPtr);
+
+    label._Dirty = true;
+    _LabelsDirty = true;
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+bool Text::UpdateLabels()
+{
+    if (!_LabelsDirty) return true;
+
+    unsigned int letterCount = _LabelGlyphs.size();
+
+    //labels have been added since the buffer was made, so make a bigger one and send every label again.
+    if (letterCount > _LabelCapacity) {
+        unsigned int capacity = MIN_CAPACITY;
+        if (_LabelCapacity > capacity) capacity = _LabelCapacity;
+        while (capacity < letterCount) capacity *= 2;
+
+        //only ever changes when a label does, so keep it in GPU memory rather than mapping it.
+        D3D11_BUFFER_DESC labelDesc;
+        ZeroMemory(&labelDesc, sizeof(labelDesc));
+        labelDesc.Usage = D3D11_USAGE_DEFAULT;
+        labelDesc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+        labelDesc.ByteWidth = capacity * _LetterSize;
+
+        ID3D11Buffer* labelBuffer = nullptr;
+        if (FAILED(Graphics::Instance()->GetDevice()->CreateBuffer(&labelDesc, 0, &labelBuffer))) {
+            DX_LOG("Text failed to create label Buffer", DX_LOG_EMPTY, LOG_ERROR);
+            return false;
+        }
+
+        if (_LabelBuffer) _LabelBuffer->Release();
+        _LabelBuffer = labelBuffer;
+        _LabelCapacity = capacity;
+
+        for (size_t i = 0; i < _Labels.size(); ++i) _Labels[i]._Dirty = true;
+    }
+
+    //only send the labels that have changed.
+    ID3D11DeviceContext* deviceContext = Graphics::Instance()->GetImmediateContext().GetDeviceContext();
+
+    for (size_t i = 0; i < _Labels.size(); ++i) {
+        Label& label = _Labels[i];
+        if (!label._Dirty) continue;
+
+        D3D11_BOX labelBox = { label._First * _LetterSize, 0, 0, (label._First + label._Capacity) * _LetterSize, 1, 1 };
+        deviceContext->UpdateSubresource(_LabelBuffer, 0, &labelBox, GetLabelData(label._First, label._Capacity), 0, 0);
+
+        label._Dirty = false;
+    }
+
+    _LabelDrawCount = letterCount;
+    _LabelsDirty = false;
 
     return true;
 }
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+const void* Text::GetLabelData(unsigned int first, unsigned int count)
+{
+    if (_Instanced) return &_LabelGlyphs[first];
+
+    //reuses the same room every time, so this only allocates the first time a label this long is uploaded.
+    if (_LabelVertices.size() < count * VERTS_PER_LETTER) _LabelVertices.resize(count * VERTS_PER_LETTER);
+
+    ExpandGlyphs(&_LabelGlyphs[first], count, _LabelVertices.data());
+
+    return _LabelVertices.data();
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+bool Text::ReserveBuffer()
+{
+    unsigned int required = _Glyphs.size();
+    if (_TextBuffer && required <= _BufferCapacity) return true;
+
+    //double the size each time so a growing batch only reallocates a handful of times.
+    unsigned int capacity = MIN_CAPACITY;
+    if (_BufferCapacity > capacity) capacity = _BufferCapacity;
+    while (capacity < required) capacity *= 2;
+
+    //sort of buffer description for vertex.
+    D3D11_BUFFER_DESC textVertexDesc;
+    ZeroMemory(&textVertexDesc, sizeof(textVertexDesc));
+    textVertexDesc.Usage = D3D11_USAGE_DYNAMIC;
+    textVertexDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+    textVertexDesc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+    textVertexDesc.ByteWidth = capacity * _LetterSize;
+
+    //create the new buffer for the vertices on GPU before letting go of the old one.
+    ID3D11Buffer* textBuffer = nullptr;
+    if (FAILED(Graphics::Instance()->GetDevice()->CreateBuffer(&textVertexDesc, 0, &textBuffer))) {
+        DX_LOG("Text failed to create Buffer", DX_LOG_EMPTY, LOG_ERROR);
+        return false;
+    }
+
+    if (_TextBuffer) _TextBuffer->Release();
+    _TextBuffer = textBuffer;
+    _BufferCapacity = capacity;
+
+    return true;
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+bool Text::CreateIndexBuffer()
+{
+    if (_IndexBuffer) return true;
+
+    //every quad is bottom left, top left, bottom right, top right - the same 2 triangles each time.
+    std::vector<unsigned short> indices(MAX_LETTERS_PER_DRAW * INDICES_PER_LETTER);
+    for (unsigned int letter = 0; letter < MAX_LETTERS_PER_DRAW; ++letter) {
+        unsigned short corner = static_cast<unsigned short>(letter * VERTS_PER_LETTER);
+        unsigned short* quad = &indices[letter * INDICES_PER_LETTER];
+
+        quad[0] = corner + 0; quad[1] = corner + 1; quad[2] = corner + 2;
+        quad[3] = corner + 2; quad[4] = corner + 1; quad[5] = corner + 3;
+    }
+
+    //never changes, so let the GPU keep it wherever suits it best.
+    D3D11_BUFFER_DESC indexDesc;
+    ZeroMemory(&indexDesc, sizeof(indexDesc));
+    indexDesc.Usage = D3D11_USAGE_IMMUTABLE;
+    indexDesc.BindFlags = D3D11_BIND_INDEX_BUFFER;
+    indexDesc.ByteWidth = indices.size() * sizeof(unsigned short);
+
+    D3D11_SUBRESOURCE_DATA indexData;
+    ZeroMemory(&indexData, sizeof(indexData));
+    indexData.pSysMem = indices.data();
+
+    if (FAILED(Graphics::Instance()->GetDevice()->CreateBuffer(&indexDesc, &indexData, &_IndexBuffer))) {
+        DX_LOG("Text failed to create index Buffer", DX_LOG_EMPTY, LOG_ERROR);
+        return false;
+    }
+
+    return true;
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+void Text::ExpandGlyphs(const GlyphInstance* glyphPtr, unsigned int count, GlyphVertex* vertexPtr)
+{
+    for (unsigned int i = 0; i < count; ++i)
+    {
+        const GlyphInstance& glyph = glyphPtr[i];
+
+        //packed values add together, but a letter hanging off the edge of the screen has to be clamped back in range.
+        int right = glyph.x + glyph.width;
+        int top = glyph.y + glyph.height;
+        short endX = static_cast<short>((right > 32767) ? 32767 : right);
+        short endY = static_cast<short>((top > 32767) ? 32767 : top);
+
+        GlyphVertex corners[VERTS_PER_LETTER] = {
+            { glyph.x, glyph.y, glyph.u0, glyph.v1, glyph.color },
+            { glyph.x, endY, glyph.u0, glyph.v0, glyph.color },
+            { endX, glyph.y, glyph.u1, glyph.v1, glyph.color },
+            { endX, endY, glyph.u1, glyph.v0, glyph.color },
+        };
+
+        memcpy(vertexPtr, corners, sizeof(corners));
+        vertexPtr += VERTS_PER_LETTER;
+    }
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+void Text::BuildString(const char* message, unsigned int length, float posX, float posY, unsigned int color, GlyphInstance* glyphPtr) const
+{
+    //positions are in NDC, which spans 2 units across the screen, so each pixel of the baked font is half a pixel
+    //of the screen - the size the text was drawn at before, kept so nothing that lays out labels has to change.
+    float pixelWidth = 1.0f / Screen::Instance()->GetWidth();
+    float pixelHeight = 1.0f / Screen::Instance()->GetHeight();
+
+    //posY is the bottom of the line, so the baseline sits the font's descent above it.
+    float baseline = posY + (_Font->GetLineHeight() - _Font->GetAscent()) * pixelHeight;
+    float penX = posX;
+
+    unsigned char previous = 0;
+
+    //for each character in string fill in its instance.
+    for (unsigned int i = 0; i < length; ++i)
+    {
+        unsigned char letter = static_cast<unsigned char>(message[i]);
+        const FontGlyph* glyph = _Font->GetGlyph(letter);
+
+        //every character still gets a letter so labels line up, anything the font can't draw is left zero sized.
+        memset(glyphPtr, 0, sizeof(GlyphInstance));
+
+        if (glyph)
+        {
+            //pull the letter closer to the one before it if the font says they fit together.
+            if (previous) penX += _Font->GetKerning(previous, letter) * pixelWidth;
+
+            if (glyph->width > 0.0f && glyph->height > 0.0f)
+            {
+                float top = baseline + glyph->bearingY * pixelHeight;
+
+                glyphPtr->x = PackSigned(penX + glyph->bearingX * pixelWidth);
+                glyphPtr->y = PackSigned(top - glyph->height * pixelHeight);
+                glyphPtr->width = PackSigned(glyph->width * pixelWidth);
+                glyphPtr->height = PackSigned(glyph->height * pixelHeight);
+                glyphPtr->u0 = PackUnsigned(glyph->u0);
+                glyphPtr->v0 = PackUnsigned(glyph->v0);
+                glyphPtr->u1 = PackUnsigned(glyph->u1);
+                glyphPtr->v1 = PackUnsigned(glyph->v1);
+                glyphPtr->color = color;
+            }
+
+            penX += glyph->advance * pixelWidth;
+            previous = letter;
+        }
+
+        ++glyphPtr;
+    }
+}
@@ -12,64 +12,244 @@
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 // Headers
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+#include "Font.h"
 #include "Texture.h"
 #include "TextShader.h"
+#include "RenderQueue.h"
 #include <string>
+#include <vector>
 #include <d3d11.h>
 #include <xnamath.h>
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-//  Text Vertex Struct
-//  --pos-- X,Y,Z position of vertex.
-//  --text-- U,V texture co-ordinates.
+//  Glyph Vertex Struct. One corner of a letter's quad, packed in to 12 bytes. Text is
+//  always drawn flat on the screen so there is no z, the shader fills it in.
+//  --x,y-- Position in NDC, as 16-bit signed normalized.
+//  --u,v-- Texture co-ordinates, as 16-bit unsigned normalized.
+//  --color-- RGBA color, 8 bits per channel.
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-struct TextVertexPos {
-    XMFLOAT3 pos;
-    XMFLOAT2 tex;
+struct GlyphVertex {
+    short x, y;
+    unsigned short u, v;
+    unsigned int color;
 };
 
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//  Glyph Instance Struct. A whole letter packed in to 20 bytes, which the instanced
+//  shader expands in to a quad.
+//  --x,y-- Bottom left corner in NDC, as 16-bit signed normalized.
+//  --width,height-- Size of the letter in NDC, as 16-bit signed normalized.
+//  --u0,v0,u1,v1-- The letter's rectangle in the font atlas, top left then bottom right,
+//  as 16-bit unsigned normalized.
+//  --color-- RGBA color, 8 bits per channel.
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+struct GlyphInstance {
+    short x, y;
+    short width, height;
+    unsigned short u0, v0, u1, v1;
+    unsigned int color;
+};
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//  Handle to a label, a retained string that is only rebuilt when its contents change.
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+typedef unsigned int TextLabel;
+
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 //  This class handles all drawing of text to the screen. Only 1 Instance is required for
 //  all wring purposes.
+//
+//  Letters come from a baked signed distance field font, so text stays sharp at any size.
+//  Each letter is placed with the font's own advance, bearing and kerning, so strings are
+//  spaced the way the font was designed rather than in fixed width cells.
+//
+//  Labels are for text that is on screen every frame but rarely changes, like the HUD.
+//  Their letters stay on the GPU between frames and are only re-uploaded when SetLabel
+//  is given something different, so an unchanged label costs nothing but its share of
+//  one draw call.
+//
+//  Strings are batched - every string drawn in a frame is added to one list of letters,
+//  which is uploaded and drawn all at once with a single bind and draw call. Letters are
+//  kept as packed instances, and either uploaded as they are for the instanced shader,
+//  or expanded in to 4 vertices each and drawn with a shared index buffer.
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-class Text
+class Text : public Renderable
 {
 public:
     //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
     //  Default Constructor
-    //  --texture-- A pointer to a texture for the text to render with.
+    //  --font-- A pointer to a loaded font for the text to render with.
     //  --shaderPtr-- not used atm, but for later changes down the road.
+    //  --useInstancing-- Draw each letter as one instance rather than 4 indexed vertices.
     //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-    Text(Texture* texture, TextShader* shaderPtr);
+    Text(Font* font, TextShader* shaderPtr, bool useInstancing = true);
 
     //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
     //  Default Destructor
     //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-    ~Text();
+    virtual ~Text();
 
-    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-    //  Draws a string to the screen at the x,y position given and the color specified.
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    //  Adds a string to this frame's batch at the x,y position given and the color
+    //  specified. Nothing is drawn until the batch is submitted or flushed.
     //  --message-- The message you want written to the screen e, "Hello World!"
     //  --posX-- The x position to start drawing from in NDC
     //  --posY-- The y position to start drawing from in NDC
     //  --color-- The color you wish the text to be. Defaults to White.
     //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-    bool DrawString(const std::string& message, float posX, float posY, XMFLOAT3 color = XMFLOAT3(1.0f,1.0f,1.0f));
+    void DrawString(const std::string& message, float posX, float posY, XMFLOAT3 color = XMFLOAT3(1.0f,1.0f,1.0f));
+
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    //  Creates a label, which is drawn every frame until this text is destroyed. Starts
+    //  off empty, give it something to say with SetLabel.
+    //  --maxLength-- The longest string the label can show, up to MAX_LABEL_LENGTH.
+    //  --posX-- The x position to start drawing from in NDC
+    //  --posY-- The y position to start drawing from in NDC
+    //  --color-- The color you wish the text to be. Defaults to White.
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    TextLabel CreateLabel(unsigned int maxLength, float posX, float posY, XMFLOAT3 color = XMFLOAT3(1.0f, 1.0f, 1.0f));
+
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    //  Changes what a label says, printf style. Formats in to a fixed buffer so it never
+    //  allocates, and only rebuilds the label if the result is different to last time.
+    //  Anything past the label's max length is cut off.
+    //  --label-- The label to change.
+    //  --format-- printf style format string, e.g. "FPS: %d"
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    void SetLabel(TextLabel label, const char* format, ...);
+
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    //  Changes the color of a label.
+    //  --label-- The label to change.
+    //  --color-- The new color.
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    void SetLabelColor(TextLabel label, XMFLOAT3 color);
+
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    //  Adds this frame's batch and the labels to the overlay layer of the render queue.
+    //  The batch stays valid until the next DrawString call, so execute the queue before then.
+    //  --queue-- The render queue for this frame.
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    void Submit(RenderQueue& queue);
+
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    //  Draws this frame's batch and the labels straight away on the immediate context,
+    //  then empties the batch.
+    //  For when there is no render queue to submit to.
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    bool Flush();
+
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    //  Uploads the batch and draws it, then draws the labels. Called by the render queue,
+    //  or by Flush.
+    //  --context-- The render context to draw through.
+    //  --data-- Unused, text keeps nothing the game changes while it's being drawn.
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    virtual void Render(RenderContext& context, const void* data) const override;
 
 	Texture* GetTexture() { return _Texture; }
+
+    static const unsigned int MAX_LABEL_LENGTH = 64;    //The longest string a label can hold.
 private:
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    //  A label. Owns _Capacity letters of the label buffer starting at _First, with any it
+    //  isn't using left zero sized so they draw nothing.
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    struct Label {
+        unsigned int _First;                    //The label's first letter in the label buffer.
+        unsigned int _Capacity;                 //How many letters the label has room for.
+        float _PosX;                            //The x position to start drawing from in NDC
+        float _PosY;                            //The y position to start drawing from in NDC
+        unsigned int _Color;                    //The packed color of the label.
+        char _Contents[MAX_LABEL_LENGTH + 1];   //What the label currently says.
+        bool _Dirty;                            //Whether the label has changed since it was last uploaded.
+    };
+
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    //  Fills in the letters for a string.
+    //  --message-- The message to build.
+    //  --posX-- The x position to start drawing from in NDC
+    //  --posY-- The y position to start drawing from in NDC
+    //  --color-- The packed color to give every letter.
+    //  --glyphPtr-- Where to write the letters, room for every letter in the message.
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    void BuildString(const char* message, unsigned int length, float posX, float posY, unsigned int color, GlyphInstance* glyphPtr) const;
+
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    //  Expands letters in to the 4 corners of their quads.
+    //  --glyphPtr-- The letters to expand.
+    //  --count-- How many letters there are.
+    //  --vertexPtr-- Where to write the vertices, room for 4 per letter.
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    static void ExpandGlyphs(const GlyphInstance* glyphPtr, unsigned int count, GlyphVertex* vertexPtr);
+
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    //  Draws letters from a buffer that's already bound, instanced or indexed.
+    //  --context-- The render context to draw through.
+    //  --letterCount-- How many letters to draw.
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    void DrawLetters(RenderContext& context, UINT letterCount) const;
+
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    //  Rebuilds a label's letters from its contents, ready to be uploaded.
+    //  --label-- The label to rebuild.
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    void RebuildLabel(Label& label);
+
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    //  Uploads any labels that have changed, creating the label buffer again if labels
+    //  have been added since. Must be called on the main thread before the labels are drawn.
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    bool UpdateLabels();
+
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    //  Gets a label's letters ready to upload, expanding them if drawing indexed quads.
+    //  --first-- The first letter to upload.
+    //  --count-- How many letters to upload.
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    const void* GetLabelData(unsigned int first, unsigned int count);
+
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    //  Makes sure the vertex buffer can hold the whole batch, growing it if not. Must be
+    //  called on the main thread before the batch is drawn.
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    bool ReserveBuffer();
+
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    //  Creates the index buffer shared by every Text, the first time one is needed.
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    static bool CreateIndexBuffer();
+
     //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
     //  Member Variables.
     //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-    Texture* _Texture;              //Texture Pointer
+    Font* _Font;                    //Font Pointer, the metrics every string is laid out with.
+    Texture* _Texture;              //Texture Pointer, the font's atlas.
 
-    const int MAX_LENGTH = 24;      //Maximum Length of a string
-    const int VERTS_PER_LETTER = 6; //Number of vertices per letter which never changes.
-    const unsigned int STRIDE = sizeof(TextVertexPos);  //The stride between each character which also never changes.
-    const unsigned int OFFSET = 0;  //The offset whihc is always 0 but it keeps code tidy.
-    const int SPRITE_SIZE = sizeof(TextVertexPos) * 6;  //Size of each letter sprite in bytes. Doesnt change.
+    static const unsigned int VERTS_PER_LETTER = 4;     //Number of corners per letter which never changes.
+    static const unsigned int INDICES_PER_LETTER = 6;   //Number of indices to draw the 2 triangles of a letter.
+    static const unsigned int MAX_LETTERS_PER_DRAW = 65536 / VERTS_PER_LETTER;  //As many letters as 16-bit indices can reach, bigger batches are drawn in parts.
+    static const unsigned int MIN_CAPACITY = 256;       //The fewest letters the buffer is created with, enough for a screen of debug text.
 
-    ID3D11Buffer* _TextBuffer;      //The buffer holding all the text vertices.
-    TextShader _Shader;             //The shader to use to draw all text.
-};
+    bool _Instanced;                //Whether letters are drawn as instances rather than indexed quads.
+    unsigned int _Stride;           //The size of a letter's instance or a single vertex, depending on how it's drawn.
+    unsigned int _LetterSize;       //How many bytes of the buffer each letter takes up.
 
+    ID3D11Buffer* _TextBuffer;      //The buffer holding all the letters, grown as needed.
+    unsigned int _BufferCapacity;   //How many letters the buffer can hold.
+    TextShader* _Shader;            //The shared shader to use to draw all text.
+
+    std::vector<GlyphInstance> _Glyphs;     //Every letter drawn this frame, cleared rather than freed so it doesn't reallocate.
+    bool _Submitted;                //Whether the batch has been handed to a render queue.
+
+    std::vector<Label> _Labels;                 //Every label, the handle is its index.
+    std::vector<GlyphInstance> _LabelGlyphs;    //The letters of every label, one after another.
+    std::vector<GlyphVertex> _LabelVertices;    //Room to expand label letters in to before uploading indexed quads.
+    ID3D11Buffer* _LabelBuffer;     //The label letters kept on the GPU between frames.
+    unsigned int _LabelCapacity;    //How many letters the label buffer can hold.
+    unsigned int _LabelDrawCount;   //How many label letters have been uploaded and are ready to draw.
+    bool _LabelsDirty;              //Whether any label needs uploading.
+
+    static ID3D11Buffer* _IndexBuffer;      //Indices for MAX_LETTERS_PER_DRAW quads, never changes so it's shared by every Text.
+    static unsigned int _IndexBufferUsers;  //How many Text objects are using the index buffer.
+};
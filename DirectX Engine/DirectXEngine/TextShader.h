@@ -18,6 +18,8 @@
 #include <d3dx11async.h>
 #include <string>
 
+#include "ShaderProgram.h"
+
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 //  Forward Declartions
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
@@ -27,8 +29,12 @@ class Texture;
 //  This is the text shader class that is in charge of handling moving data to GPU for
 //  text rendering. Modelled after the other shaders Designed by Kim Kane. Modified to
 //  the uses required like sending color data for changing text color.
+//
+//  Letters come in as packed 16-bit quads - either 4 vertices per letter drawn with a
+//  shared index buffer, or with TextInstanceShader a single instance per letter that the
+//  vertex shader expands in to a quad.
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-class TextShader {
+class TextShader : public ShaderProgram {
 
 public:
     //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
@@ -39,14 +45,14 @@ public:
     //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
     //  Default Destructor
     //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-    ~TextShader();
+    virtual ~TextShader();
 
     //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
     //  Loads the shader onto the GPU
     //  --vertexFileLocation-- The file location for the vertexShader
     //  --pixelFileLocation-- The file lcoation for the pixelShader
     //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-    bool LoadShader(const std::wstring& vertexFileLocation, const std::wstring& pixelFileLocation);
+    virtual bool LoadShader(const std::wstring& vertexFileLocation, const std::wstring& pixelFileLocation);
 
     //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
     //  Binds the shader to current use and sets all the buffers to be active in sahder.
@@ -56,36 +62,60 @@ public:
     void Bind(Texture* texture, D3D_PRIMITIVE_TOPOLOGY renderMode = D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 
     //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-    //  Updates the color buffer to change the color of the text.
-    //  --color-- The color to change the text to.
+    //  Binds the shaders, layout and sampler. Called by the render queue when it switches
+    //  to this shader.
+    //  --context-- The render context to bind through.
     //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-    bool UpdateConstantBuffers(XMFLOAT4 color);
+    virtual void BindProgram(RenderContext& context);
 
-private:
     //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-    //  Outputs an error if something goes wrong.
+    //  Binds the font texture. Called by the render queue when the texture changes.
+    //  --context-- The render context to bind through.
+    //  --texture-- pointer to the texture used to draw the text.
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    virtual void BindTexture(RenderContext& context, Texture* texture);
+
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    //  Nothing to send per object, the color of each letter is in its vertices.
+    //  --context-- The render context to bind through.
+    //  --command-- The queued draw.
+    //  --camera-- Unused, text is drawn in screen space.
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    virtual void BindObject(RenderContext& context, const RenderCommand& command, Camera* camera);
+
+protected:
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    //  Constructor for the instanced version of the shader.
+    //  --instanced-- Whether each letter is one instance rather than 4 vertices.
     //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-    void OutputShaderErrorMessage(ID3D10Blob* errorMessage, const WCHAR* fileLocation);
+    explicit TextShader(bool instanced);
 
+private:
     //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
     //  Sets the texture to be used by GPU when rendering.
+    //  --context-- The render context to bind through.
     //  --texture-- A pointer to the teture to use.
     //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-    void SetTexture(Texture* texture);
+    void SetTexture(RenderContext& context, Texture* texture);
 
     //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
     //  Member Variables.
     //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-    ID3D11VertexShader*		_VertexShader;          //A pointer to the vertex shader buffer
-    ID3D11PixelShader*		_PixelShader;           //A pointer to the pixel shader buffer
-    ID3D11InputLayout*		_Layout;                //A pointer to the vertex layout buffer
-    ID3D11Buffer*           _PixelColorBuffer;      //A pointer to the pixel color constant buffer
+    ID3D11VertexShader*		_VertexShader;          //A pointer to the vertex shader buffer (owned by the shader manager)
+    ID3D11PixelShader*		_PixelShader;           //A pointer to the pixel shader buffer (owned by the shader manager)
+    ID3D11InputLayout*		_Layout;                //A pointer to the vertex layout buffer (owned by the shader manager)
+    bool                    _Instanced;             //Whether letters are drawn as instances rather than indexed quads.
+};
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//  The text shader for instanced letters. Its own type so the shader manager keeps it
+//  apart from the indexed version.
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+class TextInstanceShader : public TextShader {
 
+public:
     //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-    //  Color Constant Buffer Struct
-    //  --_PixelColor-- The color to send to the GPU Shader.
+    //  Default Constructor
     //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-    struct PixelColorBuffer {
-        XMFLOAT4 _PixelColor;
-    };
+    TextInstanceShader() : TextShader(true) {}
 };
\ No newline at end of file
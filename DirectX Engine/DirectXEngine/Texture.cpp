@@ -7,7 +7,8 @@
 /*******************************************************************************************************************
 	Constructor with initializer list to set all default values of variables
 *******************************************************************************************************************/
-Texture::Texture()	:	m_texture(nullptr)
+Texture::Texture()	:	m_texture(nullptr),
+						m_sortId(++m_nextSortId)
 {
 }
 
@@ -18,7 +19,6 @@ Texture::Texture()	:	m_texture(nullptr)
 Texture::~Texture()
 {
 	if (m_texture)			m_texture->Release(); m_texture = nullptr;
-	if (m_defaultSampler)	m_defaultSampler->Release(); m_defaultSampler = nullptr;
 }
 
 
@@ -55,6 +55,45 @@ bool Texture::LoadTexture(const std::string& texture)
 }
 
 
+/*******************************************************************************************************************
+	Function that creates a texture from pixels already in memory - the texture never changes, so it is immutable
+*******************************************************************************************************************/
+bool Texture::CreateTexture(unsigned int width, unsigned int height, DXGI_FORMAT format, const void* pixels, unsigned int rowPitch)
+{
+	HRESULT result = S_OK;
+
+	D3D11_TEXTURE2D_DESC textureDescription = {};
+	textureDescription.Width				= width;
+	textureDescription.Height				= height;
+	textureDescription.MipLevels			= 1;
+	textureDescription.ArraySize			= 1;
+	textureDescription.Format				= format;
+	textureDescription.SampleDesc.Count		= 1;
+	textureDescription.Usage				= D3D11_USAGE_IMMUTABLE;
+	textureDescription.BindFlags			= D3D11_BIND_SHADER_RESOURCE;
+
+	D3D11_SUBRESOURCE_DATA textureData = {};
+	textureData.pSysMem						= pixels;
+	textureData.SysMemPitch					= rowPitch;
+
+	ID3D11Texture2D* texture = nullptr;
+
+	if (m_texture) { m_texture->Release(); m_texture = nullptr; }
+
+	result = Graphics::Instance()->GetDevice()->CreateTexture2D(&textureDescription, &textureData, &texture);
+	if (FAILED(result)) { DX_LOG("[TEXTURE] Failed to create texture from memory", DX_LOG_EMPTY, LOG_ERROR); return false; }
+
+	result = Graphics::Instance()->GetDevice()->CreateShaderResourceView(texture, nullptr, &m_texture);
+	texture->Release();
+	if (FAILED(result)) { DX_LOG("[TEXTURE] Failed to create shader resource view from memory", DX_LOG_EMPTY, LOG_ERROR); return false; }
+
+	_Height = (float)height;
+	_Width	= (float)width;
+
+	return true;
+}
+
+
 /*******************************************************************************************************************
 	Accessor Methods
 *******************************************************************************************************************/
@@ -66,10 +105,14 @@ ID3D11SamplerState* const* Texture::GetSampler() { return &m_defaultSampler; }
 	Static variables and functions
 *******************************************************************************************************************/
 ID3D11SamplerState* Texture::m_defaultSampler = nullptr;
+unsigned int Texture::m_nextSortId = 0;
 
 
 bool Texture::GenerateSamplerFilters()
 {
+	//-------------------------------------------- Every shader shares the one default sampler, so only create it the first time it is asked for
+	if (m_defaultSampler) { return true; }
+
 	HRESULT result = S_OK;
 
 	D3D11_SAMPLER_DESC defaultSamplerDescription = {};
@@ -108,4 +151,10 @@ bool Texture::GenerateSamplerFilters()
 	}
 
 	return true;
+}
+
+
+void Texture::ReleaseSamplerFilters()
+{
+	if (m_defaultSampler) { m_defaultSampler->Release(); m_defaultSampler = nullptr; }
 }
\ No newline at end of file
@@ -24,11 +24,15 @@ public:
 	float GetHeight() { return _Height; }
 	float GetWidth() { return _Width; }
 
+	unsigned int GetSortId() const { return m_sortId; }
+
 public:
 	bool LoadTexture(const std::string& texture);
+	bool CreateTexture(unsigned int width, unsigned int height, DXGI_FORMAT format, const void* pixels, unsigned int rowPitch);
 
 public:
 	static bool GenerateSamplerFilters();
+	static void ReleaseSamplerFilters();
 
 protected:
 	bool GenerateTexture(const std::string& fileLocation, ID3D11ShaderResourceView** texture);
@@ -38,5 +42,8 @@ private:
 
 	float _Height, _Width;
 
+	unsigned int				m_sortId;
+
 	static ID3D11SamplerState*	m_defaultSampler;
+	static unsigned int			m_nextSortId;
 };
\ No newline at end of file
@@ -0,0 +1,208 @@
+#include "ThreadPool.h"
+#include "Log.h"
+#include "Profiler.h"
+
+/*******************************************************************************************************************
+	Constructor with initializer list to set all default values of variables
+*******************************************************************************************************************/
+ThreadPool::ThreadPool()	:	m_job(nullptr),
+								m_jobsRemaining(0),
+								m_busyWorkers(0),
+								m_generation(0),
+								m_isRunning(false)
+{
+
+}
+
+
+/*******************************************************************************************************************
+	Shut down all necessary procedures, release resources and clean up memory
+*******************************************************************************************************************/
+ThreadPool::~ThreadPool()
+{
+	Shutdown();
+}
+
+
+/*******************************************************************************************************************
+	Function that starts the worker threads - zero threads is allowed, in which case the caller runs every job
+*******************************************************************************************************************/
+bool ThreadPool::Initialize(unsigned int threadCount)
+{
+	Shutdown();
+
+	m_isRunning = true;
+
+	m_queues.clear();
+	for (unsigned int i = 0; i <= threadCount; i++) {
+		m_queues.push_back(std::unique_ptr<JobQueue>(new JobQueue()));
+		m_queues.back()->begin = m_queues.back()->end = 0;
+	}
+
+	for (unsigned int i = 0; i < threadCount; i++) {
+		m_threads.push_back(std::thread(&ThreadPool::WorkerLoop, this, i));
+	}
+
+	DX_LOG("[THREAD POOL] Worker threads started: ", threadCount, LOG_SUCCESS);
+
+	return true;
+}
+
+
+/*******************************************************************************************************************
+	Function that wakes every worker, tells them to stop and waits for them to finish
+*******************************************************************************************************************/
+void ThreadPool::Shutdown()
+{
+	if (m_threads.empty()) { return; }
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_isRunning = false;
+	}
+
+	m_wakeCondition.notify_all();
+
+	for (unsigned int i = 0; i < m_threads.size(); i++) { m_threads[i].join(); }
+	m_threads.clear();
+}
+
+
+/*******************************************************************************************************************
+	Function that runs a job jobCount times across the workers and this thread, returning when all runs are done
+*******************************************************************************************************************/
+void ThreadPool::Dispatch(unsigned int jobCount, const std::function<void(unsigned int)>& job)
+{
+	if (jobCount == 0) { return; }
+
+	//-------------------------------------------- Nobody to share with, or nothing worth sharing, so don't wake anyone
+	if (m_threads.empty() || jobCount == 1) {
+		for (unsigned int i = 0; i < jobCount; i++) { job(i); }
+		return;
+	}
+
+	std::unique_lock<std::mutex> lock(m_mutex);
+
+	//-------------------------------------------- A worker still looking for work from the last dispatch has to be out of the queues before they're refilled
+	m_doneCondition.wait(lock, [this]() { return m_busyWorkers == 0; });
+
+	m_job			= &job;
+	m_jobsRemaining	= jobCount;
+
+	//-------------------------------------------- Each thread starts with its own even, unbroken run of jobs
+	unsigned int queueCount = m_queues.size();
+
+	for (unsigned int i = 0; i < queueCount; i++) {
+		std::lock_guard<std::mutex> queueLock(m_queues[i]->mutex);
+
+		m_queues[i]->begin	= (unsigned int)((unsigned long long)jobCount * i / queueCount);
+		m_queues[i]->end	= (unsigned int)((unsigned long long)jobCount * (i + 1) / queueCount);
+	}
+
+	++m_generation;
+	m_wakeCondition.notify_all();
+
+	//-------------------------------------------- Help out rather than sit idle, then wait for any runs still going on the workers
+	lock.unlock();
+	RunJobs(queueCount - 1);
+	lock.lock();
+
+	m_doneCondition.wait(lock, [this]() { return m_jobsRemaining == 0; });
+}
+
+
+/*******************************************************************************************************************
+	Function that runs jobs from a thread's own queue, then steals from the others until there are none left
+*******************************************************************************************************************/
+void ThreadPool::RunJobs(unsigned int queue)
+{
+	unsigned int jobIndex = 0;
+
+	while (TakeJob(queue, jobIndex) || StealJob(queue, jobIndex)) {
+
+		(*m_job)(jobIndex);
+
+		//-------------------------------------------- The last run to finish wakes the dispatching thread
+		if (--m_jobsRemaining == 0) {
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_doneCondition.notify_all();
+		}
+	}
+}
+
+
+/*******************************************************************************************************************
+	Function that takes the next job from the front of a thread's own queue
+*******************************************************************************************************************/
+bool ThreadPool::TakeJob(unsigned int queue, unsigned int& jobIndex)
+{
+	JobQueue& jobs = *m_queues[queue];
+	std::lock_guard<std::mutex> lock(jobs.mutex);
+
+	if (jobs.begin == jobs.end) { return false; }
+
+	jobIndex = jobs.begin++;
+
+	return true;
+}
+
+
+/*******************************************************************************************************************
+	Function that takes a job from the back of another thread's queue - false once every queue is empty
+*******************************************************************************************************************/
+bool ThreadPool::StealJob(unsigned int thief, unsigned int& jobIndex)
+{
+	unsigned int queueCount = m_queues.size();
+
+	//-------------------------------------------- Start with the next thread along, so thieves don't all pile on to the same one
+	for (unsigned int i = 1; i < queueCount; i++) {
+		JobQueue& jobs = *m_queues[(thief + i) % queueCount];
+		std::lock_guard<std::mutex> lock(jobs.mutex);
+
+		if (jobs.begin == jobs.end) { continue; }
+
+		jobIndex = --jobs.end;
+
+		return true;
+	}
+
+	return false;
+}
+
+
+/*******************************************************************************************************************
+	Function that each worker thread runs - sleeps until there is a new dispatch, helps with it, then sleeps again
+*******************************************************************************************************************/
+void ThreadPool::WorkerLoop(unsigned int queue)
+{
+	DX_PROFILE_THREAD("Worker");
+
+	std::unique_lock<std::mutex> lock(m_mutex);
+
+	unsigned int lastGeneration = m_generation;
+
+	while (true) {
+
+		m_wakeCondition.wait(lock, [this, lastGeneration]() { return !m_isRunning || m_generation != lastGeneration; });
+
+		if (!m_isRunning) { return; }
+
+		lastGeneration = m_generation;
+		m_busyWorkers++;
+
+		lock.unlock();
+		{
+			DX_PROFILE_SCOPE("Jobs");
+			RunJobs(queue);
+		}
+		lock.lock();
+
+		if (--m_busyWorkers == 0) { m_doneCondition.notify_all(); }
+	}
+}
+
+
+/*******************************************************************************************************************
+	Accessor Methods
+*******************************************************************************************************************/
+unsigned int ThreadPool::GetThreadCount() const { return m_threads.size(); }
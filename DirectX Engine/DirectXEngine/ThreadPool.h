@@ -0,0 +1,75 @@
+#pragma once
+
+/*******************************************************************************************************************
+	ThreadPool.h, ThreadPool.cpp
+	Created by Kim Kane
+	Last updated: 19/10/2026
+
+	A fixed set of worker threads that sit asleep until they are given work.
+
+	Dispatch() runs a job a number of times, passing each run its index, spread across the workers and the
+	calling thread. It only returns once every run has finished, so anything the job writes can be read
+	straight afterwards without any further locking.
+
+	Each thread is handed an even share of the runs up front, in its own queue with its own lock. It works
+	through its share from the front, and once that's gone it steals from the back of another thread's
+	share. Threads only meet when one runs dry, so uneven jobs still finish together without every run
+	queuing on one lock.
+
+*******************************************************************************************************************/
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class ThreadPool {
+
+public:
+	ThreadPool();
+	~ThreadPool();
+
+public:
+	bool Initialize(unsigned int threadCount);
+	void Shutdown();
+
+public:
+	void Dispatch(unsigned int jobCount, const std::function<void(unsigned int)>& job);
+	unsigned int GetThreadCount() const;
+
+private:
+	ThreadPool(const ThreadPool&);
+	ThreadPool& operator=(const ThreadPool&);
+
+private:
+	//-------------------------------------------- The runs one thread owns - it takes from the front, other threads steal from the back
+	struct JobQueue
+	{
+		std::mutex		mutex;
+		unsigned int	begin;
+		unsigned int	end;
+	};
+
+private:
+	void WorkerLoop(unsigned int queue);
+	void RunJobs(unsigned int queue);
+	bool TakeJob(unsigned int queue, unsigned int& jobIndex);
+	bool StealJob(unsigned int thief, unsigned int& jobIndex);
+
+private:
+	std::vector<std::thread>					m_threads;
+	std::mutex									m_mutex;
+	std::condition_variable						m_wakeCondition;
+	std::condition_variable						m_doneCondition;
+
+	//-------------------------------------------- One queue per worker, and the last one for the thread that dispatches
+	std::vector<std::unique_ptr<JobQueue>>		m_queues;
+
+	const std::function<void(unsigned int)>*	m_job;
+	std::atomic<unsigned int>					m_jobsRemaining;
+	unsigned int								m_busyWorkers;
+	unsigned int								m_generation;
+	bool										m_isRunning;
+};
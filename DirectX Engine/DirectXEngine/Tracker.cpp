@@ -1,33 +1,34 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+
 #include "Tracker.h"
+#include "Log.h"
 
 /*******************************************************************************************************************
-	Function that initializes all the trackers default settings
+	Function that initializes all the trackers default settings - times come from the clock given, or the system clock
 *******************************************************************************************************************/
-bool Tracker::Initialize()
+bool Tracker::Initialize(Clock* clock)
 {
-	//-------------------------------------------- Initialize the timer tracker for the in-game delta time
-
-	//-------------------------------------------- Check to see if this system supports high performance timers.
-	QueryPerformanceFrequency((LARGE_INTEGER*)&m_frequency);
-	if (m_frequency == 0) { return false; }
+	static SystemClock systemClock;
 
-	//-------------------------------------------- Find out how many times the frequency counter ticks every millisecond
-	m_ticksPerMs = (float)(m_frequency / 1000);
-	QueryPerformanceCounter((LARGE_INTEGER*)&m_startTime);
+	//-------------------------------------------- Initialize the timer tracker for the in-game delta time
+	m_clock = (clock) ? clock : &systemClock;
+	m_startTime = m_clock->GetTime();
 
 	//-------------------------------------------- Initialize the frames per second tracker, for outputting to screen using 2D font rendering
-	m_startFps = timeGetTime();
-
-	//-------------------------------------------- Initialize the CPU tracker, which allows us to query the usage of CPU
-	PDH_STATUS status;
+	m_startFps = m_startTime;
+	m_count = 0;
 
-	//-------------------------------------------- Create a query object to poll CPU usage
-	status = PdhOpenQuery(nullptr, 0, &m_queryHandle);
-	if (status != ERROR_SUCCESS) { m_canReadCpu = false; }
+	//-------------------------------------------- Initialize the CPU tracker, which allows us to query the usage of CPU - the frame trackers still work without it
+	m_canReadCpu = m_cpuMonitor.Initialize();
+	m_startProcessTime = m_clock->GetProcessTime();
 
-	//-------------------------------------------- Set query object to poll all CPU's in the system
-	status = PdhAddCounter(m_queryHandle, TEXT("\\Processor(_Total)\\% processor time"), 0, &m_counterHandle);
-	if (status != ERROR_SUCCESS) { m_canReadCpu = false; }
+	//-------------------------------------------- Start the frame statistics again
+	m_frameIndex = m_frameCount = 0;
+	memset(&m_frameStats, 0, sizeof(m_frameStats));
 
 	return true;
 }
@@ -38,52 +39,105 @@ bool Tracker::Initialize()
 *******************************************************************************************************************/
 void Tracker::Update()
 {
-	//-------------------------------------------- Update delta time
-	INT64 currentTime = 0;
-	float timeDifference = 0;
-	
 	//--------------------------------------------  Query the current time
-	QueryPerformanceCounter((LARGE_INTEGER*)&currentTime);
+	double currentTime = m_clock->GetTime();
 
-	//--------------------------------------------  Calculate the difference in time since the last time we queried for the current time
-	timeDifference = (float)(currentTime - m_startTime);
-
-	//--------------------------------------------  Calculate the frame time by the time difference over the timer speed resolution
-	m_frameTime = timeDifference / m_ticksPerMs;
+	//--------------------------------------------  Calculate the frame time in milliseconds, from the difference in time since the last time we queried for the current time
+	m_frameTime = (float)((currentTime - m_startTime) * 1000.0);
 
 	//--------------------------------------------  Restart the timer
 	m_startTime = currentTime;
 
+	//-------------------------------------------- Keep the frame time for the frame statistics, over the top of the oldest once the ring is full
+	m_frameTimes[m_frameIndex] = m_frameTime;
+	m_frameIndex = (m_frameIndex + 1) % TrackerConstants::FrameHistory;
+	if (m_frameCount < TrackerConstants::FrameHistory) { m_frameCount++; }
+
 	//-------------------------------------------- Update frames per second (FPS)
 	m_count++;
 
-	//-------------------------------------------- If one second has passed then update the frame per second speed
-	if (timeGetTime() >= (m_startFps + 1000))
+	//-------------------------------------------- If one second has passed then update the frame per second speed, and everything else that's measured over a second
+	if (currentTime >= m_startFps + 1.0)
 	{
 		m_framesPerSec = m_count;
 		m_count = 0;
 
-		m_startFps = timeGetTime();
+		UpdateFrameStats();
+
+		//-------------------------------------------- Update CPU usage - the process's is its CPU time over all the time every core had
+		if (m_canReadCpu) { m_cpuMonitor.Sample(); }
+
+		unsigned int coreCount = (m_cpuMonitor.GetCoreCount() > 0) ? m_cpuMonitor.GetCoreCount() : (std::max)(std::thread::hardware_concurrency(), 1u);
+		double processTime = m_clock->GetProcessTime();
+
+		m_processUsage = (float)(100.0 * (processTime - m_startProcessTime) / ((currentTime - m_startFps) * coreCount));
+		m_startProcessTime = processTime;
+
+		m_startFps = currentTime;
 	}
+}
 
-	//-------------------------------------------- Update CPU usage
-	PDH_FMT_COUNTERVALUE value;
 
-	if (m_canReadCpu)
-	{
-		//-------------------------------------------- If it has been 1 second then update the current CPU usage and reset the 1 second timer again
-		if ((m_lastSampleTime + 1000) < GetTickCount())
-		{
-			m_lastSampleTime = GetTickCount();
+/*******************************************************************************************************************
+	Function that sums up the latest frame times - percentiles are nearest rank, so each is a frame time that really happened
+*******************************************************************************************************************/
+void Tracker::UpdateFrameStats()
+{
+	memset(&m_frameStats, 0, sizeof(m_frameStats));
+	if (m_frameCount == 0) { return; }
+
+	//-------------------------------------------- The order in the ring doesn't matter for any of this, so sort a copy of whatever's filled
+	m_sortedTimes.assign(m_frameTimes, m_frameTimes + m_frameCount);
+	std::sort(m_sortedTimes.begin(), m_sortedTimes.end());
 
-			PdhCollectQueryData(m_queryHandle);
+	double total = 0.0;
 
-			PdhGetFormattedCounterValue(m_counterHandle, PDH_FMT_LONG, NULL, &value);
+	for (unsigned int i = 0; i < m_frameCount; i++) {
+		total += m_sortedTimes[i];
 
-			m_cpuUsage = value.longValue;
-		}
+		unsigned int bucket = (unsigned int)(m_sortedTimes[i] / TrackerConstants::BucketWidth);
+		m_frameStats.histogram[(std::min)(bucket, TrackerConstants::HistogramBuckets - 1)]++;
 	}
 
+	//-------------------------------------------- The smallest frame time that this percentage of frames are no slower than
+	auto percentile = [](float percent) {
+		unsigned int rank = (unsigned int)ceil(percent / 100.0f * m_frameCount);
+		return m_sortedTimes[(std::max)(rank, 1u) - 1];
+	};
+
+	m_frameStats.count	= m_frameCount;
+	m_frameStats.min	= m_sortedTimes.front();
+	m_frameStats.max	= m_sortedTimes.back();
+	m_frameStats.mean	= (float)(total / m_frameCount);
+	m_frameStats.p50	= percentile(50.0f);
+	m_frameStats.p95	= percentile(95.0f);
+	m_frameStats.p99	= percentile(99.0f);
+}
+
+
+/*******************************************************************************************************************
+	Function that writes the latest frame times out as a CSV, oldest first
+*******************************************************************************************************************/
+bool Tracker::WriteFrameTimes(const std::string& fileLocation)
+{
+	FILE* file = fopen(fileLocation.c_str(), "w");
+	if (!file) { DX_LOG("[TRACKER] Couldn't write frame times: ", fileLocation.c_str(), LOG_ERROR); return false; }
+
+	fputs("Frame,Time (ms)\n", file);
+
+	//-------------------------------------------- Until the ring is full the oldest is at the start, after that it's the next one to be written over
+	unsigned int oldest = (m_frameCount < TrackerConstants::FrameHistory) ? 0 : m_frameIndex;
+
+	for (unsigned int i = 0; i < m_frameCount; i++) {
+		fprintf(file, "%u,%.4f\n", i, m_frameTimes[(oldest + i) % TrackerConstants::FrameHistory]);
+	}
+
+	bool isWritten = (ferror(file) == 0);
+	fclose(file);
+
+	DX_LOG("[TRACKER] Frame times written to: ", fileLocation.c_str(), LOG_SUCCESS);
+
+	return isWritten;
 }
 
 
@@ -92,7 +146,8 @@ void Tracker::Update()
 *******************************************************************************************************************/
 void Tracker::Shutdown()
 {
-	if (m_canReadCpu) { PdhCloseQuery(m_queryHandle); m_queryHandle = nullptr; }
+	m_cpuMonitor.Shutdown();
+	m_canReadCpu = false;
 }
 
 
@@ -102,32 +157,42 @@ void Tracker::Shutdown()
 float Tracker::GetTime()	{ return m_frameTime; }
 int Tracker::GetFps()		{ return m_framesPerSec; }
 
+const FrameStats& Tracker::GetFrameStats() { return m_frameStats; }
+
 int Tracker::GetCpuPercentage()
 {
 	int usage = 0;
 
 	//-------------------------------------------- If we can read the CPU from the operating system then return the current usage.  If not then return zero.
-	if (m_canReadCpu)	{ usage = (int)m_cpuUsage; }
+	if (m_canReadCpu)	{ usage = (int)m_cpuMonitor.GetTotalUsage(); }
 	else				{ usage = 0; }
 
 	return usage;
 }
 
+int Tracker::GetProcessCpuPercentage()					{ return (int)m_processUsage; }
+unsigned int Tracker::GetCoreCount()					{ return m_cpuMonitor.GetCoreCount(); }
+int Tracker::GetCoreCpuPercentage(unsigned int core)	{ return (int)m_cpuMonitor.GetCoreUsage(core); }
+
 
 /*******************************************************************************************************************
 	Static variables initialization
 *******************************************************************************************************************/
-INT64 Tracker::m_frequency					= 0;
-float Tracker::m_ticksPerMs					= 0;
-INT64 Tracker::m_startTime					= 0;
+Clock* Tracker::m_clock						= nullptr;
+double Tracker::m_startTime					= 0;
 float Tracker::m_frameTime					= 0;
 
 int Tracker::m_framesPerSec					= 0;
 int Tracker::m_count						= 0;
-unsigned long Tracker::m_startFps			= 0;
-
-bool Tracker::m_canReadCpu					= true;
-HQUERY Tracker::m_queryHandle				= nullptr;
-HCOUNTER Tracker::m_counterHandle			= nullptr;
-unsigned long Tracker::m_lastSampleTime		= GetTickCount();
-long Tracker::m_cpuUsage					= 0;
\ No newline at end of file
+double Tracker::m_startFps					= 0;
+
+bool Tracker::m_canReadCpu					= false;
+CpuMonitor Tracker::m_cpuMonitor;
+double Tracker::m_startProcessTime			= 0;
+float Tracker::m_processUsage				= 0;
+
+float Tracker::m_frameTimes[TrackerConstants::FrameHistory];
+unsigned int Tracker::m_frameIndex			= 0;
+unsigned int Tracker::m_frameCount			= 0;
+std::vector<float> Tracker::m_sortedTimes;
+FrameStats Tracker::m_frameStats			= {};
\ No newline at end of file
@@ -3,22 +3,45 @@
 /*******************************************************************************************************************
 	Tracker.h, Tracker.cpp
 	Created by Kim Kane
-	Last updated: 27/01/2018
+	Last updated: 19/10/2026
 
 	Static class that keeps track of the delta time, FPS and CPU usage of users PC.
 
+	The FPS is an average, so it hides the odd slow frame - which is what's seen as a stutter. So the latest
+	frame times are also kept in a ring, and once a second (along with the FPS) they're summed up in to
+	FrameStats: the best, worst and mean, the 50th, 95th and 99th percentiles, and a histogram. The 99th
+	percentile is the one to watch - 1 frame in 100 is slower than it. WriteFrameTimes() writes the ring out
+	as a CSV, oldest first, for a closer look.
+
+	Time comes from a Clock and CPU usage from a CpuMonitor, so the trackers work off Windows too, and can be
+	driven by a FakeClock in tests. The CPU usage is the whole machine's, each core's and this process's.
+
 *******************************************************************************************************************/
-#pragma comment(lib, "pdh.lib")
-#pragma comment(lib, "winmm.lib")
+#include <string>
+#include <vector>
+
+#include "Clock.h"
+#include "Constants.h"
 
-#include <pdh.h>
-#include <Windows.h>
-#include <mmsystem.h>
+//-------------------------------------------- A summary of the latest frame times, all in milliseconds
+struct FrameStats
+{
+	unsigned int	count;
+	float			min;
+	float			max;
+	float			mean;
+	float			p50;
+	float			p95;
+	float			p99;
+
+	//-------------------------------------------- How many frames took between i and i + 1 bucket widths
+	unsigned int	histogram[TrackerConstants::HistogramBuckets];
+};
 
 class Tracker {
 
 public:
-	static bool Initialize();
+	static bool Initialize(Clock* clock = nullptr);
 	static void Update();
 	static void Shutdown();
 
@@ -26,23 +49,38 @@ public:
 	static float GetTime();
 	static int GetFps();
 	static int GetCpuPercentage();
+	static int GetProcessCpuPercentage();
+	static unsigned int GetCoreCount();
+	static int GetCoreCpuPercentage(unsigned int core);
+	static const FrameStats& GetFrameStats();
+
+public:
+	static bool WriteFrameTimes(const std::string& fileLocation);
 
 private:
 	Tracker();
 
 private:
-	static INT64			m_frequency;
-	static float			m_ticksPerMs;
-	static INT64			m_startTime;
+	static void UpdateFrameStats();
+
+private:
+	static Clock*			m_clock;
+	static double			m_startTime;
 	static float			m_frameTime;
 
 	static int				m_framesPerSec;
 	static int				m_count;
-	static unsigned long	m_startFps;
+	static double			m_startFps;
 
 	static bool				m_canReadCpu;
-	static HQUERY			m_queryHandle;
-	static HCOUNTER			m_counterHandle;
-	static unsigned long	m_lastSampleTime;
-	static long				m_cpuUsage;
+	static CpuMonitor		m_cpuMonitor;
+	static double			m_startProcessTime;
+	static float			m_processUsage;
+
+	//-------------------------------------------- The latest frame times, with the oldest written over first
+	static float			m_frameTimes[TrackerConstants::FrameHistory];
+	static unsigned int		m_frameIndex;
+	static unsigned int		m_frameCount;
+	static std::vector<float>	m_sortedTimes;
+	static FrameStats		m_frameStats;
 };
\ No newline at end of file
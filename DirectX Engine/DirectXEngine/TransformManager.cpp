@@ -0,0 +1,249 @@
+#include "TransformManager.h"
+
+/*******************************************************************************************************************
+	Constructor with initializer list to set all default values of variables
+*******************************************************************************************************************/
+TransformManager::TransformManager()	:	m_count(0)
+{
+}
+
+
+/*******************************************************************************************************************
+	Function that creates a transform at the position given, with no rotation and a scale of 1
+*******************************************************************************************************************/
+TransformHandle TransformManager::Create(const XMFLOAT3& position)
+{
+	TransformHandle transform = m_count;
+
+	//-------------------------------------------- Reuse a released slot if there is one, otherwise take the next one on the end
+	if (!m_freeTransforms.empty()) {
+		transform = m_freeTransforms.back();
+		m_freeTransforms.pop_back();
+	}
+	else {
+		if (m_count == m_positionX.size()) {
+
+			//-------------------------------------------- Double the room each time, keeping every array a whole number of SIMD groups
+			size_t capacity = (m_count < 4) ? 4 : m_count * 2;
+
+			m_positionX.resize(capacity, 0.0f); m_positionY.resize(capacity, 0.0f); m_positionZ.resize(capacity, 0.0f);
+			m_rotationX.resize(capacity, 0.0f);	m_rotationY.resize(capacity, 0.0f);	m_rotationZ.resize(capacity, 0.0f);	m_rotationW.resize(capacity, 1.0f);
+			m_scaleX.resize(capacity, 1.0f);	m_scaleY.resize(capacity, 1.0f);	m_scaleZ.resize(capacity, 1.0f);
+
+			m_worldMatrices.resize(capacity);
+			m_dirty.resize((capacity + 31) / 32, 0);
+		}
+
+		m_count++;
+	}
+
+	m_positionX[transform] = position.x;	m_positionY[transform] = position.y;	m_positionZ[transform] = position.z;
+	m_rotationX[transform] = 0.0f;			m_rotationY[transform] = 0.0f;			m_rotationZ[transform] = 0.0f;			m_rotationW[transform] = 1.0f;
+	m_scaleX[transform] = 1.0f;				m_scaleY[transform] = 1.0f;				m_scaleZ[transform] = 1.0f;
+
+	MarkDirty(transform);
+
+	return transform;
+}
+
+
+/*******************************************************************************************************************
+	Function that hands a transform's slot back to be reused
+*******************************************************************************************************************/
+void TransformManager::Release(TransformHandle transform)
+{
+	if (transform >= m_count) { return; }
+
+	m_freeTransforms.push_back(transform);
+}
+
+
+/*******************************************************************************************************************
+	Function that moves a transform to the position given
+*******************************************************************************************************************/
+void TransformManager::SetPosition(TransformHandle transform, const XMFLOAT3& position)
+{
+	m_positionX[transform] = position.x;
+	m_positionY[transform] = position.y;
+	m_positionZ[transform] = position.z;
+
+	MarkDirty(transform);
+}
+
+
+/*******************************************************************************************************************
+	Function that moves a transform by the distance given along each axis
+*******************************************************************************************************************/
+void TransformManager::Translate(TransformHandle transform, float x, float y, float z)
+{
+	m_positionX[transform] += x;
+	m_positionY[transform] += y;
+	m_positionZ[transform] += z;
+
+	MarkDirty(transform);
+}
+
+
+/*******************************************************************************************************************
+	Function that rotates a transform by a quaternion, about the transform's own axes
+*******************************************************************************************************************/
+void TransformManager::Rotate(TransformHandle transform, FXMVECTOR rotation)
+{
+	//-------------------------------------------- The new rotation is applied first, so it turns about the object's axes rather than the world's
+	XMVECTOR current = GetRotation(transform);
+
+	SetRotation(transform, XMQuaternionMultiply(rotation, current));
+}
+
+
+/*******************************************************************************************************************
+	Function that sets the rotation of a transform to the quaternion given
+*******************************************************************************************************************/
+void TransformManager::SetRotation(TransformHandle transform, FXMVECTOR rotation)
+{
+	//-------------------------------------------- Renormalize, so rounding errors can't build up in to a scale over many rotations
+	XMFLOAT4 normalized;
+	XMStoreFloat4(&normalized, XMQuaternionNormalize(rotation));
+
+	m_rotationX[transform] = normalized.x;
+	m_rotationY[transform] = normalized.y;
+	m_rotationZ[transform] = normalized.z;
+	m_rotationW[transform] = normalized.w;
+
+	MarkDirty(transform);
+}
+
+
+/*******************************************************************************************************************
+	Function that sets the scale of a transform along each axis
+*******************************************************************************************************************/
+void TransformManager::SetScale(TransformHandle transform, const XMFLOAT3& scale)
+{
+	m_scaleX[transform] = scale.x;
+	m_scaleY[transform] = scale.y;
+	m_scaleZ[transform] = scale.z;
+
+	MarkDirty(transform);
+}
+
+
+/*******************************************************************************************************************
+	Function that rebuilds the world matrix of every transform that has changed since the last time
+*******************************************************************************************************************/
+void TransformManager::UpdateWorldMatrices()
+{
+	for (unsigned int word = 0; word < m_dirty.size(); word++) {
+
+		//-------------------------------------------- Most transforms don't move every frame, so skip 32 at a time
+		if (m_dirty[word] == 0) { continue; }
+
+		for (unsigned int group = 0; group < 32; group += 4) {
+			if (((m_dirty[word] >> group) & 0xF) == 0) { continue; }
+
+			BuildWorldMatrices(word * 32 + group);
+		}
+
+		m_dirty[word] = 0;
+	}
+}
+
+
+/*******************************************************************************************************************
+	Function that flags a transform's world matrix as needing rebuilding
+*******************************************************************************************************************/
+void TransformManager::MarkDirty(TransformHandle transform)
+{
+	m_dirty[transform >> 5] |= (1u << (transform & 31));
+}
+
+
+/*******************************************************************************************************************
+	Function that checks whether a transform's world matrix needs rebuilding
+*******************************************************************************************************************/
+bool TransformManager::IsDirty(TransformHandle transform) const
+{
+	return (m_dirty[transform >> 5] & (1u << (transform & 31))) != 0;
+}
+
+
+/*******************************************************************************************************************
+	Function that builds the world matrices of 4 transforms at once, starting at the one given
+*******************************************************************************************************************/
+void TransformManager::BuildWorldMatrices(unsigned int first)
+{
+	//-------------------------------------------- Each vector holds the same component of all 4 transforms
+	XMVECTOR x = XMLoadFloat4((const XMFLOAT4*)&m_rotationX[first]);
+	XMVECTOR y = XMLoadFloat4((const XMFLOAT4*)&m_rotationY[first]);
+	XMVECTOR z = XMLoadFloat4((const XMFLOAT4*)&m_rotationZ[first]);
+	XMVECTOR w = XMLoadFloat4((const XMFLOAT4*)&m_rotationW[first]);
+
+	XMVECTOR scaleX = XMLoadFloat4((const XMFLOAT4*)&m_scaleX[first]);
+	XMVECTOR scaleY = XMLoadFloat4((const XMFLOAT4*)&m_scaleY[first]);
+	XMVECTOR scaleZ = XMLoadFloat4((const XMFLOAT4*)&m_scaleZ[first]);
+
+	//-------------------------------------------- The same rotation matrix XMMatrixRotationQuaternion builds, 4 quaternions at a time
+	XMVECTOR zero	= XMVectorZero();
+	XMVECTOR one	= XMVectorSplatOne();
+	XMVECTOR two	= one + one;
+
+	XMVECTOR xx = x * x * two,	yy = y * y * two,	zz = z * z * two;
+	XMVECTOR xy = x * y * two,	xz = x * z * two,	yz = y * z * two;
+	XMVECTOR xw = x * w * two,	yw = y * w * two,	zw = z * w * two;
+
+	XMMATRIX right(		(one - yy - zz) * scaleX,
+						(xy + zw) * scaleX,
+						(xz - yw) * scaleX,
+						zero);
+
+	XMMATRIX up(		(xy - zw) * scaleY,
+						(one - xx - zz) * scaleY,
+						(yz + xw) * scaleY,
+						zero);
+
+	XMMATRIX forward(	(xz + yw) * scaleZ,
+						(yz - xw) * scaleZ,
+						(one - xx - yy) * scaleZ,
+						zero);
+
+	XMMATRIX position(	XMLoadFloat4((const XMFLOAT4*)&m_positionX[first]),
+						XMLoadFloat4((const XMFLOAT4*)&m_positionY[first]),
+						XMLoadFloat4((const XMFLOAT4*)&m_positionZ[first]),
+						one);
+
+	//-------------------------------------------- Swap rows and columns, so each row holds one transform's values
+	right		= XMMatrixTranspose(right);
+	up			= XMMatrixTranspose(up);
+	forward		= XMMatrixTranspose(forward);
+	position	= XMMatrixTranspose(position);
+
+	for (unsigned int i = 0; i < 4; i++) {
+		XMStoreFloat4x4(&m_worldMatrices[first + i], XMMATRIX(right.r[i], up.r[i], forward.r[i], position.r[i]));
+	}
+}
+
+
+/*******************************************************************************************************************
+	Accessor Methods
+*******************************************************************************************************************/
+XMFLOAT3 TransformManager::GetPosition(TransformHandle transform) const	{ return XMFLOAT3(m_positionX[transform], m_positionY[transform], m_positionZ[transform]); }
+XMVECTOR TransformManager::GetRotation(TransformHandle transform) const	{ return XMVectorSet(m_rotationX[transform], m_rotationY[transform], m_rotationZ[transform], m_rotationW[transform]); }
+XMFLOAT3 TransformManager::GetScale(TransformHandle transform) const		{ return XMFLOAT3(m_scaleX[transform], m_scaleY[transform], m_scaleZ[transform]); }
+unsigned int TransformManager::GetCount() const								{ return m_count - m_freeTransforms.size(); }
+
+XMMATRIX TransformManager::GetRotationMatrix(TransformHandle transform) const
+{
+	return XMMatrixRotationQuaternion(GetRotation(transform));
+}
+
+XMMATRIX TransformManager::GetWorldMatrix(TransformHandle transform)
+{
+	//-------------------------------------------- Asked for before this frame's pass, so bring its group up to date now
+	if (IsDirty(transform)) {
+		unsigned int first = transform & ~3u;
+
+		BuildWorldMatrices(first);
+		m_dirty[first >> 5] &= ~(0xFu << (first & 31));
+	}
+
+	return XMLoadFloat4x4(&m_worldMatrices[transform]);
+}
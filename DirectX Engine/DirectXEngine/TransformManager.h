@@ -0,0 +1,87 @@
+#pragma once
+
+/*******************************************************************************************************************
+	TransformManager.h, TransformManager.cpp
+	Created by Kim Kane
+	Last updated: 19/10/2026
+
+	Singleton class that stores the position, rotation and scale of every game object.
+
+	Each component is kept in its own tightly packed array (x's together, y's together, etc.) rather than
+	inside each object, and a game object only holds a handle in to them. Moving or rotating an object just
+	writes a few floats and sets its dirty bit - nothing else happens until the world matrix is needed.
+
+	Rotations are stored as quaternions. Rotating composes the new rotation on with one quaternion multiply,
+	so there's no sin/cos of accumulated angles per call, and renormalizing keeps the rotation from drifting
+	however many times it's applied. Matrices are only made from the quaternion when one is asked for.
+
+	UpdateWorldMatrices() is the one pass per frame that brings every dirty world matrix up to date. It works
+	on 4 transforms at a time, loading the same component of each in to one vector, so one run of SIMD maths
+	builds 4 matrices. Runs of 32 clean transforms are skipped with a single test of the dirty bits.
+
+	Handles stay valid until released, and released slots are reused by the next transform created.
+
+*******************************************************************************************************************/
+#include <d3d11.h>
+#include <xnamath.h>
+#include <vector>
+
+#include "Singleton.h"
+
+typedef unsigned int TransformHandle;
+
+const TransformHandle INVALID_TRANSFORM = 0xFFFFFFFF;
+
+class TransformManager {
+
+public:
+	friend class Singleton<TransformManager>;
+
+public:
+	TransformHandle Create(const XMFLOAT3& position);
+	void Release(TransformHandle transform);
+
+public:
+	void SetPosition(TransformHandle transform, const XMFLOAT3& position);
+	void Translate(TransformHandle transform, float x, float y, float z);
+	void Rotate(TransformHandle transform, FXMVECTOR rotation);
+	void SetRotation(TransformHandle transform, FXMVECTOR rotation);
+	void SetScale(TransformHandle transform, const XMFLOAT3& scale);
+
+public:
+	void UpdateWorldMatrices();
+
+public:
+	XMFLOAT3 GetPosition(TransformHandle transform) const;
+	XMVECTOR GetRotation(TransformHandle transform) const;
+	XMFLOAT3 GetScale(TransformHandle transform) const;
+	XMMATRIX GetRotationMatrix(TransformHandle transform) const;
+	XMMATRIX GetWorldMatrix(TransformHandle transform);
+	unsigned int GetCount() const;
+
+private:
+	void MarkDirty(TransformHandle transform);
+	bool IsDirty(TransformHandle transform) const;
+	void BuildWorldMatrices(unsigned int first);
+
+private:
+	TransformManager();
+	TransformManager(const TransformManager&);
+	TransformManager& operator=(const TransformManager&);
+
+private:
+	//-------------------------------------------- One array per component, always a multiple of 4 long so the SIMD pass never reads off the end
+	std::vector<float>				m_positionX, m_positionY, m_positionZ;
+	std::vector<float>				m_rotationX, m_rotationY, m_rotationZ, m_rotationW;
+	std::vector<float>				m_scaleX, m_scaleY, m_scaleZ;
+
+	std::vector<XMFLOAT4X4>			m_worldMatrices;
+
+	//-------------------------------------------- One bit per transform, set when it changes and cleared when its world matrix is rebuilt
+	std::vector<unsigned int>		m_dirty;
+
+	std::vector<TransformHandle>	m_freeTransforms;
+	unsigned int					m_count;
+};
+
+typedef Singleton<TransformManager> Transforms;
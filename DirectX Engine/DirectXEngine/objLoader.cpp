@@ -2,6 +2,7 @@
 #include "FileManager.h"
 #include "Constants.h"
 #include "Log.h"
+#include "Profiler.h"
 #include "Tools.h"
 
 /*******************************************************************************************************************
@@ -27,8 +28,54 @@ ObjLoader::~ObjLoader()
 *******************************************************************************************************************/
 bool ObjLoader::LoadObjFile(const char* fileLocation, std::vector<XMFLOAT3>& outVertices, std::vector<XMFLOAT2>& outTextureCoords, std::vector<XMFLOAT3>& outNormals, std::vector<unsigned int>& outIndices)
 {
+	DX_PROFILE_FUNCTION();
+
+	if (!ReadObjFile(fileLocation)) { return false; }
+
+	//---------------------------------------------------------------- As we want to draw elements index-based (to avoid duplicated vertex data), we then call this function, which checks for multiple vertex data and then finally pushes the data to the out vectors
+	PushData(outVertices, outTextureCoords, outNormals, outIndices);
+
+	return true;
+}
+
+
+/*******************************************************************************************************************
+	Load an OBJ file and store every face corner, in face order, without merging duplicates
+	Used by animations, which can only merge corners that are the same in every frame, not just in this one
+*******************************************************************************************************************/
+bool ObjLoader::LoadObjFile(const char* fileLocation, std::vector<BufferConstants::PackedVertex>& outCorners)
+{
+	DX_PROFILE_FUNCTION();
+
+	if (!ReadObjFile(fileLocation)) { return false; }
+
+	outCorners.resize(m_vertices.size());
+
+	for (unsigned int i = 0; i < m_vertices.size(); i++) {
+		BufferConstants::PackedVertex packed = { m_vertices[i], m_textureCoords[i], m_normals[i] };
+		outCorners[i] = packed;
+	}
+
+	m_vertices.clear();
+	m_textureCoords.clear();
+	m_normals.clear();
+
+	return true;
+}
+
+
+/*******************************************************************************************************************
+	Function that reads an OBJ file and stores one vertex, texture coordinate and normal per face corner
+*******************************************************************************************************************/
+bool ObjLoader::ReadObjFile(const char* fileLocation)
+{
+	DX_PROFILE_FUNCTION();
+
+	//---------------------------------------------------------------- Keep hold of the file manager, as it's used for every line read
+	FileManager* file = File::Instance();
+
 	//---------------------------------------------------------------- Open the OBJ file for reading only
-	if (!File::Instance()->OpenForReading(fileLocation)) { return false; }
+	if (!file->OpenForReading(fileLocation)) { return false; }
 
 	//---------------------------------------------------------------- Generate temporary vectors to store the faces/indices data
 	std::vector<unsigned int> vertexIndices, textureCoordIndices, normalIndices;
@@ -39,13 +86,13 @@ bool ObjLoader::LoadObjFile(const char* fileLocation, std::vector<XMFLOAT3>& out
 	std::vector<XMFLOAT3> inNormals;
 
 	//---------------------------------------------------------------- Get all the data from the file
-	while (File::Instance()->ExtractFileData()) {
+	while (file->ExtractFileData()) {
 
 		//---------------------------------------------------------------- Check if the file contains "v", "vt", or "vn", remove this part of the string and read in the object data only
-		if		(File::Instance()->FileDataContains(FileConstants::Vertices))		{ GetVertices(inVertices); }
-		else if (File::Instance()->FileDataContains(FileConstants::TextureCoords))	{ GetTextureCoords(inTextureCoords); }
-		else if (File::Instance()->FileDataContains(FileConstants::Normals))		{ GetNormals(inNormals); }
-		else if (File::Instance()->FileDataContains(FileConstants::Faces))			{ GetIndices(vertexIndices, textureCoordIndices, normalIndices); }
+		if		(file->FileDataContains(FileConstants::Vertices))		{ GetVertices(inVertices); }
+		else if (file->FileDataContains(FileConstants::TextureCoords))	{ GetTextureCoords(inTextureCoords); }
+		else if (file->FileDataContains(FileConstants::Normals))		{ GetNormals(inNormals); }
+		else if (file->FileDataContains(FileConstants::Faces))			{ GetIndices(vertexIndices, textureCoordIndices, normalIndices); }
 	}
 
 	//---------------------------------------------------------------- We then need to calibrate the indices (-1 all indices) before we push the data in to the m_vertices, m_textureCoords and m_normals vectors, because arrays in C++ start from 0, and OBJ files start from 1
@@ -53,11 +100,8 @@ bool ObjLoader::LoadObjFile(const char* fileLocation, std::vector<XMFLOAT3>& out
 	CalibrateIndices(inTextureCoords, m_textureCoords, textureCoordIndices);
 	CalibrateIndices(inNormals, m_normals, normalIndices);
 
-	//---------------------------------------------------------------- As we want to draw elements index-based (to avoid duplicated vertex data), we then call this function, which checks for multiple vertex data and then finally pushes the data to the out vectors
-	PushData(outVertices, outTextureCoords, outNormals, outIndices);
-
 	//---------------------------------------------------------------- Close the file once we are finished with it. This is necessary as other OBJ files cannot be loaded as long as the file remains open
-	File::Instance()->Close(fileLocation);
+	file->Close(fileLocation);
 
 	return true;
 }
@@ -24,8 +24,10 @@ public:
 
 public:
 	bool LoadObjFile(const char* fileLocation, std::vector<XMFLOAT3>& outVertices, std::vector<XMFLOAT2>& outTextureCoords, std::vector<XMFLOAT3>& outNormals, std::vector<unsigned int>& outIndices);
+	bool LoadObjFile(const char* fileLocation, std::vector<BufferConstants::PackedVertex>& outCorners);
 
 private:
+	bool ReadObjFile(const char* fileLocation);
 	void PushData(std::vector<XMFLOAT3>& outVertices, std::vector<XMFLOAT2>& outTextureCoords, std::vector<XMFLOAT3>& outNormals, std::vector<unsigned int>& outIndices);
 	bool GetSimilarVertexIndex(BufferConstants::PackedVertex& packed, std::map<BufferConstants::PackedVertex, unsigned int>& vertexToOutIndex, unsigned int& result);
 	